@@ -85,7 +85,7 @@ class CSSModuleCompiler {
         let compiler = StyleSheetCompiler(logger: logger, content: fileContent, baseURL: baseURL, relativeProjectPath: relativeProjectPath)
         let result = try compiler.compile()
 
-        let data = try result.rootStyleNode.orderedSerializedData()
+        let data = StyleTable.serialize(styleNode: result.rootStyleNode)
 
         let importPath = "\(relativeProjectPath).\(FileExtensions.valdiCss)"
 
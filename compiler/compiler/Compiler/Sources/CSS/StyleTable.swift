@@ -0,0 +1,381 @@
+//
+//  StyleTable.swift
+//  Compiler
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+import Foundation
+
+/**
+ Compact serialization format of a compiled stylesheet, emitted in place of the StyleNode
+ protobuf. The runtime deserializes it into the same in-memory rule tree as the protobuf,
+ without going through protobuf parsing. Strings and attributes are stored once in tables
+ and referenced by index from the rule tree. See CSSStyleTable.hpp in the runtime for the
+ detailed layout, both sides must be kept in sync.
+ */
+struct StyleTable {
+
+    static let magic: UInt32 = 0x53534356 // "VCSS"
+    static let version: UInt32 = 1
+
+    private static let attributeTypeString: UInt32 = 0
+    private static let attributeTypeInt: UInt32 = 1
+    private static let attributeTypeDouble: UInt32 = 2
+    private static let attributeTypeNull: UInt32 = 3
+
+    private struct AttributeKey: Hashable {
+        let name: String
+        let type: Int
+        let strValue: String
+        let intValue: Int64
+        let doubleBits: UInt64
+
+        init(attribute: Valdi_NodeAttribute) {
+            name = attribute.name
+            type = attribute.type.rawValue
+            strValue = attribute.type == .nodeAttributeTypeString ? attribute.strValue : ""
+            intValue = attribute.type == .nodeAttributeTypeInt ? attribute.intValue : 0
+            doubleBits = attribute.type == .nodeAttributeTypeDouble ? attribute.doubleValue.bitPattern : 0
+        }
+    }
+
+    private final class Writer {
+        var output = Data()
+        var strings = [String]()
+        var stringIndexes = [String: UInt32]()
+        var attributes = [Valdi_NodeAttribute]()
+        var attributeIndexes = [AttributeKey: UInt32]()
+
+        func write(word: UInt32) {
+            output.append(integer: word.littleEndian)
+        }
+
+        func collect(string: String) {
+            if stringIndexes[string] == nil {
+                stringIndexes[string] = UInt32(strings.count)
+                strings.append(string)
+            }
+        }
+
+        func collect(attribute: Valdi_NodeAttribute) {
+            collect(string: attribute.name)
+            if attribute.type == .nodeAttributeTypeString {
+                collect(string: attribute.strValue)
+            }
+            let key = AttributeKey(attribute: attribute)
+            if attributeIndexes[key] == nil {
+                attributeIndexes[key] = UInt32(attributes.count)
+                attributes.append(attribute)
+            }
+        }
+
+        func collect(styleNode: Valdi_StyleNode) {
+            for style in styleNode.styles {
+                collect(attribute: style.attribute)
+            }
+            if styleNode.hasRuleIndex {
+                collect(ruleIndex: styleNode.ruleIndex)
+            }
+        }
+
+        func collect(ruleIndex: Valdi_CSSRuleIndex) {
+            for namedStyleNode in ruleIndex.idRules + ruleIndex.classRules + ruleIndex.tagRules {
+                collect(string: namedStyleNode.name)
+                collect(styleNode: namedStyleNode.node)
+            }
+            for attributeRule in ruleIndex.attributeRules {
+                collect(attribute: attributeRule.attribute)
+                collect(styleNode: attributeRule.node)
+            }
+            if ruleIndex.hasFirstChildRule {
+                collect(styleNode: ruleIndex.firstChildRule)
+            }
+            if ruleIndex.hasLastChildRule {
+                collect(styleNode: ruleIndex.lastChildRule)
+            }
+            for nthChildRule in ruleIndex.nthChildRules {
+                collect(styleNode: nthChildRule.node)
+            }
+            if ruleIndex.hasAncestorRules {
+                collect(ruleIndex: ruleIndex.ancestorRules)
+            }
+            if ruleIndex.hasDirectParentRules {
+                collect(ruleIndex: ruleIndex.directParentRules)
+            }
+        }
+
+        func writeTables() {
+            write(word: UInt32(strings.count))
+            for string in strings {
+                let stringData = Data(string.utf8)
+                write(word: UInt32(stringData.count))
+                output.append(stringData)
+                for _ in 0..<Data.computePadding(size: UInt32(stringData.count)) {
+                    output.append(0)
+                }
+            }
+
+            write(word: UInt32(attributes.count))
+            for attribute in attributes {
+                write(word: stringIndexes[attribute.name]!)
+
+                let payload: UInt64
+                switch attribute.type {
+                case .nodeAttributeTypeInt:
+                    write(word: StyleTable.attributeTypeInt)
+                    payload = UInt64(bitPattern: attribute.intValue)
+                case .nodeAttributeTypeDouble:
+                    write(word: StyleTable.attributeTypeDouble)
+                    payload = attribute.doubleValue.bitPattern
+                case .nodeAttributeTypeString:
+                    write(word: StyleTable.attributeTypeString)
+                    payload = UInt64(stringIndexes[attribute.strValue]!)
+                default:
+                    // The runtime resolves attributes of an unknown type to null
+                    write(word: StyleTable.attributeTypeNull)
+                    payload = 0
+                }
+                write(word: UInt32(truncatingIfNeeded: payload))
+                write(word: UInt32(truncatingIfNeeded: payload >> 32))
+            }
+        }
+
+        func write(styleNode: Valdi_StyleNode) {
+            write(word: UInt32(styleNode.styles.count))
+            for style in styleNode.styles {
+                write(word: attributeIndexes[AttributeKey(attribute: style.attribute)]!)
+                write(word: UInt32(bitPattern: style.priority))
+                write(word: UInt32(bitPattern: style.id))
+            }
+
+            write(word: styleNode.hasRuleIndex ? 1 : 0)
+            if styleNode.hasRuleIndex {
+                write(ruleIndex: styleNode.ruleIndex)
+            }
+        }
+
+        func write(mapRule: [Valdi_NamedStyleNode]) {
+            // Sorted so that the runtime can insert them in order, and to keep builds deterministic
+            let sortedRules = mapRule.sorted { $0.name < $1.name }
+            write(word: UInt32(sortedRules.count))
+            for namedStyleNode in sortedRules {
+                write(word: stringIndexes[namedStyleNode.name]!)
+                write(styleNode: namedStyleNode.node)
+            }
+        }
+
+        func write(ruleIndex: Valdi_CSSRuleIndex) {
+            write(mapRule: ruleIndex.idRules)
+            write(mapRule: ruleIndex.classRules)
+            write(mapRule: ruleIndex.tagRules)
+
+            write(word: UInt32(ruleIndex.attributeRules.count))
+            for attributeRule in ruleIndex.attributeRules {
+                write(word: attributeIndexes[AttributeKey(attribute: attributeRule.attribute)]!)
+                write(word: UInt32(attributeRule.type.rawValue))
+                write(styleNode: attributeRule.node)
+            }
+
+            write(word: ruleIndex.hasFirstChildRule ? 1 : 0)
+            if ruleIndex.hasFirstChildRule {
+                write(styleNode: ruleIndex.firstChildRule)
+            }
+            write(word: ruleIndex.hasLastChildRule ? 1 : 0)
+            if ruleIndex.hasLastChildRule {
+                write(styleNode: ruleIndex.lastChildRule)
+            }
+
+            write(word: UInt32(ruleIndex.nthChildRules.count))
+            for nthChildRule in ruleIndex.nthChildRules {
+                write(word: UInt32(bitPattern: nthChildRule.n))
+                write(word: UInt32(bitPattern: nthChildRule.offset))
+                write(styleNode: nthChildRule.node)
+            }
+
+            write(word: ruleIndex.hasAncestorRules ? 1 : 0)
+            if ruleIndex.hasAncestorRules {
+                write(ruleIndex: ruleIndex.ancestorRules)
+            }
+            write(word: ruleIndex.hasDirectParentRules ? 1 : 0)
+            if ruleIndex.hasDirectParentRules {
+                write(ruleIndex: ruleIndex.directParentRules)
+            }
+        }
+    }
+
+    private final class Reader {
+        let parser: Parser<Data>
+        var strings = [String]()
+        var attributes = [Valdi_NodeAttribute]()
+
+        init(data: Data) {
+            parser = Parser(sequence: data)
+        }
+
+        func readWord() throws -> UInt32 {
+            return UInt32(littleEndian: try parser.parseInt())
+        }
+
+        func readPresence() throws -> Bool {
+            return try readWord() != 0
+        }
+
+        func readString() throws -> String {
+            let index = Int(try readWord())
+            guard index < strings.count else {
+                throw CompilerError("Invalid string index \(index) in style table")
+            }
+            return strings[index]
+        }
+
+        func readAttribute() throws -> Valdi_NodeAttribute {
+            let index = Int(try readWord())
+            guard index < attributes.count else {
+                throw CompilerError("Invalid attribute index \(index) in style table")
+            }
+            return attributes[index]
+        }
+
+        func readTables() throws {
+            let stringsCount = try readWord()
+            for _ in 0..<stringsCount {
+                let length = try readWord()
+                let stringData = try parser.subsequence(length: Int(length))
+                let padding = Int(Data.computePadding(size: length))
+                if padding > 0 {
+                    try parser.advance(distance: padding)
+                }
+                strings.append(String(data: Data(stringData), encoding: .utf8) ?? "<invalid>")
+            }
+
+            let attributesCount = try readWord()
+            for _ in 0..<attributesCount {
+                var attribute = Valdi_NodeAttribute()
+                attribute.name = try readString()
+                let type = try readWord()
+                let payload = UInt64(try readWord()) | (UInt64(try readWord()) << 32)
+                switch type {
+                case StyleTable.attributeTypeInt:
+                    attribute.type = .nodeAttributeTypeInt
+                    attribute.intValue = Int64(bitPattern: payload)
+                case StyleTable.attributeTypeDouble:
+                    attribute.type = .nodeAttributeTypeDouble
+                    attribute.doubleValue = Double(bitPattern: payload)
+                case StyleTable.attributeTypeString:
+                    attribute.type = .nodeAttributeTypeString
+                    let index = Int(payload)
+                    guard index < strings.count else {
+                        throw CompilerError("Invalid string index \(index) in style table")
+                    }
+                    attribute.strValue = strings[index]
+                case StyleTable.attributeTypeNull:
+                    attribute.type = .UNRECOGNIZED(Int(StyleTable.attributeTypeNull))
+                default:
+                    throw CompilerError("Invalid attribute type \(type) in style table")
+                }
+                attributes.append(attribute)
+            }
+        }
+
+        func readStyleNode() throws -> Valdi_StyleNode {
+            var styleNode = Valdi_StyleNode()
+            let stylesCount = try readWord()
+            for _ in 0..<stylesCount {
+                var style = Valdi_StyleDeclaration()
+                style.attribute = try readAttribute()
+                style.priority = Int32(bitPattern: try readWord())
+                style.id = Int32(bitPattern: try readWord())
+                styleNode.styles.append(style)
+            }
+            if try readPresence() {
+                styleNode.ruleIndex = try readRuleIndex()
+            }
+            return styleNode
+        }
+
+        func readMapRule() throws -> [Valdi_NamedStyleNode] {
+            var out = [Valdi_NamedStyleNode]()
+            let count = try readWord()
+            for _ in 0..<count {
+                var namedStyleNode = Valdi_NamedStyleNode()
+                namedStyleNode.name = try readString()
+                namedStyleNode.node = try readStyleNode()
+                out.append(namedStyleNode)
+            }
+            return out
+        }
+
+        func readRuleIndex() throws -> Valdi_CSSRuleIndex {
+            var ruleIndex = Valdi_CSSRuleIndex()
+            ruleIndex.idRules = try readMapRule()
+            ruleIndex.classRules = try readMapRule()
+            ruleIndex.tagRules = try readMapRule()
+
+            let attributeRulesCount = try readWord()
+            for _ in 0..<attributeRulesCount {
+                var attributeRule = Valdi_CSSRuleIndex.AttributeRule()
+                attributeRule.attribute = try readAttribute()
+                attributeRule.type = Valdi_CSSRuleIndex.AttributeRule.TypeEnum(rawValue: Int(try readWord())) ?? .equals
+                attributeRule.node = try readStyleNode()
+                ruleIndex.attributeRules.append(attributeRule)
+            }
+
+            if try readPresence() {
+                ruleIndex.firstChildRule = try readStyleNode()
+            }
+            if try readPresence() {
+                ruleIndex.lastChildRule = try readStyleNode()
+            }
+
+            let nthChildRulesCount = try readWord()
+            for _ in 0..<nthChildRulesCount {
+                var nthChildRule = Valdi_CSSRuleIndex.NthChildRule()
+                nthChildRule.n = Int32(bitPattern: try readWord())
+                nthChildRule.offset = Int32(bitPattern: try readWord())
+                nthChildRule.node = try readStyleNode()
+                ruleIndex.nthChildRules.append(nthChildRule)
+            }
+
+            if try readPresence() {
+                ruleIndex.ancestorRules = try readRuleIndex()
+            }
+            if try readPresence() {
+                ruleIndex.directParentRules = try readRuleIndex()
+            }
+            return ruleIndex
+        }
+    }
+
+    static func isStyleTable(data: Data) -> Bool {
+        guard data.count >= 4 else {
+            return false
+        }
+        return UInt32(data: Data(data.prefix(4))).map { UInt32(littleEndian: $0) } == magic
+    }
+
+    static func serialize(styleNode: Valdi_StyleNode) -> Data {
+        let writer = Writer()
+        writer.collect(styleNode: styleNode)
+
+        writer.write(word: magic)
+        writer.write(word: version)
+        writer.writeTables()
+        writer.write(styleNode: styleNode)
+
+        return writer.output
+    }
+
+    static func deserialize(data: Data) throws -> Valdi_StyleNode {
+        let reader = Reader(data: data)
+        guard try reader.readWord() == magic else {
+            throw CompilerError("Did not find style table magic")
+        }
+        let dataVersion = try reader.readWord()
+        guard dataVersion == version else {
+            throw CompilerError("Unsupported style table version \(dataVersion)")
+        }
+        try reader.readTables()
+        return try reader.readStyleNode()
+    }
+}
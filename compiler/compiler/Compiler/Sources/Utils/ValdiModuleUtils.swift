@@ -66,7 +66,11 @@ class ValdiModuleUtils {
         if filename.hasSuffix(Files.downloadManifest) {
             protobufMessage = try Valdi_DownloadableModuleManifest(serializedData: fileData)
         } else if filename.hasSuffix(FileExtensions.valdiCss) {
-            protobufMessage = try Valdi_StyleNode(serializedData: fileData)
+            if StyleTable.isStyleTable(data: fileData) {
+                protobufMessage = try StyleTable.deserialize(data: fileData)
+            } else {
+                protobufMessage = try Valdi_StyleNode(serializedData: fileData)
+            }
         } else {
             protobufMessage = nil
         }
@@ -0,0 +1,175 @@
+//
+//  main.cpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+// Replays a DisplayList capture made with DisplayListCaptureWriter through a RasterContext,
+// and reports how long the frames took to rasterize. This lets us reproduce rendering
+// performance issues from a device capture on a headless machine.
+//
+// Usage: replay <capture_path> [--iterations <count>] [--scale <scale>] [--mode full|delta|both]
+
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayListCapture.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/RasterContext.hpp"
+#include "snap_drawing/cpp/Utils/Bitmap.hpp"
+
+#include "utils/time/StopWatch.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/DiskUtils.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+using namespace snap::drawing;
+
+using ReplayDuration = snap::utils::time::Duration<std::chrono::steady_clock>;
+
+struct ReplayOptions {
+    std::string_view capturePath;
+    size_t iterations = 1;
+    Scalar scale = 1;
+    bool full = true;
+    bool delta = true;
+};
+
+static int printUsage() {
+    fmt::print(stderr, "Usage: replay <capture_path> [--iterations <count>] [--scale <scale>] [--mode full|delta|both]\n");
+    return EXIT_FAILURE;
+}
+
+static bool parseOptions(int argc, const char** argv, ReplayOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg(argv[i]);
+        auto hasValue = i + 1 < argc;
+
+        if (arg == "--iterations" && hasValue) {
+            options.iterations = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--scale" && hasValue) {
+            options.scale = static_cast<Scalar>(std::atof(argv[++i]));
+        } else if (arg == "--mode" && hasValue) {
+            std::string_view mode(argv[++i]);
+            options.full = mode == "full" || mode == "both";
+            options.delta = mode == "delta" || mode == "both";
+        } else if (options.capturePath.empty() && !arg.empty() && arg[0] != '-') {
+            options.capturePath = arg;
+        } else {
+            return false;
+        }
+    }
+
+    return !options.capturePath.empty() && options.scale > 0 && (options.full || options.delta);
+}
+
+static ReplayDuration percentile(std::vector<ReplayDuration>& durations, double ratio) {
+    auto index = static_cast<size_t>(std::ceil(ratio * static_cast<double>(durations.size())));
+    index = std::clamp(index, static_cast<size_t>(1), durations.size()) - 1;
+    std::nth_element(durations.begin(), durations.begin() + index, durations.end());
+    return durations[index];
+}
+
+static bool replay(const Ref<DisplayListCapture>& capture, const ReplayOptions& options, bool delta) {
+    auto rasterContext = Valdi::makeShared<RasterContext>(
+        Valdi::ConsoleLogger::getLogger(), ExternalSurfaceRasterizationMethod::ACCURATE, delta);
+
+    std::vector<ReplayDuration> durations;
+    ReplayDuration totalDuration;
+    size_t renderedPixelsCount = 0;
+    Ref<Valdi::IBitmap> bitmap;
+
+    for (size_t iteration = 0; iteration < options.iterations; iteration++) {
+        for (const auto& frame : capture->getFrames()) {
+            auto width = static_cast<int>(std::ceil(frame->getSize().width * options.scale));
+            auto height = static_cast<int>(std::ceil(frame->getSize().height * options.scale));
+            if (width <= 0 || height <= 0) {
+                continue;
+            }
+
+            if (bitmap == nullptr || bitmap->getInfo().width != width || bitmap->getInfo().height != height) {
+                auto newBitmap = Bitmap::make(Valdi::BitmapInfo(
+                    width, height, Valdi::ColorTypeRGBA8888, Valdi::AlphaTypePremul, static_cast<size_t>(width) * 4));
+                if (!newBitmap) {
+                    fmt::print(stderr, "Failed to allocate bitmap: {}\n", newBitmap.error().toString());
+                    return false;
+                }
+                bitmap = newBitmap.value();
+            }
+
+            snap::utils::time::StopWatch sw;
+            sw.start();
+
+            auto result = delta ? rasterContext->rasterDelta(frame, bitmap) : rasterContext->raster(frame, bitmap, true);
+
+            auto elapsed = sw.elapsed();
+            if (!result) {
+                fmt::print(stderr, "Failed to raster frame: {}\n", result.error().toString());
+                return false;
+            }
+
+            durations.emplace_back(elapsed);
+            totalDuration += elapsed;
+            renderedPixelsCount += result.value().renderedPixelsCount;
+        }
+    }
+
+    if (durations.empty()) {
+        fmt::print("{}: no frames to raster\n", delta ? "delta" : "full");
+        return true;
+    }
+
+    auto framesCount = durations.size();
+    auto maxDuration = *std::max_element(durations.begin(), durations.end());
+    auto p50 = percentile(durations, 0.5);
+    auto p90 = percentile(durations, 0.9);
+    auto p99 = percentile(durations, 0.99);
+
+    fmt::print("{}: {} frames in {} (avg {}, p50 {}, p90 {}, p99 {}, max {}), {} rendered pixels per frame\n",
+               delta ? "delta" : "full",
+               framesCount,
+               totalDuration,
+               totalDuration / framesCount,
+               p50,
+               p90,
+               p99,
+               maxDuration,
+               renderedPixelsCount / framesCount);
+
+    return true;
+}
+
+int main(int argc, const char** argv) {
+    ReplayOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return printUsage();
+    }
+
+    auto data = Valdi::DiskUtils::load(Valdi::DiskUtils::absolutePathFromString(options.capturePath));
+    if (!data) {
+        fmt::print(stderr, "Failed to load capture: {}\n", data.error().toString());
+        return EXIT_FAILURE;
+    }
+
+    auto capture = DisplayListCapture::parse(data.value(), /* mergePlanes */ true);
+    if (!capture) {
+        fmt::print(stderr, "Failed to parse capture: {}\n", capture.error().toString());
+        return EXIT_FAILURE;
+    }
+
+    fmt::print("Loaded {} frames from {}\n", capture.value()->getFrames().size(), options.capturePath);
+
+    if (options.full && !replay(capture.value(), options, false)) {
+        return EXIT_FAILURE;
+    }
+    if (options.delta && !replay(capture.value(), options, true)) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
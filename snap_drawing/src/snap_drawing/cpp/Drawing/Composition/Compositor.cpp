@@ -13,10 +13,13 @@
 #include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/ExternalSurface.hpp"
 #include "utils/debugging/Assert.hpp"
+#include "utils/time/StopWatch.hpp"
 
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include <optional>
+
 namespace snap::drawing {
 
 // Since we use a bitmask for the presence field in order to remain efficient,
@@ -63,11 +66,27 @@ struct SubmittedPrepareMask {
 
 class PopulatePlanesVisitor {
 public:
-    PopulatePlanesVisitor(DisplayList& displayList, Valdi::ILogger& logger)
+    PopulatePlanesVisitor(DisplayList& displayList,
+                          Valdi::ILogger& logger,
+                          const Valdi::SmallVector<CompositorCachedPlane, 4>* cachedPlanes)
         : _displayList(displayList),
           _displayListFrame(0, 0, displayList.getSize().width, displayList.getSize().height),
-          _logger(logger) {
+          _logger(logger),
+          _cachedPlanes(cachedPlanes) {
         appendContext(CompositionState(), nullptr);
+
+        if (_cachedPlanes != nullptr) {
+            // Re-create the planes of the cached composition upfront. The external planes
+            // are completed as their DrawExternalSurface operations are visited.
+            for (const auto& cachedPlane : *_cachedPlanes) {
+                if (cachedPlane.externalSurface != nullptr) {
+                    _resolvedPlanes.emplace_back(nullptr, Matrix(), Path(), 1.0f, cachedPlane.absoluteFrame);
+                    _cachedExternalPlanesCount++;
+                } else {
+                    appendRegularPlane();
+                }
+            }
+        }
     }
 
     void visit(const Operations::PushContext& pushContext) {
@@ -104,14 +123,26 @@ public:
     }
 
     void visit(const Operations::DrawPicture& drawPicture) {
+        if (_replayFailed) {
+            return;
+        }
+
         auto absoluteClippedPictureRect =
             resolveAbsoluteClippedRect(fromSkValue<Rect>(drawPicture.picture->cullRect()));
 
-        auto& resolvedPlane = resolveRegularPlane(absoluteClippedPictureRect);
-        appendDrawPictureToPlane(drawPicture, absoluteClippedPictureRect, resolvedPlane);
+        auto* resolvedPlane = resolveRegularPlane(absoluteClippedPictureRect);
+        if (resolvedPlane == nullptr) {
+            return;
+        }
+
+        appendDrawPictureToPlane(drawPicture, absoluteClippedPictureRect, *resolvedPlane);
     }
 
     void visit(const Operations::DrawExternalSurface& drawExternalSurface) {
+        if (_replayFailed) {
+            return;
+        }
+
         auto& current = getCurrentContext();
 
         auto& externalSurface = drawExternalSurface.externalSurfaceSnapshot->getExternalSurface();
@@ -122,6 +153,15 @@ public:
         auto absoluteOpacity = drawExternalSurface.opacity * current.compositionState.getAbsoluteOpacity();
         auto absoluteSurfaceRect = current.compositionState.getAbsoluteRect(externalSurfaceRect);
 
+        if (_cachedPlanes != nullptr) {
+            replayExternalPlane(drawExternalSurface.externalSurfaceSnapshot,
+                                current.compositionState.getAbsoluteMatrix(),
+                                current.compositionState.getAbsoluteClipPath(),
+                                absoluteOpacity,
+                                absoluteSurfaceRect);
+            return;
+        }
+
         appendExternalPlane(drawExternalSurface.externalSurfaceSnapshot,
                             current.compositionState.getAbsoluteMatrix(),
                             current.compositionState.getAbsoluteClipPath(),
@@ -130,16 +170,24 @@ public:
     }
 
     void visit(const Operations::PrepareMask& prepareMask) {
+        if (_replayFailed) {
+            return;
+        }
+
         auto absoluteClippedRect = resolveAbsoluteClippedRect(prepareMask.mask->getBounds());
 
-        auto& resolvedPlane = resolveRegularPlane(absoluteClippedRect);
+        auto* resolvedPlane = resolveRegularPlane(absoluteClippedRect);
+        if (resolvedPlane == nullptr) {
+            return;
+        }
 
-        resolvedPlane.bbox->insert(absoluteClippedRect);
+        resolvedPlane->bbox->insert(absoluteClippedRect);
+        _usedPlanesField |= static_cast<uint64_t>(1) << resolvedPlane->planeIndex;
 
-        syncDisplayListWithPlaneIfNeeded(resolvedPlane);
+        syncDisplayListWithPlaneIfNeeded(*resolvedPlane);
         _displayList.appendPrepareMask(prepareMask.mask);
 
-        _submittedPrepareMasks.emplace_back(prepareMask.mask, resolvedPlane.planeIndex);
+        _submittedPrepareMasks.emplace_back(prepareMask.mask, resolvedPlane->planeIndex);
     }
 
     void visit(const Operations::ApplyMask& applyMask) {
@@ -161,16 +209,38 @@ public:
         return _resolvedPlanes;
     }
 
+    /**
+     Returns whether the cached planes could be used to compose the visited DisplayList.
+     */
+    bool didReplayCachedPlanes() const {
+        if (_cachedPlanes == nullptr || _replayFailed || _replayedExternalPlanesCount != _cachedExternalPlanesCount) {
+            return false;
+        }
+
+        // A regular plane that no longer holds anything would still cost a surface
+        auto regularPlanesCount = _cachedPlanes->size() - _cachedExternalPlanesCount;
+        auto allPlanesField = regularPlanesCount == kMaxSurfacesCount ?
+                                  ~static_cast<uint64_t>(0) :
+                                  (static_cast<uint64_t>(1) << regularPlanesCount) - 1;
+        return _usedPlanesField == allPlanesField;
+    }
+
 private:
     [[maybe_unused]] DisplayList& _displayList;
     Rect _displayListFrame;
     [[maybe_unused]] Valdi::ILogger& _logger;
+    const Valdi::SmallVector<CompositorCachedPlane, 4>* _cachedPlanes;
     Valdi::SmallVector<VisitedContext, 8> _visitedContexts;
     Valdi::SmallVector<ResolvedPlane, 2> _resolvedPlanes;
     Valdi::SmallVector<SubmittedPrepareMask, 2> _submittedPrepareMasks;
     std::vector<int> _bboxSearchResult;
     uint64_t _planeIndexSequence = 0;
     uint64_t _currentDisplayListPlaneIndex = 0;
+    // Bitmask of the regular planes which have received a draw operation
+    uint64_t _usedPlanesField = 0;
+    size_t _cachedExternalPlanesCount = 0;
+    size_t _replayedExternalPlanesCount = 0;
+    bool _replayFailed = false;
 
     Rect resolveAbsoluteClippedRect(const Rect& relativeRect) {
         return getCurrentContext().compositionState.getAbsoluteClippedRect(relativeRect);
@@ -198,6 +268,7 @@ private:
                                   const Rect& frame,
                                   ResolvedRegularPlane& plane) {
         plane.bbox->insert(frame);
+        _usedPlanesField |= static_cast<uint64_t>(1) << plane.planeIndex;
 
         syncDisplayListWithPlaneIfNeeded(plane);
         _displayList.appendPicture(drawPicture.picture, drawPicture.opacity);
@@ -332,6 +403,95 @@ private:
         return *it->getExternal();
     }
 
+    void replayExternalPlane(ExternalSurfaceSnapshot* externalSurfaceSnapshot,
+                             const Matrix& transform,
+                             const Path& clipPath,
+                             Scalar opacity,
+                             const Rect& absoluteFrame) {
+        // External planes are always inserted above the previous ones, so they appear
+        // in the cached planes in the same order as they are drawn.
+        auto externalPlaneIndex = _replayedExternalPlanesCount++;
+        for (auto& plane : _resolvedPlanes) {
+            auto* externalPlane = plane.getExternal();
+            if (externalPlane == nullptr) {
+                continue;
+            }
+
+            if (externalPlaneIndex > 0) {
+                externalPlaneIndex--;
+                continue;
+            }
+
+            if (externalPlane->absoluteFrame != absoluteFrame || !isSameExternalSurface(plane, externalSurfaceSnapshot)) {
+                _replayFailed = true;
+                return;
+            }
+
+            externalPlane->externalSurface = externalSurfaceSnapshot;
+            externalPlane->transform = transform;
+            externalPlane->clipPath = clipPath;
+            externalPlane->opacity = opacity;
+            return;
+        }
+
+        // More external surfaces than in the cached composition
+        _replayFailed = true;
+    }
+
+    bool isSameExternalSurface(const ResolvedPlane& plane, ExternalSurfaceSnapshot* externalSurfaceSnapshot) const {
+        auto planeIndex = static_cast<size_t>(&plane - _resolvedPlanes.data());
+        return (*_cachedPlanes)[planeIndex].externalSurface == externalSurfaceSnapshot->getExternalSurface().get();
+    }
+
+    /**
+     Finds the lowest cached regular plane in which a draw operation can be inserted without
+     breaking the drawing order: above the external planes that were already drawn and the regular
+     planes holding intersecting content, and below the external planes that are yet to be drawn.
+     */
+    ResolvedRegularPlane* resolveReplayedRegularPlane(const Rect& absoluteFrame) {
+        size_t minIndex = 0;
+        size_t maxIndex = _resolvedPlanes.size();
+        auto foundIntersectingContent = false;
+
+        size_t index = _resolvedPlanes.size();
+        while (index > 0) {
+            index--;
+
+            auto& plane = _resolvedPlanes[index];
+            auto* externalPlane = plane.getExternal();
+            if (externalPlane != nullptr) {
+                if (!externalPlane->absoluteFrame.intersects(absoluteFrame)) {
+                    continue;
+                }
+
+                if (externalPlane->externalSurface != nullptr) {
+                    // Already drawn, and so are all the external planes below it
+                    if (!foundIntersectingContent) {
+                        minIndex = index + 1;
+                    }
+                    break;
+                }
+
+                maxIndex = index;
+            } else if (!foundIntersectingContent && plane.getRegular()->bbox->contains(absoluteFrame)) {
+                // Keep looking for external planes below that are yet to be drawn
+                minIndex = index;
+                foundIntersectingContent = true;
+            }
+        }
+
+        for (size_t index = minIndex; index < maxIndex; index++) {
+            auto* regularPlane = _resolvedPlanes[index].getRegular();
+            if (regularPlane != nullptr) {
+                return regularPlane;
+            }
+        }
+
+        // The operation crosses the boundary of the cached planes
+        _replayFailed = true;
+        return nullptr;
+    }
+
     ResolvedRegularPlane* getTopRegularPlane() {
         size_t index = _resolvedPlanes.size();
         while (index > 0) {
@@ -347,7 +507,11 @@ private:
         return nullptr;
     }
 
-    ResolvedRegularPlane& resolveRegularPlane(const Rect& absoluteFrame) {
+    ResolvedRegularPlane* resolveRegularPlane(const Rect& absoluteFrame) {
+        if (_cachedPlanes != nullptr) {
+            return resolveReplayedRegularPlane(absoluteFrame);
+        }
+
         ResolvedRegularPlane* bestPlane = nullptr;
 
         // The algorithm goes from top plane to bottom, and finds the lowest plane
@@ -379,17 +543,17 @@ private:
         }
 
         if (bestPlane != nullptr) {
-            return *bestPlane;
+            return bestPlane;
         }
 
         if (_planeIndexSequence < kMaxSurfacesCount) {
-            return appendRegularPlane();
+            return &appendRegularPlane();
         }
 
         // Cannot create more planes, we fallback on re-using the top one
         auto* topPlane = getTopRegularPlane();
         SC_ASSERT_NOTNULL(topPlane);
-        return *topPlane;
+        return topPlane;
     }
 };
 
@@ -397,19 +561,48 @@ Compositor::Compositor(Valdi::ILogger& logger) : _logger(logger) {}
 
 Ref<DisplayList> Compositor::performComposition(DisplayList& sourceDisplayList, CompositorPlaneList& planeList) {
     if (!sourceDisplayList.hasExternalSurfaces()) {
+        _cachedPlanes.clear();
+        _lastCompositionMetrics = CompositionMetrics();
         planeList.appendDrawableSurface();
         return Ref<DisplayList>(&sourceDisplayList);
     }
 
     VALDI_TRACE("SnapDrawing.performComposition");
 
-    auto outputDisplayList =
-        Valdi::makeShared<DisplayList>(sourceDisplayList.getSize(), sourceDisplayList.getFrameTime());
+    snap::utils::time::StopWatch stopWatch;
+    stopWatch.start();
 
-    PopulatePlanesVisitor visitor(*outputDisplayList, _logger);
-    sourceDisplayList.visitOperations(kDisplayListAllPlaneIndexes, visitor);
+    Ref<DisplayList> outputDisplayList;
+    std::optional<PopulatePlanesVisitor> visitor;
+    auto reusedPlanes = false;
+
+    if (!_cachedPlanes.empty()) {
+        outputDisplayList =
+            Valdi::makeShared<DisplayList>(sourceDisplayList.getSize(), sourceDisplayList.getFrameTime());
+        visitor.emplace(*outputDisplayList, _logger, &_cachedPlanes);
+        sourceDisplayList.visitOperations(kDisplayListAllPlaneIndexes, visitor.value());
+        reusedPlanes = visitor->didReplayCachedPlanes();
+    }
 
-    for (const auto& plane : visitor.getResolvedPlanes()) {
+    if (!reusedPlanes) {
+        outputDisplayList =
+            Valdi::makeShared<DisplayList>(sourceDisplayList.getSize(), sourceDisplayList.getFrameTime());
+        visitor.emplace(*outputDisplayList, _logger, nullptr);
+        sourceDisplayList.visitOperations(kDisplayListAllPlaneIndexes, visitor.value());
+
+        _cachedPlanes.clear();
+        for (const auto& plane : visitor->getResolvedPlanes()) {
+            const auto* resolvedExternalSurface = plane.getExternal();
+            if (resolvedExternalSurface != nullptr) {
+                _cachedPlanes.emplace_back(resolvedExternalSurface->externalSurface->getExternalSurface().get(),
+                                           resolvedExternalSurface->absoluteFrame);
+            } else {
+                _cachedPlanes.emplace_back(nullptr, Rect::makeEmpty());
+            }
+        }
+    }
+
+    for (const auto& plane : visitor->getResolvedPlanes()) {
         const auto* resolvedExternalSurface = plane.getExternal();
         if (resolvedExternalSurface != nullptr) {
             planeList.appendPlane(
@@ -420,7 +613,14 @@ Ref<DisplayList> Compositor::performComposition(DisplayList& sourceDisplayList,
         }
     }
 
+    _lastCompositionMetrics.duration = Duration::fromSeconds(stopWatch.elapsed().seconds());
+    _lastCompositionMetrics.reusedPlanes = reusedPlanes;
+
     return outputDisplayList;
 }
 
+const CompositionMetrics& Compositor::getLastCompositionMetrics() const {
+    return _lastCompositionMetrics;
+}
+
 } // namespace snap::drawing
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Utils/Duration.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
 
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 
@@ -18,6 +20,25 @@ class ILogger;
 namespace snap::drawing {
 
 class CompositorPlaneList;
+class ExternalSurface;
+
+struct CompositionMetrics {
+    // Time spent resolving the planes of the last DisplayList
+    Duration duration;
+    // Whether the plane split of the previous DisplayList was re-used
+    bool reusedPlanes = false;
+};
+
+// A plane resolved during the last full composition, from bottom to top
+struct CompositorCachedPlane {
+    // The external surface drawn in the plane, or nullptr for a regular plane.
+    // Only used for identity comparisons, the surface is not retained.
+    const ExternalSurface* externalSurface;
+    Rect absoluteFrame;
+
+    inline CompositorCachedPlane(const ExternalSurface* externalSurface, const Rect& absoluteFrame)
+        : externalSurface(externalSurface), absoluteFrame(absoluteFrame) {}
+};
 
 /**
  The Compositor finds how many surfaces need to be used in order to draw a DisplayList.
@@ -27,6 +48,12 @@ class CompositorPlaneList;
  surfaces depending on what they should drawn. The Compositor tries to limit the number
  of regular surfaces to use as much as possible. It does this by calculating the intersections
  of the draw commands to see if they intersects with external surfaces.
+
+ The Compositor remembers the planes it resolved for the last DisplayList. When the next DisplayList
+ has the same external surfaces at the same absolute frames, the draw commands are assigned to the
+ remembered planes instead of splitting the DisplayList again. The planes are re-resolved from scratch
+ when the external surfaces changed, when a draw command can no longer fit in any of the remembered
+ regular planes without breaking the drawing order, or when a remembered regular plane ends up empty.
  */
 class Compositor {
 public:
@@ -34,8 +61,15 @@ public:
 
     Ref<DisplayList> performComposition(DisplayList& sourceDisplayList, CompositorPlaneList& planeList);
 
+    /**
+     Returns how long the last call to performComposition() took and whether the planes were re-used.
+     */
+    const CompositionMetrics& getLastCompositionMetrics() const;
+
 private:
     [[maybe_unused]] Valdi::ILogger& _logger;
+    Valdi::SmallVector<CompositorCachedPlane, 4> _cachedPlanes;
+    CompositionMetrics _lastCompositionMetrics;
 };
 
 } // namespace snap::drawing
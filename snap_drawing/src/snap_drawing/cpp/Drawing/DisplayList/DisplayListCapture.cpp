@@ -0,0 +1,749 @@
+//
+//  DisplayListCapture.cpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayListCapture.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/GraphicsContext/BitmapGraphicsContext.hpp"
+#include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
+#include "snap_drawing/cpp/Drawing/Surface/ExternalSurface.hpp"
+#include "snap_drawing/cpp/Text/SkFontMgrSingleton.hpp"
+#include "snap_drawing/cpp/Utils/BitmapFactory.hpp"
+
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
+#include "include/encode/SkPngEncoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace snap::drawing {
+
+enum CaptureRecordType : uint32_t {
+    CaptureRecordTypePicture = 1,
+    CaptureRecordTypeMask = 2,
+    CaptureRecordTypeExternalSurface = 3,
+    CaptureRecordTypeExternalSurfaceSnapshot = 4,
+    CaptureRecordTypeFrame = 5,
+};
+
+static sk_sp<SkData> serializeImage(SkImage* image, void* /*ctx*/) {
+    return SkPngEncoder::Encode(nullptr, image, SkPngEncoder::Options());
+}
+
+static sk_sp<SkData> serializeTypeface(SkTypeface* typeface, void* /*ctx*/) {
+    // Embed the font data so that the capture can be replayed on a machine without the same fonts
+    return typeface->serialize(SkTypeface::SerializeBehavior::kDoIncludeData);
+}
+
+static sk_sp<SkTypeface> deserializeTypeface(const void* data, size_t length, void* /*ctx*/) {
+    SkMemoryStream stream(data, length, false);
+    return SkTypeface::MakeDeserialize(&stream, snap::snap_drawing::getSkFontMgrSingleton());
+}
+
+/**
+ Replays a mask captured as an SkPicture of its apply pass. The content to mask is
+ isolated in a layer, on which the recorded mask is then drawn.
+ */
+class CapturedMask : public IMask {
+public:
+    CapturedMask(const Rect& bounds, sk_sp<SkPicture> picture) : _bounds(bounds), _picture(std::move(picture)) {}
+    ~CapturedMask() override = default;
+
+    Rect getBounds() const override {
+        return _bounds;
+    }
+
+    void prepare(SkCanvas* canvas) override {
+        canvas->saveLayer(&_bounds.getSkValue(), nullptr);
+    }
+
+    void apply(SkCanvas* canvas) override {
+        canvas->drawPicture(_picture);
+        canvas->restore();
+    }
+
+    String getDescription() override {
+        return STRING_FORMAT("CapturedMask with bounds {}", _bounds);
+    }
+
+private:
+    Rect _bounds;
+    sk_sp<SkPicture> _picture;
+};
+
+/**
+ Placeholder for an external surface whose content was not captured.
+ It rasterizes as a solid rectangle covering the surface frame.
+ */
+class CapturedExternalSurface : public ExternalSurface {
+public:
+    CapturedExternalSurface() = default;
+    ~CapturedExternalSurface() override = default;
+
+    Ref<Valdi::IBitmapFactory> getRasterBitmapFactory() const override {
+        return BitmapFactory::getInstance(Valdi::ColorTypeRGBA8888);
+    }
+
+    Valdi::Result<Valdi::Void> rasterInto(const Ref<Valdi::IBitmap>& bitmap,
+                                          const Rect& frame,
+                                          const Matrix& transform,
+                                          float rasterScaleX,
+                                          float rasterScaleY) override {
+        BitmapGraphicsContext bitmapContext;
+        auto surface = bitmapContext.createBitmapSurface(bitmap);
+        auto canvas = surface->prepareCanvas();
+        if (!canvas) {
+            return canvas.moveError();
+        }
+
+        auto* skCanvas = canvas.value().getSkiaCanvas();
+        skCanvas->concat(transform.getSkValue());
+        skCanvas->scale(rasterScaleX, rasterScaleY);
+
+        SkPaint paint;
+        paint.setColor(Color::makeARGB(0xFF, 0x80, 0x80, 0x80).getSkValue());
+        skCanvas->drawRect(frame.getSkValue(), paint);
+
+        surface->flush();
+
+        return Valdi::Void();
+    }
+};
+
+struct CaptureResourcesVisitor {
+    DisplayListCaptureWriter& writer;
+
+    void visit(const Operations::PushContext& /*pushContext*/) {}
+    void visit(const Operations::PopContext& /*popContext*/) {}
+    void visit(const Operations::ClipRect& /*clipRect*/) {}
+    void visit(const Operations::ClipRound& /*clipRound*/) {}
+
+    void visit(const Operations::DrawPicture& drawPicture) {
+        auto it = writer._pictureIds.try_emplace(drawPicture.picture->uniqueID(), 0);
+        if (it.second) {
+            SkSerialProcs procs;
+            procs.fImageProc = &serializeImage;
+            procs.fTypefaceProc = &serializeTypeface;
+            auto data = drawPicture.picture->serialize(&procs);
+
+            it.first->second = writer.beginResource();
+            writer.writeWord(CaptureRecordTypePicture);
+            writer.writeWord(it.first->second);
+            writer.writeWord(static_cast<uint32_t>(data->size()));
+            writer.writeBytes(data->data(), data->size());
+            writer.endResource(it.first->second);
+        }
+
+        writer.useResource(it.first->second);
+    }
+
+    void visit(const Operations::DrawExternalSurface& drawExternalSurface) {
+        auto snapshot = Valdi::strongSmallRef(drawExternalSurface.externalSurfaceSnapshot);
+        const auto& externalSurface = snapshot->getExternalSurface();
+
+        auto surfaceIt = writer._externalSurfaceIds.try_emplace(externalSurface, 0);
+        if (surfaceIt.second) {
+            surfaceIt.first->second = writer.beginResource();
+            writer.writeWord(CaptureRecordTypeExternalSurface);
+            writer.writeWord(surfaceIt.first->second);
+            writer.writeScalar(externalSurface->getRelativeSize().width);
+            writer.writeScalar(externalSurface->getRelativeSize().height);
+            writer.endResource(surfaceIt.first->second);
+        }
+        auto surfaceId = surfaceIt.first->second;
+        // The surface is used before its snapshot, so that it is written first
+        writer.useResource(surfaceId);
+
+        auto snapshotIt = writer._externalSurfaceSnapshotIds.try_emplace(std::move(snapshot), 0);
+        if (snapshotIt.second) {
+            snapshotIt.first->second = writer.beginResource();
+            writer.writeWord(CaptureRecordTypeExternalSurfaceSnapshot);
+            writer.writeWord(snapshotIt.first->second);
+            writer.writeWord(surfaceId);
+            writer.endResource(snapshotIt.first->second);
+        }
+
+        writer.useResource(snapshotIt.first->second);
+    }
+
+    void visit(const Operations::PrepareMask& prepareMask) {
+        auto it = writer._maskIds.try_emplace(Valdi::strongSmallRef(prepareMask.mask), 0);
+        if (it.second) {
+            auto bounds = prepareMask.mask->getBounds();
+            SkPictureRecorder recorder;
+            auto* canvas = recorder.beginRecording(bounds.getSkValue());
+            // Balances the restore() that apply() makes after drawing the mask
+            canvas->save();
+            prepareMask.mask->apply(canvas);
+            auto data = recorder.finishRecordingAsPicture()->serialize();
+
+            it.first->second = writer.beginResource();
+            writer.writeWord(CaptureRecordTypeMask);
+            writer.writeWord(it.first->second);
+            writer.writeScalar(bounds.left);
+            writer.writeScalar(bounds.top);
+            writer.writeScalar(bounds.right);
+            writer.writeScalar(bounds.bottom);
+            writer.writeWord(static_cast<uint32_t>(data->size()));
+            writer.writeBytes(data->data(), data->size());
+            writer.endResource(it.first->second);
+        }
+
+        writer.useResource(it.first->second);
+    }
+
+    void visit(const Operations::ApplyMask& /*applyMask*/) {
+        // Always preceded by a PrepareMask with the same mask
+    }
+};
+
+struct CaptureOperationsVisitor {
+    DisplayListCaptureWriter& writer;
+    uint32_t operationsCount = 0;
+
+    void visit(const Operations::PushContext& pushContext) {
+        writeType(Operations::PushContext::kId);
+
+        Scalar matrixValues[9];
+        pushContext.matrix.getAll(matrixValues);
+        for (auto value : matrixValues) {
+            writer.writeScalar(value);
+        }
+        writer.writeScalar(pushContext.opacity);
+        writer.writeBytes(&pushContext.layerId, sizeof(pushContext.layerId));
+        writer.writeWord(pushContext.hasUpdates ? 1 : 0);
+    }
+
+    void visit(const Operations::PopContext& /*popContext*/) {
+        writeType(Operations::PopContext::kId);
+    }
+
+    void visit(const Operations::DrawPicture& drawPicture) {
+        writeType(Operations::DrawPicture::kId);
+        writer.writeWord(writer._pictureIds.find(drawPicture.picture->uniqueID())->second);
+        writer.writeScalar(drawPicture.opacity);
+    }
+
+    void visit(const Operations::ClipRect& clipRect) {
+        writeType(Operations::ClipRect::kId);
+        writer.writeScalar(clipRect.width);
+        writer.writeScalar(clipRect.height);
+    }
+
+    void visit(const Operations::ClipRound& clipRound) {
+        writeType(Operations::ClipRound::kId);
+        writer.writeScalar(clipRound.width);
+        writer.writeScalar(clipRound.height);
+
+        const auto& borderRadius = clipRound.borderRadius;
+        writer.writeScalar(borderRadius.topLeft());
+        writer.writeScalar(borderRadius.topRight());
+        writer.writeScalar(borderRadius.bottomRight());
+        writer.writeScalar(borderRadius.bottomLeft());
+        writer.writeWord((borderRadius.topLeftIsPercent() ? 1 : 0) | (borderRadius.topRightIsPercent() ? 2 : 0) |
+                         (borderRadius.bottomRightIsPercent() ? 4 : 0) |
+                         (borderRadius.bottomLeftIsPercent() ? 8 : 0));
+    }
+
+    void visit(const Operations::DrawExternalSurface& drawExternalSurface) {
+        writeType(Operations::DrawExternalSurface::kId);
+        writer.writeWord(
+            writer._externalSurfaceSnapshotIds.find(Valdi::strongSmallRef(drawExternalSurface.externalSurfaceSnapshot))
+                ->second);
+        writer.writeScalar(drawExternalSurface.opacity);
+    }
+
+    void visit(const Operations::PrepareMask& prepareMask) {
+        writeType(Operations::PrepareMask::kId);
+        writer.writeWord(writer._maskIds.find(Valdi::strongSmallRef(prepareMask.mask))->second);
+    }
+
+    void visit(const Operations::ApplyMask& applyMask) {
+        writeType(Operations::ApplyMask::kId);
+        writer.writeWord(writer._maskIds.find(Valdi::strongSmallRef(applyMask.mask))->second);
+    }
+
+    void writeType(size_t type) {
+        writer.writeWord(static_cast<uint32_t>(type));
+        operationsCount++;
+    }
+};
+
+template<typename Ids, typename Resources>
+static void removeReleasedIds(Ids& ids, const Resources& resources) {
+    auto it = ids.begin();
+    while (it != ids.end()) {
+        if (resources.find(it->second) == resources.end()) {
+            ids.erase(it++);
+        } else {
+            it++;
+        }
+    }
+}
+
+DisplayListCaptureWriter::DisplayListCaptureWriter(size_t maxFramesCount)
+    : _maxFramesCount(std::max(maxFramesCount, static_cast<size_t>(1))) {}
+
+DisplayListCaptureWriter::~DisplayListCaptureWriter() = default;
+
+void DisplayListCaptureWriter::append(const DisplayList& displayList) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+
+    _frameSequence++;
+    _currentFrame = &_frames.emplace_back();
+
+    CaptureResourcesVisitor resourcesVisitor{*this};
+    displayList.visitOperations(kDisplayListAllPlaneIndexes, resourcesVisitor);
+
+    auto size = displayList.getSize();
+    auto frameTime = displayList.getFrameTime().getTime();
+    auto planesCount = displayList.getPlanesCount();
+
+    _buffer = Valdi::makeShared<Valdi::ByteBuffer>();
+    writeWord(CaptureRecordTypeFrame);
+    writeScalar(size.width);
+    writeScalar(size.height);
+    writeBytes(&frameTime, sizeof(frameTime));
+    writeWord(static_cast<uint32_t>(planesCount));
+
+    for (size_t i = 0; i < planesCount; i++) {
+        writeOperations(displayList, i);
+    }
+
+    _currentFrame->record = std::move(_buffer);
+    _currentFrame = nullptr;
+
+    while (_frames.size() > _maxFramesCount) {
+        dropOldestFrame();
+    }
+}
+
+uint32_t DisplayListCaptureWriter::beginResource() {
+    _buffer = Valdi::makeShared<Valdi::ByteBuffer>();
+    return _resourceIdSequence++;
+}
+
+void DisplayListCaptureWriter::endResource(uint32_t resourceId) {
+    _resources[resourceId].record = std::move(_buffer);
+}
+
+void DisplayListCaptureWriter::useResource(uint32_t resourceId) {
+    auto& resource = _resources[resourceId];
+    if (resource.lastFrameSequence == _frameSequence) {
+        return;
+    }
+    resource.lastFrameSequence = _frameSequence;
+    resource.framesCount++;
+    _currentFrame->resourceIds.emplace_back(resourceId);
+}
+
+void DisplayListCaptureWriter::dropOldestFrame() {
+    auto releasedResource = false;
+    for (auto resourceId : _frames.front().resourceIds) {
+        const auto& it = _resources.find(resourceId);
+        if (--it->second.framesCount == 0) {
+            _resources.erase(it);
+            releasedResource = true;
+        }
+    }
+    _frames.pop_front();
+
+    if (releasedResource) {
+        removeReleasedIds(_pictureIds, _resources);
+        removeReleasedIds(_maskIds, _resources);
+        removeReleasedIds(_externalSurfaceIds, _resources);
+        removeReleasedIds(_externalSurfaceSnapshotIds, _resources);
+    }
+}
+
+void DisplayListCaptureWriter::writeOperations(const DisplayList& displayList, size_t planeIndex) {
+    auto countOffset = _buffer->size();
+    writeWord(0);
+
+    CaptureOperationsVisitor operationsVisitor{*this};
+    displayList.visitOperations(planeIndex, operationsVisitor);
+
+    std::memcpy(_buffer->data() + countOffset, &operationsVisitor.operationsCount, sizeof(uint32_t));
+}
+
+size_t DisplayListCaptureWriter::getFramesCount() const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return _frames.size();
+}
+
+Valdi::BytesView DisplayListCaptureWriter::getData() const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+
+    auto output = Valdi::makeShared<Valdi::ByteBuffer>();
+    auto appendWord = [&](uint32_t word) {
+        const auto* begin = reinterpret_cast<const Valdi::Byte*>(&word);
+        output->append(begin, begin + sizeof(word));
+    };
+    appendWord(DisplayListCapture::kMagic);
+    appendWord(DisplayListCapture::kVersion);
+
+    // Resources of dropped frames are written right before the first kept frame which uses them
+    Valdi::FlatSet<uint32_t> writtenResourceIds;
+    for (const auto& frame : _frames) {
+        for (auto resourceId : frame.resourceIds) {
+            if (writtenResourceIds.insert(resourceId).second) {
+                const auto& record = _resources.find(resourceId)->second.record;
+                output->append(record->begin(), record->end());
+            }
+        }
+        output->append(frame.record->begin(), frame.record->end());
+    }
+
+    return output->toBytesView();
+}
+
+void DisplayListCaptureWriter::writeWord(uint32_t word) {
+    writeBytes(&word, sizeof(word));
+}
+
+void DisplayListCaptureWriter::writeScalar(Scalar scalar) {
+    static_assert(sizeof(Scalar) == sizeof(uint32_t));
+    writeBytes(&scalar, sizeof(scalar));
+}
+
+void DisplayListCaptureWriter::writeBytes(const void* data, size_t size) {
+    const auto* begin = reinterpret_cast<const Valdi::Byte*>(data);
+    _buffer->append(begin, begin + size);
+
+    auto padding = ((size + 3) & ~static_cast<size_t>(3)) - size;
+    if (padding > 0) {
+        std::memset(_buffer->appendWritable(padding), 0, padding);
+    }
+}
+
+class DisplayListCaptureReader {
+public:
+    DisplayListCaptureReader(const Valdi::Byte* data, size_t len) : _current(data), _end(data + len) {}
+
+    Valdi::Result<std::vector<Ref<DisplayList>>> read(bool mergePlanes) {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if (!readWord(magic) || magic != DisplayListCapture::kMagic) {
+            return Valdi::Error("Invalid display list capture magic");
+        }
+        if (!readWord(version) || version != DisplayListCapture::kVersion) {
+            return Valdi::Error(STRING_FORMAT("Unsupported display list capture version {}", version));
+        }
+
+        std::vector<Ref<DisplayList>> frames;
+        while (_current != _end) {
+            uint32_t recordType = 0;
+            if (!readWord(recordType)) {
+                return malformed();
+            }
+
+            bool success = false;
+            switch (recordType) {
+                case CaptureRecordTypePicture:
+                    success = readPicture();
+                    break;
+                case CaptureRecordTypeMask:
+                    success = readMask();
+                    break;
+                case CaptureRecordTypeExternalSurface:
+                    success = readExternalSurface();
+                    break;
+                case CaptureRecordTypeExternalSurfaceSnapshot:
+                    success = readExternalSurfaceSnapshot();
+                    break;
+                case CaptureRecordTypeFrame: {
+                    auto frame = readFrame(mergePlanes);
+                    if (frame != nullptr) {
+                        frames.emplace_back(std::move(frame));
+                        success = true;
+                    }
+                } break;
+                default:
+                    break;
+            }
+
+            if (!success) {
+                return malformed();
+            }
+        }
+
+        return frames;
+    }
+
+private:
+    const Valdi::Byte* _current;
+    const Valdi::Byte* _end;
+    Valdi::FlatMap<uint32_t, sk_sp<SkPicture>> _pictures;
+    Valdi::FlatMap<uint32_t, Ref<IMask>> _masks;
+    Valdi::FlatMap<uint32_t, Ref<ExternalSurface>> _externalSurfaces;
+    Valdi::FlatMap<uint32_t, Ref<ExternalSurfaceSnapshot>> _externalSurfaceSnapshots;
+
+    static Valdi::Error malformed() {
+        return Valdi::Error("Malformed display list capture");
+    }
+
+    bool readBytes(void* output, size_t size) {
+        auto paddedSize = (size + 3) & ~static_cast<size_t>(3);
+        if (static_cast<size_t>(_end - _current) < paddedSize) {
+            return false;
+        }
+        std::memcpy(output, _current, size);
+        _current += paddedSize;
+        return true;
+    }
+
+    bool readWord(uint32_t& out) {
+        return readBytes(&out, sizeof(out));
+    }
+
+    bool readScalar(Scalar& out) {
+        return readBytes(&out, sizeof(out));
+    }
+
+    template<typename T>
+    bool readId(const Valdi::FlatMap<uint32_t, T>& resources, uint32_t& out) {
+        return readWord(out) && resources.find(out) != resources.end();
+    }
+
+    template<typename T>
+    bool readNewId(const Valdi::FlatMap<uint32_t, T>& resources, uint32_t& out) {
+        // Resources are written once, before the first frame which uses them
+        return readWord(out) && resources.find(out) == resources.end();
+    }
+
+    sk_sp<SkPicture> readSkPicture(const SkDeserialProcs* procs) {
+        uint32_t size = 0;
+        if (!readWord(size)) {
+            return nullptr;
+        }
+        auto paddedSize = (static_cast<size_t>(size) + 3) & ~static_cast<size_t>(3);
+        if (static_cast<size_t>(_end - _current) < paddedSize) {
+            return nullptr;
+        }
+
+        auto picture = SkPicture::MakeFromData(_current, size, procs);
+        _current += paddedSize;
+        return picture;
+    }
+
+    bool readPicture() {
+        uint32_t pictureId = 0;
+        if (!readNewId(_pictures, pictureId)) {
+            return false;
+        }
+
+        SkDeserialProcs procs;
+        procs.fTypefaceProc = &deserializeTypeface;
+        auto picture = readSkPicture(&procs);
+        if (picture == nullptr) {
+            return false;
+        }
+
+        _pictures[pictureId] = std::move(picture);
+        return true;
+    }
+
+    bool readMask() {
+        uint32_t maskId = 0;
+        Rect bounds;
+        if (!readNewId(_masks, maskId) || !readScalar(bounds.left) || !readScalar(bounds.top) ||
+            !readScalar(bounds.right) || !readScalar(bounds.bottom)) {
+            return false;
+        }
+
+        auto picture = readSkPicture(nullptr);
+        if (picture == nullptr) {
+            return false;
+        }
+
+        _masks[maskId] = Valdi::makeShared<CapturedMask>(bounds, std::move(picture));
+        return true;
+    }
+
+    bool readExternalSurface() {
+        uint32_t externalSurfaceId = 0;
+        Size relativeSize;
+        if (!readNewId(_externalSurfaces, externalSurfaceId) || !readScalar(relativeSize.width) ||
+            !readScalar(relativeSize.height)) {
+            return false;
+        }
+
+        auto externalSurface = Valdi::makeShared<CapturedExternalSurface>();
+        externalSurface->setRelativeSize(relativeSize);
+        _externalSurfaces[externalSurfaceId] = externalSurface;
+        return true;
+    }
+
+    bool readExternalSurfaceSnapshot() {
+        uint32_t snapshotId = 0;
+        uint32_t externalSurfaceId = 0;
+        if (!readNewId(_externalSurfaceSnapshots, snapshotId) || !readId(_externalSurfaces, externalSurfaceId)) {
+            return false;
+        }
+
+        _externalSurfaceSnapshots[snapshotId] =
+            Valdi::makeShared<ExternalSurfaceSnapshot>(_externalSurfaces[externalSurfaceId]);
+        return true;
+    }
+
+    Ref<DisplayList> readFrame(bool mergePlanes) {
+        Size size;
+        double frameTime = 0;
+        uint32_t planesCount = 0;
+        if (!readScalar(size.width) || !readScalar(size.height) || !readBytes(&frameTime, sizeof(frameTime)) ||
+            !readWord(planesCount)) {
+            return nullptr;
+        }
+
+        auto displayList = Valdi::makeShared<DisplayList>(size, TimePoint(frameTime));
+        for (uint32_t i = 0; i < planesCount; i++) {
+            if (i > 0 && !mergePlanes) {
+                displayList->appendPlane();
+            }
+            if (!readOperations(*displayList)) {
+                return nullptr;
+            }
+        }
+
+        return displayList;
+    }
+
+    bool readOperations(DisplayList& displayList) {
+        uint32_t operationsCount = 0;
+        if (!readWord(operationsCount)) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < operationsCount; i++) {
+            uint32_t type = 0;
+            if (!readWord(type) || !readOperation(displayList, type)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool readOperation(DisplayList& displayList, uint32_t type) {
+        switch (type) {
+            case Operations::PushContext::kId: {
+                Scalar matrixValues[9];
+                for (auto& value : matrixValues) {
+                    if (!readScalar(value)) {
+                        return false;
+                    }
+                }
+                Scalar opacity = 0;
+                uint64_t layerId = 0;
+                uint32_t hasUpdates = 0;
+                if (!readScalar(opacity) || !readBytes(&layerId, sizeof(layerId)) || !readWord(hasUpdates)) {
+                    return false;
+                }
+
+                Matrix matrix;
+                matrix.getSkValue().set9(matrixValues);
+                displayList.pushContext(matrix, opacity, layerId, hasUpdates != 0);
+                return true;
+            }
+            case Operations::PopContext::kId:
+                displayList.popContext();
+                return true;
+            case Operations::DrawPicture::kId: {
+                uint32_t pictureId = 0;
+                Scalar opacity = 0;
+                if (!readId(_pictures, pictureId) || !readScalar(opacity)) {
+                    return false;
+                }
+                displayList.appendPicture(_pictures[pictureId].get(), opacity);
+                return true;
+            }
+            case Operations::ClipRect::kId: {
+                Scalar width = 0;
+                Scalar height = 0;
+                if (!readScalar(width) || !readScalar(height)) {
+                    return false;
+                }
+                displayList.appendClipRect(width, height);
+                return true;
+            }
+            case Operations::ClipRound::kId: {
+                Scalar values[6];
+                uint32_t percentFlags = 0;
+                for (auto& value : values) {
+                    if (!readScalar(value)) {
+                        return false;
+                    }
+                }
+                if (!readWord(percentFlags)) {
+                    return false;
+                }
+
+                BorderRadius borderRadius(values[2],
+                                          values[3],
+                                          values[4],
+                                          values[5],
+                                          (percentFlags & 1) != 0,
+                                          (percentFlags & 2) != 0,
+                                          (percentFlags & 4) != 0,
+                                          (percentFlags & 8) != 0);
+                displayList.appendClipRound(borderRadius, values[0], values[1]);
+                return true;
+            }
+            case Operations::DrawExternalSurface::kId: {
+                uint32_t snapshotId = 0;
+                Scalar opacity = 0;
+                if (!readId(_externalSurfaceSnapshots, snapshotId) || !readScalar(opacity)) {
+                    return false;
+                }
+                displayList.appendLayerContent(LayerContent(nullptr, _externalSurfaceSnapshots[snapshotId]), opacity);
+                return true;
+            }
+            case Operations::PrepareMask::kId:
+            case Operations::ApplyMask::kId: {
+                uint32_t maskId = 0;
+                if (!readId(_masks, maskId)) {
+                    return false;
+                }
+                if (type == Operations::PrepareMask::kId) {
+                    displayList.appendPrepareMask(_masks[maskId].get());
+                } else {
+                    displayList.appendApplyMask(_masks[maskId].get());
+                }
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+};
+
+DisplayListCapture::DisplayListCapture(std::vector<Ref<DisplayList>> frames) : _frames(std::move(frames)) {}
+
+DisplayListCapture::~DisplayListCapture() = default;
+
+const std::vector<Ref<DisplayList>>& DisplayListCapture::getFrames() const {
+    return _frames;
+}
+
+Valdi::Result<Ref<DisplayListCapture>> DisplayListCapture::parse(const Valdi::BytesView& data, bool mergePlanes) {
+    DisplayListCaptureReader reader(data.data(), data.size());
+    auto frames = reader.read(mergePlanes);
+    if (!frames) {
+        return frames.moveError();
+    }
+
+    return Valdi::makeShared<DisplayListCapture>(frames.moveValue());
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,149 @@
+//
+//  DisplayListCapture.hpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Scalar.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+
+#include <deque>
+#include <vector>
+
+namespace snap::drawing {
+
+class DisplayList;
+class ExternalSurface;
+class ExternalSurfaceSnapshot;
+class IMask;
+
+/**
+ Hashes captured objects by identity. The capture holds a reference on the objects it uses
+ as keys, so that their addresses cannot be reused by new objects while they are captured.
+ */
+struct CapturedObjectHash {
+    template<typename T>
+    size_t operator()(const Ref<T>& object) const {
+        return std::hash<const void*>()(object.get());
+    }
+};
+
+template<typename T>
+using CapturedObjectIds = phmap::flat_hash_map<Ref<T>, uint32_t, CapturedObjectHash>;
+
+/**
+ Records a sequence of DisplayLists into a compact binary capture, which can be
+ loaded back with DisplayListCapture and replayed offline through a RasterContext.
+
+ The capture is a stream of 32 bits little endian words, starting with a magic and a version.
+ The resources referenced by the DisplayLists are written once, right before the first frame
+ that uses them, and are then referenced by their id:
+ - SkPictures are written using SkPicture::serialize(), with images encoded as PNG and typefaces
+   embedded in the capture.
+ - Masks are written as their bounds, and an SkPicture recording of their apply pass.
+ - External surfaces are written as placeholders holding their relative size, their content
+   is not captured.
+ Frames are written with their size, frame time and the operations of every plane.
+
+ The writer only keeps the last frames, up to the max frames count given at construction.
+ Resources are released along with the last kept frame that uses them.
+ */
+class DisplayListCaptureWriter : public Valdi::SimpleRefCountable {
+public:
+    static constexpr size_t kDefaultMaxFramesCount = 600;
+
+    explicit DisplayListCaptureWriter(size_t maxFramesCount = kDefaultMaxFramesCount);
+    ~DisplayListCaptureWriter() override;
+
+    /**
+     Append the given DisplayList as the next frame of the capture, dropping the
+     oldest frame if the capture already holds the max frames count.
+     */
+    void append(const DisplayList& displayList);
+
+    /**
+     Returns how many frames the capture currently holds.
+     */
+    size_t getFramesCount() const;
+
+    /**
+     Returns the capture data containing the frames currently held by the capture.
+     */
+    Valdi::BytesView getData() const;
+
+private:
+    struct CapturedResource {
+        Ref<Valdi::ByteBuffer> record;
+        // Number of kept frames using the resource
+        size_t framesCount = 0;
+        // Sequence of the last frame which used the resource
+        size_t lastFrameSequence = 0;
+    };
+
+    struct CapturedFrame {
+        Ref<Valdi::ByteBuffer> record;
+        // Ids of the resources used by the frame, in the order in which they need to be written
+        std::vector<uint32_t> resourceIds;
+    };
+
+    mutable Valdi::Mutex _mutex;
+    size_t _maxFramesCount;
+    std::deque<CapturedFrame> _frames;
+    Valdi::FlatMap<uint32_t, CapturedResource> _resources;
+    Valdi::FlatMap<uint32_t, uint32_t> _pictureIds;
+    CapturedObjectIds<IMask> _maskIds;
+    CapturedObjectIds<ExternalSurface> _externalSurfaceIds;
+    CapturedObjectIds<ExternalSurfaceSnapshot> _externalSurfaceSnapshotIds;
+    uint32_t _resourceIdSequence = 0;
+    size_t _frameSequence = 0;
+    // Buffer of the record being written
+    Ref<Valdi::ByteBuffer> _buffer;
+    CapturedFrame* _currentFrame = nullptr;
+
+    uint32_t beginResource();
+    void endResource(uint32_t resourceId);
+    void useResource(uint32_t resourceId);
+    void dropOldestFrame();
+
+    void writeWord(uint32_t word);
+    void writeScalar(Scalar scalar);
+    void writeBytes(const void* data, size_t size);
+    void writeOperations(const DisplayList& displayList, size_t planeIndex);
+
+    friend struct CaptureResourcesVisitor;
+    friend struct CaptureOperationsVisitor;
+};
+
+/**
+ A DisplayListCapture holds the frames loaded from a capture made by DisplayListCaptureWriter.
+ */
+class DisplayListCapture : public Valdi::SimpleRefCountable {
+public:
+    explicit DisplayListCapture(std::vector<Ref<DisplayList>> frames);
+    ~DisplayListCapture() override;
+
+    const std::vector<Ref<DisplayList>>& getFrames() const;
+
+    /**
+     Parse a capture made by DisplayListCaptureWriter.
+     When mergePlanes is true, the planes of every frame are merged into a single plane,
+     which is the form expected by RasterContext.
+     */
+    static Valdi::Result<Ref<DisplayListCapture>> parse(const Valdi::BytesView& data, bool mergePlanes);
+
+    static constexpr uint32_t kMagic = 0x434c4453; // "SDLC"
+    static constexpr uint32_t kVersion = 2;
+
+private:
+    std::vector<Ref<DisplayList>> _frames;
+};
+
+} // namespace snap::drawing
@@ -7,11 +7,15 @@
 
 #include "snap_drawing/cpp/Drawing/DrawLooper.hpp"
 #include "snap_drawing/cpp/Drawing/DrawOperation.hpp"
+#include "snap_drawing/cpp/Drawing/DrawPool.hpp"
 #include "utils/debugging/Assert.hpp"
+#include "utils/time/StopWatch.hpp"
 
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include <algorithm>
+
 namespace snap::drawing {
 
 /**
@@ -75,7 +79,9 @@ public:
 
     void onFrame(TimePoint /*time*/) override {
         auto drawLock = _drawLooper->getDrawLock();
-        _graphicsContext->setResourceCacheLimit(kMaxGpuCacheSize);
+        _drawLooper->runOnGraphicsContextThreads({_graphicsContext}, [](GraphicsContext& graphicsContext) {
+            graphicsContext.setResourceCacheLimit(kMaxGpuCacheSize);
+        });
     }
 
 private:
@@ -96,6 +102,9 @@ void DrawLooper::addLayerRoot(const Ref<LayerRoot>& layerRoot,
 
     {
         auto lock = getEntriesLock();
+        entry->getFrameTimingTracker().setFrameInterval(_targetFrameInterval);
+        entry->getFrameTimingTracker().setAdaptiveFrameRateEnabled(_adaptiveFrameRateEnabled);
+
         SC_ASSERT(getEntryForLayer(*layerRoot) == nullptr);
 
         _entries.emplace_back(entry);
@@ -256,42 +265,170 @@ void DrawLooper::onDidDraw(DrawLooperEntry& entry,
 
 void DrawLooper::drawEntry(DrawLooperEntry& entry) {
     DrawOperationsBatch batch;
-    batch.emplace_back(entry.makeDrawOperation(true));
+    batch.emplace_back(PendingDraw{Valdi::strongSmallRef(&entry), entry.makeDrawOperation(true)});
 
     drawOperationsBatch(batch);
 }
 
-DrawOperationsBatch DrawLooper::collectDrawOperations() {
+DrawOperationsBatch DrawLooper::collectDrawOperations(TimePoint time) {
     DrawOperationsBatch drawOperations;
     auto entriesLock = getEntriesLock();
 
     for (const auto& it : _entries) {
         if (it->getDrawState().needsDraw) {
-            drawOperations.emplace_back(it->makeDrawOperation(true));
+            auto& frameTimingTracker = it->getFrameTimingTracker();
+            if (frameTimingTracker.shouldSkipDrawAtTime(time)) {
+                // Throttled by the adaptive frame rate, the most recent frame gets drawn on a later vsync
+                frameTimingTracker.onDrawSkipped(time);
+                continue;
+            }
+
+            frameTimingTracker.onWillDrawAtTime(time);
+            drawOperations.emplace_back(PendingDraw{it, it->makeDrawOperation(true)});
         }
     }
 
     return drawOperations;
 }
 
-void DrawLooper::drawOperationsBatch(const DrawOperationsBatch& drawOperations) {
-    Valdi::SmallVector<GraphicsContext*, 2> graphicsContexts;
-
-    for (const auto& drawOperation : drawOperations) {
-        while (drawOperation->hasNext()) {
-            auto result = drawOperation->drawNext();
-
-            if (!result) {
-                VALDI_ERROR(_logger, "Failed to draw Surface: {}", result.error());
-            } else {
-                auto* graphicsContext = result.value();
-                if (graphicsContext != nullptr &&
-                    std::find(graphicsContexts.begin(), graphicsContexts.end(), graphicsContext) ==
-                        graphicsContexts.end()) {
-                    graphicsContexts.emplace_back(graphicsContext);
-                }
+static void appendGraphicsContext(GraphicsContextsBatch& graphicsContexts, GraphicsContext* graphicsContext) {
+    if (graphicsContext != nullptr &&
+        std::find(graphicsContexts.begin(), graphicsContexts.end(), graphicsContext) == graphicsContexts.end()) {
+        graphicsContexts.emplace_back(graphicsContext);
+    }
+}
+
+void DrawLooper::drawPendingDraw(const PendingDraw& pendingDraw, GraphicsContextsBatch& graphicsContexts) {
+    snap::utils::time::StopWatch sw;
+    sw.start();
+
+    const auto& drawOperation = pendingDraw.drawOperation;
+    while (drawOperation->hasNext()) {
+        auto result = drawOperation->drawNext();
+
+        if (!result) {
+            VALDI_ERROR(_logger, "Failed to draw Surface: {}", result.error());
+        } else {
+            appendGraphicsContext(graphicsContexts, result.value());
+        }
+    }
+
+    auto drawDuration = Duration::fromSeconds(sw.elapsed().seconds());
+    pendingDraw.entry->setLastDrawDuration(drawDuration);
+    pendingDraw.entry->getFrameTimingTracker().onFrameDrawn(drawDuration);
+}
+
+struct DrawGroup {
+    Valdi::SmallVector<size_t, 4> drawIndexes;
+    Valdi::SmallVector<const SurfacePresenterManager*, 2> surfacePresenterManagers;
+    GraphicsContextsBatch graphicsContexts;
+
+    bool sharesResource(const DrawGroup& other) const {
+        for (const auto* surfacePresenterManager : surfacePresenterManagers) {
+            if (std::find(other.surfacePresenterManagers.begin(),
+                          other.surfacePresenterManagers.end(),
+                          surfacePresenterManager) != other.surfacePresenterManagers.end()) {
+                return true;
+            }
+        }
+        for (auto* graphicsContext : graphicsContexts) {
+            if (std::find(other.graphicsContexts.begin(), other.graphicsContexts.end(), graphicsContext) !=
+                other.graphicsContexts.end()) {
+                return true;
             }
         }
+        return false;
+    }
+
+    void merge(const DrawGroup& other) {
+        drawIndexes.insert(drawIndexes.end(), other.drawIndexes.begin(), other.drawIndexes.end());
+        std::sort(drawIndexes.begin(), drawIndexes.end());
+        surfacePresenterManagers.insert(
+            surfacePresenterManagers.end(), other.surfacePresenterManagers.begin(), other.surfacePresenterManagers.end());
+        for (auto* graphicsContext : other.graphicsContexts) {
+            appendGraphicsContext(graphicsContexts, graphicsContext);
+        }
+    }
+};
+
+/**
+ Split the draws into groups which can be drawn concurrently. Draws that share a GraphicsContext
+ or a SurfacePresenterManager end up in the same group, and are drawn sequentially in their
+ original order.
+ */
+static std::vector<DrawGroup> makeIndependentDrawGroups(const DrawOperationsBatch& drawOperations) {
+    std::vector<DrawGroup> groups;
+
+    for (size_t i = 0; i < drawOperations.size(); i++) {
+        const auto& drawOperation = drawOperations[i].drawOperation;
+
+        DrawGroup draw;
+        draw.drawIndexes.emplace_back(i);
+        draw.surfacePresenterManagers.emplace_back(drawOperation->getSurfacePresenterManager().get());
+        drawOperation->collectGraphicsContexts(draw.graphicsContexts);
+
+        std::optional<size_t> targetGroup;
+        size_t groupIndex = 0;
+        while (groupIndex < groups.size()) {
+            if (!groups[groupIndex].sharesResource(draw)) {
+                groupIndex++;
+                continue;
+            }
+
+            if (!targetGroup) {
+                targetGroup = {groupIndex};
+                groupIndex++;
+                continue;
+            }
+
+            // The draw connects two groups, merge them
+            groups[targetGroup.value()].merge(groups[groupIndex]);
+            groups.erase(groups.begin() + groupIndex);
+        }
+
+        if (!targetGroup) {
+            groups.emplace_back(std::move(draw));
+        } else {
+            groups[targetGroup.value()].merge(draw);
+        }
+    }
+
+    return groups;
+}
+
+void DrawLooper::drawOperationsConcurrently(const DrawOperationsBatch& drawOperations) {
+    auto groups = makeIndependentDrawGroups(drawOperations);
+
+    std::vector<size_t> threadIndexes;
+    threadIndexes.reserve(groups.size());
+    for (const auto& group : groups) {
+        // A group holds every draw using its GraphicsContexts, they are drawn and committed on a single thread
+        threadIndexes.emplace_back(_drawPool->getThreadIndexForGraphicsContexts(group.graphicsContexts));
+    }
+
+    _drawPool->run(threadIndexes, [&](size_t groupIndex) {
+        VALDI_TRACE("SnapDrawing.drawEntries");
+        GraphicsContextsBatch graphicsContexts;
+        for (auto drawIndex : groups[groupIndex].drawIndexes) {
+            drawPendingDraw(drawOperations[drawIndex], graphicsContexts);
+        }
+
+        // Committed on the thread assigned to the GraphicsContexts
+        for (auto* graphicsContext : graphicsContexts) {
+            graphicsContext->commit();
+        }
+    });
+}
+
+void DrawLooper::drawOperationsBatch(const DrawOperationsBatch& drawOperations) {
+    if (_drawPool != nullptr) {
+        drawOperationsConcurrently(drawOperations);
+        return;
+    }
+
+    GraphicsContextsBatch graphicsContexts;
+    for (const auto& pendingDraw : drawOperations) {
+        drawPendingDraw(pendingDraw, graphicsContexts);
     }
 
     for (auto* graphicsContext : graphicsContexts) {
@@ -299,11 +436,12 @@ void DrawLooper::drawOperationsBatch(const DrawOperationsBatch& drawOperations)
     }
 }
 
-void DrawLooper::drawFrames(TimePoint /*time*/) {
+void DrawLooper::drawFrames(TimePoint time) {
     auto drawLock = getDrawLock();
-    auto drawOperations = collectDrawOperations();
+    auto drawOperations = collectDrawOperations(time);
     drawOperationsBatch(drawOperations);
     performCleanup(DrawLooper::CleanUpMode::PostDraw);
+    emitFrameTimingsReports();
 
     auto entriesLock = getEntriesLock();
     _drawScheduled = false;
@@ -348,33 +486,56 @@ void DrawLooper::processFrames(TimePoint time) {
 }
 
 void DrawLooper::performCleanup(DrawLooper::CleanUpMode cleanUpMode) {
-    for (const auto& managedGraphicsContext : _managedGraphicsContexts) {
+    runOnGraphicsContextThreads(_managedGraphicsContexts, [cleanUpMode](GraphicsContext& graphicsContext) {
         switch (cleanUpMode) {
             case CleanUpMode::PostDraw:
-                managedGraphicsContext->performCleanup(false, kCacheExpirationSeconds);
+                graphicsContext.performCleanup(false, kCacheExpirationSeconds);
                 break;
             case CleanUpMode::EnteringBackground:
-                managedGraphicsContext->setResourceCacheLimit(kMaxGpuCacheSizeInBackground);
-                managedGraphicsContext->performCleanup(true, std::chrono::seconds(0));
-                managedGraphicsContext->setResourceCacheLimit(kMaxGpuCacheSize);
+                graphicsContext.setResourceCacheLimit(kMaxGpuCacheSizeInBackground);
+                graphicsContext.performCleanup(true, std::chrono::seconds(0));
+                graphicsContext.setResourceCacheLimit(kMaxGpuCacheSize);
                 break;
             case CleanUpMode::TrimMemory:
-                managedGraphicsContext->setResourceCacheLimit(0);
-                managedGraphicsContext->performCleanup(true, std::chrono::seconds(0));
-                managedGraphicsContext->setResourceCacheLimit(kMaxGpuCacheSize);
+                graphicsContext.setResourceCacheLimit(0);
+                graphicsContext.performCleanup(true, std::chrono::seconds(0));
+                graphicsContext.setResourceCacheLimit(kMaxGpuCacheSize);
                 break;
         }
+    });
+}
+
+void DrawLooper::runOnGraphicsContextThreads(const std::vector<Ref<GraphicsContext>>& graphicsContexts,
+                                             const Valdi::Function<void(GraphicsContext&)>& task) {
+    if (_drawPool == nullptr) {
+        for (const auto& graphicsContext : graphicsContexts) {
+            task(*graphicsContext);
+        }
+        return;
     }
+
+    std::vector<size_t> threadIndexes;
+    threadIndexes.reserve(graphicsContexts.size());
+    for (const auto& graphicsContext : graphicsContexts) {
+        threadIndexes.emplace_back(_drawPool->getThreadIndexForGraphicsContext(graphicsContext.get()));
+    }
+
+    _drawPool->run(threadIndexes, [&](size_t index) { task(*graphicsContexts[index]); });
 }
 
 bool DrawLooper::processFrameForNextLayer(TimePoint currentFrameTime) {
     auto entriesLock = getEntriesLock();
     for (const auto& it : _entries) {
-        if (it->needsProcessFrameAtTime(currentFrameTime)) {
+        // A LayerRoot throttled by the adaptive frame rate stays pending and gets processed on a later tick
+        if (it->needsProcessFrameAtTime(currentFrameTime) &&
+            !it->getFrameTimingTracker().shouldSkipProcessFrameAtTime(currentFrameTime)) {
+            auto entry = it;
             auto layerRoot = it->getLayerRoot();
             entriesLock.unlock();
 
+            entry->getFrameTimingTracker().onWillProcessFrame(currentFrameTime);
             layerRoot->processFrame(currentFrameTime);
+            entry->getFrameTimingTracker().onDidProcessFrame();
             return true;
         }
     }
@@ -431,4 +592,70 @@ DrawLock DrawLooper::getDrawLock() const {
     return DrawLock(_drawMutex);
 }
 
+void DrawLooper::setDrawPool(const Ref<DrawPool>& drawPool) {
+    auto drawLock = getDrawLock();
+    _drawPool = drawPool;
+}
+
+std::optional<Duration> DrawLooper::getLastDrawDurationOfLayerRoot(LayerRoot& layerRoot) const {
+    auto drawLock = getDrawLock();
+    auto entriesLock = getEntriesLock();
+    auto entry = getEntryForLayer(layerRoot);
+    if (entry == nullptr) {
+        return std::nullopt;
+    }
+    return {entry->getLastDrawDuration()};
+}
+
+std::vector<FrameTiming> DrawLooper::getFrameTimingsOfLayerRoot(LayerRoot& layerRoot) const {
+    auto entriesLock = getEntriesLock();
+    auto entry = getEntryForLayer(layerRoot);
+    if (entry == nullptr) {
+        return {};
+    }
+    return entry->getFrameTimingTracker().getFrameTimings();
+}
+
+void DrawLooper::setFrameTimingsListener(const Ref<IFrameTimingsListener>& frameTimingsListener) {
+    auto drawLock = getDrawLock();
+    _frameTimingsListener = frameTimingsListener;
+}
+
+void DrawLooper::setTargetFrameInterval(Duration targetFrameInterval) {
+    auto entriesLock = getEntriesLock();
+    _targetFrameInterval = targetFrameInterval;
+    for (const auto& entry : _entries) {
+        entry->getFrameTimingTracker().setFrameInterval(targetFrameInterval);
+    }
+}
+
+void DrawLooper::setAdaptiveFrameRateEnabled(bool adaptiveFrameRateEnabled) {
+    auto entriesLock = getEntriesLock();
+    _adaptiveFrameRateEnabled = adaptiveFrameRateEnabled;
+    for (const auto& entry : _entries) {
+        entry->getFrameTimingTracker().setAdaptiveFrameRateEnabled(adaptiveFrameRateEnabled);
+    }
+}
+
+void DrawLooper::emitFrameTimingsReports() {
+    if (_frameTimingsListener == nullptr) {
+        return;
+    }
+
+    std::vector<std::pair<Ref<LayerRoot>, FrameTimingsReport>> reports;
+    {
+        auto entriesLock = getEntriesLock();
+        for (const auto& entry : _entries) {
+            auto report = entry->getFrameTimingTracker().consumeReport();
+            if (report) {
+                reports.emplace_back(entry->getLayerRoot(), report.value());
+            }
+        }
+    }
+
+    for (const auto& it : reports) {
+        _frameTimingsListener->onFrameTimingsReport(*it.first, it.second);
+    }
+}
+
 } // namespace snap::drawing
@@ -8,22 +8,33 @@
 #pragma once
 
 #include "snap_drawing/cpp/Drawing/DrawLooperEntry.hpp"
+#include "snap_drawing/cpp/Drawing/FrameTimings.hpp"
 #include "snap_drawing/cpp/Drawing/IFrameScheduler.hpp"
 #include "snap_drawing/cpp/Layers/LayerRoot.hpp"
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
 #include "valdi_core/cpp/Interfaces/ILogger.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 
+#include <optional>
 #include <vector>
 
 namespace snap::drawing {
 
 using EntriesLock = std::unique_lock<std::recursive_mutex>;
 using DrawLock = std::unique_lock<std::recursive_mutex>;
-using DrawOperationsBatch = Valdi::SmallVector<Ref<DrawOperation>, 8>;
 
+struct PendingDraw {
+    Ref<DrawLooperEntry> entry;
+    Ref<DrawOperation> drawOperation;
+};
+
+using DrawOperationsBatch = Valdi::SmallVector<PendingDraw, 8>;
+using GraphicsContextsBatch = Valdi::SmallVector<GraphicsContext*, 2>;
+
+class DrawPool;
 class PerformCleanupCallback;
 class ConfigureCacheSizeCallback;
 
@@ -52,6 +63,17 @@ class ConfigureCacheSizeCallback;
  Most calls into the looper ends up acquiring the entries mutex. The draw mutex is locked at the
  beginning of vsync and released after draw. This ensures that mutations on the GraphicsContext
  of a LayerRoot can be done synchronously with the VSync thread.
+
+ When a DrawPool is set, the entries are drawn on the pool threads, and the ones that don't share a
+ GraphicsContext or a SurfacePresenterManager are drawn concurrently. A GraphicsContext is always drawn,
+ committed, cleaned up and resized on its assigned pool thread. The VSync thread waits until all the
+ entries have been drawn, all while holding the draw mutex.
+
+ Every entry records the process and draw durations of its frames, as well as the frames that were
+ replaced by a newer one before they could be drawn. Those are exposed through getFrameTimingsOfLayerRoot()
+ and periodically reported to the IFrameTimingsListener. When adaptive frame rate is enabled, a LayerRoot
+ whose processing or drawing keeps missing its frame deadline gets processed and drawn at a lower rate
+ until its frames become cheap again. The other LayerRoots keep their rate.
  */
 class DrawLooper : public Valdi::SimpleRefCountable, protected DrawLooperEntryListener {
 public:
@@ -149,6 +171,40 @@ public:
 
     DrawLock getDrawLock() const;
 
+    /**
+     Set the DrawPool used to draw independent LayerRoot entries concurrently.
+     The GraphicsContexts used by the SurfacePresenterManagers and the managed GraphicsContexts
+     should not be bound to the VSync thread. When null, all the entries are drawn in the VSync thread.
+     */
+    void setDrawPool(const Ref<DrawPool>& drawPool);
+
+    /**
+     Returns how long the last draw of the given LayerRoot took.
+     */
+    std::optional<Duration> getLastDrawDurationOfLayerRoot(LayerRoot& layerRoot) const;
+
+    /**
+     Returns the timings of the last frames of the given LayerRoot, from the oldest to the most recent.
+     */
+    std::vector<FrameTiming> getFrameTimingsOfLayerRoot(LayerRoot& layerRoot) const;
+
+    /**
+     Set the listener that will receive periodic frame timings reports for every LayerRoot.
+     */
+    void setFrameTimingsListener(const Ref<IFrameTimingsListener>& frameTimingsListener);
+
+    /**
+     Set the expected interval between two frames, used to detect frames that missed their deadline.
+     Defaults to 1/60 seconds.
+     */
+    void setTargetFrameInterval(Duration targetFrameInterval);
+
+    /**
+     Set whether the DrawLooper should lower the rate at which a LayerRoot is processed and drawn
+     when its frames keep missing their deadline.
+     */
+    void setAdaptiveFrameRateEnabled(bool adaptiveFrameRateEnabled);
+
 protected:
     void onNeedsProcessFrame(DrawLooperEntry& entry) override;
 
@@ -172,6 +228,9 @@ private:
     [[maybe_unused]] Valdi::ILogger& _logger;
     std::vector<Ref<DrawLooperEntry>> _entries;
     std::vector<Ref<GraphicsContext>> _managedGraphicsContexts;
+    Ref<DrawPool> _drawPool;
+    Ref<IFrameTimingsListener> _frameTimingsListener;
+    Duration _targetFrameInterval = Duration::fromSeconds(1.0 / 60.0);
     mutable std::recursive_mutex _mainThreadMutex;
     mutable std::recursive_mutex _drawMutex;
     SurfacePresenterId _surfacePresenterIdSequence = 0;
@@ -179,6 +238,7 @@ private:
     bool _processFrameScheduled = false;
     bool _drawScheduled = false;
     bool _inBackground = false;
+    bool _adaptiveFrameRateEnabled = false;
 
     Ref<DrawLooperEntry> getEntryForLayer(LayerRoot& layerRoot) const;
     Ref<DrawLooperEntry> mustGetEntryForLayer(LayerRoot& layerRoot) const;
@@ -195,10 +255,15 @@ private:
 
     bool processFrameForNextLayer(TimePoint currentFrameTime);
 
-    DrawOperationsBatch collectDrawOperations();
+    DrawOperationsBatch collectDrawOperations(TimePoint time);
     void drawOperationsBatch(const DrawOperationsBatch& drawOperations);
+    void drawOperationsConcurrently(const DrawOperationsBatch& drawOperations);
+    void drawPendingDraw(const PendingDraw& pendingDraw, GraphicsContextsBatch& graphicsContexts);
     bool needsDraw() const;
+    void emitFrameTimingsReports();
     void performCleanup(CleanUpMode cleanUpMode);
+    void runOnGraphicsContextThreads(const std::vector<Ref<GraphicsContext>>& graphicsContexts,
+                                     const Valdi::Function<void(GraphicsContext&)>& task);
 };
 
 } // namespace snap::drawing
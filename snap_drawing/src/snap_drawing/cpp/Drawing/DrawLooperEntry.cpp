@@ -5,6 +5,7 @@
 //  Created by Simon Corsin on 1/25/22.
 //
 
+#include "snap_drawing/cpp/Drawing/Composition/Compositor.hpp"
 #include "snap_drawing/cpp/Drawing/DrawLooperEntry.hpp"
 #include "snap_drawing/cpp/Drawing/DrawOperation.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
@@ -46,6 +47,10 @@ bool DrawLooperEntry::needsProcessFrameAtTime(TimePoint frameTime) const {
 
 void DrawLooperEntry::enqueueDisplayList(const Ref<DisplayList>& displayList) {
     _displayList = displayList;
+    if (displayList != nullptr) {
+        _frameTimingTracker.onFrameEnqueued(displayList->getFrameTime(),
+                                            _layerRoot->getLastCompositionMetrics().duration);
+    }
 }
 
 Ref<DrawOperation> DrawLooperEntry::makeDrawOperation(bool shouldSwapToNextFrame) {
@@ -53,6 +58,7 @@ Ref<DrawOperation> DrawLooperEntry::makeDrawOperation(bool shouldSwapToNextFrame
 
     if (shouldSwapToNextFrame) {
         if (_displayList != nullptr) {
+            _frameTimingTracker.onFrameDrawStarted();
             auto frameTime = _displayList->getFrameTime();
             for (auto& presenter : _surfacePresenters) {
                 if (presenter.needsDrawForFrameTime(frameTime)) {
@@ -71,6 +77,22 @@ Ref<DrawOperation> DrawLooperEntry::makeDrawOperation(bool shouldSwapToNextFrame
     return Valdi::makeShared<DrawOperation>(_displayList, _surfacePresenterManager, std::move(surfacePresenters));
 }
 
+void DrawLooperEntry::setLastDrawDuration(Duration lastDrawDuration) {
+    _lastDrawDuration = lastDrawDuration;
+}
+
+Duration DrawLooperEntry::getLastDrawDuration() const {
+    return _lastDrawDuration;
+}
+
+FrameTimingTracker& DrawLooperEntry::getFrameTimingTracker() {
+    return _frameTimingTracker;
+}
+
+const FrameTimingTracker& DrawLooperEntry::getFrameTimingTracker() const {
+    return _frameTimingTracker;
+}
+
 const Ref<LayerRoot>& DrawLooperEntry::getLayerRoot() const {
     return _layerRoot;
 }
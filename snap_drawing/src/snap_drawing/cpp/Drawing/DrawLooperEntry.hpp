@@ -8,6 +8,7 @@
 #pragma once
 
 #include "snap_drawing/cpp/Drawing/Composition/CompositorPlaneList.hpp"
+#include "snap_drawing/cpp/Drawing/FrameTimings.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurface.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterList.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterManager.hpp"
@@ -77,6 +78,18 @@ public:
 
     const SurfacePresenterList& getSurfacePresenters() const;
 
+    /**
+     Duration of the last draw of this entry's presenters, measured on the thread that drew it.
+     */
+    void setLastDrawDuration(Duration lastDrawDuration);
+    Duration getLastDrawDuration() const;
+
+    /**
+     Tracks the process and draw timings of the frames emitted by the LayerRoot.
+     */
+    FrameTimingTracker& getFrameTimingTracker();
+    const FrameTimingTracker& getFrameTimingTracker() const;
+
     void onNeedsProcessFrame(LayerRoot& root) override;
 
     void onDidDraw(LayerRoot& root, const Ref<DisplayList>& displayList, const CompositorPlaneList* planeList) override;
@@ -87,6 +100,8 @@ private:
     DrawLooperEntryListener* _listener;
     SurfacePresenterList _surfacePresenters;
     Ref<DisplayList> _displayList;
+    Duration _lastDrawDuration;
+    FrameTimingTracker _frameTimingTracker;
     bool _disallowSynchronousDraw = false;
 
     void updateSurfaceForPlane(const CompositorPlane& plane,
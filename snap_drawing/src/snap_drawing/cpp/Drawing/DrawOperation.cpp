@@ -9,6 +9,8 @@
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterManager.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include <algorithm>
+
 namespace snap::drawing {
 
 DrawOperation::DrawOperation(const Ref<DisplayList>& displayList,
@@ -75,6 +77,22 @@ bool DrawOperation::hasNext() {
     return _current != _surfacePresenters.end();
 }
 
+void DrawOperation::collectGraphicsContexts(Valdi::SmallVector<GraphicsContext*, 2>& output) const {
+    for (const auto* it = _current; it != _surfacePresenters.end(); it++) {
+        if (!it->isDrawable() || it->getDrawableSurface() == nullptr) {
+            continue;
+        }
+        auto* graphicsContext = it->getDrawableSurface()->getGraphicsContext();
+        if (graphicsContext != nullptr && std::find(output.begin(), output.end(), graphicsContext) == output.end()) {
+            output.emplace_back(graphicsContext);
+        }
+    }
+}
+
+const Ref<SurfacePresenterManager>& DrawOperation::getSurfacePresenterManager() const {
+    return _surfacePresenterManager;
+}
+
 void DrawOperation::advance() {
     while (_current != _surfacePresenters.end() && !_current->isDrawable()) {
         _current++;
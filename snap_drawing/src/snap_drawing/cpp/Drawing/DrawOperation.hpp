@@ -9,6 +9,7 @@
 
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterList.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
 
 namespace snap::drawing {
 
@@ -26,6 +27,13 @@ public:
     Valdi::Result<snap::drawing::GraphicsContext*> drawNext();
     bool hasNext();
 
+    /**
+     Append the GraphicsContexts that the remaining draws of this operation will use.
+     */
+    void collectGraphicsContexts(Valdi::SmallVector<GraphicsContext*, 2>& output) const;
+
+    const Ref<SurfacePresenterManager>& getSurfacePresenterManager() const;
+
 private:
     Ref<DisplayList> _displayList;
     Ref<SurfacePresenterManager> _surfacePresenterManager;
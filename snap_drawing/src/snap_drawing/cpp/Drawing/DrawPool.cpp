@@ -0,0 +1,119 @@
+//
+//  DrawPool.cpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "snap_drawing/cpp/Drawing/DrawPool.hpp"
+#include "snap_drawing/cpp/Drawing/GraphicsContext/GraphicsContext.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <optional>
+
+namespace snap::drawing {
+
+DrawPool::DrawPool(size_t threadsCount) {
+    _queues.reserve(threadsCount);
+    for (size_t i = 0; i < threadsCount; i++) {
+        _queues.emplace_back(
+            Valdi::DispatchQueue::create(STRING_FORMAT("SnapDrawing Draw Thread {}", i + 1), Valdi::ThreadQoSClassMax));
+    }
+}
+
+DrawPool::~DrawPool() {
+    for (const auto& queue : _queues) {
+        queue->fullTeardown();
+    }
+}
+
+size_t DrawPool::getThreadsCount() const {
+    return _queues.size();
+}
+
+DrawPool::GraphicsContextThread* DrawPool::findGraphicsContextThread(GraphicsContext* graphicsContext) {
+    auto it = _graphicsContextThreads.begin();
+    while (it != _graphicsContextThreads.end()) {
+        auto existingGraphicsContext = it->graphicsContext.lock();
+        if (existingGraphicsContext == nullptr) {
+            it = _graphicsContextThreads.erase(it);
+            continue;
+        }
+        if (existingGraphicsContext.get() == graphicsContext) {
+            return &(*it);
+        }
+        it++;
+    }
+
+    return nullptr;
+}
+
+size_t DrawPool::getThreadIndexForGraphicsContext(GraphicsContext* graphicsContext) {
+    auto* graphicsContextThread = findGraphicsContextThread(graphicsContext);
+    if (graphicsContextThread != nullptr) {
+        return graphicsContextThread->threadIndex;
+    }
+
+    auto threadIndex = getNextThreadIndex();
+    _graphicsContextThreads.emplace_back(GraphicsContextThread{Valdi::weakRef(graphicsContext), threadIndex});
+    return threadIndex;
+}
+
+size_t DrawPool::getThreadIndexForGraphicsContexts(const Valdi::SmallVector<GraphicsContext*, 2>& graphicsContexts) {
+    std::optional<size_t> threadIndex;
+    for (auto* graphicsContext : graphicsContexts) {
+        auto* graphicsContextThread = findGraphicsContextThread(graphicsContext);
+        if (graphicsContextThread != nullptr) {
+            threadIndex = {graphicsContextThread->threadIndex};
+            break;
+        }
+    }
+
+    if (!threadIndex) {
+        threadIndex = {getNextThreadIndex()};
+    }
+
+    for (auto* graphicsContext : graphicsContexts) {
+        auto* graphicsContextThread = findGraphicsContextThread(graphicsContext);
+        if (graphicsContextThread != nullptr) {
+            graphicsContextThread->threadIndex = threadIndex.value();
+        } else {
+            _graphicsContextThreads.emplace_back(
+                GraphicsContextThread{Valdi::weakRef(graphicsContext), threadIndex.value()});
+        }
+    }
+
+    return threadIndex.value();
+}
+
+size_t DrawPool::getNextThreadIndex() {
+    auto threadIndex = _nextThreadIndex;
+    _nextThreadIndex = (_nextThreadIndex + 1) % _queues.size();
+    return threadIndex;
+}
+
+void DrawPool::run(const std::vector<size_t>& threadIndexes, const Valdi::Function<void(size_t)>& task) {
+    size_t remainingTasks = threadIndexes.size();
+    if (remainingTasks == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < threadIndexes.size(); i++) {
+        // The queues are serial, tasks sharing a thread run in the order they were enqueued
+        _queues[threadIndexes[i]]->async([&, i]() {
+            task(i);
+
+            std::lock_guard<Valdi::Mutex> guard(_mutex);
+            remainingTasks--;
+            _condition.notifyAll();
+        });
+    }
+
+    std::unique_lock<Valdi::Mutex> lock(_mutex);
+    while (remainingTasks > 0) {
+        _condition.wait(lock);
+    }
+}
+
+} // namespace snap::drawing
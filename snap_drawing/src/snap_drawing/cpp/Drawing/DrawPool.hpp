@@ -0,0 +1,83 @@
+//
+//  DrawPool.hpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+
+#include <vector>
+
+namespace Valdi {
+class DispatchQueue;
+}
+
+namespace snap::drawing {
+
+class GraphicsContext;
+
+/**
+ A small pool of draw threads, used by the DrawLooper to draw independent LayerRoot entries
+ concurrently. Every GraphicsContext is assigned to one of the pool threads, on which all its
+ draws and commits happen, so that its resources are never used from more than one thread.
+ run() only returns once all the tasks have completed, which allows callers to keep holding
+ their locks while the tasks are running.
+ */
+class DrawPool : public Valdi::SimpleRefCountable {
+public:
+    explicit DrawPool(size_t threadsCount);
+    ~DrawPool() override;
+
+    size_t getThreadsCount() const;
+
+    /**
+     Returns the index of the pool thread to which the given GraphicsContext is assigned.
+     A GraphicsContext keeps the same thread for as long as it is alive. Contexts are
+     assigned to the threads in a round robin fashion.
+     */
+    size_t getThreadIndexForGraphicsContext(GraphicsContext* graphicsContext);
+
+    /**
+     Returns the index of the pool thread to which all the given GraphicsContexts are assigned,
+     for work which uses them together. The contexts that were not assigned yet join the thread
+     of the first assigned one. When they were assigned to different threads, they are all moved
+     to that thread. This is safe as run() only returns once the tasks have completed, so no
+     work for a context can be pending on its previous thread.
+     */
+    size_t getThreadIndexForGraphicsContexts(const Valdi::SmallVector<GraphicsContext*, 2>& graphicsContexts);
+
+    /**
+     Returns the index of the next pool thread in the round robin, for tasks which
+     don't use any GraphicsContext.
+     */
+    size_t getNextThreadIndex();
+
+    /**
+     Run the task for every index between 0 and threadIndexes.size(), on the pool thread at the
+     matching position in threadIndexes. Tasks assigned to the same thread run sequentially, in order.
+     Returns when all tasks have completed.
+     */
+    void run(const std::vector<size_t>& threadIndexes, const Valdi::Function<void(size_t)>& task);
+
+private:
+    struct GraphicsContextThread {
+        Valdi::Weak<GraphicsContext> graphicsContext;
+        size_t threadIndex;
+    };
+
+    GraphicsContextThread* findGraphicsContextThread(GraphicsContext* graphicsContext);
+
+    std::vector<Ref<Valdi::DispatchQueue>> _queues;
+    std::vector<GraphicsContextThread> _graphicsContextThreads;
+    size_t _nextThreadIndex = 0;
+    Valdi::Mutex _mutex;
+    Valdi::ConditionVariable _condition;
+};
+
+} // namespace snap::drawing
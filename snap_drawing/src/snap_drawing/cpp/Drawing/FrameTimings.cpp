@@ -0,0 +1,242 @@
+//
+//  FrameTimings.cpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "snap_drawing/cpp/Drawing/FrameTimings.hpp"
+
+#include <algorithm>
+
+namespace snap::drawing {
+
+/**
+ Number of consecutive frames that need to miss their budget before the frame rate is lowered.
+ */
+static constexpr size_t kFramesOverBudgetBeforeSlowdown = 3;
+/**
+ Number of consecutive frames that need to fit in the budget of the next faster rate
+ before the frame rate is raised again.
+ */
+static constexpr size_t kFramesUnderBudgetBeforeSpeedup = 30;
+static constexpr size_t kMaxFrameSkipFactor = 4;
+
+static Duration scaleDuration(Duration duration, double factor) {
+    return Duration::fromSeconds(duration.seconds() * factor);
+}
+
+void FrameTimingsReport::append(const FrameTiming& frameTiming) {
+    framesCount++;
+    totalProcessDuration += frameTiming.processDuration;
+    maxProcessDuration = std::max(maxProcessDuration, frameTiming.processDuration);
+    totalCompositionDuration += frameTiming.compositionDuration;
+    maxCompositionDuration = std::max(maxCompositionDuration, frameTiming.compositionDuration);
+
+    if (frameTiming.superseded) {
+        supersededFramesCount++;
+        return;
+    }
+
+    drawnFramesCount++;
+    totalDrawDuration += frameTiming.drawDuration;
+    maxDrawDuration = std::max(maxDrawDuration, frameTiming.drawDuration);
+    if (frameTiming.missedDeadline) {
+        missedDeadlinesCount++;
+    }
+}
+
+void FrameTimingHistory::append(const FrameTiming& frameTiming) {
+    _frameTimings[_next] = frameTiming;
+    _next = (_next + 1) % kCapacity;
+    _size = std::min(_size + 1, kCapacity);
+}
+
+size_t FrameTimingHistory::size() const {
+    return _size;
+}
+
+std::vector<FrameTiming> FrameTimingHistory::getFrameTimings() const {
+    std::vector<FrameTiming> output;
+    output.reserve(_size);
+
+    auto start = (_next + kCapacity - _size) % kCapacity;
+    for (size_t i = 0; i < _size; i++) {
+        output.emplace_back(_frameTimings[(start + i) % kCapacity]);
+    }
+
+    return output;
+}
+
+void FrameTimingTracker::setFrameInterval(Duration frameInterval) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _frameInterval = frameInterval;
+}
+
+void FrameTimingTracker::setAdaptiveFrameRateEnabled(bool adaptiveFrameRateEnabled) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _adaptiveFrameRateEnabled = adaptiveFrameRateEnabled;
+    if (!adaptiveFrameRateEnabled) {
+        _frameSkipFactor = 1;
+        _consecutiveFramesOverBudget = 0;
+        _consecutiveFramesUnderBudget = 0;
+    }
+}
+
+size_t FrameTimingTracker::getFrameSkipFactor() const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return _frameSkipFactor;
+}
+
+bool FrameTimingTracker::shouldSkipProcessFrameAtTime(TimePoint frameTime) const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return isThrottled(_lastProcessTime, frameTime);
+}
+
+bool FrameTimingTracker::shouldSkipDrawAtTime(TimePoint drawTime) const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return isThrottled(_lastDrawTime, drawTime);
+}
+
+bool FrameTimingTracker::isThrottled(std::optional<TimePoint> lastTime, TimePoint time) const {
+    if (_frameSkipFactor <= 1 || !lastTime) {
+        return false;
+    }
+
+    // Half an interval of tolerance, as the vsync times given by the scheduler are not perfectly spaced
+    auto minimumElapsed = scaleDuration(_frameInterval, static_cast<double>(_frameSkipFactor) - 0.5);
+    return (time - lastTime.value()) < minimumElapsed;
+}
+
+void FrameTimingTracker::onWillProcessFrame(TimePoint frameTime) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _lastProcessTime = {frameTime};
+    _processingFrame = true;
+    _processStopWatch.start();
+}
+
+void FrameTimingTracker::onDidProcessFrame() {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _processingFrame = false;
+}
+
+void FrameTimingTracker::onWillDrawAtTime(TimePoint drawTime) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _lastDrawTime = {drawTime};
+}
+
+void FrameTimingTracker::onDrawSkipped(TimePoint drawTime) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    if (_lastSkippedDrawTime && _lastSkippedDrawTime.value() == drawTime) {
+        return;
+    }
+    _lastSkippedDrawTime = {drawTime};
+    _report.droppedFramesCount++;
+}
+
+void FrameTimingTracker::onFrameEnqueued(TimePoint frameTime, Duration compositionDuration) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    if (_pendingFrame) {
+        auto supersededFrame = _pendingFrame.value();
+        supersededFrame.superseded = true;
+        finalizeFrame(supersededFrame);
+    }
+
+    FrameTiming frameTiming;
+    frameTiming.frameTime = frameTime;
+    frameTiming.compositionDuration = compositionDuration;
+    if (_processingFrame) {
+        frameTiming.processDuration = Duration::fromSeconds(_processStopWatch.elapsed().seconds());
+    }
+    _pendingFrame = {frameTiming};
+}
+
+void FrameTimingTracker::onFrameDrawStarted() {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    if (_pendingFrame) {
+        _drawingFrame = std::move(_pendingFrame);
+        _pendingFrame = std::nullopt;
+    }
+}
+
+void FrameTimingTracker::onFrameDrawn(Duration drawDuration) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    if (!_drawingFrame) {
+        // Redraw of a frame which was already accounted for
+        return;
+    }
+
+    auto frameTiming = _drawingFrame.value();
+    _drawingFrame = std::nullopt;
+
+    frameTiming.drawDuration = drawDuration;
+    // Processing and drawing are pipelined on separate threads, the frame misses its
+    // vsync when either of them cannot complete within the frame interval.
+    frameTiming.missedDeadline = std::max(frameTiming.processDuration, drawDuration) > _frameInterval;
+    finalizeFrame(frameTiming);
+}
+
+std::vector<FrameTiming> FrameTimingTracker::getFrameTimings() const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return _history.getFrameTimings();
+}
+
+std::optional<FrameTimingsReport> FrameTimingTracker::consumeReport() {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    if (_report.framesCount < kFramesPerReport) {
+        return std::nullopt;
+    }
+
+    auto report = _report;
+    report.frameSkipFactor = _frameSkipFactor;
+    _report = FrameTimingsReport();
+    return {report};
+}
+
+void FrameTimingTracker::finalizeFrame(const FrameTiming& frameTiming) {
+    _history.append(frameTiming);
+    _report.append(frameTiming);
+
+    if (_adaptiveFrameRateEnabled) {
+        updateFrameSkipFactor(frameTiming);
+    }
+}
+
+void FrameTimingTracker::updateFrameSkipFactor(const FrameTiming& frameTiming) {
+    if (frameTiming.superseded && _frameSkipFactor > 1) {
+        // Can still happen for frames emitted outside of a throttled process pass,
+        // the frame has no draw duration to account for
+        return;
+    }
+
+    // Processing and drawing are both throttled, either of them missing the budget
+    // of the current rate means the LayerRoot cannot keep up with it
+    auto budget = scaleDuration(_frameInterval, static_cast<double>(_frameSkipFactor));
+    auto frameDuration = std::max(frameTiming.processDuration, frameTiming.drawDuration);
+
+    // A superseded frame means the draw thread could not keep up with the processed frames
+    if (frameTiming.superseded || frameDuration > budget) {
+        _consecutiveFramesUnderBudget = 0;
+        _consecutiveFramesOverBudget++;
+
+        if (_consecutiveFramesOverBudget >= kFramesOverBudgetBeforeSlowdown && _frameSkipFactor < kMaxFrameSkipFactor) {
+            _frameSkipFactor = std::min(_frameSkipFactor * 2, kMaxFrameSkipFactor);
+            _consecutiveFramesOverBudget = 0;
+        }
+        return;
+    }
+
+    _consecutiveFramesOverBudget = 0;
+
+    if (_frameSkipFactor > 1 && frameDuration <= scaleDuration(budget, 0.5)) {
+        _consecutiveFramesUnderBudget++;
+        if (_consecutiveFramesUnderBudget >= kFramesUnderBudgetBeforeSpeedup) {
+            _frameSkipFactor /= 2;
+            _consecutiveFramesUnderBudget = 0;
+        }
+    } else {
+        _consecutiveFramesUnderBudget = 0;
+    }
+}
+
+} // namespace snap::drawing
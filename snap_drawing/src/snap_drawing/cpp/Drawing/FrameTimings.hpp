@@ -0,0 +1,145 @@
+//
+//  FrameTimings.hpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/TimePoint.hpp"
+#include "utils/time/StopWatch.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <array>
+#include <optional>
+#include <vector>
+
+namespace snap::drawing {
+
+class LayerRoot;
+
+struct FrameTiming {
+    TimePoint frameTime;
+    // Time spent in LayerRoot::processFrame() until the frame was emitted
+    Duration processDuration;
+    // Part of the process duration spent splitting the frame into planes around external surfaces
+    Duration compositionDuration;
+    // Time spent drawing the frame into the surfaces
+    Duration drawDuration;
+    // Whether the frame was replaced by a newer frame before it could be drawn
+    bool superseded = false;
+    // Whether processing and drawing the frame took longer than the frame interval
+    bool missedDeadline = false;
+};
+
+struct FrameTimingsReport {
+    size_t framesCount = 0;
+    size_t drawnFramesCount = 0;
+    size_t supersededFramesCount = 0;
+    // Number of vsyncs on which a pending frame was not drawn because the frame rate was lowered
+    size_t droppedFramesCount = 0;
+    size_t missedDeadlinesCount = 0;
+    Duration totalProcessDuration;
+    Duration maxProcessDuration;
+    Duration totalCompositionDuration;
+    Duration maxCompositionDuration;
+    Duration totalDrawDuration;
+    Duration maxDrawDuration;
+    size_t frameSkipFactor = 1;
+
+    void append(const FrameTiming& frameTiming);
+};
+
+/**
+ Fixed size ring buffer holding the timings of the last frames of a LayerRoot.
+ */
+class FrameTimingHistory {
+public:
+    static constexpr size_t kCapacity = 64;
+
+    void append(const FrameTiming& frameTiming);
+
+    size_t size() const;
+
+    /**
+     Returns the frame timings from the oldest to the most recent.
+     */
+    std::vector<FrameTiming> getFrameTimings() const;
+
+private:
+    std::array<FrameTiming, kCapacity> _frameTimings;
+    size_t _next = 0;
+    size_t _size = 0;
+};
+
+/**
+ Receives periodic frame timings reports from the DrawLooper.
+ Reports are emitted from the draw thread, implementations should return quickly.
+ */
+class IFrameTimingsListener : public Valdi::SimpleRefCountable {
+public:
+    virtual void onFrameTimingsReport(LayerRoot& layerRoot, const FrameTimingsReport& report) = 0;
+};
+
+/**
+ Tracks the frames of a LayerRoot from the moment they are processed until they are drawn
+ or replaced by a newer frame. When adaptive frame rate is enabled, the tracker lowers
+ the rate at which the LayerRoot gets processed and drawn when either its process or its draw
+ duration keeps taking longer than the budget, and restores it when frames fit again in a
+ faster rate. Both are throttled together, so that no frame gets processed only to be
+ superseded before it can be drawn.
+ */
+class FrameTimingTracker {
+public:
+    static constexpr size_t kFramesPerReport = 120;
+
+    void setFrameInterval(Duration frameInterval);
+    void setAdaptiveFrameRateEnabled(bool adaptiveFrameRateEnabled);
+
+    size_t getFrameSkipFactor() const;
+    bool shouldSkipProcessFrameAtTime(TimePoint frameTime) const;
+    bool shouldSkipDrawAtTime(TimePoint drawTime) const;
+
+    void onWillProcessFrame(TimePoint frameTime);
+    void onDidProcessFrame();
+
+    void onWillDrawAtTime(TimePoint drawTime);
+    void onDrawSkipped(TimePoint drawTime);
+
+    void onFrameEnqueued(TimePoint frameTime, Duration compositionDuration = Duration());
+    void onFrameDrawStarted();
+    void onFrameDrawn(Duration drawDuration);
+
+    std::vector<FrameTiming> getFrameTimings() const;
+
+    /**
+     Returns the report of the last frames if enough frames were tracked since the last report.
+     */
+    std::optional<FrameTimingsReport> consumeReport();
+
+private:
+    mutable Valdi::Mutex _mutex;
+    FrameTimingHistory _history;
+    FrameTimingsReport _report;
+    std::optional<FrameTiming> _pendingFrame;
+    std::optional<FrameTiming> _drawingFrame;
+    std::optional<TimePoint> _lastProcessTime;
+    std::optional<TimePoint> _lastDrawTime;
+    std::optional<TimePoint> _lastSkippedDrawTime;
+    snap::utils::time::StopWatch _processStopWatch;
+    Duration _frameInterval = Duration::fromSeconds(1.0 / 60.0);
+    size_t _frameSkipFactor = 1;
+    size_t _consecutiveFramesOverBudget = 0;
+    size_t _consecutiveFramesUnderBudget = 0;
+    bool _processingFrame = false;
+    bool _adaptiveFrameRateEnabled = false;
+
+    bool isThrottled(std::optional<TimePoint> lastTime, TimePoint time) const;
+    void finalizeFrame(const FrameTiming& frameTiming);
+    void updateFrameSkipFactor(const FrameTiming& frameTiming);
+};
+
+} // namespace snap::drawing
@@ -1,96 +1,208 @@
 #include "snap_drawing/cpp/Drawing/Raster/RasterDamageResolver.hpp"
-#include "snap_drawing/cpp/Drawing/Composition/CompositionState.hpp"
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
 #include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
-#include "valdi_core/cpp/Utils/SmallVector.hpp"
 
 namespace snap::drawing {
 
 struct ComputeDamageVisitor {
-    explicit ComputeDamageVisitor(RasterDamageResolver& rasterDamageResolver, Scalar scaleX, Scalar scaleY)
+    ComputeDamageVisitor(RasterDamageResolver& rasterDamageResolver, Scalar scaleX, Scalar scaleY, bool scaleChanged)
         : _rasterDamageResolver(rasterDamageResolver) {
         Matrix baseMatrix;
         baseMatrix.setScaleX(scaleX);
         baseMatrix.setScaleY(scaleY);
-        _contextStack.emplace_back(CompositionState(Path(), baseMatrix, 1.0), 0, false);
+        _rootCompositionState = CompositionState(Path(), baseMatrix, 1.0);
+        _contextStack.emplace_back(&_rootCompositionState, nullptr, scaleChanged, false);
     }
 
     void visit(const Operations::PushContext& pushContext) {
-        auto& topContext = getCurrentContext();
+        const auto& parentContext = getCurrentContext();
 
-        _contextStack.emplace_back(topContext.compositionState.pushContext(pushContext.opacity, pushContext.matrix),
-                                   pushContext.layerId,
-                                   pushContext.hasUpdates);
+        bool isNew = false;
+        auto& layerState = _rasterDamageResolver.getLayerStateForVisit(pushContext.layerId, isNew);
+
+        bool compositionChanged = false;
+        if (isNew || parentContext.compositionChanged || layerState.opacity != pushContext.opacity ||
+            layerState.matrix != pushContext.matrix) {
+            auto compositionState =
+                parentContext.compositionState->pushContext(pushContext.opacity, pushContext.matrix);
+
+            compositionChanged = isNew || !isSameCompositionState(compositionState, layerState.compositionState);
+
+            layerState.matrix = pushContext.matrix;
+            layerState.opacity = pushContext.opacity;
+            layerState.compositionState = std::move(compositionState);
+        }
+
+        auto& context = _contextStack.emplace_back(&layerState.compositionState,
+                                                   &layerState,
+                                                   compositionChanged,
+                                                   compositionChanged || pushContext.hasUpdates);
+        if (context.contentChanged) {
+            beginContentChange(context);
+        }
     }
 
     void visit(const Operations::PopContext& /*popContext*/) {
+        auto& context = getCurrentContext();
+        auto& layerState = *context.layerState;
+
+        if (context.clipIndex < layerState.clips.size()) {
+            // The layer no longer has as many clips as before
+            layerState.clips.resize(context.clipIndex);
+        }
+
+        if (context.contentChanged) {
+            _rasterDamageResolver.addDamageInRect(layerState.contentRect);
+            _rasterDamageResolver.addDamageInRect(context.volatileRect);
+        } else if (context.volatileRect != layerState.volatileRect) {
+            _rasterDamageResolver.addDamageInRect(layerState.volatileRect);
+            _rasterDamageResolver.addDamageInRect(context.volatileRect);
+        }
+
+        layerState.volatileRect = context.volatileRect;
+
         _contextStack.pop_back();
     }
 
     void visit(const Operations::ClipRect& clipRect) {
-        auto& currentContext = getCurrentContext();
-
-        currentContext.compositionState.clipRect(clipRect.width, clipRect.height);
+        applyClip(false, BorderRadius(), clipRect.width, clipRect.height);
     }
 
     void visit(const Operations::ClipRound& clipRound) {
-        auto& currentContext = getCurrentContext();
-
-        currentContext.compositionState.clipRound(clipRound.borderRadius, clipRound.width, clipRound.height);
+        applyClip(true, clipRound.borderRadius, clipRound.width, clipRound.height);
     }
 
     void visit(const Operations::DrawPicture& drawPicture) {
-        addDamageIfNeeded(fromSkValue<Rect>(drawPicture.picture->cullRect()));
+        auto& context = getCurrentContext();
+        if (context.contentChanged) {
+            context.layerState->contentRect.join(
+                context.compositionState->getAbsoluteClippedRect(fromSkValue<Rect>(drawPicture.picture->cullRect())));
+        }
     }
 
     void visit(const Operations::DrawExternalSurface& drawExternalSurface) {
         auto size = drawExternalSurface.externalSurfaceSnapshot->getExternalSurface()->getRelativeSize();
 
-        addDamageIfNeeded(Rect::makeXYWH(0, 0, size.width, size.height));
+        addVolatileRect(Rect::makeXYWH(0, 0, size.width, size.height));
     }
 
     void visit(const Operations::PrepareMask& prepareMask) {
-        addDamageIfNeeded(prepareMask.mask->getBounds());
+        addVolatileRect(prepareMask.mask->getBounds());
     }
 
     void visit(const Operations::ApplyMask& applyMask) {}
 
 private:
     struct Context {
-        CompositionState compositionState;
-        uint64_t layerId = 0;
-        bool hasUpdates = false;
-
-        Context(CompositionState&& compositionState, uint64_t layerId, bool hasUpdates)
-            : compositionState(std::move(compositionState)), layerId(layerId), hasUpdates(hasUpdates) {}
+        const CompositionState* compositionState;
+        RasterDamageResolver::LayerState* layerState;
+        // Whether the absolute composition state of this context changed since the last frame,
+        // in which case the composition state of all the children needs to be re-evaluated.
+        bool compositionChanged;
+        // Whether the rects drawn by this layer need to be re-evaluated
+        bool contentChanged;
+        size_t clipIndex = 0;
+        Rect volatileRect = Rect::makeEmpty();
+
+        Context(const CompositionState* compositionState,
+                RasterDamageResolver::LayerState* layerState,
+                bool compositionChanged,
+                bool contentChanged)
+            : compositionState(compositionState),
+              layerState(layerState),
+              compositionChanged(compositionChanged),
+              contentChanged(contentChanged) {}
     };
 
     RasterDamageResolver& _rasterDamageResolver;
-    Valdi::SmallVector<Context, 8> _contextStack;
+    CompositionState _rootCompositionState;
+    Valdi::SmallVector<Context, 16> _contextStack;
 
     Context& getCurrentContext() {
         return _contextStack[_contextStack.size() - 1];
     }
 
-    void addDamageIfNeeded(const Rect& bounds) {
-        const auto& context = getCurrentContext();
-        auto absoluteRect = context.compositionState.getAbsoluteClippedRect(bounds);
-        _rasterDamageResolver.addNonTransparentLayerInRect(context.layerId,
-                                                           absoluteRect,
-                                                           context.compositionState.getAbsoluteMatrix(),
-                                                           context.compositionState.getAbsoluteClipPath(),
-                                                           context.compositionState.getAbsoluteOpacity(),
-                                                           context.hasUpdates);
+    void beginContentChange(Context& context) {
+        // Damage the previously drawn area, the new area will be damaged when the context is popped
+        _rasterDamageResolver.addDamageInRect(context.layerState->contentRect);
+        _rasterDamageResolver.addDamageInRect(context.layerState->volatileRect);
+        context.layerState->contentRect = Rect::makeEmpty();
+    }
+
+    void applyClip(bool isRound, const BorderRadius& borderRadius, Scalar width, Scalar height) {
+        auto& context = getCurrentContext();
+        auto* layerState = context.layerState;
+        if (layerState == nullptr) {
+            return;
+        }
+
+        auto clipIndex = context.clipIndex++;
+        auto isNewClip = clipIndex == layerState->clips.size();
+        if (isNewClip) {
+            layerState->clips.emplace_back();
+        }
+
+        // Resolved after the insertion, which might have moved the previous clip states
+        const auto& baseCompositionState =
+            clipIndex == 0 ? layerState->compositionState : layerState->clips[clipIndex - 1].compositionState;
+        auto& clipState = layerState->clips[clipIndex];
+
+        if (!isNewClip && !context.compositionChanged && clipState.isRound == isRound && clipState.width == width &&
+            clipState.height == height && (!isRound || clipState.borderRadius == borderRadius)) {
+            context.compositionState = &clipState.compositionState;
+            return;
+        }
+
+        auto compositionState = baseCompositionState;
+        if (isRound) {
+            compositionState.clipRound(borderRadius, width, height);
+        } else {
+            compositionState.clipRect(width, height);
+        }
+
+        if (!context.compositionChanged &&
+            (isNewClip || !isSameCompositionState(compositionState, clipState.compositionState))) {
+            context.compositionChanged = true;
+            if (!context.contentChanged) {
+                // The pictures drawn before the clip are unchanged, so the previous content rect
+                // is kept and extended by the pictures drawn after it.
+                context.contentChanged = true;
+                _rasterDamageResolver.addDamageInRect(layerState->contentRect);
+            }
+        }
+
+        clipState.isRound = isRound;
+        clipState.borderRadius = borderRadius;
+        clipState.width = width;
+        clipState.height = height;
+        clipState.compositionState = std::move(compositionState);
+        context.compositionState = &clipState.compositionState;
+    }
+
+    void addVolatileRect(const Rect& bounds) {
+        auto& context = getCurrentContext();
+        context.volatileRect.join(context.compositionState->getAbsoluteClippedRect(bounds));
+    }
+
+    static bool isSameCompositionState(const CompositionState& left, const CompositionState& right) {
+        return left.getAbsoluteOpacity() == right.getAbsoluteOpacity() &&
+               left.getAbsoluteMatrix() == right.getAbsoluteMatrix() &&
+               left.getAbsoluteClipPath() == right.getAbsoluteClipPath();
     }
 };
 
 RasterDamageResolver::RasterDamageResolver() = default;
 RasterDamageResolver::~RasterDamageResolver() = default;
 
+RasterDamageResolver::RasterDamageResolver(RasterDamageResolver&& other) noexcept = default;
+RasterDamageResolver& RasterDamageResolver::operator=(RasterDamageResolver&& other) noexcept = default;
+
 void RasterDamageResolver::beginUpdates(Scalar surfaceWidth, Scalar surfaceHeight) {
     auto changed = _width != surfaceWidth || _height != surfaceHeight;
     _width = surfaceWidth;
     _height = surfaceHeight;
+    _frameId++;
+    _visitedLayerStatesCount = 0;
 
     if (changed) {
         addDamageInRect(Rect::makeXYWH(0, 0, surfaceWidth, surfaceHeight));
@@ -98,58 +210,84 @@ void RasterDamageResolver::beginUpdates(Scalar surfaceWidth, Scalar surfaceHeigh
 }
 
 std::vector<Rect> RasterDamageResolver::endUpdates() {
-    resolveDamage();
+    if (_visitedLayerStatesCount != _layerStatesCount) {
+        removeUnvisitedLayerStates();
+    }
 
-    std::swap(_previousLayerContents, _layerContents);
-    _layerContents.clear();
     auto damageRects = std::move(_damageRects);
     _damageRects = std::vector<Rect>();
 
     return damageRects;
 }
 
-void RasterDamageResolver::resolveDamage() {
-    // Iterate over all previous layer contents, and add damage if the layer was removed, or has updates of any kind.
-    for (const auto& [layerId, layerContent] : _previousLayerContents) {
-        const auto& it = _layerContents.find(layerId);
-        if (it == _layerContents.end()) {
-            // Layer no longer exists, add damage for the entire previous rect
-            addDamageInRect(layerContent.absoluteRect);
-            continue;
-        }
+RasterDamageResolver::LayerState& RasterDamageResolver::getLayerStateForVisit(uint64_t layerId, bool& isNew) {
+    auto& head = _layerStates[layerId];
+    auto* layerState = &head;
 
-        auto& newLayerContent = it->second;
+    while (*layerState != nullptr && (*layerState)->frameId == _frameId) {
+        layerState = &(*layerState)->nextOccurrence;
+    }
 
-        if (newLayerContent.hasUpdates || newLayerContent.absoluteMatrix != layerContent.absoluteMatrix ||
-            newLayerContent.clipPath != layerContent.clipPath ||
-            newLayerContent.absoluteRect != layerContent.absoluteRect ||
-            newLayerContent.absoluteOpacity != layerContent.absoluteOpacity) {
-            newLayerContent.hasUpdates = false;
+    isNew = *layerState == nullptr;
+    if (isNew) {
+        *layerState = std::make_unique<LayerState>();
+        _layerStatesCount++;
+    }
+
+    (*layerState)->frameId = _frameId;
+    _visitedLayerStatesCount++;
 
-            addDamageInRect(layerContent.absoluteRect);
-            addDamageInRect(newLayerContent.absoluteRect);
+    return **layerState;
+}
+
+void RasterDamageResolver::removeUnvisitedLayerStates() {
+    // Occurrences of a layer are visited in order, so the visited states are always
+    // at the beginning of the chain.
+    auto it = _layerStates.begin();
+    while (it != _layerStates.end()) {
+        auto* layerState = &it->second;
+        while (*layerState != nullptr && (*layerState)->frameId == _frameId) {
+            layerState = &(*layerState)->nextOccurrence;
         }
-    }
 
-    // Iterate over new layer contents, add damage for the new layer that were not processed in the previous loop.
-    for (auto& [layerId, layerContent] : _layerContents) {
-        if (layerContent.hasUpdates) {
-            layerContent.hasUpdates = false;
-            addDamageInRect(layerContent.absoluteRect);
+        auto removed = std::move(*layerState);
+        while (removed != nullptr) {
+            addDamageInRect(removed->contentRect);
+            addDamageInRect(removed->volatileRect);
+            _layerStatesCount--;
+            removed = std::move(removed->nextOccurrence);
+        }
+
+        if (it->second == nullptr) {
+            _layerStates.erase(it++);
+        } else {
+            it++;
         }
     }
 }
 
+size_t RasterDamageResolver::getLayerStatesCount() const {
+    return _layerStatesCount;
+}
+
 void RasterDamageResolver::addDamageFromDisplayListUpdates(const DisplayList& displayList) {
     auto scaleX = _width / displayList.getSize().width;
     auto scaleY = _height / displayList.getSize().height;
-    ComputeDamageVisitor computeDamageVisitor(*this, scaleX, scaleY);
+    auto scaleChanged = scaleX != _scaleX || scaleY != _scaleY;
+    _scaleX = scaleX;
+    _scaleY = scaleY;
+
+    ComputeDamageVisitor computeDamageVisitor(*this, scaleX, scaleY, scaleChanged);
     for (size_t i = 0; i < displayList.getPlanesCount(); i++) {
         displayList.visitOperations(i, computeDamageVisitor);
     }
 }
 
 void RasterDamageResolver::addDamageInRect(const Rect& rect) {
+    if (rect.isEmpty()) {
+        return;
+    }
+
     auto damageToAdd = rect;
 
     /**
@@ -172,18 +310,4 @@ void RasterDamageResolver::addDamageInRect(const Rect& rect) {
     _damageRects.emplace_back(damageToAdd);
 }
 
-void RasterDamageResolver::addNonTransparentLayerInRect(uint64_t layerId,
-                                                        const Rect& rect,
-                                                        const Matrix& absoluteMatrix,
-                                                        const Path& clipPath,
-                                                        Scalar absoluteOpacity,
-                                                        bool hasUpdates) {
-    auto& layerContent = _layerContents[layerId];
-    layerContent.absoluteRect = rect;
-    layerContent.absoluteMatrix = absoluteMatrix;
-    layerContent.clipPath = clipPath;
-    layerContent.absoluteOpacity = absoluteOpacity;
-    layerContent.hasUpdates = hasUpdates;
-}
-
-} // namespace snap::drawing
\ No newline at end of file
+} // namespace snap::drawing
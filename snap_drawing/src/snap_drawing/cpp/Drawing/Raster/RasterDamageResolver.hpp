@@ -1,10 +1,13 @@
 #pragma once
 
+#include "snap_drawing/cpp/Drawing/Composition/CompositionState.hpp"
+#include "snap_drawing/cpp/Utils/BorderRadius.hpp"
 #include "snap_drawing/cpp/Utils/Geometry.hpp"
 #include "snap_drawing/cpp/Utils/Matrix.hpp"
-#include "snap_drawing/cpp/Utils/Path.hpp"
 #include "snap_drawing/cpp/Utils/Scalar.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include <memory>
 #include <vector>
 
 namespace snap::drawing {
@@ -16,12 +19,21 @@ struct ComputeDamageVisitor;
 RasterDamageResolver helps with resolving dirty rects from a display list. It is used to
 implement delta rasterization, so that only the areas that have changed since the last
 drawn frame are rasterized.
+
+The resolver keeps the absolute composition state and drawn rect of each layer across frames,
+indexed by layer id. A layer only has its composition state and drawn rects re-evaluated when it
+has updates, when its own matrix, opacity or clip changed, or when the absolute composition state
+of its parent changed. Unchanged layers are skipped, so the cost of a frame is mostly proportional
+to the number of changed layers.
  */
 class RasterDamageResolver {
 public:
     RasterDamageResolver();
     ~RasterDamageResolver();
 
+    RasterDamageResolver(RasterDamageResolver&& other) noexcept;
+    RasterDamageResolver& operator=(RasterDamageResolver&& other) noexcept;
+
     void beginUpdates(Scalar surfaceWidth, Scalar surfaceHeight);
     std::vector<Rect> endUpdates();
 
@@ -29,30 +41,55 @@ public:
 
     void addDamageInRect(const Rect& rect);
 
+    /**
+     Returns the number of layers for which the resolver currently holds a state.
+     */
+    size_t getLayerStatesCount() const;
+
 private:
     friend ComputeDamageVisitor;
-    struct LayerContent {
-        Rect absoluteRect;
-        Matrix absoluteMatrix;
-        Scalar absoluteOpacity;
-        Path clipPath;
-        bool hasUpdates;
+
+    struct ClipState {
+        BorderRadius borderRadius;
+        Scalar width = 0;
+        Scalar height = 0;
+        bool isRound = false;
+        CompositionState compositionState;
+    };
+
+    struct LayerState {
+        // Last frame in which this state was visited
+        uint64_t frameId = 0;
+        // Matrix and opacity of the context as pushed, relative to the parent
+        Matrix matrix;
+        Scalar opacity = 1.0;
+        // Absolute composition state of the context before any clip is applied
+        CompositionState compositionState;
+        // Absolute composition state after each clip operation of the context
+        Valdi::SmallVector<ClipState, 1> clips;
+        // Absolute union of the pictures drawn by the layer
+        Rect contentRect = Rect::makeEmpty();
+        // Absolute union of the masks and external surfaces drawn by the layer, which are always
+        // re-evaluated as they can change without the layer having updates.
+        Rect volatileRect = Rect::makeEmpty();
+        // The same layer id is pushed once per plane the layer ends up in,
+        // each occurrence has its own state.
+        std::unique_ptr<LayerState> nextOccurrence;
     };
 
     Scalar _width = 0;
     Scalar _height = 0;
+    Scalar _scaleX = 0;
+    Scalar _scaleY = 0;
+    uint64_t _frameId = 0;
+    size_t _layerStatesCount = 0;
+    size_t _visitedLayerStatesCount = 0;
     std::vector<Rect> _damageRects;
-    Valdi::FlatMap<uint64_t, LayerContent> _previousLayerContents;
-    Valdi::FlatMap<uint64_t, LayerContent> _layerContents;
+    Valdi::FlatMap<uint64_t, std::unique_ptr<LayerState>> _layerStates;
 
-    void resolveDamage();
+    LayerState& getLayerStateForVisit(uint64_t layerId, bool& isNew);
 
-    void addNonTransparentLayerInRect(uint64_t layerId,
-                                      const Rect& rect,
-                                      const Matrix& absoluteMatrix,
-                                      const Path& clipPath,
-                                      Scalar absoluteOpacity,
-                                      bool hasUpdates);
+    void removeUnvisitedLayerStates();
 };
 
-} // namespace snap::drawing
\ No newline at end of file
+} // namespace snap::drawing
@@ -0,0 +1,101 @@
+//
+//  ChildrenHitTestIndex.cpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "snap_drawing/cpp/Layers/ChildrenHitTestIndex.hpp"
+#include "snap_drawing/cpp/Layers/Layer.hpp"
+
+#include <algorithm>
+
+namespace snap::drawing {
+
+/**
+ Outset applied to the hit test frames and to the queried point, so that points sitting
+ exactly on an edge are still considered, and that rounding differences between the
+ point and rect conversions cannot exclude a child that Layer::hitTest() would accept.
+ */
+static constexpr Scalar kHitTestFrameTolerance = 0.5f;
+
+ChildrenHitTestIndex::ChildrenHitTestIndex() = default;
+ChildrenHitTestIndex::~ChildrenHitTestIndex() = default;
+
+void ChildrenHitTestIndex::setNeedsUpdate() {
+    _needsUpdate = true;
+}
+
+void ChildrenHitTestIndex::getCandidates(const std::vector<Ref<Layer>>& children,
+                                         const Point& point,
+                                         std::vector<size_t>& output) {
+    auto start = output.size();
+
+    if (children.size() < kMinChildrenCount) {
+        // Not worth maintaining an index, all children are candidates
+        auto i = children.size();
+        while (i > 0) {
+            i--;
+            output.emplace_back(i);
+        }
+
+        _boxes = nullptr;
+        _needsUpdate = true;
+        return;
+    }
+
+    if (_needsUpdate) {
+        _needsUpdate = false;
+        update(children);
+    }
+
+    _searchOutput.clear();
+    _boxes->search(Rect::makeLTRB(point.x - kHitTestFrameTolerance,
+                                  point.y - kHitTestFrameTolerance,
+                                  point.x + kHitTestFrameTolerance,
+                                  point.y + kHitTestFrameTolerance),
+                   _searchOutput);
+
+    for (auto boxIndex : _searchOutput) {
+        output.emplace_back(_boxChildIndexes[static_cast<size_t>(boxIndex)]);
+    }
+    output.insert(output.end(), _unboundedChildIndexes.begin(), _unboundedChildIndexes.end());
+
+    std::sort(output.begin() + start, output.end(), std::greater<>());
+}
+
+void ChildrenHitTestIndex::update(const std::vector<Ref<Layer>>& children) {
+    if (_boxes == nullptr) {
+        _boxes = Valdi::makeShared<BoundingBoxHierarchy>();
+    } else {
+        _boxes->clear();
+    }
+    _boxChildIndexes.clear();
+    _unboundedChildIndexes.clear();
+
+    for (size_t i = 0; i < children.size(); i++) {
+        const auto& child = children[i];
+        if (!child->isHitTestBoundedToFrame()) {
+            _unboundedChildIndexes.emplace_back(i);
+            continue;
+        }
+
+        auto frame = child->getHitTestFrame();
+        if (frame.left > frame.right) {
+            std::swap(frame.left, frame.right);
+        }
+        if (frame.top > frame.bottom) {
+            std::swap(frame.top, frame.bottom);
+        }
+        if (!(frame.left <= frame.right && frame.top <= frame.bottom)) {
+            // NaN coordinates, let the child decide
+            _unboundedChildIndexes.emplace_back(i);
+            continue;
+        }
+
+        _boxes->insert(frame.withInsets(-kHitTestFrameTolerance, -kHitTestFrameTolerance));
+        _boxChildIndexes.emplace_back(i);
+    }
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,56 @@
+//
+//  ChildrenHitTestIndex.hpp
+//  snap_drawing
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/BoundingBoxHierarchy.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+
+#include <vector>
+
+namespace snap::drawing {
+
+class Layer;
+
+/**
+ A spatial index over the hit test frames of the children of a Layer, which
+ narrows down the children that need to be hit tested for a given point.
+ The index is only built for layers with many children, it is invalidated when the
+ children list changes or when the hit test frame of one of the children changes, and
+ rebuilt lazily on the next query. As scroll offsets are applied on the parent of the
+ scrolled children, scrolling does not invalidate the index.
+ */
+class ChildrenHitTestIndex {
+public:
+    ChildrenHitTestIndex();
+    ~ChildrenHitTestIndex();
+
+    void setNeedsUpdate();
+
+    /**
+     Append into the given output the indexes of the children which might be hit by the
+     given point, expressed in the coordinates of the parent. The indexes are appended
+     from the last child to the first one, which is the order in which they should be hit tested.
+     */
+    void getCandidates(const std::vector<Ref<Layer>>& children, const Point& point, std::vector<size_t>& output);
+
+    static constexpr size_t kMinChildrenCount = 16;
+
+private:
+    Ref<BoundingBoxHierarchy> _boxes;
+    // Maps the boxes of the hierarchy to their child index
+    std::vector<size_t> _boxChildIndexes;
+    // Children which might be hit outside of their hit test frame
+    std::vector<size_t> _unboundedChildIndexes;
+    std::vector<int> _searchOutput;
+    bool _needsUpdate = true;
+
+    void update(const std::vector<Ref<Layer>>& children);
+};
+
+} // namespace snap::drawing
@@ -212,6 +212,7 @@ void Layer::insertChild(const Valdi::Ref<Layer>& childLayer, size_t index) {
 
     childLayer->onParentChanged(Valdi::strongSmallRef(this));
 
+    _childrenHitTestIndex.setNeedsUpdate();
     setChildNeedsDisplay();
 
     onChildInserted(childLayer.get(), index);
@@ -242,6 +243,7 @@ void Layer::removeChild(Layer* childLayer, bool shouldNotify) {
     }
 
     if (erased) {
+        _childrenHitTestIndex.setNeedsUpdate();
         if (shouldNotify) {
             onChildRemoved(childLayer);
         }
@@ -304,12 +306,11 @@ Ref<Layer> Layer::getLayerAtPoint(const Point& point) {
     }
 
     // Dispatch touches to children, starting from the last child.
-    auto children = _children.readAccess();
-    auto i = children->size();
-    while (i > 0) {
-        i--;
+    std::vector<size_t> candidates;
+    getHitTestCandidateChildren(point, candidates);
 
-        const auto& child = (*children)[i];
+    for (auto i : candidates) {
+        auto child = getChild(i);
         auto childPoint = child->convertPointFromParent(point);
 
         auto hitChild = child->getLayerAtPoint(childPoint);
@@ -321,6 +322,24 @@ Ref<Layer> Layer::getLayerAtPoint(const Point& point) {
     return Valdi::strongSmallRef(this);
 }
 
+bool Layer::isHitTestBoundedToFrame() const {
+    // A zero scale collapses every point of the parent onto the origin of this layer
+    return _scaleX != 0 && _scaleY != 0;
+}
+
+Rect Layer::getHitTestFrame() {
+    _hitTestFrameDirty = false;
+    return convertRectToParent(Rect::makeLTRB(-_touchAreaExtensionLeft,
+                                              -_touchAreaExtensionTop,
+                                              _frame.width() + _touchAreaExtensionRight,
+                                              _frame.height() + _touchAreaExtensionBottom));
+}
+
+void Layer::getHitTestCandidateChildren(const Point& point, std::vector<size_t>& output) {
+    auto children = _children.readAccess();
+    _childrenHitTestIndex.getCandidates(*children, point, output);
+}
+
 void Layer::updateMatrix(Scalar width, Scalar height) {
     _matrix.setIdentity();
 
@@ -359,6 +378,7 @@ void Layer::setTouchAreaExtension(Scalar left, Scalar right, Scalar top, Scalar
     _touchAreaExtensionRight = right;
     _touchAreaExtensionTop = top;
     _touchAreaExtensionBottom = bottom;
+    setHitTestFrameDirty();
 }
 
 void Layer::setBackgroundColor(Color backgroundColor) {
@@ -851,6 +871,20 @@ Point Layer::convertPointToParent(const Point& point) {
 void Layer::setVisualFrameDirty() {
     _visualFrameDirty = true;
     _matrixDirty = true;
+    setHitTestFrameDirty();
+}
+
+void Layer::setHitTestFrameDirty() {
+    // The parent only needs to be notified once until it reads our hit test frame again
+    if (_hitTestFrameDirty) {
+        return;
+    }
+    _hitTestFrameDirty = true;
+
+    auto parent = Valdi::castOrNull<Layer>(_parent.lock());
+    if (parent != nullptr) {
+        parent->_childrenHitTestIndex.setNeedsUpdate();
+    }
 }
 
 Rect Layer::getAbsoluteVisualFrame() {
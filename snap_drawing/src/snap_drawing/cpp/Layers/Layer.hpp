@@ -13,6 +13,7 @@
 
 #include "snap_drawing/cpp/Resources.hpp"
 
+#include "snap_drawing/cpp/Layers/ChildrenHitTestIndex.hpp"
 #include "snap_drawing/cpp/Layers/Interfaces/ILayer.hpp"
 
 #include "snap_drawing/cpp/Touches/GestureRecognizer.hpp"
@@ -144,6 +145,24 @@ public:
     virtual bool hitTest(const Point& point) const;
     Ref<Layer> getLayerAtPoint(const Point& point);
 
+    /**
+     Returns whether hitTest() can only succeed for points within the hit test frame
+     of this layer. Layers which return false are always hit tested by their parent.
+     */
+    virtual bool isHitTestBoundedToFrame() const;
+
+    /**
+     Returns the frame in the parent's coordinates in which hitTest() can succeed,
+     which is the visual frame extended by the touch area extension.
+     */
+    Rect getHitTestFrame();
+
+    /**
+     Append into the given output the indexes of the children which might be hit by the given point,
+     expressed in this layer's coordinates, starting from the last child.
+     */
+    void getHitTestCandidateChildren(const Point& point, std::vector<size_t>& output);
+
     void layoutIfNeeded();
 
     bool needsDisplay() const;
@@ -246,6 +265,7 @@ private:
     SafeContainer<std::vector<Valdi::Ref<GestureRecognizer>>> _gestureRecognizers;
     SafeContainer<Valdi::FlatMap<String, Ref<IAnimation>>> _animations;
     Valdi::Weak<ILayer> _parent;
+    ChildrenHitTestIndex _childrenHitTestIndex;
     ILayerRoot* _root = nullptr;
     Ref<RefCountable> _attachedData;
     LayerId _layerId = kLayerIdNone;
@@ -282,6 +302,7 @@ private:
     bool _isDrawing = false;
     bool _visualFrameDirty = true;
     bool _matrixDirty = true;
+    bool _hitTestFrameDirty = true;
     bool _isRightToLeft = false;
     std::optional<EventId> _enqueuedFrame;
     Valdi::StringBox _accessibilityId;
@@ -298,6 +319,7 @@ private:
     void drawForeground(Scalar width, Scalar height);
 
     void setVisualFrameDirty();
+    void setHitTestFrameDirty();
 
     void notifyParentSetChildNeedsDisplay();
 
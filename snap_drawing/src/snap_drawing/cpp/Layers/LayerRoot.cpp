@@ -13,6 +13,7 @@
 
 #include "snap_drawing/cpp/Drawing/Composition/Compositor.hpp"
 #include "snap_drawing/cpp/Drawing/Composition/CompositorPlaneList.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayListCapture.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurfaceCanvas.hpp"
 
 #include "snap_drawing/cpp/Touches/DragGestureRecognizer.hpp"
@@ -44,6 +45,10 @@ LayerRootListener* LayerRoot::getListener() const {
     return _listener;
 }
 
+void LayerRoot::setDisplayListCaptureWriter(const Ref<DisplayListCaptureWriter>& displayListCaptureWriter) {
+    _displayListCaptureWriter = displayListCaptureWriter;
+}
+
 void LayerRoot::setContentLayer(const Valdi::Ref<Layer>& contentLayer, ContentLayerSizingMode sizingMode) {
     if (_contentLayer != contentLayer || _sizingMode != sizingMode) {
         _touchDispatcher.cancelAllGestures();
@@ -114,10 +119,11 @@ Ref<DisplayList> LayerRoot::draw() {
     auto elapsed = sw.elapsed();
     if (elapsed.milliseconds() >= kFrameWarningThresholdMs) {
         VALDI_WARN(_resources->getLogger(),
-                   "Spent {} to render frame (draw cache hit {}, draw cache miss {})",
+                   "Spent {} to render frame (draw cache hit {}, draw cache miss {}, composition {}ms)",
                    elapsed.toString(),
                    metrics.visitedLayers - metrics.drawCacheMiss,
-                   metrics.drawCacheMiss);
+                   metrics.drawCacheMiss,
+                   getLastCompositionMetrics().duration.milliseconds());
     }
 
     return displayList;
@@ -137,8 +143,19 @@ Ref<DisplayList> LayerRoot::doDraw(DrawMetrics& metrics) {
         _planeList->clear();
     }
 
-    Compositor compositor(_resources->getLogger());
-    return compositor.performComposition(*displayList, *_planeList);
+    if (_compositor == nullptr) {
+        _compositor = std::make_unique<Compositor>(_resources->getLogger());
+    }
+
+    return _compositor->performComposition(*displayList, *_planeList);
+}
+
+const CompositionMetrics& LayerRoot::getLastCompositionMetrics() const {
+    static const CompositionMetrics kEmptyMetrics;
+    if (_compositor == nullptr) {
+        return kEmptyMetrics;
+    }
+    return _compositor->getLastCompositionMetrics();
 }
 
 void LayerRoot::setChildNeedsDisplay() {
@@ -321,6 +338,10 @@ void LayerRoot::processFrame(TimePoint absoluteFrameTime) {
     _didEnqueueFrame = false;
     _processingFrame = false;
 
+    if (displayList != nullptr && _displayListCaptureWriter != nullptr) {
+        _displayListCaptureWriter->append(*displayList);
+    }
+
     if (displayList != nullptr && _listener != nullptr) {
         _listener->onDidDraw(*this, displayList, _planeList.get());
     }
@@ -26,7 +26,10 @@ namespace snap::drawing {
 
 class LayerRoot;
 class DrawableSurfaceCanvas;
+class Compositor;
 class CompositorPlaneList;
+class DisplayListCaptureWriter;
+struct CompositionMetrics;
 
 class LayerRootListener {
 public:
@@ -81,6 +84,12 @@ public:
     void setListener(LayerRootListener* listener);
     LayerRootListener* getListener() const;
 
+    /**
+     Set a writer into which every DisplayList emitted by this LayerRoot will be captured,
+     so that the frames can later be replayed offline. Pass null to stop capturing.
+     */
+    void setDisplayListCaptureWriter(const Ref<DisplayListCaptureWriter>& displayListCaptureWriter);
+
     void setChildNeedsDisplay() override;
     bool needsDisplay() const;
 
@@ -103,6 +112,11 @@ public:
     const std::optional<TimePoint>& getLastAbsoluteFrameTime() const;
     const Ref<DisplayList>& getLastDrawnFrame() const;
 
+    /**
+     Returns how long the composition of the last drawn frame took.
+     */
+    const CompositionMetrics& getLastCompositionMetrics() const;
+
     Ref<DisplayList> draw();
 
     void drawInCanvas(DrawableSurfaceCanvas& canvas);
@@ -137,7 +151,9 @@ private:
     std::optional<TimePoint> _initialAbsoluteFrameTime;
     std::optional<TimePoint> _lastAbsoluteFrameTime;
     std::unique_ptr<CompositorPlaneList> _planeList;
+    std::unique_ptr<Compositor> _compositor;
     Ref<DisplayList> _lastDrawnFrame;
+    Ref<DisplayListCaptureWriter> _displayListCaptureWriter;
 
     bool needsLayout() const;
 
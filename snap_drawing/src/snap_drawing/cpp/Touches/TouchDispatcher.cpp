@@ -108,10 +108,11 @@ bool TouchDispatcher::captureCandidates(const TouchEvent& event,
     }
 
     // Dispatch touches to children, starting from the last child.
-    auto i = layer->getChildrenSize();
-    while (i > 0) {
-        i--;
+    // The layer narrows down the children to the ones whose hit test frame contains the location.
+    std::vector<size_t> childIndexes;
+    layer->getHitTestCandidateChildren(event.getLocation(), childIndexes);
 
+    for (auto i : childIndexes) {
         auto child = layer->getChild(i);
 
         auto childPoint = child->convertPointFromParent(event.getLocation());
@@ -19,11 +19,7 @@ void BoundingBoxHierarchy::insert(const Rect& box) {
 }
 
 bool BoundingBoxHierarchy::contains(const Rect& box) {
-    if (_rTree == nullptr) {
-        SkRTreeFactory factory;
-        _rTree = factory();
-        _rTree->insert(_frames.data(), static_cast<int>(_frames.size()));
-    }
+    buildIfNeeded();
 
     _rTree->search(box.getSkValue(), &_rTreeOutput);
     if (_rTreeOutput.empty()) {
@@ -34,4 +30,27 @@ bool BoundingBoxHierarchy::contains(const Rect& box) {
     }
 }
 
+void BoundingBoxHierarchy::search(const Rect& box, std::vector<int>& output) {
+    buildIfNeeded();
+
+    _rTree->search(box.getSkValue(), &output);
+}
+
+void BoundingBoxHierarchy::clear() {
+    _frames.clear();
+    _rTree = nullptr;
+}
+
+size_t BoundingBoxHierarchy::size() const {
+    return _frames.size();
+}
+
+void BoundingBoxHierarchy::buildIfNeeded() {
+    if (_rTree == nullptr) {
+        SkRTreeFactory factory;
+        _rTree = factory();
+        _rTree->insert(_frames.data(), static_cast<int>(_frames.size()));
+    }
+}
+
 } // namespace snap::drawing
@@ -26,7 +26,18 @@ public:
     void insert(const Rect& box);
     bool contains(const Rect& box);
 
+    /**
+     Append into the given output the indexes, in insertion order, of the inserted boxes
+     which intersect with the given box. The output is not sorted.
+     */
+    void search(const Rect& box, std::vector<int>& output);
+
+    void clear();
+    size_t size() const;
+
 private:
+    void buildIfNeeded();
+
     std::vector<SkRect> _frames;
     std::vector<int> _rTreeOutput;
     sk_sp<SkBBoxHierarchy> _rTree;
@@ -605,4 +605,104 @@ TEST(Compositor, optimizesOutUnusedCommands) {
     ASSERT_EQ(*expectedBuilder.displayList, *outputDisplayList);
 }
 
+static void buildFrameWithExternalSurface(DisplayListBuilder& builder,
+                                          const Ref<ExternalSurface>& externalSurface,
+                                          Vector externalSurfacePosition,
+                                          Vector overlayPosition) {
+    builder.context(Vector(0, 0), 1.0, [&]() {
+        builder.rectangle(Size(25, 25), 1.0);
+        builder.context(externalSurfacePosition, 1.0, [&]() { builder.externalSurface(externalSurface, 1.0); });
+        builder.context(overlayPosition, 1.0, [&]() { builder.rectangle(Size(10, 10), 1.0); });
+    });
+}
+
+TEST(Compositor, reusesPlanesWhenExternalSurfacesAreUnchanged) {
+    auto externalSurface = Valdi::makeShared<ExternalSurface>();
+    externalSurface->setRelativeSize(Size(10, 10));
+    Compositor compositor(ConsoleLogger::getLogger());
+
+    DisplayListBuilder builder(100, 100);
+    buildFrameWithExternalSurface(builder, externalSurface, Vector(15, 15), Vector(20, 20));
+    CompositorPlaneList planeList;
+    compositor.performComposition(*builder.displayList, planeList);
+
+    ASSERT_FALSE(compositor.getLastCompositionMetrics().reusedPlanes);
+    ASSERT_EQ(static_cast<size_t>(3), planeList.getPlanesCount());
+
+    // The overlay moves but still only intersects with the same planes
+    DisplayListBuilder nextBuilder(100, 100);
+    buildFrameWithExternalSurface(nextBuilder, externalSurface, Vector(15, 15), Vector(18, 18));
+    CompositorPlaneList nextPlaneList;
+    auto outputDisplayList = compositor.performComposition(*nextBuilder.displayList, nextPlaneList);
+
+    ASSERT_TRUE(compositor.getLastCompositionMetrics().reusedPlanes);
+    ASSERT_EQ(static_cast<size_t>(3), nextPlaneList.getPlanesCount());
+    ASSERT_EQ(CompositorPlaneTypeDrawable, nextPlaneList.getPlaneAtIndex(0).getType());
+    ASSERT_EQ(CompositorPlaneTypeExternal, nextPlaneList.getPlaneAtIndex(1).getType());
+    ASSERT_EQ(CompositorPlaneTypeDrawable, nextPlaneList.getPlaneAtIndex(2).getType());
+    ASSERT_EQ(externalSurface.get(), nextPlaneList.getPlaneAtIndex(1).getExternalSurface());
+
+    // Output should be the same as with a full composition
+    Ref<DisplayList> expectedDisplayList;
+    performComposition(nextBuilder, &expectedDisplayList);
+    ASSERT_EQ(*expectedDisplayList, *outputDisplayList);
+}
+
+TEST(Compositor, resolvesPlanesAgainWhenExternalSurfaceMoves) {
+    auto externalSurface = Valdi::makeShared<ExternalSurface>();
+    externalSurface->setRelativeSize(Size(10, 10));
+    Compositor compositor(ConsoleLogger::getLogger());
+
+    DisplayListBuilder builder(100, 100);
+    buildFrameWithExternalSurface(builder, externalSurface, Vector(15, 15), Vector(20, 20));
+    CompositorPlaneList planeList;
+    compositor.performComposition(*builder.displayList, planeList);
+
+    ASSERT_EQ(static_cast<size_t>(3), planeList.getPlanesCount());
+
+    // The external surface no longer intersects with anything
+    DisplayListBuilder nextBuilder(100, 100);
+    buildFrameWithExternalSurface(nextBuilder, externalSurface, Vector(50, 50), Vector(20, 20));
+    CompositorPlaneList nextPlaneList;
+    compositor.performComposition(*nextBuilder.displayList, nextPlaneList);
+
+    ASSERT_FALSE(compositor.getLastCompositionMetrics().reusedPlanes);
+    ASSERT_EQ(static_cast<size_t>(2), nextPlaneList.getPlanesCount());
+    ASSERT_EQ(CompositorPlaneTypeExternal, nextPlaneList.getPlaneAtIndex(0).getType());
+    ASSERT_EQ(CompositorPlaneTypeDrawable, nextPlaneList.getPlaneAtIndex(1).getType());
+}
+
+TEST(Compositor, resolvesPlanesAgainWhenDrawOperationCrossesPlaneBoundary) {
+    auto externalSurface = Valdi::makeShared<ExternalSurface>();
+    externalSurface->setRelativeSize(Size(10, 10));
+    Compositor compositor(ConsoleLogger::getLogger());
+
+    DisplayListBuilder builder(100, 100);
+    buildFrameWithExternalSurface(builder, externalSurface, Vector(15, 15), Vector(60, 60));
+    CompositorPlaneList planeList;
+    compositor.performComposition(*builder.displayList, planeList);
+
+    // The overlay fits below the external surface
+    ASSERT_EQ(static_cast<size_t>(2), planeList.getPlanesCount());
+
+    // The overlay now needs to be above the external surface
+    DisplayListBuilder nextBuilder(100, 100);
+    buildFrameWithExternalSurface(nextBuilder, externalSurface, Vector(15, 15), Vector(20, 20));
+    CompositorPlaneList nextPlaneList;
+    compositor.performComposition(*nextBuilder.displayList, nextPlaneList);
+
+    ASSERT_FALSE(compositor.getLastCompositionMetrics().reusedPlanes);
+    ASSERT_EQ(static_cast<size_t>(3), nextPlaneList.getPlanesCount());
+    ASSERT_EQ(CompositorPlaneTypeDrawable, nextPlaneList.getPlaneAtIndex(2).getType());
+
+    // Moving it back out leaves the top plane empty, which should also resolve the planes again
+    DisplayListBuilder lastBuilder(100, 100);
+    buildFrameWithExternalSurface(lastBuilder, externalSurface, Vector(15, 15), Vector(60, 60));
+    CompositorPlaneList lastPlaneList;
+    compositor.performComposition(*lastBuilder.displayList, lastPlaneList);
+
+    ASSERT_FALSE(compositor.getLastCompositionMetrics().reusedPlanes);
+    ASSERT_EQ(static_cast<size_t>(2), lastPlaneList.getPlanesCount());
+}
+
 } // namespace snap::drawing
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "DisplayListBuilder.hpp"
+#include "TestBitmap.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayListCapture.hpp"
+#include "snap_drawing/cpp/Drawing/DrawingContext.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/RasterContext.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static LayerContent makeRectangle(Size size, Color color) {
+    DrawingContext ctx(size.width, size.height);
+
+    Paint paint;
+    paint.setColor(color);
+
+    ctx.drawPaint(paint, ctx.drawBounds());
+
+    return ctx.finish();
+}
+
+static Ref<DisplayList> makeDisplayList(const LayerContent& background, const LayerContent& square, TimePoint frameTime) {
+    auto displayList = makeShared<DisplayList>(Size(4, 4), frameTime);
+
+    displayList->pushContext(Matrix(), 1.0, 1, true);
+    displayList->appendLayerContent(background, 1.0);
+
+    Matrix matrix;
+    matrix.setTranslateX(1);
+    matrix.setTranslateY(1);
+    displayList->pushContext(matrix, 1.0, 2, true);
+    displayList->appendClipRect(2, 2);
+    displayList->appendLayerContent(square, 1.0);
+    displayList->popContext();
+
+    displayList->popContext();
+
+    return displayList;
+}
+
+static Ref<TestBitmap> raster(const Ref<DisplayList>& displayList) {
+    auto rasterContext = makeShared<RasterContext>(ConsoleLogger::getLogger(),
+                                                   ExternalSurfaceRasterizationMethod::ACCURATE,
+                                                   /* enableDeltaRasterization */ false);
+    auto bitmap = makeShared<TestBitmap>(4, 4);
+    auto result = rasterContext->raster(displayList, bitmap, true);
+    EXPECT_TRUE(result) << result.description();
+    return bitmap;
+}
+
+TEST(DisplayListCapture, canCaptureAndReplayFrames) {
+    auto background = makeRectangle(Size(4, 4), Color::red());
+    auto square = makeRectangle(Size(4, 4), Color::blue());
+
+    auto firstFrame = makeDisplayList(background, square, TimePoint(1.0));
+    auto secondFrame = makeDisplayList(background, square, TimePoint(2.0));
+
+    auto writer = makeShared<DisplayListCaptureWriter>();
+    writer->append(*firstFrame);
+    writer->append(*secondFrame);
+
+    ASSERT_EQ(static_cast<size_t>(2), writer->getFramesCount());
+
+    auto capture = DisplayListCapture::parse(writer->getData(), true);
+    ASSERT_TRUE(capture) << capture.description();
+
+    const auto& frames = capture.value()->getFrames();
+    ASSERT_EQ(static_cast<size_t>(2), frames.size());
+
+    ASSERT_EQ(Size(4, 4), frames[0]->getSize());
+    ASSERT_EQ(TimePoint(1.0), frames[0]->getFrameTime());
+    ASSERT_EQ(TimePoint(2.0), frames[1]->getFrameTime());
+
+    auto firstOperations = getOperationsFromDisplayList(frames[0], 0);
+    auto secondOperations = getOperationsFromDisplayList(frames[1], 0);
+    ASSERT_EQ(static_cast<size_t>(6), firstOperations.size());
+    ASSERT_EQ(Operations::ClipRect::kId, firstOperations[3]->type);
+    ASSERT_EQ(Operations::DrawPicture::kId, firstOperations[4]->type);
+
+    // Pictures shared between frames should be written once and shared again when replaying
+    ASSERT_EQ(reinterpret_cast<const Operations::DrawPicture*>(firstOperations[4])->picture,
+              reinterpret_cast<const Operations::DrawPicture*>(secondOperations[4])->picture);
+
+    ASSERT_EQ(*raster(firstFrame), *raster(frames[0]));
+    ASSERT_EQ(*raster(frames[1]),
+              std::initializer_list<Color>({
+                  // clang-format off
+                Color::red(), Color::red(), Color::red(), Color::red(),
+                Color::red(), Color::blue(), Color::blue(), Color::red(),
+                Color::red(), Color::blue(), Color::blue(), Color::red(),
+                Color::red(), Color::red(), Color::red(), Color::red(),
+                  // clang-format on
+              }));
+}
+
+TEST(DisplayListCapture, keepsOnlyTheLastFrames) {
+    auto background = makeRectangle(Size(4, 4), Color::red());
+    auto square = makeRectangle(Size(4, 4), Color::blue());
+    auto otherSquare = makeRectangle(Size(4, 4), Color::green());
+
+    auto secondFrame = makeDisplayList(background, square, TimePoint(2.0));
+    auto thirdFrame = makeDisplayList(background, otherSquare, TimePoint(3.0));
+
+    auto writer = makeShared<DisplayListCaptureWriter>(2);
+    writer->append(*makeDisplayList(background, square, TimePoint(1.0)));
+    writer->append(*secondFrame);
+    writer->append(*thirdFrame);
+
+    ASSERT_EQ(static_cast<size_t>(2), writer->getFramesCount());
+
+    auto capture = DisplayListCapture::parse(writer->getData(), true);
+    ASSERT_TRUE(capture) << capture.description();
+
+    const auto& frames = capture.value()->getFrames();
+    ASSERT_EQ(static_cast<size_t>(2), frames.size());
+    ASSERT_EQ(TimePoint(2.0), frames[0]->getFrameTime());
+    ASSERT_EQ(TimePoint(3.0), frames[1]->getFrameTime());
+
+    // Resources first used by the dropped frame should still be written for the kept frames
+    ASSERT_EQ(*raster(secondFrame), *raster(frames[0]));
+    ASSERT_EQ(*raster(thirdFrame), *raster(frames[1]));
+}
+
+TEST(DisplayListCapture, failsOnMalformedData) {
+    auto background = makeRectangle(Size(4, 4), Color::red());
+    auto square = makeRectangle(Size(4, 4), Color::blue());
+
+    auto writer = makeShared<DisplayListCaptureWriter>();
+    writer->append(*makeDisplayList(background, square, TimePoint(1.0)));
+
+    auto data = writer->getData();
+
+    auto truncatedCapture = DisplayListCapture::parse(BytesView(data.getSource(), data.data(), data.size() - 4), true);
+    ASSERT_FALSE(truncatedCapture);
+
+    uint32_t invalidMagic = 0;
+    auto invalidMagicCapture =
+        DisplayListCapture::parse(BytesView(nullptr, reinterpret_cast<const Byte*>(&invalidMagic), sizeof(invalidMagic)), true);
+    ASSERT_FALSE(invalidMagicCapture);
+}
+
+} // namespace snap::drawing
@@ -2,6 +2,7 @@
 
 #include "snap_drawing/cpp/Animations/Animation.hpp"
 #include "snap_drawing/cpp/Drawing/DrawLooper.hpp"
+#include "snap_drawing/cpp/Drawing/DrawPool.hpp"
 #include "snap_drawing/cpp/Layers/ExternalLayer.hpp"
 #include "snap_drawing/cpp/Layers/Layer.hpp"
 #include "snap_drawing/cpp/Layers/LayerRoot.hpp"
@@ -14,6 +15,7 @@
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterManager.hpp"
 
 #include <deque>
+#include <thread>
 
 using namespace Valdi;
 
@@ -118,9 +120,15 @@ public:
         return _performCleanupRequests;
     }
 
+    std::vector<std::thread::id> getRequestThreadIds() const {
+        std::lock_guard<Valdi::Mutex> guard(_mutex);
+        return _requestThreadIds;
+    }
+
     void setResourceCacheLimit(size_t resourceCacheLimitBytes) override {
         std::lock_guard<Valdi::Mutex> guard(_mutex);
         _resourceCacheLimitBytesRequests.emplace_back(resourceCacheLimitBytes);
+        _requestThreadIds.emplace_back(std::this_thread::get_id());
     }
 
     void performCleanup(bool shouldPurgeScratchResources, std::chrono::seconds secondsNotUsed) override {
@@ -130,12 +138,21 @@ public:
 
         std::lock_guard<Valdi::Mutex> guard(_mutex);
         _performCleanupRequests.emplace_back(cleanUpRequest);
+        _requestThreadIds.emplace_back(std::this_thread::get_id());
+    }
+
+    void commit() override {
+        BitmapGraphicsContext::commit();
+
+        std::lock_guard<Valdi::Mutex> guard(_mutex);
+        _requestThreadIds.emplace_back(std::this_thread::get_id());
     }
 
 private:
     mutable Valdi::Mutex _mutex;
     std::vector<size_t> _resourceCacheLimitBytesRequests;
     std::vector<PerformCleanupRequest> _performCleanupRequests;
+    std::vector<std::thread::id> _requestThreadIds;
 };
 
 class TestSurfacePresenterManager : public SurfacePresenterManager {
@@ -1121,6 +1138,140 @@ TEST(DrawLooper, doesNotDrawWhenInBackground) {
     ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
 }
 
+TEST(DrawLooper, drawsIndependentLayerRootsConcurrently) {
+    DrawLooperTestContainer container;
+    container.drawLooper->setDrawPool(makeShared<DrawPool>(2));
+
+    auto otherLayerRoot = container.makeLayerRoot();
+    otherLayerRoot->getContentLayer()->setBackgroundColor(Color::red());
+
+    auto surfacePresenterManager = container.addLayerRootToLooper(container.layerRoot);
+    auto otherSurfacePresenterManager = container.addLayerRootToLooper(otherLayerRoot);
+
+    ASSERT_FALSE(container.drawLooper->getLastDrawDurationOfLayerRoot(*container.makeLayerRoot()));
+
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    auto pixelBitmap = surfacePresenterManager->getSurfaceSinglePixelBitmap(0);
+    auto otherPixelBitmap = otherSurfacePresenterManager->getSurfaceSinglePixelBitmap(0);
+
+    ASSERT_TRUE(pixelBitmap != nullptr);
+    ASSERT_TRUE(otherPixelBitmap != nullptr);
+
+    ASSERT_EQ(Color::black(), pixelBitmap->getPixel());
+    ASSERT_EQ(Color::red(), otherPixelBitmap->getPixel());
+
+    ASSERT_TRUE(container.drawLooper->getLastDrawDurationOfLayerRoot(*container.layerRoot));
+    ASSERT_TRUE(container.drawLooper->getLastDrawDurationOfLayerRoot(*otherLayerRoot));
+
+    container.frameScheduler->advanceTime(1.0);
+    otherLayerRoot->getContentLayer()->setBackgroundColor(Color::blue());
+
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    ASSERT_EQ(Color::black(), pixelBitmap->getPixel());
+    ASSERT_EQ(Color::blue(), otherPixelBitmap->getPixel());
+}
+
+TEST(DrawLooper, drawPoolKeepsGraphicsContextsOnTheSameThread) {
+    auto drawPool = makeShared<DrawPool>(2);
+
+    auto graphicsContext = makeShared<TestGraphicsContext>();
+    auto otherGraphicsContext = makeShared<TestGraphicsContext>();
+
+    auto threadIndex = drawPool->getThreadIndexForGraphicsContext(graphicsContext.get());
+    auto otherThreadIndex = drawPool->getThreadIndexForGraphicsContext(otherGraphicsContext.get());
+
+    ASSERT_NE(threadIndex, otherThreadIndex);
+    ASSERT_EQ(threadIndex, drawPool->getThreadIndexForGraphicsContext(graphicsContext.get()));
+    ASSERT_EQ(otherThreadIndex, drawPool->getThreadIndexForGraphicsContext(otherGraphicsContext.get()));
+
+    std::vector<std::thread::id> threadIds(4);
+    drawPool->run({threadIndex, otherThreadIndex, threadIndex, otherThreadIndex},
+                  [&](size_t taskIndex) { threadIds[taskIndex] = std::this_thread::get_id(); });
+
+    ASSERT_EQ(threadIds[0], threadIds[2]);
+    ASSERT_EQ(threadIds[1], threadIds[3]);
+    ASSERT_NE(threadIds[0], threadIds[1]);
+}
+
+TEST(DrawLooper, drawPoolMovesGraphicsContextsUsedTogetherToTheSameThread) {
+    auto drawPool = makeShared<DrawPool>(2);
+
+    auto graphicsContext = makeShared<TestGraphicsContext>();
+    auto otherGraphicsContext = makeShared<TestGraphicsContext>();
+
+    auto threadIndex = drawPool->getThreadIndexForGraphicsContext(graphicsContext.get());
+    ASSERT_NE(threadIndex, drawPool->getThreadIndexForGraphicsContext(otherGraphicsContext.get()));
+
+    GraphicsContextsBatch graphicsContexts;
+    graphicsContexts.emplace_back(graphicsContext.get());
+    graphicsContexts.emplace_back(otherGraphicsContext.get());
+
+    ASSERT_EQ(threadIndex, drawPool->getThreadIndexForGraphicsContexts(graphicsContexts));
+    ASSERT_EQ(threadIndex, drawPool->getThreadIndexForGraphicsContext(otherGraphicsContext.get()));
+}
+
+TEST(DrawLooper, usesGraphicsContextsOnlyFromTheirDrawThread) {
+    DrawLooperTestContainer container;
+    container.drawLooper->setDrawPool(makeShared<DrawPool>(2));
+
+    auto surfacePresenterManager = container.addLayerRootToLooper(container.layerRoot);
+    auto graphicsContext = surfacePresenterManager->getGraphicsContext();
+    container.drawLooper->appendManagedGraphicsContext(graphicsContext);
+
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    container.drawLooper->onApplicationIsInLowMemory();
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    ASSERT_FALSE(graphicsContext->getResourceCacheLimitRequests().empty());
+    ASSERT_FALSE(graphicsContext->getPerformCleanupRequests().empty());
+
+    auto threadIds = graphicsContext->getRequestThreadIds();
+    ASSERT_FALSE(threadIds.empty());
+    for (const auto& threadId : threadIds) {
+        ASSERT_NE(std::this_thread::get_id(), threadId);
+        ASSERT_EQ(threadIds[0], threadId);
+    }
+}
+
+TEST(DrawLooper, recordsFrameTimings) {
+    DrawLooperTestContainer container;
+
+    container.addLayerRootToLooper(container.layerRoot);
+
+    ASSERT_TRUE(container.drawLooper->getFrameTimingsOfLayerRoot(*container.layerRoot).empty());
+
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    // Two frames processed before the draw thread had a chance to draw the first one
+    container.frameScheduler->advanceTime(1.0);
+    container.layerRoot->getContentLayer()->setBackgroundColor(Color::red());
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+
+    container.frameScheduler->advanceTime(1.0);
+    container.layerRoot->getContentLayer()->setBackgroundColor(Color::blue());
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    auto frameTimings = container.drawLooper->getFrameTimingsOfLayerRoot(*container.layerRoot);
+
+    ASSERT_EQ(static_cast<size_t>(3), frameTimings.size());
+    ASSERT_EQ(TimePoint(0.0), frameTimings[0].frameTime);
+    ASSERT_FALSE(frameTimings[0].superseded);
+    ASSERT_EQ(TimePoint(1.0), frameTimings[1].frameTime);
+    ASSERT_TRUE(frameTimings[1].superseded);
+    ASSERT_EQ(TimePoint(2.0), frameTimings[2].frameTime);
+    ASSERT_FALSE(frameTimings[2].superseded);
+}
+
 void updateSurfacePresenters(const Ref<DrawLooperEntry>& entry, const CompositorPlaneList& planeList) {
     entry->updateSurfacePresenters(planeList);
     // Check that the presenter states are correct
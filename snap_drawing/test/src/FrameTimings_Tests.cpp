@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Drawing/FrameTimings.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static const Duration kFrameInterval = Duration(1.0 / 60.0);
+
+static void drawFrame(FrameTimingTracker& tracker, TimePoint frameTime, Duration drawDuration) {
+    tracker.onFrameEnqueued(frameTime);
+    tracker.onFrameDrawStarted();
+    tracker.onFrameDrawn(drawDuration);
+}
+
+TEST(FrameTimingHistory, keepsLastFrames) {
+    FrameTimingHistory history;
+
+    for (size_t i = 0; i < FrameTimingHistory::kCapacity + 3; i++) {
+        FrameTiming frameTiming;
+        frameTiming.frameTime = TimePoint(static_cast<TimeInterval>(i));
+        history.append(frameTiming);
+    }
+
+    auto frameTimings = history.getFrameTimings();
+
+    ASSERT_EQ(FrameTimingHistory::kCapacity, frameTimings.size());
+    ASSERT_EQ(TimePoint(3.0), frameTimings.front().frameTime);
+    ASSERT_EQ(TimePoint(static_cast<TimeInterval>(FrameTimingHistory::kCapacity + 2)), frameTimings.back().frameTime);
+}
+
+TEST(FrameTimingTracker, tracksMissedDeadlines) {
+    FrameTimingTracker tracker;
+    tracker.setFrameInterval(kFrameInterval);
+
+    drawFrame(tracker, TimePoint(0.0), Duration(0.001));
+    drawFrame(tracker, TimePoint(1.0), Duration(0.1));
+
+    auto frameTimings = tracker.getFrameTimings();
+
+    ASSERT_EQ(static_cast<size_t>(2), frameTimings.size());
+    ASSERT_FALSE(frameTimings[0].missedDeadline);
+    ASSERT_TRUE(frameTimings[1].missedDeadline);
+    ASSERT_EQ(Duration(0.1), frameTimings[1].drawDuration);
+}
+
+TEST(FrameTimingTracker, ignoresRedrawsOfDrawnFrames) {
+    FrameTimingTracker tracker;
+
+    drawFrame(tracker, TimePoint(0.0), Duration(0.001));
+    tracker.onFrameDrawStarted();
+    tracker.onFrameDrawn(Duration(0.001));
+
+    ASSERT_EQ(static_cast<size_t>(1), tracker.getFrameTimings().size());
+}
+
+TEST(FrameTimingTracker, emitsReportPeriodically) {
+    FrameTimingTracker tracker;
+    tracker.setFrameInterval(kFrameInterval);
+
+    for (size_t i = 0; i < FrameTimingTracker::kFramesPerReport - 1; i++) {
+        // Every other frame gets superseded
+        tracker.onFrameEnqueued(TimePoint(static_cast<TimeInterval>(i)));
+        if (i % 2 == 1) {
+            tracker.onFrameDrawStarted();
+            tracker.onFrameDrawn(Duration(0.001));
+        }
+    }
+
+    tracker.onFrameEnqueued(TimePoint(static_cast<TimeInterval>(FrameTimingTracker::kFramesPerReport - 1)));
+
+    ASSERT_FALSE(tracker.consumeReport());
+
+    tracker.onFrameDrawStarted();
+    tracker.onFrameDrawn(Duration(0.001));
+
+    auto report = tracker.consumeReport();
+
+    ASSERT_TRUE(report);
+    ASSERT_EQ(FrameTimingTracker::kFramesPerReport, report->framesCount);
+    ASSERT_EQ(FrameTimingTracker::kFramesPerReport / 2, report->supersededFramesCount);
+    ASSERT_EQ(FrameTimingTracker::kFramesPerReport / 2, report->drawnFramesCount);
+    ASSERT_EQ(static_cast<size_t>(0), report->missedDeadlinesCount);
+
+    ASSERT_FALSE(tracker.consumeReport());
+}
+
+TEST(FrameTimingTracker, lowersDrawRateWhenMissingDeadlines) {
+    FrameTimingTracker tracker;
+    tracker.setFrameInterval(kFrameInterval);
+
+    auto frameTime = TimePoint(0.0);
+    for (size_t i = 0; i < 3; i++) {
+        tracker.onWillDrawAtTime(frameTime);
+        drawFrame(tracker, frameTime, Duration(0.1));
+        frameTime += kFrameInterval;
+    }
+
+    // Adaptive frame rate is disabled by default
+    ASSERT_EQ(static_cast<size_t>(1), tracker.getFrameSkipFactor());
+
+    tracker.setAdaptiveFrameRateEnabled(true);
+
+    auto lastDrawTime = frameTime;
+    for (size_t i = 0; i < 3; i++) {
+        tracker.onWillDrawAtTime(frameTime);
+        drawFrame(tracker, frameTime, Duration(0.1));
+        lastDrawTime = frameTime;
+        frameTime += kFrameInterval;
+    }
+
+    ASSERT_EQ(static_cast<size_t>(2), tracker.getFrameSkipFactor());
+
+    ASSERT_TRUE(tracker.shouldSkipDrawAtTime(lastDrawTime + kFrameInterval));
+    ASSERT_FALSE(tracker.shouldSkipDrawAtTime(lastDrawTime + kFrameInterval + kFrameInterval));
+
+    tracker.onDrawSkipped(frameTime);
+    tracker.onDrawSkipped(frameTime);
+
+    // Frames that fit in half of the budget restore the frame rate
+    for (size_t i = 0; i < 30; i++) {
+        drawFrame(tracker, frameTime, Duration(0.001));
+        frameTime += kFrameInterval;
+    }
+
+    ASSERT_EQ(static_cast<size_t>(1), tracker.getFrameSkipFactor());
+    ASSERT_FALSE(tracker.shouldSkipDrawAtTime(frameTime));
+
+    for (size_t i = 0; i < FrameTimingTracker::kFramesPerReport; i++) {
+        drawFrame(tracker, frameTime, Duration(0.001));
+        frameTime += kFrameInterval;
+    }
+
+    auto report = tracker.consumeReport();
+
+    ASSERT_TRUE(report);
+    ASSERT_EQ(static_cast<size_t>(1), report->droppedFramesCount);
+    ASSERT_EQ(static_cast<size_t>(6), report->missedDeadlinesCount);
+}
+
+TEST(FrameTimingTracker, lowersProcessRateWithDrawRate) {
+    FrameTimingTracker tracker;
+    tracker.setFrameInterval(kFrameInterval);
+    tracker.setAdaptiveFrameRateEnabled(true);
+
+    auto frameTime = TimePoint(0.0);
+    ASSERT_FALSE(tracker.shouldSkipProcessFrameAtTime(frameTime));
+
+    for (size_t i = 0; i < 3; i++) {
+        tracker.onWillProcessFrame(frameTime);
+        tracker.onDidProcessFrame();
+        drawFrame(tracker, frameTime, Duration(0.02));
+        frameTime += kFrameInterval;
+    }
+
+    ASSERT_EQ(static_cast<size_t>(2), tracker.getFrameSkipFactor());
+
+    auto lastProcessTime = frameTime - kFrameInterval;
+    ASSERT_TRUE(tracker.shouldSkipProcessFrameAtTime(lastProcessTime + kFrameInterval));
+    ASSERT_FALSE(tracker.shouldSkipProcessFrameAtTime(lastProcessTime + kFrameInterval + kFrameInterval));
+
+    tracker.setAdaptiveFrameRateEnabled(false);
+    ASSERT_FALSE(tracker.shouldSkipProcessFrameAtTime(lastProcessTime + kFrameInterval));
+}
+
+TEST(FrameTimingTracker, ignoresFramesSupersededWhileDrawsAreThrottled) {
+    FrameTimingTracker tracker;
+    tracker.setFrameInterval(kFrameInterval);
+    tracker.setAdaptiveFrameRateEnabled(true);
+
+    auto frameTime = TimePoint(0.0);
+    for (size_t i = 0; i < 3; i++) {
+        drawFrame(tracker, frameTime, Duration(0.02));
+        frameTime += kFrameInterval;
+    }
+
+    ASSERT_EQ(static_cast<size_t>(2), tracker.getFrameSkipFactor());
+
+    // Frames emitted in between two throttled draws get superseded
+    for (size_t i = 0; i < 10; i++) {
+        tracker.onFrameEnqueued(frameTime);
+        frameTime += kFrameInterval;
+        drawFrame(tracker, frameTime, Duration(0.02));
+        frameTime += kFrameInterval;
+    }
+
+    ASSERT_EQ(static_cast<size_t>(2), tracker.getFrameSkipFactor());
+}
+
+} // namespace snap::drawing
@@ -163,4 +163,89 @@ TEST_F(RasterDamageResolverTests, returnsDamageOnMovedLayer) {
     ASSERT_EQ(Rect::makeXYWH(10, 10, 10, 10), damageRects[1]);
 }
 
+TEST_F(RasterDamageResolverTests, returnsDamageOnChildrenOfMovedLayer) {
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        _builder.context(Vector(10, 10), 1.0, 2, false, [&]() {
+            _builder.context(Vector(5, 5), 1.0, 3, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+        });
+        _builder.context(Vector(60, 60), 1.0, 4, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+    });
+
+    // First pass to populate the previous layer contents
+    resolveDamage();
+
+    _builder = DisplayListBuilder(100, 100);
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        _builder.context(Vector(30, 10), 1.0, 2, false, [&]() {
+            _builder.context(Vector(5, 5), 1.0, 3, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+        });
+        _builder.context(Vector(60, 60), 1.0, 4, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+    });
+
+    auto damageRects = resolveDamage();
+
+    ASSERT_EQ(static_cast<size_t>(2), damageRects.size());
+    ASSERT_EQ(Rect::makeXYWH(15, 15, 10, 10), damageRects[0]);
+    ASSERT_EQ(Rect::makeXYWH(35, 15, 10, 10), damageRects[1]);
+}
+
+TEST_F(RasterDamageResolverTests, returnsDamageOnChangedClip) {
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        _builder.clip(Size(50, 50));
+        _builder.context(Vector(20, 20), 1.0, 2, false, [&]() { _builder.rectangle(Size(60, 60), 1.0); });
+    });
+
+    // First pass to populate the previous layer contents
+    resolveDamage();
+    ASSERT_EQ(static_cast<size_t>(0), resolveDamage().size());
+
+    _builder = DisplayListBuilder(100, 100);
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        _builder.clip(Size(70, 70));
+        _builder.context(Vector(20, 20), 1.0, 2, false, [&]() { _builder.rectangle(Size(60, 60), 1.0); });
+    });
+
+    auto damageRects = resolveDamage();
+
+    ASSERT_EQ(static_cast<size_t>(1), damageRects.size());
+    ASSERT_EQ(Rect::makeXYWH(20, 20, 50, 50), damageRects[0]);
+}
+
+TEST_F(RasterDamageResolverTests, returnsNoDamageForLayersSpanningMultiplePlanes) {
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        _builder.context(Vector(10, 10), 1.0, 2, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+    });
+    _builder.plane([&]() {
+        _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+            _builder.context(Vector(50, 50), 1.0, 3, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+        });
+    });
+
+    // First pass to populate the previous layer contents
+    resolveDamage();
+    auto damageRects = resolveDamage();
+
+    ASSERT_EQ(static_cast<size_t>(0), damageRects.size());
+    ASSERT_EQ(static_cast<size_t>(4), _damageResolver.getLayerStatesCount());
+}
+
+TEST_F(RasterDamageResolverTests, releasesStatesOfRemovedLayers) {
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        _builder.context(Vector(50, 50), 1.0, 2, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+        _builder.context(Vector(20, 20), 1.0, 3, false, [&]() { _builder.rectangle(Size(10, 10), 1.0); });
+    });
+
+    resolveDamage();
+
+    ASSERT_EQ(static_cast<size_t>(3), _damageResolver.getLayerStatesCount());
+
+    _builder = DisplayListBuilder(100, 100);
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {});
+
+    auto damageRects = resolveDamage();
+
+    ASSERT_EQ(static_cast<size_t>(2), damageRects.size());
+    ASSERT_EQ(static_cast<size_t>(1), _damageResolver.getLayerStatesCount());
+}
+
 } // namespace snap::drawing
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "TestGestureUtils.hpp"
 
+#include <algorithm>
+#include <functional>
+
 using namespace Valdi;
 
 namespace snap::drawing {
@@ -115,6 +118,79 @@ TEST(Layer, canResolveCoordinatesWithScale) {
     ASSERT_EQ(Point::make(4, 12.25), result.value());
 }
 
+static Ref<Layer> makeGrid(size_t columns, size_t rows, Scalar cellSize) {
+    auto gridView = createView(0, 0, static_cast<Scalar>(columns) * cellSize, static_cast<Scalar>(rows) * cellSize);
+    for (size_t row = 0; row < rows; row++) {
+        for (size_t column = 0; column < columns; column++) {
+            gridView->addChild(createView(
+                static_cast<Scalar>(column) * cellSize, static_cast<Scalar>(row) * cellSize, cellSize, cellSize));
+        }
+    }
+    return gridView;
+}
+
+TEST(Layer, canHitTestManyChildren) {
+    auto gridView = makeGrid(10, 10, 10);
+
+    ASSERT_EQ(gridView->getChild(0), gridView->getLayerAtPoint(Point::make(5, 5)));
+    ASSERT_EQ(gridView->getChild(23), gridView->getLayerAtPoint(Point::make(35, 25)));
+    ASSERT_EQ(gridView->getChild(99), gridView->getLayerAtPoint(Point::make(95, 95)));
+
+    std::vector<size_t> candidates;
+    gridView->getHitTestCandidateChildren(Point::make(35, 25), candidates);
+    ASSERT_LT(candidates.size(), static_cast<size_t>(10));
+    ASSERT_TRUE(std::is_sorted(candidates.begin(), candidates.end(), std::greater<>()));
+
+    // Moving a child should be reflected in the next hit test
+    gridView->getChild(99)->setFrame(Rect::makeXYWH(0, 0, 10, 10));
+    ASSERT_EQ(gridView->getChild(99), gridView->getLayerAtPoint(Point::make(5, 5)));
+    ASSERT_EQ(gridView, gridView->getLayerAtPoint(Point::make(95, 95)));
+
+    // Touch area extension should be taken in account
+    gridView->getChild(99)->setFrame(Rect::makeXYWH(90, 90, 5, 5));
+    ASSERT_EQ(gridView, gridView->getLayerAtPoint(Point::make(98, 98)));
+    gridView->getChild(99)->setTouchAreaExtension(0, 5, 0, 5);
+    ASSERT_EQ(gridView->getChild(99), gridView->getLayerAtPoint(Point::make(98, 98)));
+
+    // The last inserted child should win among overlapping siblings
+    auto overlay = createView(0, 0, 100, 100);
+    gridView->addChild(overlay);
+    ASSERT_EQ(overlay, gridView->getLayerAtPoint(Point::make(35, 25)));
+
+    overlay->removeFromParent();
+    ASSERT_EQ(gridView->getChild(23), gridView->getLayerAtPoint(Point::make(35, 25)));
+}
+
+TEST(Layer, hitTestIndexFollowsChildTransforms) {
+    // Children separated by gaps
+    auto rowView = createView(0, 0, 400, 40);
+    for (size_t i = 0; i < 20; i++) {
+        rowView->addChild(createView(static_cast<Scalar>(i) * 20, 0, 10, 10));
+    }
+
+    // Scrolling moves the parent of the children, which should keep hitting the right children
+    auto scrollView = createView(0, 0, 100, 10);
+    scrollView->addChild(rowView);
+    ASSERT_EQ(rowView->getChild(0), scrollView->getLayerAtPoint(Point::make(5, 5)));
+    rowView->setFrame(Rect::makeXYWH(-200, 0, 400, 40));
+    ASSERT_EQ(rowView->getChild(10), scrollView->getLayerAtPoint(Point::make(5, 5)));
+
+    auto child = rowView->getChild(0);
+    ASSERT_EQ(rowView, rowView->getLayerAtPoint(Point::make(15, 5)));
+
+    child->setTranslationX(10);
+    ASSERT_EQ(child, rowView->getLayerAtPoint(Point::make(15, 5)));
+
+    child->setScaleX(2);
+    child->setScaleY(2);
+    ASSERT_EQ(child, rowView->getLayerAtPoint(Point::make(19, 12)));
+
+    // A layer with a zero scale is hit everywhere in its parent
+    child->setScaleX(0);
+    child->setScaleY(0);
+    ASSERT_EQ(child, rowView->getLayerAtPoint(Point::make(395, 5)));
+}
+
 //
 // TEST(Layer, canResolveCoordinatesWithScaleTranslate) {
 //
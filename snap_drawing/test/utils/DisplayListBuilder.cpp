@@ -59,10 +59,15 @@ LayerContent DisplayListBuilder::rectangle(Size size, Scalar opacity) {
 }
 
 LayerContent DisplayListBuilder::externalSurface(Size size, Scalar opacity) {
-    return draw(size, opacity, [&](DrawingContext& drawingContext) {
-        auto externalSurface = Valdi::makeShared<ExternalSurface>();
-        externalSurface->setRelativeSize(size);
+    auto externalSurface = Valdi::makeShared<ExternalSurface>();
+    externalSurface->setRelativeSize(size);
+
+    return this->externalSurface(externalSurface, opacity);
+}
 
+LayerContent DisplayListBuilder::externalSurface(const Ref<ExternalSurface>& externalSurface, Scalar opacity) {
+    auto size = externalSurface->getRelativeSize();
+    return draw(size, opacity, [&](DrawingContext& drawingContext) {
         drawingContext.drawExternalSurface(externalSurface);
     });
 }
@@ -29,6 +29,8 @@ struct DisplayListBuilder {
 
     LayerContent externalSurface(Size size, Scalar opacity);
 
+    LayerContent externalSurface(const Ref<ExternalSurface>& externalSurface, Scalar opacity);
+
     void mask(const Rect& rect, BuilderCb&& cb);
 
     void layerContent(const LayerContent& layerContent, Scalar opacity);
@@ -1,8 +1,48 @@
 import { RequireFunc } from 'valdi_core/src/IModuleLoader';
-import { FileSystemModule } from './FileSystemModule';
+import { FileSystemCompletion, FileSystemModule, ReadFileRangeOptions } from './FileSystemModule';
 
 declare const require: RequireFunc;
 
 export const VALDI_MODULES_ROOT = './valdi_modules/src/valdi';
 
 export const fs = require('FileSystem') as FileSystemModule;
+
+function toPromise<T>(call: (completion: FileSystemCompletion<T>) => void): Promise<T> {
+  return new Promise<T>((resolve, reject) => {
+    call((result, error) => {
+      if (error) {
+        reject(new Error(error));
+      } else {
+        resolve(result as T);
+      }
+    });
+  });
+}
+
+/**
+ * Reads the file at the given path without blocking the JS thread.
+ */
+export function readFile(path: string, options?: ReadFileRangeOptions): Promise<string | ArrayBuffer> {
+  return toPromise(completion => fs.readFile(path, options, completion));
+}
+
+/**
+ * Writes the file at the given path without blocking the JS thread.
+ */
+export function writeFile(path: string, data: ArrayBuffer | string): Promise<void> {
+  return toPromise(completion => fs.writeFile(path, data, completion));
+}
+
+/**
+ * Removes the file or directory at the given path without blocking the JS thread.
+ */
+export function remove(path: string): Promise<boolean> {
+  return toPromise(completion => fs.remove(path, completion));
+}
+
+/**
+ * Creates a directory at the given path without blocking the JS thread.
+ */
+export function createDirectory(path: string, createIntermediates: boolean): Promise<boolean> {
+  return toPromise(completion => fs.createDirectory(path, createIntermediates, completion));
+}
@@ -4,6 +4,31 @@ export interface ReadFileOptions {
   encoding?: FileEncoding | undefined | null;
 }
 
+export interface ReadFileRangeOptions extends ReadFileOptions {
+  /**
+   * Byte offset at which the read should start.
+   * @default: 0
+   */
+  offset?: number;
+  /**
+   * Number of bytes to read, reads until the end of the file when not set.
+   */
+  length?: number;
+  /**
+   * Map the file into memory instead of reading it, for binary reads of large files.
+   * Pages are then loaded lazily as the ArrayBuffer is accessed. The file must not be
+   * truncated while the ArrayBuffer is alive, which would crash the app.
+   * @default: false
+   */
+  mapped?: boolean;
+}
+
+/**
+ * Completion of an async file system operation, called with either
+ * the result of the operation or an error message.
+ */
+export type FileSystemCompletion<T> = (result: T | undefined, error: string | undefined) => void;
+
 /**
  * Valdi File System module
  * This FS API right now is only for internal usage due to some limitations.
@@ -15,9 +40,26 @@ export interface FileSystemModule {
 
   createDirectorySync(path: string, createIntermediates: boolean): boolean;
 
-  readFileSync(path: string, options?: ReadFileOptions): string | ArrayBuffer;
+  readFileSync(path: string, options?: ReadFileRangeOptions): string | ArrayBuffer;
 
   writeFileSync(path: string, data: ArrayBuffer | string): void;
 
+  /**
+   * Async variants, which perform the disk IO off the JS thread.
+   * Binary reads return an ArrayBuffer backed by the loaded bytes without copy,
+   * or by the mapped file when the mapped option is set.
+   */
+  remove(path: string, completion: FileSystemCompletion<boolean>): void;
+
+  createDirectory(path: string, createIntermediates: boolean, completion: FileSystemCompletion<boolean>): void;
+
+  readFile(
+    path: string,
+    options: ReadFileRangeOptions | undefined,
+    completion: FileSystemCompletion<string | ArrayBuffer>,
+  ): void;
+
+  writeFile(path: string, data: ArrayBuffer | string, completion: FileSystemCompletion<void>): void;
+
   currentWorkingDirectory(): string;
-}
\ No newline at end of file
+}
@@ -1,6 +1,6 @@
 import 'jasmine/src/jasmine';
 import { arrayToString } from 'coreutils/src/Uint8ArrayUtils';
-import { fs, VALDI_MODULES_ROOT } from '../src/FileSystem';
+import { createDirectory, fs, readFile, remove, VALDI_MODULES_ROOT, writeFile } from '../src/FileSystem';
 
 describe('File System Module', () => {
   const newFSItems = {
@@ -60,4 +60,54 @@ describe('File System Module', () => {
 
     expect(resultFromFolderRemove).toBeTrue();
   });
+
+  it('should read file asynchronously', async () => {
+    const fileName = `${VALDI_MODULES_ROOT}/file_system/test/test_file.txt`;
+
+    const result = await readFile(fileName, { encoding: 'utf8' });
+    expect(result).toEqual('test data for file');
+
+    const buffer = await readFile(fileName);
+    expect(buffer).toBeInstanceOf(ArrayBuffer);
+    expect(arrayToString(new Uint8Array(buffer as ArrayBuffer))).toEqual('test data for file');
+  });
+
+  it('should read a range of a file asynchronously', async () => {
+    const fileName = `${VALDI_MODULES_ROOT}/file_system/test/test_file.txt`;
+
+    const result = await readFile(fileName, { encoding: 'utf8', offset: 5, length: 4 });
+    expect(result).toEqual('data');
+  });
+
+  it('should read a mapped file asynchronously', async () => {
+    const fileName = `${VALDI_MODULES_ROOT}/file_system/test/test_file.txt`;
+
+    const buffer = await readFile(fileName, { mapped: true, offset: 5, length: 4 });
+    expect(buffer).toBeInstanceOf(ArrayBuffer);
+    expect(arrayToString(new Uint8Array(buffer as ArrayBuffer))).toEqual('data');
+  });
+
+  it('should reject async read if file does not exist', async () => {
+    const fileName = `${VALDI_MODULES_ROOT}/file_system/test/no_file`;
+
+    let error: Error | undefined;
+    try {
+      await readFile(fileName);
+    } catch (err) {
+      error = err as Error;
+    }
+
+    expect(error?.message).toEqual(`Could not read the file at path: '${fileName}'`);
+  });
+
+  it('should create, write and remove files and folders asynchronously', async () => {
+    const fileName = `${newFSItems.folder}/async_file.txt`;
+
+    expect(await createDirectory(newFSItems.folder, false)).toBeTrue();
+
+    await writeFile(fileName, 'async data');
+    expect(await readFile(fileName, { encoding: 'utf8' })).toEqual('async data');
+
+    expect(await remove(newFSItems.folder)).toBeTrue();
+  });
 });
@@ -1,4 +1,4 @@
-import { FileSystemModule, ReadFileOptions } from '../src/FileSystemModule';
+import { FileSystemCompletion, FileSystemModule, ReadFileRangeOptions } from '../src/FileSystemModule';
 
 const encUtf8 = new TextEncoder();
 const decUtf8 = new TextDecoder();
@@ -95,9 +95,11 @@ const fsStub: FileSystemModule = {
     return true;
   },
 
-  readFileSync(path: string, options?: ReadFileOptions): string | ArrayBuffer {
+  readFileSync(path: string, options?: ReadFileRangeOptions): string | ArrayBuffer {
     const p = norm(path);
-    const buf = files.get(p) ?? new Uint8Array(0);
+    const file = files.get(p) ?? new Uint8Array(0);
+    const offset = options?.offset ?? 0;
+    const buf = file.subarray(offset, options?.length !== undefined ? offset + options.length : undefined);
 
     const enc = options?.encoding;
     if (enc === "utf8") return decUtf8.decode(buf);
@@ -118,11 +120,45 @@ const fsStub: FileSystemModule = {
     files.set(p, bytes);
   },
 
+  remove(path: string, completion: FileSystemCompletion<boolean>): void {
+    callAsync(completion, () => this.removeSync(path));
+  },
+
+  createDirectory(path: string, createIntermediates: boolean, completion: FileSystemCompletion<boolean>): void {
+    callAsync(completion, () => this.createDirectorySync(path, createIntermediates));
+  },
+
+  readFile(
+    path: string,
+    options: ReadFileRangeOptions | undefined,
+    completion: FileSystemCompletion<string | ArrayBuffer>,
+  ): void {
+    callAsync(completion, () => this.readFileSync(path, options));
+  },
+
+  writeFile(path: string, data: ArrayBuffer | string, completion: FileSystemCompletion<void>): void {
+    callAsync(completion, () => this.writeFileSync(path, data));
+  },
+
   currentWorkingDirectory(): string {
     return CWD;
   },
 };
 
+/** The in-memory FS has no IO to wait on, the completion is only deferred to match the native behavior. */
+function callAsync<T>(completion: FileSystemCompletion<T>, fn: () => T): void {
+  setTimeout(() => {
+    let result: T;
+    try {
+      result = fn();
+    } catch (err) {
+      completion(undefined, String(err));
+      return;
+    }
+    completion(result, undefined);
+  }, 0);
+}
+
 /** Exported instance + setter so you can swap in a real native binding later. */
 export let fileSystem: FileSystemModule = fsStub;
 export function setFileSystem(impl: FileSystemModule): void {
@@ -1773,6 +1773,25 @@ export interface ScrollView extends _ScrollView, CommonView, ContainerTemplateEl
    * @default: 0
    */
   viewportExtensionLeft?: number;
+
+  /**
+   * How far ahead in time, in seconds, the children that are about to enter
+   * the viewport should be prepared while scrolling. The viewport is extended
+   * in the scroll direction by the distance the content is predicted to travel
+   * within that time given the current scroll velocity and deceleration, and the
+   * lazy layouts of the children within it are calculated ahead of time.
+   *
+   * @default: 0
+   */
+  prefetchLookahead?: number;
+
+  /**
+   * When prefetchLookahead is set, whether the views of the children
+   * that are about to enter the viewport should also be pre-created.
+   *
+   * @default: false
+   */
+  prefetchViews?: boolean;
 }
 
 /**
@@ -336,6 +336,7 @@ JSRuntime* JS_NewRuntime(void);
 void JS_SetRuntimeInfo(JSRuntime* rt, const char* info);
 void JS_SetMemoryLimit(JSRuntime* rt, size_t limit);
 void JS_SetGCThreshold(JSRuntime* rt, size_t gc_threshold);
+size_t JS_GetMallocSize(JSRuntime* rt);
 /* use 0 to disable maximum stack size check */
 void JS_SetMaxStackSize(JSRuntime* rt, size_t stack_size);
 /* should be called when changing thread to update the stack top value
@@ -1705,6 +1705,11 @@ void JS_SetGCThreshold(JSRuntime* rt, size_t gc_threshold) {
     rt->malloc_gc_threshold = gc_threshold;
 }
 
+/* same size as the one compared against the GC threshold, without walking the heap */
+size_t JS_GetMallocSize(JSRuntime* rt) {
+    return rt->malloc_state.malloc_size + rt->external_malloc_bytes;
+}
+
 #define malloc(s) malloc_is_forbidden(s)
 #define free(p) free_is_forbidden(p)
 #define realloc(p, s) realloc_is_forbidden(p, s)
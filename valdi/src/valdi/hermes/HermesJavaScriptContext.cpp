@@ -1152,13 +1152,17 @@ void HermesJavaScriptContext::enqueueMicrotask(const JSValue& value, JSException
 
 JavaScriptContextMemoryStatistics HermesJavaScriptContext::dumpMemoryStatistics() {
     JavaScriptContextMemoryStatistics out;
+    out.memoryUsageBytes = getHeapSizeBytes();
+
+    return out;
+}
+
+size_t HermesJavaScriptContext::getHeapSizeBytes() {
     hermes::vm::GCBase::HeapInfo info;
 
     _runtime->getHeap().getHeapInfo(info);
 
-    out.memoryUsageBytes = static_cast<size_t>(info.allocatedBytes);
-
-    return out;
+    return static_cast<size_t>(info.allocatedBytes);
 }
 
 BytesView HermesJavaScriptContext::dumpHeap(JSExceptionTracker& exceptionTracker) {
@@ -139,6 +139,7 @@ public:
 
     void garbageCollect() final;
     JavaScriptContextMemoryStatistics dumpMemoryStatistics() final;
+    size_t getHeapSizeBytes() final;
     BytesView dumpHeap(JSExceptionTracker& exceptionTracker);
 
     void enqueueMicrotask(const JSValue& value, JSExceptionTracker& exceptionTracker) final;
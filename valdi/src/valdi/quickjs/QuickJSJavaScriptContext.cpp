@@ -372,6 +372,36 @@ Valdi::JSValueRef QuickJSJavaScriptContext::newObject(Valdi::JSExceptionTracker&
     return checkCallAndGetValue(exceptionTracker, JS_NewObject(_context));
 }
 
+Valdi::JSValueRef QuickJSJavaScriptContext::newObjectWithProperties(const Valdi::JSPropertyName* propertyNames,
+                                                                    const Valdi::JSValue* propertyValues,
+                                                                    size_t size,
+                                                                    Valdi::JSExceptionTracker& exceptionTracker) {
+    auto guard = _threadAccessChecker.guard();
+    auto object = JS_NewObject(_context);
+    if (JS_IsException(object) != 0) {
+        setExceptionToTracker(exceptionTracker);
+        return Valdi::JSValueRef();
+    }
+
+    // Defining the properties directly avoids the setter lookups on the prototype chain
+    // that JS_SetProperty() does. Since the object is fresh, the result is the same.
+    for (size_t i = 0; i < size; i++) {
+        // JS_DefinePropertyValue() automatically releases the given value.
+        auto ret = JS_DefinePropertyValue(_context,
+                                          object,
+                                          fromValdiJSPropertyName(propertyNames[i]),
+                                          JS_DupValue(_context, fromValdiJSValue(propertyValues[i])),
+                                          JS_PROP_C_W_E | JS_PROP_THROW);
+        if (ret < 0) {
+            JS_FreeValue(_context, object);
+            setExceptionToTracker(exceptionTracker);
+            return Valdi::JSValueRef();
+        }
+    }
+
+    return toRetainedJSValueRef(object);
+}
+
 Valdi::JSValueRef QuickJSJavaScriptContext::newFunction(const Valdi::Ref<Valdi::JSFunction>& callable,
                                                         Valdi::JSExceptionTracker& exceptionTracker) {
     auto guard = _threadAccessChecker.guard();
@@ -1061,6 +1091,11 @@ Valdi::JavaScriptContextMemoryStatistics QuickJSJavaScriptContext::dumpMemorySta
     return out;
 }
 
+size_t QuickJSJavaScriptContext::getHeapSizeBytes() {
+    auto guard = _threadAccessChecker.guard();
+    return JS_GetMallocSize(_runtime);
+}
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunneeded-internal-declaration"
 
@@ -66,6 +66,11 @@ public:
 
     Valdi::JSValueRef newObject(Valdi::JSExceptionTracker& exceptionTracker) override;
 
+    Valdi::JSValueRef newObjectWithProperties(const Valdi::JSPropertyName* propertyNames,
+                                              const Valdi::JSValue* propertyValues,
+                                              size_t size,
+                                              Valdi::JSExceptionTracker& exceptionTracker) override;
+
     Valdi::JSValueRef newFunction(const Valdi::Ref<Valdi::JSFunction>& callable,
                                   Valdi::JSExceptionTracker& exceptionTracker) override;
 
@@ -176,6 +181,7 @@ public:
 
     void garbageCollect() override;
     Valdi::JavaScriptContextMemoryStatistics dumpMemoryStatistics() override;
+    size_t getHeapSizeBytes() override;
 
     void dumpHeap(Valdi::JavaScriptHeapDumpBuilder& heapDumpBuilder);
 
@@ -37,6 +37,9 @@ void ScrollAttributes::bind(AttributeHandlerById& attributes) {
     binder.bindViewNodeFloat("viewportExtensionLeft", &ViewNode::setViewportExtensionLeft);
     binder.bindViewNodeFloat("viewportExtensionRight", &ViewNode::setViewportExtensionRight);
 
+    binder.bindViewNodeFloat("prefetchLookahead", &ViewNode::setScrollPrefetchLookahead);
+    binder.bindViewNodeBoolean("prefetchViews", &ViewNode::setScrollPrefetchViews);
+
     binder.bindViewNodeCallback("onContentSizeChange", &ViewNode::setOnContentSizeChangeCallback);
 
     std::vector<CompositeAttributePart> parts;
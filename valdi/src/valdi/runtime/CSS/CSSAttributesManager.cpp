@@ -155,8 +155,35 @@ void CSSAttributesManager::updateCSS(const CSSAttributesManagerUpdateContext& co
     }
 }
 
+bool CSSAttributesManager::invalidate(CSSInvalidation invalidation) {
+    if ((invalidation & (CSSInvalidationChildren | CSSInvalidationDescendants)) != 0) {
+        // Our children key their shared styles on our resolved style, so it has to be
+        // resolved again whenever one of our inputs used by their rules changes.
+        invalidation |= CSSInvalidationSelf;
+    }
+    _pendingInvalidation |= invalidation;
+    return invalidation != CSSInvalidationNone;
+}
+
+CSSInvalidation CSSAttributesManager::consumeInvalidation() {
+    auto invalidation = _pendingInvalidation;
+    _pendingInvalidation = CSSInvalidationNone;
+    return invalidation;
+}
+
 bool CSSAttributesManager::setCSSClass(const Value& cssClass, bool isOverridenFromParent) {
-    return getCSSNodeContainer(isOverridenFromParent).node.setClass(cssClass.toStringBox());
+    auto& nodeContainer = getCSSNodeContainer(isOverridenFromParent);
+
+    FlatSet<StringBox> previousClasses;
+    if (!nodeContainer.node.setClass(cssClass.toStringBox(), &previousClasses)) {
+        return false;
+    }
+    if (nodeContainer.cssDocument != nullptr) {
+        invalidate(nodeContainer.cssDocument->getSelectorDependencies().getClassChangeInvalidation(
+            previousClasses, nodeContainer.node.getResolvedClasses()));
+    }
+
+    return true;
 }
 
 bool CSSAttributesManager::setCSSDocument(const Value& cssDocument, bool isOverridenFromParent) {
@@ -175,15 +202,40 @@ bool CSSAttributesManager::setCSSDocument(const Value& cssDocument, bool isOverr
         nodeContainer.node.setMonitoredCssAttributes(nullptr);
     }
 
+    // Any rule of the node and its descendants might now match differently
+    invalidate(CSSInvalidationSelf | CSSInvalidationDescendants);
+
     return true;
 }
 
 bool CSSAttributesManager::setElementTag(const StringBox& elementTag, bool isOverridenFromParent) {
-    return getCSSNodeContainer(isOverridenFromParent).node.setTagName(elementTag);
+    auto& nodeContainer = getCSSNodeContainer(isOverridenFromParent);
+
+    auto previousTagName = nodeContainer.node.getTagName();
+    if (!nodeContainer.node.setTagName(elementTag)) {
+        return false;
+    }
+    if (nodeContainer.cssDocument != nullptr) {
+        invalidate(
+            nodeContainer.cssDocument->getSelectorDependencies().getTagChangeInvalidation(previousTagName, elementTag));
+    }
+
+    return true;
 }
 
 bool CSSAttributesManager::setElementId(const StringBox& elementId, bool isOverridenFromParent) {
-    return getCSSNodeContainer(isOverridenFromParent).node.setNodeId(elementId);
+    auto& nodeContainer = getCSSNodeContainer(isOverridenFromParent);
+
+    auto previousNodeId = nodeContainer.node.getNodeId();
+    if (!nodeContainer.node.setNodeId(elementId)) {
+        return false;
+    }
+    if (nodeContainer.cssDocument != nullptr) {
+        invalidate(
+            nodeContainer.cssDocument->getSelectorDependencies().getIdChangeInvalidation(previousNodeId, elementId));
+    }
+
+    return true;
 }
 
 CSSNodeContainer* CSSAttributesManager::getCSSNodeContainerForDocument(const CSSDocument* cssDocument) const {
@@ -209,29 +261,53 @@ CSSNode* CSSAttributesManager::getCSSParentForDocument(const CSSDocument& cssDoc
     return nullptr;
 }
 
-void CSSAttributesManager::copyCSSDocument(const CSSAttributesManager& other) {
-    if (other.getCSSDocument() != nullptr) {
-        setCSSDocument(Value(other.getCSSDocument()), false);
+bool CSSAttributesManager::copyCSSDocument(const CSSAttributesManager& other) {
+    if (other.getCSSDocument() == nullptr) {
+        return false;
     }
+    return setCSSDocument(Value(other.getCSSDocument()), false);
 }
 
 void CSSAttributesManager::setParent(CSSAttributesManager* attributesManagerOfParent) {
     _attributesManagerOfParent = attributesManagerOfParent;
 }
 
+static CSSInvalidation setSiblingsIndexesOfContainer(CSSNodeContainer& nodeContainer,
+                                                     int siblingsCount,
+                                                     int indexAmongSiblings) {
+    auto previousSiblingsCount = nodeContainer.node.getSiblingsCount();
+    auto previousIndexAmongSiblings = nodeContainer.node.getIndexAmongSiblings();
+
+    auto changed = nodeContainer.node.setSiblingsCount(siblingsCount);
+    changed |= nodeContainer.node.setIndexAmongSiblings(indexAmongSiblings);
+
+    if (!changed || nodeContainer.cssDocument == nullptr) {
+        return CSSInvalidationNone;
+    }
+
+    // The position only matters if it changes which of the first-child,
+    // last-child or nth-child selectors of the document match the node.
+    const auto& cssDocument = *nodeContainer.cssDocument;
+    if (cssDocument.computePositionSignature(previousIndexAmongSiblings, previousSiblingsCount) ==
+        cssDocument.computePositionSignature(indexAmongSiblings, siblingsCount)) {
+        return CSSInvalidationNone;
+    }
+
+    return cssDocument.getSelectorDependencies().getPositionChangeInvalidation();
+}
+
 bool CSSAttributesManager::setSiblingsIndexes(int siblingsCount, int indexAmongSiblings) {
-    auto changed = false;
+    auto invalidation = CSSInvalidationNone;
 
     if (_cssNodeContainer != nullptr) {
-        changed |= _cssNodeContainer->node.setSiblingsCount(siblingsCount);
-        changed |= _cssNodeContainer->node.setIndexAmongSiblings(indexAmongSiblings);
+        invalidation |= setSiblingsIndexesOfContainer(*_cssNodeContainer, siblingsCount, indexAmongSiblings);
     }
     if (_cssNodeContainerFromParentOveridde != nullptr) {
-        changed |= _cssNodeContainerFromParentOveridde->node.setSiblingsCount(siblingsCount);
-        changed |= _cssNodeContainerFromParentOveridde->node.setIndexAmongSiblings(indexAmongSiblings);
+        invalidation |=
+            setSiblingsIndexesOfContainer(*_cssNodeContainerFromParentOveridde, siblingsCount, indexAmongSiblings);
     }
 
-    return changed;
+    return invalidate(invalidation);
 }
 
 StringBox CSSAttributesManager::getNodeId() const {
@@ -254,6 +330,37 @@ bool CSSAttributesManager::needUpdateCSS() const {
     return _cssNodeContainer != nullptr || _cssNodeContainerFromParentOveridde != nullptr;
 }
 
+bool CSSAttributesManager::hasCSSDocumentsOf(const CSSAttributesManager& other) const {
+    if (other._cssNodeContainer != nullptr && other._cssNodeContainer->cssDocument != nullptr &&
+        getCSSNodeContainerForDocument(other._cssNodeContainer->cssDocument.get()) == nullptr) {
+        return false;
+    }
+    if (other._cssNodeContainerFromParentOveridde != nullptr &&
+        other._cssNodeContainerFromParentOveridde->cssDocument != nullptr &&
+        getCSSNodeContainerForDocument(other._cssNodeContainerFromParentOveridde->cssDocument.get()) == nullptr) {
+        return false;
+    }
+
+    return true;
+}
+
+void CSSAttributesManager::resetResolvedStyles() {
+    if (_cssNodeContainer != nullptr) {
+        _cssNodeContainer->node.resetResolvedStyle();
+    }
+    if (_cssNodeContainerFromParentOveridde != nullptr) {
+        _cssNodeContainerFromParentOveridde->node.resetResolvedStyle();
+    }
+}
+
+Ref<CSSResolvedStyle> CSSAttributesManager::getResolvedStyle() const {
+    if (_cssNodeContainer != nullptr) {
+        return _cssNodeContainer->node.getResolvedStyle();
+    }
+
+    return nullptr;
+}
+
 bool CSSAttributesManager::hasNodeId(const StringBox& nodeId) const {
     if (_cssNodeContainer != nullptr && _cssNodeContainer->node.getNodeId() == nodeId) {
         return true;
@@ -266,15 +373,31 @@ bool CSSAttributesManager::hasNodeId(const StringBox& nodeId) const {
     return false;
 }
 
-bool CSSAttributesManager::attributeChanged(AttributeId attribute) {
-    bool changed = false;
-    if (_cssNodeContainer != nullptr) {
-        changed |= _cssNodeContainer->node.attributeChanged(attribute);
-    }
-    if (_cssNodeContainerFromParentOveridde != nullptr) {
-        changed |= _cssNodeContainerFromParentOveridde->node.attributeChanged(attribute);
+bool CSSAttributesManager::isMonitoredAttribute(AttributeId attribute) const {
+    return (_cssNodeContainer != nullptr && _cssNodeContainer->node.isMonitoredAttribute(attribute)) ||
+           (_cssNodeContainerFromParentOveridde != nullptr &&
+            _cssNodeContainerFromParentOveridde->node.isMonitoredAttribute(attribute));
+}
+
+static CSSInvalidation attributeChangedInContainer(const std::unique_ptr<CSSNodeContainer>& nodeContainer,
+                                                   AttributeId attribute,
+                                                   const Value& previousValue,
+                                                   const Value& newValue) {
+    if (nodeContainer == nullptr || nodeContainer->cssDocument == nullptr ||
+        !nodeContainer->node.isMonitoredAttribute(attribute)) {
+        return CSSInvalidationNone;
     }
-    return changed;
+
+    return nodeContainer->cssDocument->getSelectorDependencies().getAttributeChangeInvalidation(
+        attribute, previousValue, newValue);
+}
+
+bool CSSAttributesManager::attributeChanged(AttributeId attribute, const Value& previousValue, const Value& newValue) {
+    auto invalidation = attributeChangedInContainer(_cssNodeContainer, attribute, previousValue, newValue);
+    invalidation |=
+        attributeChangedInContainer(_cssNodeContainerFromParentOveridde, attribute, previousValue, newValue);
+
+    return invalidate(invalidation);
 }
 
 CSSNodeContainer& CSSAttributesManager::getCSSNodeContainer(bool isOverridenFromParent) {
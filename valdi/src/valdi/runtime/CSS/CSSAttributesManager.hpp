@@ -8,6 +8,7 @@
 #pragma once
 
 #include "valdi/runtime/CSS/CSSNodeParentResolver.hpp"
+#include "valdi/runtime/CSS/CSSSelectorDependencies.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
@@ -23,6 +24,7 @@ class Animator;
 class ILogger;
 class AttributeOwner;
 class CSSDocument;
+class CSSResolvedStyle;
 class ViewTransactionScope;
 
 struct CSSNodeContainer;
@@ -67,22 +69,54 @@ public:
 
     Shared<CSSDocument> getCSSDocument() const;
 
+    /**
+     The setters below return whether the CSS inputs of the node have changed.
+     The nodes whose matched rules can change as a result are accumulated and
+     can be retrieved with consumeInvalidation().
+     */
     bool setCSSDocument(const Value& cssDocument, bool isOverridenFromParent);
     bool setCSSClass(const Value& cssClass, bool isOverridenFromParent);
     bool setElementId(const StringBox& elementId, bool isOverridenFromParent);
     bool setElementTag(const StringBox& elementTag, bool isOverridenFromParent);
     bool setSiblingsIndexes(int siblingsCount, int indexAmongSiblings);
 
-    bool attributeChanged(AttributeId attribute);
+    bool isMonitoredAttribute(AttributeId attribute) const;
+    bool attributeChanged(AttributeId attribute, const Value& previousValue, const Value& newValue);
+
+    /**
+     Returns the invalidation accumulated since the last call, and resets it.
+     */
+    CSSInvalidation consumeInvalidation();
 
     StringBox getNodeId() const;
     bool hasNodeId(const StringBox& nodeId) const;
 
     bool needUpdateCSS() const;
 
+    /**
+     Whether the node is matched against every CSS document of the given node. When it isn't,
+     children sharing a document with the given node might resolve their CSS parent past this node.
+     */
+    bool hasCSSDocumentsOf(const CSSAttributesManager& other) const;
+
+    /**
+     Discard the styles resolved by the CSS nodes, so that the next
+     CSS update pass resolves them again.
+     */
+    void resetResolvedStyles();
+
+    /**
+     Returns the style resolved for the CSS document of the node during the last CSS update pass.
+     */
+    Ref<CSSResolvedStyle> getResolvedStyle() const;
+
     void setParent(CSSAttributesManager* attributesManagerOfParent);
 
-    void copyCSSDocument(const CSSAttributesManager& other);
+    /**
+     Set the CSS document of the given node on this node. Returns whether it has changed,
+     in which case the resulting invalidation can be retrieved with consumeInvalidation().
+     */
+    bool copyCSSDocument(const CSSAttributesManager& other);
 
 protected:
     CSSNode* getCSSParentForDocument(const CSSDocument& cssDocument) override;
@@ -92,6 +126,9 @@ private:
     std::unique_ptr<CSSNodeContainer> _cssNodeContainer;
     std::unique_ptr<CSSNodeContainer> _cssNodeContainerFromParentOveridde;
     CSSAttributesManager* _attributesManagerOfParent = nullptr;
+    CSSInvalidation _pendingInvalidation = CSSInvalidationNone;
+
+    bool invalidate(CSSInvalidation invalidation);
 
     bool removeAllStyles(const CSSAttributesManagerUpdateContext& context);
 
@@ -6,15 +6,48 @@
 //
 
 #include "valdi/runtime/CSS/CSSDocument.hpp"
+#include "valdi/runtime/CSS/CSSStyleTable.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/ValueUtils.hpp"
 
+#include <algorithm>
+
 namespace Valdi {
 
+// Number of resolved styles kept per document. Nodes styled consecutively in list UIs
+// tend to share a handful of entries, so this only needs to cover one screen worth of
+// distinct styles.
+constexpr size_t kStyleSharingCacheCapacity = 256;
+
+// Bits of the position signature used for the first-child and last-child rules,
+// the remaining ones are used for the nth-child rules.
+constexpr uint64_t kPositionFirstChild = 1;
+constexpr uint64_t kPositionLastChild = 1 << 1;
+constexpr size_t kPositionNthChildBitsOffset = 2;
+// When the document has too many nth-child selectors to fit in the signature,
+// we fallback on the raw position, flagged with the highest bit.
+constexpr size_t kPositionMaxNthChildSelectors = 61;
+constexpr uint64_t kPositionRawFlag = static_cast<uint64_t>(1) << 63;
+
 CSSDocument::CSSDocument(const ResourceId& resourceId, const Valdi::StyleNode& styleNode, AttributeIds& attributeIds)
-    : _resourceId(resourceId) {
+    : _resourceId(resourceId), _styleSharingCache(kStyleSharingCacheCapacity) {
     populateStyleNode(attributeIds, styleNode, _rootNode);
+    processRules();
+}
+
+CSSDocument::CSSDocument(const ResourceId& resourceId, CSSStyleNode&& rootNode)
+    : _resourceId(resourceId), _rootNode(std::move(rootNode)), _styleSharingCache(kStyleSharingCacheCapacity) {
+    processRules();
+}
+
+void CSSDocument::processRules() {
+    collectSelectorDependencies(_rootNode, 0);
+
+    if (_monitoredCssAttributes != nullptr) {
+        _sortedMonitoredAttributes.assign(_monitoredCssAttributes->begin(), _monitoredCssAttributes->end());
+        std::sort(_sortedMonitoredAttributes.begin(), _sortedMonitoredAttributes.end());
+    }
 }
 
 CSSDocument::~CSSDocument() = default;
@@ -85,15 +118,6 @@ void CSSDocument::populateRuleIndex(AttributeIds& attributeIds,
         auto& newAttributeRule = currentRuleIndex.attributeRules.emplace_back();
         newAttributeRule.attribute = toCSSAttribute(attributeIds, attributeRule.attribute());
         newAttributeRule.type = attributeRule.type();
-
-        // We insert into the monitoredCssAttributes set all attributes that we know can
-        // impact the resolved rules. To do this we traverse the CSS rule index tree to
-        // find all the attributes rules.
-        if (_monitoredCssAttributes == nullptr) {
-            _monitoredCssAttributes = Valdi::makeShared<FlatSet<AttributeId>>();
-        }
-        _monitoredCssAttributes->emplace(newAttributeRule.attribute.id);
-
         populateStyleNode(attributeIds, attributeRule.node(), newAttributeRule.styleNode);
     }
 
@@ -125,6 +149,78 @@ void CSSDocument::populateRuleIndex(AttributeIds& attributeIds,
     }
 }
 
+void CSSDocument::collectSelectorDependencies(const CSSStyleNode& styleNode, size_t depth) {
+    if (styleNode.ruleIndex != nullptr) {
+        collectSelectorDependencies(*styleNode.ruleIndex, depth);
+    }
+}
+
+void CSSDocument::collectSelectorDependencies(const CSSProcessedRuleIndex& ruleIndex, size_t depth) {
+    for (const auto& it : ruleIndex.idRules) {
+        _selectorDependencies.addIdDependency(it.first, depth);
+        collectSelectorDependencies(it.second, depth);
+    }
+
+    for (const auto& it : ruleIndex.classRules) {
+        _selectorDependencies.addClassDependency(it.first, depth);
+        collectSelectorDependencies(it.second, depth);
+    }
+
+    for (const auto& it : ruleIndex.tagRules) {
+        _selectorDependencies.addTagDependency(it.first, depth);
+        collectSelectorDependencies(it.second, depth);
+    }
+
+    for (const auto& attributeRule : ruleIndex.attributeRules) {
+        // We insert into the monitoredCssAttributes set all attributes that we know can
+        // impact the resolved rules. To do this we traverse the CSS rule index tree to
+        // find all the attributes rules.
+        if (_monitoredCssAttributes == nullptr) {
+            _monitoredCssAttributes = Valdi::makeShared<FlatSet<AttributeId>>();
+        }
+        _monitoredCssAttributes->emplace(attributeRule.attribute.id);
+
+        if (attributeRule.type == Valdi::CSSRuleIndex_AttributeRule_Type_EQUALS) {
+            _selectorDependencies.addAttributeValueDependency(attributeRule.attribute.id,
+                                                              attributeRule.attribute.value);
+        }
+        collectSelectorDependencies(attributeRule.styleNode, depth);
+    }
+
+    if (ruleIndex.firstChildRule != nullptr) {
+        _hasFirstChildRules = true;
+        _selectorDependencies.addPositionDependency(depth);
+        collectSelectorDependencies(*ruleIndex.firstChildRule, depth);
+    }
+
+    if (ruleIndex.lastChildRule != nullptr) {
+        _hasLastChildRules = true;
+        _selectorDependencies.addPositionDependency(depth);
+        collectSelectorDependencies(*ruleIndex.lastChildRule, depth);
+    }
+
+    for (const auto& nthChildRule : ruleIndex.nthChildRules) {
+        auto selector = std::make_pair(nthChildRule.n, nthChildRule.offset);
+        if (std::find(_nthChildSelectors.begin(), _nthChildSelectors.end(), selector) == _nthChildSelectors.end()) {
+            _nthChildSelectors.emplace_back(selector);
+        }
+        _selectorDependencies.addPositionDependency(depth);
+        collectSelectorDependencies(nthChildRule.node, depth);
+    }
+
+    if (ruleIndex.directParentRules != nullptr) {
+        auto parentDepth =
+            depth == CSSSelectorDependencies::kCSSDependencyDepthAncestor ? depth : depth + 1;
+        _parentRulesDepth = std::max(_parentRulesDepth, parentDepth);
+        collectSelectorDependencies(*ruleIndex.directParentRules, parentDepth);
+    }
+
+    if (ruleIndex.ancestorRules != nullptr) {
+        _parentRulesDepth = CSSSelectorDependencies::kCSSDependencyDepthAncestor;
+        collectSelectorDependencies(*ruleIndex.ancestorRules, CSSSelectorDependencies::kCSSDependencyDepthAncestor);
+    }
+}
+
 const CSSStyleNode& CSSDocument::getRootNode() const {
     return _rootNode;
 }
@@ -142,10 +238,62 @@ const ResourceId& CSSDocument::getResourceId() const {
     return _resourceId;
 }
 
+const std::vector<AttributeId>& CSSDocument::getSortedMonitoredAttributes() const {
+    return _sortedMonitoredAttributes;
+}
+
+bool CSSDocument::hasParentRules() const {
+    return _parentRulesDepth != 0;
+}
+
+uint64_t CSSDocument::computePositionSignature(int indexAmongSiblings, int siblingsCount) const {
+    if (_nthChildSelectors.size() > kPositionMaxNthChildSelectors) {
+        return kPositionRawFlag | ((static_cast<uint64_t>(indexAmongSiblings) & 0x7FFFFFFF) << 31) |
+               (static_cast<uint64_t>(siblingsCount) & 0x7FFFFFFF);
+    }
+
+    uint64_t signature = 0;
+    if (_hasFirstChildRules && indexAmongSiblings == 0) {
+        signature |= kPositionFirstChild;
+    }
+    if (_hasLastChildRules && indexAmongSiblings == siblingsCount - 1) {
+        signature |= kPositionLastChild;
+    }
+
+    auto bit = kPositionNthChildBitsOffset;
+    for (const auto& selector : _nthChildSelectors) {
+        if (CSSNthChildRule::matchesIndex(indexAmongSiblings, selector.first, selector.second)) {
+            signature |= static_cast<uint64_t>(1) << bit;
+        }
+        bit++;
+    }
+
+    return signature;
+}
+
+CSSStyleSharingCache& CSSDocument::getStyleSharingCache() const {
+    return _styleSharingCache;
+}
+
+const CSSSelectorDependencies& CSSDocument::getSelectorDependencies() const {
+    return _selectorDependencies;
+}
+
 Result<Ref<CSSDocument>> CSSDocument::parse(const ResourceId& resourceId,
                                             const Byte* data,
                                             size_t len,
                                             AttributeIds& attributeIds) {
+    if (CSSStyleTable::isStyleTable(data, len)) {
+        CSSStyleNode rootNode;
+        auto result = CSSStyleTable::deserialize(data, len, attributeIds, rootNode);
+        if (!result) {
+            return result.moveError();
+        }
+
+        return Valdi::makeShared<CSSDocument>(resourceId, std::move(rootNode));
+    }
+
+    // Documents compiled before the style table was introduced are serialized StyleNodes
     Valdi::StyleNode styleNodeRoot;
 
     bool parsed = styleNodeRoot.ParseFromArray(data, static_cast<int>(len));
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "valdi/runtime/CSS/CSSAttributes.hpp"
+#include "valdi/runtime/CSS/CSSSelectorDependencies.hpp"
+#include "valdi/runtime/CSS/CSSStyleSharingCache.hpp"
 #include "valdi/valdi.pb.h"
 #include "valdi_core/cpp/Resources/ResourceId.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
@@ -41,6 +43,17 @@ struct CSSNthChildRule {
     CSSStyleNode node;
     int n = 0;
     int offset = 0;
+
+    static inline bool matchesIndex(const int index, const int n, const int offset) {
+        // nth-child element indexes start at one
+        auto adjustedIndex = index + 1;
+        if (n == 0) {
+            return adjustedIndex == offset;
+        }
+
+        auto offsetIndex = adjustedIndex - offset;
+        return offsetIndex % n == 0 && offsetIndex / n >= 0;
+    }
 };
 
 struct CSSProcessedRuleIndex {
@@ -60,6 +73,7 @@ using MonitoredCssAttributesPtr = std::shared_ptr<FlatSet<AttributeId>>;
 class CSSDocument : public ValdiObject {
 public:
     CSSDocument(const ResourceId& resourceId, const Valdi::StyleNode& styleNode, AttributeIds& attributeIds);
+    CSSDocument(const ResourceId& resourceId, CSSStyleNode&& rootNode);
     ~CSSDocument() override;
 
     const CSSStyleNode& getRootNode() const;
@@ -74,11 +88,44 @@ public:
 
     const ResourceId& getResourceId() const;
 
+    /**
+     Returns the monitored attributes in a stable order, used to build style sharing keys.
+     */
+    const std::vector<AttributeId>& getSortedMonitoredAttributes() const;
+
+    /**
+     Whether the document contains rules which depend on the parent or ancestors of a node.
+     */
+    bool hasParentRules() const;
+
+    /**
+     Computes a signature of the sibling position of a node, such that two nodes with the same
+     signature match exactly the same first-child, last-child and nth-child rules.
+     */
+    uint64_t computePositionSignature(int indexAmongSiblings, int siblingsCount) const;
+
+    CSSStyleSharingCache& getStyleSharingCache() const;
+
+    /**
+     Returns the dependencies of the selectors of this document, used to find
+     the minimal set of nodes to match again when a node changes.
+     */
+    const CSSSelectorDependencies& getSelectorDependencies() const;
+
     VALDI_CLASS_HEADER(CSSDocument)
 private:
     ResourceId _resourceId;
     CSSStyleNode _rootNode;
     MonitoredCssAttributesPtr _monitoredCssAttributes;
+    std::vector<AttributeId> _sortedMonitoredAttributes;
+    std::vector<std::pair<int, int>> _nthChildSelectors;
+    bool _hasFirstChildRules = false;
+    bool _hasLastChildRules = false;
+    size_t _parentRulesDepth = 0;
+    mutable CSSStyleSharingCache _styleSharingCache;
+    CSSSelectorDependencies _selectorDependencies;
+
+    void processRules();
 
     void populateStyleNode(AttributeIds& attributeIds, const Valdi::StyleNode& styleNode, CSSStyleNode& currentNode);
     void populateRuleIndex(AttributeIds& attributeIds,
@@ -88,6 +135,9 @@ private:
                                          const Valdi::StyleDeclaration& styleDeclaration,
                                          CSSStyleDeclaration& currentStyleDeclaration);
 
+    void collectSelectorDependencies(const CSSStyleNode& styleNode, size_t depth);
+    void collectSelectorDependencies(const CSSProcessedRuleIndex& ruleIndex, size_t depth);
+
     void populateMapRule(AttributeIds& attributeIds,
                          const google::protobuf::RepeatedPtrField<::Valdi::NamedStyleNode>& mapRule,
                          FlatMap<StringBox, CSSStyleNode>& currentMap);
@@ -55,18 +55,17 @@ void forEachCSSClass(const StringBox& cssClasses, T&& callback) {
 
 CSSNode::CSSNode() = default;
 
-CSSNode::~CSSNode() {
-    if (_lastStyleDeclarations != nullptr) {
-        CSSNode::releaseStyleDeclarationMap(std::move(_lastStyleDeclarations));
-    }
-}
+CSSNode::~CSSNode() = default;
 
-bool CSSNode::setClass(const StringBox& cssClass) {
+bool CSSNode::setClass(const StringBox& cssClass, FlatSet<StringBox>* previousClasses) {
     if (_cssClass == cssClass) {
         return false;
     }
 
     _cssClass = cssClass;
+    if (previousClasses != nullptr) {
+        *previousClasses = std::move(_resolvedCssClasses);
+    }
     _resolvedCssClasses.clear();
 
     forEachCSSClass(cssClass, [&](StringBox cssClass) { _resolvedCssClasses.emplace(std::move(cssClass)); });
@@ -106,6 +105,10 @@ const StringBox& CSSNode::getClass() const {
     return _cssClass;
 }
 
+const FlatSet<StringBox>& CSSNode::getResolvedClasses() const {
+    return _resolvedCssClasses;
+}
+
 bool CSSNode::isMonitoredAttribute(AttributeId attribute) const {
     if (_monitoredCssAttributes == nullptr) {
         return false;
@@ -114,10 +117,6 @@ bool CSSNode::isMonitoredAttribute(AttributeId attribute) const {
     return _monitoredCssAttributes->find(attribute) != _monitoredCssAttributes->end();
 }
 
-bool CSSNode::attributeChanged(AttributeId attribute) {
-    return isMonitoredAttribute(attribute);
-}
-
 int CSSNode::getIndexAmongSiblings() const {
     return _indexAmongSiblings;
 }
@@ -131,6 +130,10 @@ bool CSSNode::setIndexAmongSiblings(int index) {
     return true;
 }
 
+int CSSNode::getSiblingsCount() const {
+    return _siblingsCount;
+}
+
 bool CSSNode::setSiblingsCount(int count) {
     if (count == _siblingsCount) {
         return false;
@@ -176,17 +179,6 @@ void CSSNode::insertDeclarations(const CSSDocument& cssDocument,
     }
 }
 
-inline bool nthChildMatchesIndex(const int index, const int n, const int offset) {
-    // nth-child element indexes start at one
-    auto adjustedIndex = index + 1;
-    if (n == 0) {
-        return adjustedIndex == offset;
-    }
-
-    auto offsetIndex = adjustedIndex - offset;
-    return offsetIndex % n == 0 && offsetIndex / n >= 0;
-}
-
 void CSSNode::insertDeclarations(const CSSDocument& cssDocument,
                                  const CSSProcessedRuleIndex& ruleIndex,
                                  AttributesApplier& attributesApplier,
@@ -264,7 +256,7 @@ void CSSNode::insertDeclarations(const CSSDocument& cssDocument,
     if (!ruleIndex.nthChildRules.empty()) {
         const auto& nthChildRules = ruleIndex.nthChildRules;
         for (const auto& nthChildRule : nthChildRules) {
-            if (nthChildMatchesIndex(_indexAmongSiblings, nthChildRule.n, nthChildRule.offset)) {
+            if (CSSNthChildRule::matchesIndex(_indexAmongSiblings, nthChildRule.n, nthChildRule.offset)) {
                 insertDeclarations(cssDocument, nthChildRule.node, attributesApplier, bestStyleDeclarationByKey);
             }
         }
@@ -297,31 +289,83 @@ void CSSNode::setAttributeFromDeclaration(ViewTransactionScope& viewTransactionS
         viewTransactionScope, attributeId, this, styleDeclaration->attribute.value, animator);
 }
 
+bool CSSNode::makeStyleSharingKey(const CSSDocument& cssDocument,
+                                  AttributesApplier& attributesApplier,
+                                  CSSStyleSharingKey& key) const {
+    key.tagName = _tagName;
+    key.nodeId = _nodeId;
+    key.cssClass = _cssClass;
+    key.positionSignature = cssDocument.computePositionSignature(_indexAmongSiblings, _siblingsCount);
+
+    for (auto attributeId : cssDocument.getSortedMonitoredAttributes()) {
+        key.monitoredAttributeValues.emplace_back(attributesApplier.getResolvedAttributeValue(attributeId));
+    }
+
+    if (cssDocument.hasParentRules()) {
+        // Parents resolve their style before their children, and again whenever an input
+        // used by the rules of their children changes, so their style reflects these inputs.
+        auto* parent = resolveParent(cssDocument);
+        if (parent != nullptr) {
+            if (parent->_resolvedStyle == nullptr) {
+                return false;
+            }
+            key.parentStyle = parent->_resolvedStyle;
+        }
+    }
+
+    return true;
+}
+
+Ref<CSSResolvedStyle> CSSNode::resolveStyle(const CSSDocument& cssDocument, AttributesApplier& attributesApplier) {
+    CSSStyleSharingKey key;
+    if (!makeStyleSharingKey(cssDocument, attributesApplier, key)) {
+        auto resolvedStyle = makeShared<CSSResolvedStyle>();
+        insertDeclarations(cssDocument, cssDocument.getRootNode(), attributesApplier, resolvedStyle->declarations);
+        return resolvedStyle;
+    }
+
+    auto& styleSharingCache = cssDocument.getStyleSharingCache();
+    auto resolvedStyle = styleSharingCache.find(key);
+    if (resolvedStyle == nullptr) {
+        resolvedStyle = makeShared<CSSResolvedStyle>();
+        insertDeclarations(cssDocument, cssDocument.getRootNode(), attributesApplier, resolvedStyle->declarations);
+        styleSharingCache.insert(std::move(key), resolvedStyle);
+    }
+
+    return resolvedStyle;
+}
+
 void CSSNode::applyCss(ViewTransactionScope& viewTransactionScope,
                        const CSSDocument& cssDocument,
                        AttributesApplier& attributesApplier,
                        const SharedAnimator& animator) {
-    auto bestStyleDeclarationByKey = CSSNode::newStyleDeclarationMap();
+    auto resolvedStyle = resolveStyle(cssDocument, attributesApplier);
 
-    insertDeclarations(cssDocument, cssDocument.getRootNode(), attributesApplier, *bestStyleDeclarationByKey);
-
-    if (_lastStyleDeclarations != nullptr) {
-        for (const auto& it : *_lastStyleDeclarations) {
-            if (bestStyleDeclarationByKey->find(it.first) == bestStyleDeclarationByKey->end()) {
+    if (_resolvedStyle != nullptr && _resolvedStyle != resolvedStyle) {
+        const auto& declarations = resolvedStyle->declarations;
+        for (const auto& it : _resolvedStyle->declarations) {
+            if (declarations.find(it.first) == declarations.end()) {
                 // If our applied CSS attribute is not among the new CSS attributes
                 // we remove it.
                 attributesApplier.removeAttribute(viewTransactionScope, it.first, this, animator);
             }
         }
-        CSSNode::releaseStyleDeclarationMap(std::move(_lastStyleDeclarations));
     }
 
-    for (const auto& tuple : *bestStyleDeclarationByKey) {
+    for (const auto& tuple : resolvedStyle->declarations) {
         const auto& property = tuple.first;
 
         setAttributeFromDeclaration(viewTransactionScope, property, attributesApplier, tuple.second, animator);
     }
-    _lastStyleDeclarations = std::move(bestStyleDeclarationByKey);
+    _resolvedStyle = std::move(resolvedStyle);
+}
+
+const Ref<CSSResolvedStyle>& CSSNode::getResolvedStyle() const {
+    return _resolvedStyle;
+}
+
+void CSSNode::resetResolvedStyle() {
+    _resolvedStyle = nullptr;
 }
 
 CSSNode* CSSNode::resolveParent(const CSSDocument& cssDocument) const {
@@ -354,25 +398,4 @@ const StringBox& CSSNode::getTagName() const {
     return _tagName;
 }
 
-thread_local std::vector<std::unique_ptr<FlatMap<AttributeId, const CSSStyleDeclaration*>>> styleDeclarationsPool;
-
-std::unique_ptr<FlatMap<AttributeId, const CSSStyleDeclaration*>> CSSNode::newStyleDeclarationMap() {
-    auto& mapPool = styleDeclarationsPool;
-    if (mapPool.empty()) {
-        auto map = std::make_unique<FlatMap<AttributeId, const CSSStyleDeclaration*>>();
-        map->reserve(10);
-        return map;
-    } else {
-        auto map = std::move(mapPool[mapPool.size() - 1]);
-        mapPool.pop_back();
-        return map;
-    }
-}
-
-void CSSNode::releaseStyleDeclarationMap(
-    std::unique_ptr<FlatMap<AttributeId, const CSSStyleDeclaration*>> styleDeclarationMap) {
-    styleDeclarationMap->clear();
-    styleDeclarationsPool.emplace_back(std::move(styleDeclarationMap));
-}
-
 } // namespace Valdi
@@ -16,6 +16,7 @@
 #include "valdi/runtime/Attributes/AttributeOwner.hpp"
 #include "valdi/runtime/CSS/CSSDocument.hpp"
 #include "valdi/runtime/CSS/CSSNodeParentResolver.hpp"
+#include "valdi/runtime/CSS/CSSStyleSharingCache.hpp"
 #include "valdi/valdi.pb.h"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
@@ -33,8 +34,13 @@ public:
     CSSNode(const CSSNode&) = delete;
     ~CSSNode() override;
 
-    bool setClass(const StringBox& cssClass);
+    /**
+     Set the CSS class of the node. When previousClasses is provided,
+     the previously resolved classes are moved into it.
+     */
+    bool setClass(const StringBox& cssClass, FlatSet<StringBox>* previousClasses = nullptr);
     const StringBox& getClass() const;
+    const FlatSet<StringBox>& getResolvedClasses() const;
 
     void applyCss(ViewTransactionScope& viewTransactionScope,
                   const CSSDocument& cssDocument,
@@ -46,9 +52,10 @@ public:
     int getIndexAmongSiblings() const;
     bool setIndexAmongSiblings(int index);
 
+    int getSiblingsCount() const;
     bool setSiblingsCount(int count);
 
-    bool attributeChanged(AttributeId attribute);
+    bool isMonitoredAttribute(AttributeId attribute) const;
 
     bool setTagName(const StringBox& tagName);
 
@@ -64,6 +71,17 @@ public:
 
     StringBox getAttributeSource(AttributeId attributeId) const override;
 
+    /**
+     Returns the style resolved during the last applyCss() pass.
+     */
+    const Ref<CSSResolvedStyle>& getResolvedStyle() const;
+
+    /**
+     Discard the last resolved style, forcing the next applyCss() pass to resolve
+     and apply all the attributes again.
+     */
+    void resetResolvedStyle();
+
 private:
     StringBox _tagName;
     StringBox _nodeId;
@@ -73,7 +91,7 @@ private:
     FlatSet<StringBox> _resolvedCssClasses;
     StringBox _cssClass;
 
-    std::unique_ptr<FlatMap<AttributeId, const CSSStyleDeclaration*>> _lastStyleDeclarations;
+    Ref<CSSResolvedStyle> _resolvedStyle;
 
     int _indexAmongSiblings = 0;
     int _siblingsCount = 0;
@@ -94,16 +112,16 @@ private:
                                      const CSSStyleDeclaration* styleDeclaration,
                                      const SharedAnimator& animator);
 
-    bool isMonitoredAttribute(AttributeId attribute) const;
-
     CSSNode* resolveParent(const CSSDocument& cssDocument) const;
 
-    // Style declaration pooling
-
-    static std::unique_ptr<FlatMap<AttributeId, const CSSStyleDeclaration*>> newStyleDeclarationMap();
-
-    static void releaseStyleDeclarationMap(
-        std::unique_ptr<FlatMap<AttributeId, const CSSStyleDeclaration*>> styleDeclarationMap);
+    Ref<CSSResolvedStyle> resolveStyle(const CSSDocument& cssDocument, AttributesApplier& attributesApplier);
+    /**
+     Fills the key under which the resolved style can be shared. Returns false if the
+     style cannot be shared, because the CSS parent has not resolved its own style yet.
+     */
+    bool makeStyleSharingKey(const CSSDocument& cssDocument,
+                             AttributesApplier& attributesApplier,
+                             CSSStyleSharingKey& key) const;
 };
 
 } // namespace Valdi
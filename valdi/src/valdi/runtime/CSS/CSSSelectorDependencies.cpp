@@ -0,0 +1,142 @@
+//
+//  CSSSelectorDependencies.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/CSS/CSSSelectorDependencies.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+
+namespace Valdi {
+
+CSSSelectorDependencies::CSSSelectorDependencies() = default;
+CSSSelectorDependencies::~CSSSelectorDependencies() = default;
+
+CSSInvalidation CSSSelectorDependencies::invalidationForDepth(size_t depth) {
+    switch (depth) {
+        case 0:
+            return CSSInvalidationSelf;
+        case 1:
+            return CSSInvalidationChildren;
+        default:
+            // We don't track deeper direct parent chains, we invalidate
+            // the whole subtree in that case.
+            return CSSInvalidationDescendants;
+    }
+}
+
+void CSSSelectorDependencies::addKeyDependency(FlatMap<StringBox, CSSInvalidation>& dependencies,
+                                               const StringBox& key,
+                                               size_t depth) {
+    auto it = dependencies.try_emplace(key, CSSInvalidationNone);
+    it.first->second |= invalidationForDepth(depth);
+}
+
+void CSSSelectorDependencies::addIdDependency(const StringBox& nodeId, size_t depth) {
+    addKeyDependency(_idDependencies, nodeId, depth);
+}
+
+void CSSSelectorDependencies::addClassDependency(const StringBox& className, size_t depth) {
+    addKeyDependency(_classDependencies, className, depth);
+}
+
+void CSSSelectorDependencies::addTagDependency(const StringBox& tagName, size_t depth) {
+    static auto kWildcardRule = STRING_LITERAL("*");
+    if (tagName == kWildcardRule) {
+        // The wildcard matches regardless of the tag
+        return;
+    }
+
+    addKeyDependency(_tagDependencies, tagName, depth);
+}
+
+void CSSSelectorDependencies::addPositionDependency(size_t depth) {
+    _positionDependencies |= invalidationForDepth(depth);
+}
+
+void CSSSelectorDependencies::addAttributeValueDependency(AttributeId attributeId, const Value& value) {
+    // Attribute rules are always evaluated against the attributes of the node being styled,
+    // including when they are nested in a parent or ancestor rule, so a change of attribute
+    // can only ever impact the node itself.
+    auto& values = _attributeValueDependencies[attributeId];
+    if (std::find(values.begin(), values.end(), value) == values.end()) {
+        values.emplace_back(value);
+    }
+}
+
+CSSInvalidation CSSSelectorDependencies::getKeyInvalidation(const FlatMap<StringBox, CSSInvalidation>& dependencies,
+                                                            const StringBox& key) {
+    const auto& it = dependencies.find(key);
+    if (it == dependencies.end()) {
+        return CSSInvalidationNone;
+    }
+    return it->second;
+}
+
+CSSInvalidation CSSSelectorDependencies::getKeyChangeInvalidation(
+    const FlatMap<StringBox, CSSInvalidation>& dependencies, const StringBox& previousKey, const StringBox& newKey) {
+    if (dependencies.empty()) {
+        return CSSInvalidationNone;
+    }
+
+    return getKeyInvalidation(dependencies, previousKey) | getKeyInvalidation(dependencies, newKey);
+}
+
+CSSInvalidation CSSSelectorDependencies::getIdChangeInvalidation(const StringBox& previousNodeId,
+                                                                 const StringBox& newNodeId) const {
+    return getKeyChangeInvalidation(_idDependencies, previousNodeId, newNodeId);
+}
+
+CSSInvalidation CSSSelectorDependencies::getTagChangeInvalidation(const StringBox& previousTagName,
+                                                                  const StringBox& newTagName) const {
+    return getKeyChangeInvalidation(_tagDependencies, previousTagName, newTagName);
+}
+
+CSSInvalidation CSSSelectorDependencies::getClassChangeInvalidation(const FlatSet<StringBox>& previousClasses,
+                                                                    const FlatSet<StringBox>& newClasses) const {
+    if (_classDependencies.empty()) {
+        return CSSInvalidationNone;
+    }
+
+    auto invalidation = CSSInvalidationNone;
+
+    // Only the classes that were added or removed can change the matched rules
+    for (const auto& className : previousClasses) {
+        if (newClasses.find(className) == newClasses.end()) {
+            invalidation |= getKeyInvalidation(_classDependencies, className);
+        }
+    }
+    for (const auto& className : newClasses) {
+        if (previousClasses.find(className) == previousClasses.end()) {
+            invalidation |= getKeyInvalidation(_classDependencies, className);
+        }
+    }
+
+    return invalidation;
+}
+
+CSSInvalidation CSSSelectorDependencies::getPositionChangeInvalidation() const {
+    return _positionDependencies;
+}
+
+CSSInvalidation CSSSelectorDependencies::getAttributeChangeInvalidation(AttributeId attributeId,
+                                                                        const Value& previousValue,
+                                                                        const Value& newValue) const {
+    const auto& it = _attributeValueDependencies.find(attributeId);
+    if (it == _attributeValueDependencies.end()) {
+        return CSSInvalidationNone;
+    }
+
+    for (const auto& value : it->second) {
+        if ((previousValue == value) != (newValue == value)) {
+            return CSSInvalidationSelf;
+        }
+    }
+
+    return CSSInvalidationNone;
+}
+
+} // namespace Valdi
@@ -0,0 +1,91 @@
+//
+//  CSSSelectorDependencies.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/Attributes/AttributeId.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+
+#include <cstdint>
+#include <limits>
+
+namespace Valdi {
+
+/**
+ Describes which nodes need their CSS rules to be matched again
+ after an input of a node has changed. Values can be combined.
+ */
+enum CSSInvalidation : uint8_t {
+    CSSInvalidationNone = 0,
+    // The node itself needs to be matched again
+    CSSInvalidationSelf = 1 << 0,
+    // The direct children of the node need to be matched again
+    CSSInvalidationChildren = 1 << 1,
+    // All the descendants of the node need to be matched again
+    CSSInvalidationDescendants = 1 << 2,
+};
+
+constexpr CSSInvalidation operator|(CSSInvalidation left, CSSInvalidation right) {
+    return static_cast<CSSInvalidation>(static_cast<uint8_t>(left) | static_cast<uint8_t>(right));
+}
+
+constexpr CSSInvalidation& operator|=(CSSInvalidation& left, CSSInvalidation right) {
+    left = left | right;
+    return left;
+}
+
+/**
+ Maps the keys used by the selectors of a CSSDocument to the set of nodes whose
+ matched rules can change when a node gains or loses that key. The depth of a key
+ is the number of parent relations between the subject of the selector and the
+ node holding the key: 0 for the subject itself, 1 for a direct parent rule,
+ kCSSDependencyDepthAncestor for an ancestor rule.
+ */
+class CSSSelectorDependencies {
+public:
+    static constexpr size_t kCSSDependencyDepthAncestor = std::numeric_limits<size_t>::max();
+
+    CSSSelectorDependencies();
+    ~CSSSelectorDependencies();
+
+    void addIdDependency(const StringBox& nodeId, size_t depth);
+    void addClassDependency(const StringBox& className, size_t depth);
+    void addTagDependency(const StringBox& tagName, size_t depth);
+    void addPositionDependency(size_t depth);
+    void addAttributeValueDependency(AttributeId attributeId, const Value& value);
+
+    CSSInvalidation getIdChangeInvalidation(const StringBox& previousNodeId, const StringBox& newNodeId) const;
+    CSSInvalidation getClassChangeInvalidation(const FlatSet<StringBox>& previousClasses,
+                                               const FlatSet<StringBox>& newClasses) const;
+    CSSInvalidation getTagChangeInvalidation(const StringBox& previousTagName, const StringBox& newTagName) const;
+    CSSInvalidation getPositionChangeInvalidation() const;
+    CSSInvalidation getAttributeChangeInvalidation(AttributeId attributeId,
+                                                   const Value& previousValue,
+                                                   const Value& newValue) const;
+
+    static CSSInvalidation invalidationForDepth(size_t depth);
+
+private:
+    FlatMap<StringBox, CSSInvalidation> _idDependencies;
+    FlatMap<StringBox, CSSInvalidation> _classDependencies;
+    FlatMap<StringBox, CSSInvalidation> _tagDependencies;
+    FlatMap<AttributeId, SmallVector<Value, 2>> _attributeValueDependencies;
+    CSSInvalidation _positionDependencies = CSSInvalidationNone;
+
+    static void addKeyDependency(FlatMap<StringBox, CSSInvalidation>& dependencies, const StringBox& key, size_t depth);
+    static CSSInvalidation getKeyInvalidation(const FlatMap<StringBox, CSSInvalidation>& dependencies,
+                                              const StringBox& key);
+    static CSSInvalidation getKeyChangeInvalidation(const FlatMap<StringBox, CSSInvalidation>& dependencies,
+                                                    const StringBox& previousKey,
+                                                    const StringBox& newKey);
+};
+
+} // namespace Valdi
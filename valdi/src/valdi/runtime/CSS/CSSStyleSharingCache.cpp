@@ -0,0 +1,84 @@
+//
+//  CSSStyleSharingCache.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/CSS/CSSStyleSharingCache.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace Valdi {
+
+CSSResolvedStyle::CSSResolvedStyle() = default;
+CSSResolvedStyle::~CSSResolvedStyle() = default;
+
+size_t CSSStyleSharingKey::hash() const {
+    size_t hash = tagName.hash();
+    boost::hash_combine(hash, nodeId.hash());
+    boost::hash_combine(hash, cssClass.hash());
+    boost::hash_combine(hash, positionSignature);
+    for (const auto& value : monitoredAttributeValues) {
+        boost::hash_combine(hash, value.hash());
+    }
+    boost::hash_combine(hash, parentStyle.get());
+    return hash;
+}
+
+bool CSSStyleSharingKey::operator==(const CSSStyleSharingKey& other) const {
+    return positionSignature == other.positionSignature && tagName == other.tagName && cssClass == other.cssClass &&
+           nodeId == other.nodeId && monitoredAttributeValues == other.monitoredAttributeValues &&
+           parentStyle == other.parentStyle;
+}
+
+CSSStyleSharingCache::CSSStyleSharingCache(size_t capacity) : _entries(capacity) {}
+CSSStyleSharingCache::~CSSStyleSharingCache() = default;
+
+Ref<CSSResolvedStyle> CSSStyleSharingCache::find(const CSSStyleSharingKey& key) {
+    std::lock_guard<Mutex> lock(_mutex);
+    const auto& it = _entries.find(key);
+    if (it == _entries.end()) {
+        _missesCount++;
+        return nullptr;
+    }
+
+    _hitsCount++;
+    return it->value();
+}
+
+void CSSStyleSharingCache::insert(CSSStyleSharingKey&& key, const Ref<CSSResolvedStyle>& resolvedStyle) {
+    std::lock_guard<Mutex> lock(_mutex);
+    auto value = resolvedStyle;
+    _entries.insert(std::move(key), std::move(value));
+}
+
+void CSSStyleSharingCache::clear() {
+    std::lock_guard<Mutex> lock(_mutex);
+    _entries.clear();
+}
+
+size_t CSSStyleSharingCache::size() const {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _entries.size();
+}
+
+size_t CSSStyleSharingCache::getHitsCount() const {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _hitsCount;
+}
+
+size_t CSSStyleSharingCache::getMissesCount() const {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _missesCount;
+}
+
+} // namespace Valdi
+
+namespace std {
+
+std::size_t hash<Valdi::CSSStyleSharingKey>::operator()(const Valdi::CSSStyleSharingKey& k) const {
+    return k.hash();
+}
+
+} // namespace std
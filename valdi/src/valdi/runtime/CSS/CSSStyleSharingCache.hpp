@@ -0,0 +1,93 @@
+//
+//  CSSStyleSharingCache.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/Attributes/AttributeId.hpp"
+#include "valdi/runtime/CSS/CSSAttributes.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/LRUCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+
+namespace Valdi {
+
+/**
+ The result of matching a CSSDocument against a CSSNode: the best style declaration
+ for each attribute. Instances are immutable once resolved, which allows them to be
+ shared between nodes which have the same matching inputs.
+ */
+class CSSResolvedStyle : public SimpleRefCountable {
+public:
+    CSSResolvedStyle();
+    ~CSSResolvedStyle() override;
+
+    FlatMap<AttributeId, const CSSStyleDeclaration*> declarations;
+};
+
+/**
+ Holds all the inputs of a CSSNode which can influence which rules of a CSSDocument
+ are matched. Two nodes with equal keys are guaranteed to resolve the same styles.
+ */
+struct CSSStyleSharingKey {
+    StringBox tagName;
+    StringBox nodeId;
+    StringBox cssClass;
+    // Which of the first-child, last-child and nth-child rules of the document match the node.
+    uint64_t positionSignature = 0;
+    // Resolved values of the attributes monitored by the document, in the document's order.
+    SmallVector<Value, 2> monitoredAttributeValues;
+    // The style resolved for the CSS parent, when the document has parent or ancestor rules.
+    // Since a resolved style is only shared between nodes with equal keys, its identity stands
+    // for the inputs of the parent and, transitively, of all its CSS ancestors. It is retained
+    // so that its address cannot be reused by another style while the key is alive.
+    Ref<CSSResolvedStyle> parentStyle;
+
+    size_t hash() const;
+
+    bool operator==(const CSSStyleSharingKey& other) const;
+};
+
+/**
+ A bounded cache of CSSResolvedStyle, owned by a CSSDocument. This lets sibling and cousin
+ nodes which share the same tag, classes, id, position class, monitored attributes and
+ ancestors skip the rule matching entirely.
+ */
+class CSSStyleSharingCache {
+public:
+    explicit CSSStyleSharingCache(size_t capacity);
+    ~CSSStyleSharingCache();
+
+    Ref<CSSResolvedStyle> find(const CSSStyleSharingKey& key);
+    void insert(CSSStyleSharingKey&& key, const Ref<CSSResolvedStyle>& resolvedStyle);
+
+    void clear();
+
+    size_t size() const;
+    size_t getHitsCount() const;
+    size_t getMissesCount() const;
+
+private:
+    mutable Mutex _mutex;
+    LRUCache<CSSStyleSharingKey, Ref<CSSResolvedStyle>> _entries;
+    size_t _hitsCount = 0;
+    size_t _missesCount = 0;
+};
+
+} // namespace Valdi
+
+namespace std {
+
+template<>
+struct hash<Valdi::CSSStyleSharingKey> {
+    std::size_t operator()(const Valdi::CSSStyleSharingKey& k) const;
+};
+
+} // namespace std
@@ -0,0 +1,526 @@
+//
+//  CSSStyleTable.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/CSS/CSSStyleTable.hpp"
+#include "valdi/runtime/Attributes/AttributeIds.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace Valdi {
+
+// Same limit as the default recursion limit of the protobuf parser
+constexpr size_t kMaxNestingDepth = 100;
+
+namespace {
+
+class CSSStyleTableReader {
+public:
+    CSSStyleTableReader(const Byte* data, size_t len, AttributeIds& attributeIds)
+        : _current(data), _end(data + len), _attributeIds(attributeIds) {}
+
+    Result<Void> read(CSSStyleNode& rootNode) {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if (!readWord(magic) || magic != CSSStyleTable::kMagic) {
+            return Error("Invalid style table magic");
+        }
+        if (!readWord(version) || version != CSSStyleTable::kVersion) {
+            return Error(STRING_FORMAT("Unsupported style table version {}", version));
+        }
+
+        if (!readStrings() || !readAttributes() || !readStyleNode(rootNode, 0)) {
+            return Error("Malformed style table");
+        }
+
+        if (_current != _end) {
+            return Error("Unexpected trailing data in style table");
+        }
+
+        return Void();
+    }
+
+private:
+    const Byte* _current;
+    const Byte* _end;
+    AttributeIds& _attributeIds;
+    std::vector<StringBox> _strings;
+    std::vector<CSSAttribute> _attributes;
+
+    bool readWord(uint32_t& out) {
+        if (static_cast<size_t>(_end - _current) < sizeof(uint32_t)) {
+            return false;
+        }
+        std::memcpy(&out, _current, sizeof(uint32_t));
+        _current += sizeof(uint32_t);
+        return true;
+    }
+
+    bool readCount(size_t& out) {
+        uint32_t count = 0;
+        if (!readWord(count)) {
+            return false;
+        }
+        // Every entry takes at least one word, which lets us reject corrupted
+        // counts before reserving any memory for them.
+        if (count > static_cast<size_t>(_end - _current) / sizeof(uint32_t)) {
+            return false;
+        }
+        out = static_cast<size_t>(count);
+        return true;
+    }
+
+    bool readString(StringBox& out) {
+        uint32_t index = 0;
+        if (!readWord(index) || index >= _strings.size()) {
+            return false;
+        }
+        out = _strings[index];
+        return true;
+    }
+
+    bool readAttribute(CSSAttribute& out) {
+        uint32_t index = 0;
+        if (!readWord(index) || index >= _attributes.size()) {
+            return false;
+        }
+        out = _attributes[index];
+        return true;
+    }
+
+    bool readStrings() {
+        size_t count = 0;
+        if (!readCount(count)) {
+            return false;
+        }
+
+        _strings.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t length = 0;
+            if (!readWord(length)) {
+                return false;
+            }
+            auto paddedLength = (static_cast<size_t>(length) + 3) & ~static_cast<size_t>(3);
+            if (static_cast<size_t>(_end - _current) < paddedLength) {
+                return false;
+            }
+
+            _strings.emplace_back(StringCache::getGlobal().makeString(reinterpret_cast<const char*>(_current), length));
+            _current += paddedLength;
+        }
+
+        return true;
+    }
+
+    bool readAttributes() {
+        size_t count = 0;
+        if (!readCount(count)) {
+            return false;
+        }
+
+        // Names are resolved into AttributeIds once per distinct attribute, declarations
+        // sharing the same attribute will just copy the resolved entry.
+        _attributes.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            StringBox name;
+            uint32_t type = 0;
+            uint32_t payload[2];
+            if (!readString(name) || !readWord(type) || !readWord(payload[0]) || !readWord(payload[1])) {
+                return false;
+            }
+
+            auto& attribute = _attributes.emplace_back();
+            attribute.id = _attributeIds.getIdForName(name);
+
+            switch (type) {
+                case CSSStyleTable::AttributeTypeString:
+                    if (payload[0] >= _strings.size()) {
+                        return false;
+                    }
+                    attribute.value = Value(_strings[payload[0]]);
+                    break;
+                case CSSStyleTable::AttributeTypeInt: {
+                    int64_t intValue = 0;
+                    std::memcpy(&intValue, payload, sizeof(intValue));
+                    attribute.value = Value(static_cast<int32_t>(intValue));
+                } break;
+                case CSSStyleTable::AttributeTypeDouble: {
+                    double doubleValue = 0;
+                    std::memcpy(&doubleValue, payload, sizeof(doubleValue));
+                    attribute.value = Value(doubleValue);
+                } break;
+                case CSSStyleTable::AttributeTypeNull:
+                    attribute.value = Value();
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool readStyleNode(CSSStyleNode& styleNode, size_t depth) {
+        if (depth > kMaxNestingDepth) {
+            return false;
+        }
+
+        size_t declarationsCount = 0;
+        if (!readCount(declarationsCount)) {
+            return false;
+        }
+
+        styleNode.styles.reserve(declarationsCount);
+        for (size_t i = 0; i < declarationsCount; i++) {
+            auto& declaration = styleNode.styles.emplace_back();
+            uint32_t priority = 0;
+            uint32_t id = 0;
+            if (!readAttribute(declaration.attribute) || !readWord(priority) || !readWord(id)) {
+                return false;
+            }
+            declaration.priority = static_cast<int>(priority);
+            declaration.id = static_cast<int>(id);
+            declaration.order = static_cast<int>(id);
+        }
+
+        uint32_t hasRuleIndex = 0;
+        if (!readWord(hasRuleIndex)) {
+            return false;
+        }
+        if (hasRuleIndex != 0) {
+            styleNode.ruleIndex = std::make_unique<CSSProcessedRuleIndex>();
+            return readRuleIndex(*styleNode.ruleIndex, depth + 1);
+        }
+
+        return true;
+    }
+
+    bool readMapRule(FlatMap<StringBox, CSSStyleNode>& mapRule, size_t depth) {
+        size_t count = 0;
+        if (!readCount(count)) {
+            return false;
+        }
+
+        mapRule.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            StringBox name;
+            if (!readString(name)) {
+                return false;
+            }
+            auto it = mapRule.try_emplace(std::move(name));
+            if (!readStyleNode(it.first->second, depth)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool readOptionalStyleNode(std::unique_ptr<CSSStyleNode>& styleNode, size_t depth) {
+        uint32_t present = 0;
+        if (!readWord(present)) {
+            return false;
+        }
+        if (present == 0) {
+            return true;
+        }
+        styleNode = std::make_unique<CSSStyleNode>();
+        return readStyleNode(*styleNode, depth);
+    }
+
+    bool readOptionalRuleIndex(std::unique_ptr<CSSProcessedRuleIndex>& ruleIndex, size_t depth) {
+        uint32_t present = 0;
+        if (!readWord(present)) {
+            return false;
+        }
+        if (present == 0) {
+            return true;
+        }
+        ruleIndex = std::make_unique<CSSProcessedRuleIndex>();
+        return readRuleIndex(*ruleIndex, depth + 1);
+    }
+
+    bool readRuleIndex(CSSProcessedRuleIndex& ruleIndex, size_t depth) {
+        if (depth > kMaxNestingDepth) {
+            return false;
+        }
+
+        if (!readMapRule(ruleIndex.idRules, depth) || !readMapRule(ruleIndex.classRules, depth) ||
+            !readMapRule(ruleIndex.tagRules, depth)) {
+            return false;
+        }
+
+        size_t attributeRulesCount = 0;
+        if (!readCount(attributeRulesCount)) {
+            return false;
+        }
+        ruleIndex.attributeRules.reserve(attributeRulesCount);
+        for (size_t i = 0; i < attributeRulesCount; i++) {
+            auto& attributeRule = ruleIndex.attributeRules.emplace_back();
+            uint32_t type = 0;
+            if (!readAttribute(attributeRule.attribute) || !readWord(type) ||
+                !Valdi::CSSRuleIndex_AttributeRule_Type_IsValid(static_cast<int>(type))) {
+                return false;
+            }
+            attributeRule.type = static_cast<Valdi::CSSRuleIndex_AttributeRule_Type>(type);
+            if (!readStyleNode(attributeRule.styleNode, depth)) {
+                return false;
+            }
+        }
+
+        if (!readOptionalStyleNode(ruleIndex.firstChildRule, depth) ||
+            !readOptionalStyleNode(ruleIndex.lastChildRule, depth)) {
+            return false;
+        }
+
+        size_t nthChildRulesCount = 0;
+        if (!readCount(nthChildRulesCount)) {
+            return false;
+        }
+        ruleIndex.nthChildRules.reserve(nthChildRulesCount);
+        for (size_t i = 0; i < nthChildRulesCount; i++) {
+            auto& nthChildRule = ruleIndex.nthChildRules.emplace_back();
+            uint32_t n = 0;
+            uint32_t offset = 0;
+            if (!readWord(n) || !readWord(offset)) {
+                return false;
+            }
+            nthChildRule.n = static_cast<int32_t>(n);
+            nthChildRule.offset = static_cast<int32_t>(offset);
+            if (!readStyleNode(nthChildRule.node, depth)) {
+                return false;
+            }
+        }
+
+        return readOptionalRuleIndex(ruleIndex.ancestorRules, depth) &&
+               readOptionalRuleIndex(ruleIndex.directParentRules, depth);
+    }
+};
+
+class CSSStyleTableWriter {
+public:
+    BytesView write(const Valdi::StyleNode& rootNode) {
+        collectStyleNode(rootNode);
+
+        writeWord(CSSStyleTable::kMagic);
+        writeWord(CSSStyleTable::kVersion);
+
+        writeWord(static_cast<uint32_t>(_strings.size()));
+        for (const auto* str : _strings) {
+            writeWord(static_cast<uint32_t>(str->size()));
+            _output->append(*str);
+            for (auto i = str->size(); (i % sizeof(uint32_t)) != 0; i++) {
+                _output->append(static_cast<Byte>(0));
+            }
+        }
+
+        writeWord(static_cast<uint32_t>(_attributes.size()));
+        for (const auto* attribute : _attributes) {
+            writeWord(_stringIndexes[attribute->name()]);
+
+            uint32_t payload[2] = {0, 0};
+            switch (attribute->type()) {
+                case Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_INT: {
+                    writeWord(CSSStyleTable::AttributeTypeInt);
+                    auto intValue = attribute->int_value();
+                    std::memcpy(payload, &intValue, sizeof(intValue));
+                } break;
+                case Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_DOUBLE: {
+                    writeWord(CSSStyleTable::AttributeTypeDouble);
+                    auto doubleValue = attribute->double_value();
+                    std::memcpy(payload, &doubleValue, sizeof(doubleValue));
+                } break;
+                case Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_STRING:
+                    writeWord(CSSStyleTable::AttributeTypeString);
+                    payload[0] = _stringIndexes[attribute->str_value()];
+                    break;
+                default:
+                    // Resolved to null by valueFromNodeAttribute()
+                    writeWord(CSSStyleTable::AttributeTypeNull);
+                    break;
+            }
+            writeWord(payload[0]);
+            writeWord(payload[1]);
+        }
+
+        writeStyleNode(rootNode);
+
+        return _output->toBytesView();
+    }
+
+private:
+    Ref<ByteBuffer> _output = makeShared<ByteBuffer>();
+    std::vector<const std::string*> _strings;
+    std::unordered_map<std::string, uint32_t> _stringIndexes;
+    std::vector<const Valdi::NodeAttribute*> _attributes;
+    std::unordered_map<std::string, uint32_t> _attributeIndexes;
+
+    void writeWord(uint32_t word) {
+        auto* output = _output->appendWritable(sizeof(uint32_t));
+        std::memcpy(output, &word, sizeof(uint32_t));
+    }
+
+    void collectString(const std::string& str) {
+        auto it = _stringIndexes.try_emplace(str, static_cast<uint32_t>(_strings.size()));
+        if (it.second) {
+            _strings.emplace_back(&it.first->first);
+        }
+    }
+
+    static std::string attributeKey(const Valdi::NodeAttribute& attribute) {
+        return attribute.SerializeAsString();
+    }
+
+    void collectAttribute(const Valdi::NodeAttribute& attribute) {
+        collectString(attribute.name());
+        if (attribute.type() == Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_STRING) {
+            collectString(attribute.str_value());
+        }
+
+        auto it = _attributeIndexes.try_emplace(attributeKey(attribute), static_cast<uint32_t>(_attributes.size()));
+        if (it.second) {
+            _attributes.emplace_back(&attribute);
+        }
+    }
+
+    void collectStyleNode(const Valdi::StyleNode& styleNode) {
+        for (const auto& declaration : styleNode.styles()) {
+            collectAttribute(declaration.attribute());
+        }
+        if (styleNode.has_ruleindex()) {
+            collectRuleIndex(styleNode.ruleindex());
+        }
+    }
+
+    void collectRuleIndex(const Valdi::CSSRuleIndex& ruleIndex) {
+        for (const auto* mapRule : {&ruleIndex.id_rules(), &ruleIndex.class_rules(), &ruleIndex.tag_rules()}) {
+            for (const auto& namedStyleNode : *mapRule) {
+                collectString(namedStyleNode.name());
+                collectStyleNode(namedStyleNode.node());
+            }
+        }
+        for (const auto& attributeRule : ruleIndex.attribute_rules()) {
+            collectAttribute(attributeRule.attribute());
+            collectStyleNode(attributeRule.node());
+        }
+        if (ruleIndex.has_first_child_rule()) {
+            collectStyleNode(ruleIndex.first_child_rule());
+        }
+        if (ruleIndex.has_last_child_rule()) {
+            collectStyleNode(ruleIndex.last_child_rule());
+        }
+        for (const auto& nthChildRule : ruleIndex.nth_child_rules()) {
+            collectStyleNode(nthChildRule.node());
+        }
+        if (ruleIndex.has_ancestor_rules()) {
+            collectRuleIndex(ruleIndex.ancestor_rules());
+        }
+        if (ruleIndex.has_direct_parent_rules()) {
+            collectRuleIndex(ruleIndex.direct_parent_rules());
+        }
+    }
+
+    void writeStyleNode(const Valdi::StyleNode& styleNode) {
+        writeWord(static_cast<uint32_t>(styleNode.styles_size()));
+        for (const auto& declaration : styleNode.styles()) {
+            writeWord(_attributeIndexes[attributeKey(declaration.attribute())]);
+            writeWord(static_cast<uint32_t>(declaration.priority()));
+            writeWord(static_cast<uint32_t>(declaration.id()));
+        }
+
+        writeWord(styleNode.has_ruleindex() ? 1 : 0);
+        if (styleNode.has_ruleindex()) {
+            writeRuleIndex(styleNode.ruleindex());
+        }
+    }
+
+    void writeMapRule(const google::protobuf::RepeatedPtrField<::Valdi::NamedStyleNode>& mapRule) {
+        std::vector<const Valdi::NamedStyleNode*> sortedRules;
+        sortedRules.reserve(mapRule.size());
+        for (const auto& namedStyleNode : mapRule) {
+            sortedRules.emplace_back(&namedStyleNode);
+        }
+        std::stable_sort(sortedRules.begin(), sortedRules.end(), [](const auto* left, const auto* right) {
+            return left->name() < right->name();
+        });
+
+        writeWord(static_cast<uint32_t>(sortedRules.size()));
+        for (const auto* namedStyleNode : sortedRules) {
+            writeWord(_stringIndexes[namedStyleNode->name()]);
+            writeStyleNode(namedStyleNode->node());
+        }
+    }
+
+    void writeRuleIndex(const Valdi::CSSRuleIndex& ruleIndex) {
+        writeMapRule(ruleIndex.id_rules());
+        writeMapRule(ruleIndex.class_rules());
+        writeMapRule(ruleIndex.tag_rules());
+
+        writeWord(static_cast<uint32_t>(ruleIndex.attribute_rules_size()));
+        for (const auto& attributeRule : ruleIndex.attribute_rules()) {
+            writeWord(_attributeIndexes[attributeKey(attributeRule.attribute())]);
+            writeWord(static_cast<uint32_t>(attributeRule.type()));
+            writeStyleNode(attributeRule.node());
+        }
+
+        writeWord(ruleIndex.has_first_child_rule() ? 1 : 0);
+        if (ruleIndex.has_first_child_rule()) {
+            writeStyleNode(ruleIndex.first_child_rule());
+        }
+        writeWord(ruleIndex.has_last_child_rule() ? 1 : 0);
+        if (ruleIndex.has_last_child_rule()) {
+            writeStyleNode(ruleIndex.last_child_rule());
+        }
+
+        writeWord(static_cast<uint32_t>(ruleIndex.nth_child_rules_size()));
+        for (const auto& nthChildRule : ruleIndex.nth_child_rules()) {
+            writeWord(static_cast<uint32_t>(nthChildRule.n()));
+            writeWord(static_cast<uint32_t>(nthChildRule.offset()));
+            writeStyleNode(nthChildRule.node());
+        }
+
+        writeWord(ruleIndex.has_ancestor_rules() ? 1 : 0);
+        if (ruleIndex.has_ancestor_rules()) {
+            writeRuleIndex(ruleIndex.ancestor_rules());
+        }
+        writeWord(ruleIndex.has_direct_parent_rules() ? 1 : 0);
+        if (ruleIndex.has_direct_parent_rules()) {
+            writeRuleIndex(ruleIndex.direct_parent_rules());
+        }
+    }
+};
+
+} // namespace
+
+bool CSSStyleTable::isStyleTable(const Byte* data, size_t len) {
+    if (len < sizeof(uint32_t)) {
+        return false;
+    }
+    uint32_t magic = 0;
+    std::memcpy(&magic, data, sizeof(uint32_t));
+    return magic == kMagic;
+}
+
+Result<Void> CSSStyleTable::deserialize(const Byte* data,
+                                        size_t len,
+                                        AttributeIds& attributeIds,
+                                        CSSStyleNode& rootNode) {
+    CSSStyleTableReader reader(data, len, attributeIds);
+    return reader.read(rootNode);
+}
+
+BytesView CSSStyleTable::serialize(const Valdi::StyleNode& styleNode) {
+    CSSStyleTableWriter writer;
+    return writer.write(styleNode);
+}
+
+} // namespace Valdi
@@ -0,0 +1,81 @@
+//
+//  CSSStyleTable.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/CSS/CSSDocument.hpp"
+#include "valdi/valdi.pb.h"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+
+#include <cstdint>
+
+namespace Valdi {
+
+class AttributeIds;
+
+/**
+ The style table is the compact serialization format of a CSS document emitted by the
+ compiler for .valdicss files, in place of the StyleNode protobuf. It is not queried in
+ place: it is deserialized into the CSSStyleNode tree and its FlatMap indexes like the
+ protobuf is, the matcher is unchanged. What it saves is the load cost: there is no
+ intermediate protobuf message, every string is stored and interned once in a string table,
+ every distinct attribute (name and pre-typed value) is stored and resolved once in an
+ attribute table, and the rule tree only references those tables by index.
+ Attributes with a type unknown to the writer are stored as null, which is what the
+ protobuf path resolves them to.
+
+ The table is made of 32 bits little endian words:
+   header:      magic, version
+   strings:     count, then for each string its byte length followed by its padded bytes
+   attributes:  count, then for each attribute its name index, type and two payload words
+   root node:   a style node
+
+   style node:  declarations count, then for each declaration its attribute index, priority and id,
+                followed by a presence word and a rule index
+   rule index:  id, class and tag rules as a count followed by name index and style node pairs
+                sorted by name, attribute rules as a count followed by attribute index, type and
+                style node triplets, first child and last child rules as a presence word
+                followed by a style node, nth child rules as a count followed by n, offset and
+                style node triplets, ancestor and direct parent rules as a presence word
+                followed by a rule index.
+ */
+class CSSStyleTable {
+public:
+    static constexpr uint32_t kMagic = 0x53534356; // "VCSS"
+    static constexpr uint32_t kVersion = 1;
+
+    enum AttributeType : uint32_t {
+        AttributeTypeString = 0,
+        AttributeTypeInt = 1,
+        AttributeTypeDouble = 2,
+        AttributeTypeNull = 3,
+    };
+
+    /**
+     Returns whether the given data starts with the style table header.
+     A serialized StyleNode protobuf can never start with the magic,
+     as 'V' is not a valid protobuf tag.
+     */
+    static bool isStyleTable(const Byte* data, size_t len);
+
+    /**
+     Populate the given root node from a serialized style table.
+     */
+    static Result<Void> deserialize(const Byte* data,
+                                    size_t len,
+                                    AttributeIds& attributeIds,
+                                    CSSStyleNode& rootNode);
+
+    /**
+     Serialize the given StyleNode into a style table.
+     This is the same encoding than the one the compiler uses.
+     */
+    static BytesView serialize(const Valdi::StyleNode& styleNode);
+};
+
+} // namespace Valdi
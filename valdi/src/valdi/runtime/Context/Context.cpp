@@ -13,9 +13,11 @@
 #include "valdi/runtime/Context/ViewManagerContext.hpp"
 #include "valdi/runtime/Metrics/Metrics.hpp"
 #include "valdi/runtime/Rendering/RenderRequest.hpp"
+#include "valdi/runtime/Rendering/RenderRequestCoalescer.hpp"
 #include "valdi/runtime/Runtime.hpp"
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
 #include "valdi_core/cpp/Utils/ContainerUtils.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/ValueFunction.hpp"
 #include <algorithm>
@@ -277,12 +279,39 @@ bool Context::runRenderRequest(ContextUpdateId updateId) {
 }
 
 void Context::runNextPendingRenderRequest(std::unique_lock<Mutex>& guard) {
-    auto pendingRenderRequest = _pendingRenderRequests.front();
-    _pendingRenderRequests.pop_front();
+    // All the requests that are pending at this point were submitted within the same
+    // frame window, we merge them so that they are applied and laid out in one pass.
+    std::vector<Ref<RenderRequest>> renderRequests;
+    SmallVector<ContextUpdateId, 4> updateIds;
+    renderRequests.reserve(_pendingRenderRequests.size());
+    for (const auto& pendingRenderRequest : _pendingRenderRequests) {
+        renderRequests.emplace_back(pendingRenderRequest.renderRequest);
+        updateIds.emplace_back(pendingRenderRequest.updateId);
+    }
+    _pendingRenderRequests.clear();
+
     Ref<Runtime> runtime(_runtime);
     guard.unlock();
-    runtime->processRenderRequest(pendingRenderRequest.renderRequest);
-    markUpdateCompleted(pendingRenderRequest.updateId, guard);
+
+    RenderRequestCoalescingStats stats;
+    auto renderRequest = RenderRequestCoalescer::coalesce(renderRequests, stats);
+    renderRequests.clear();
+
+    if (stats.requestsCount > 1) {
+        const auto& metrics = runtime->getMetrics();
+        if (metrics != nullptr) {
+            metrics->emitRenderRequestsCoalesced(getPath().getResourceId().bundleName,
+                                                 stats.requestsCount,
+                                                 stats.entriesCount,
+                                                 stats.mergedEntriesCount);
+        }
+    }
+
+    runtime->processRenderRequest(renderRequest);
+
+    for (auto updateId : updateIds) {
+        markUpdateCompleted(updateId, guard);
+    }
 }
 
 bool Context::flushRenderRequests() {
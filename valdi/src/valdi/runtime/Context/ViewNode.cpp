@@ -22,6 +22,7 @@
 #include "valdi/runtime/Interfaces/IViewTransaction.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
 #include "valdi/runtime/Views/MeasureDelegate.hpp"
+#include "valdi/runtime/Views/PendingView.hpp"
 #include "valdi/runtime/Views/ViewTransactionScope.hpp"
 #include "valdi_core/cpp/Constants.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
@@ -36,6 +37,7 @@
 #include "utils/debugging/Assert.hpp"
 #include "utils/time/StopWatch.hpp"
 #include "valdi_core/cpp/Utils/ContainerUtils.hpp"
+#include <algorithm>
 #include <cmath>
 #include <fmt/format.h>
 #include <sstream>
@@ -124,6 +126,7 @@ constexpr size_t kLimitToViewportDisabledFlag = 14;
 constexpr size_t kHasChildWithZIndex = 15;
 constexpr size_t kAnimationsEnabled = 16;
 constexpr size_t kHasParent = 17;
+constexpr size_t kCSSChildrenNeedUpdate = 18;
 constexpr size_t kShouldReceiveVisibilityUpdates = 19;
 constexpr size_t kCSSNeedsUpdate = 20;
 constexpr size_t kCSSHasChildNeedsUpdate = 21;
@@ -135,6 +138,10 @@ constexpr size_t kHasChildWithAccessibilityId = 26;
 constexpr size_t kCanAlwaysScrollHorizontal = 27;
 constexpr size_t kCanAlwaysScrollVertical = 28;
 constexpr size_t kAccessibilityTreeNeedsUpdate = 29;
+constexpr size_t kCSSDescendantsNeedUpdate = 30;
+constexpr size_t kPrefetchLazyLayoutFlag = 31;
+constexpr size_t kViewsPrefetchedFlag = 32;
+constexpr size_t kPendingViewFailedFlag = 33;
 
 ViewNode::ViewNode(YGConfig* yogaConfig, AttributeIds& attributeIds, ILogger& logger)
     : _yogaNode(yogaConfig != nullptr ? Yoga::createNode(yogaConfig) : nullptr),
@@ -308,7 +315,22 @@ bool ViewNode::createView(ViewTransactionScope& viewTransactionScope, const Ref<
         return false;
     }
 
-    auto view = _viewFactory->createView(_viewNodeTree, this, true);
+    Ref<View> view;
+    if (_viewNodeTree->defersViewCreationToMainThread()) {
+        // Only pooled views can be used outside of the main thread, the missing ones
+        // are created by the main thread when it applies the operations of this pass.
+        view = _viewFactory->dequeueViewFromPool();
+        if (view == nullptr) {
+            if (_flags[kPendingViewFailedFlag]) {
+                // The last attempt could not create the view, try again on the next update
+                _flags[kPendingViewFailedFlag] = false;
+                return false;
+            }
+            view = _viewNodeTree->makePendingView(_viewFactory, *this);
+        }
+    } else {
+        view = _viewFactory->createView(_viewNodeTree, this, true);
+    }
 
     if (view != nullptr) {
         viewTransactionScope.transaction().moveViewToTree(view, _viewNodeTree, this);
@@ -347,6 +369,24 @@ void ViewNode::setViewTreeNeedsUpdate() {
     }
 }
 
+void ViewNode::replacePendingView(ViewTransactionScope& viewTransactionScope, PendingView& pendingView) {
+    if (_view.get() != &pendingView) {
+        // The view was removed or replaced since it was requested
+        return;
+    }
+
+    const auto& view = pendingView.getView();
+    if (view != nullptr) {
+        // The operations which referenced the PendingView were applied on the created view
+        _view = view;
+        return;
+    }
+
+    _flags[kPendingViewFailedFlag] = true;
+    setView(viewTransactionScope, nullptr, nullptr);
+    setViewTreeNeedsUpdate();
+}
+
 const SharedAnimator& ViewNode::resolveAnimator(const SharedAnimator& parentAnimator) const {
     if (!isAnimationsEnabled()) {
         return nullAnimator();
@@ -371,6 +411,60 @@ void ViewNode::onFinishedAnimating() {
     }
 }
 
+// Views which are further from the viewport than the current max distance are created
+// in batches of this size, nearest first.
+constexpr size_t kViewCreationBatchSize = 8;
+
+// A node owning a view with deferred views in its children, along with the state
+// needed to visit its children again without restarting from the root.
+struct PendingViewParent {
+    Ref<ViewNode> viewNode;
+    bool visibleInViewport = false;
+    bool limitToViewportEnabled = false;
+    SharedAnimator animator;
+    bool hasDeferredChildren = false;
+};
+
+struct ViewCreationBudget {
+    snap::utils::time::StopWatch stopWatch;
+    int64_t budgetUs = 0;
+    Frame viewport;
+    float maxDistance = 0;
+    bool createdView = false;
+    std::vector<float> deferredDistances;
+    PendingViewParent* currentViewParent = nullptr;
+    std::vector<PendingViewParent> pendingViewParents;
+
+    bool isExhausted() const {
+        // At least one view is created per update so that the view tree always makes progress
+        return createdView && stopWatch.elapsedUs() >= budgetUs;
+    }
+};
+
+static float distanceToViewport(const Frame& frame, const Frame& viewport) {
+    auto distanceX = std::max({viewport.getLeft() - frame.getRight(), frame.getLeft() - viewport.getRight(), 0.0f});
+    auto distanceY = std::max({viewport.getTop() - frame.getBottom(), frame.getTop() - viewport.getBottom(), 0.0f});
+    return std::max(distanceX, distanceY);
+}
+
+bool ViewNode::shouldDeferViewCreation(ViewCreationBudget& viewCreationBudget) const {
+    auto distance = distanceToViewport(computeVisualFrameInRoot(), viewCreationBudget.viewport);
+    if (distance <= 0.0f) {
+        // Views intersecting the viewport are never deferred
+        return false;
+    }
+
+    if (distance > viewCreationBudget.maxDistance || viewCreationBudget.isExhausted()) {
+        viewCreationBudget.deferredDistances.emplace_back(distance);
+        if (viewCreationBudget.currentViewParent != nullptr) {
+            viewCreationBudget.currentViewParent->hasDeferredChildren = true;
+        }
+        return true;
+    }
+
+    return false;
+}
+
 void ViewNode::doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
                                 const Ref<View>& currentParentView,
                                 bool parentVisibleInViewport,
@@ -378,6 +472,7 @@ void ViewNode::doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
                                 bool parentViewChanged,
                                 bool viewInflationEnabled,
                                 const SharedAnimator& parentAnimator,
+                                ViewCreationBudget* viewCreationBudget,
                                 ViewNodeUpdateViewTreeResult& updateResult,
                                 int* currentViewIndex,
                                 int* viewsCount) {
@@ -451,6 +546,7 @@ void ViewNode::doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
                                                     parentViewChanged,
                                                     viewInflationEnabled,
                                                     animator,
+                                                    viewCreationBudget,
                                                     updateResult,
                                                     currentViewIndex,
                                                     viewsCount);
@@ -464,6 +560,7 @@ void ViewNode::doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
                                                     parentViewChanged,
                                                     viewInflationEnabled,
                                                     animator,
+                                                    viewCreationBudget,
                                                     updateResult,
                                                     currentViewIndex,
                                                     viewsCount);
@@ -477,11 +574,22 @@ void ViewNode::doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
             *viewsCount += _numberOfViewChildren;
         }
     } else {
+        if (needView && viewCreationBudget != nullptr && !hasView() && shouldDeferViewCreation(*viewCreationBudget)) {
+            // The view and its subtree are created in a later pass, the space of the view
+            // stays empty in the meantime.
+            updateResult.deferredViews++;
+            setViewTreeNeedsUpdate();
+            return;
+        }
+
         bool viewChanged = false;
         if (needView) {
             if (createView(viewTransactionScope, animator)) {
                 viewChanged = true;
                 updateResult.createdViews++;
+                if (viewCreationBudget != nullptr) {
+                    viewCreationBudget->createdView = true;
+                }
             }
 
             if (parentViewChanged && _flags[kViewIncludedInParentFlag] && currentParentView == nullptr) {
@@ -514,39 +622,77 @@ void ViewNode::doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
         }
 
         if (needUpdate || viewChanged) {
-            int viewIndex = 0;
-            int viewsCount = 0;
+            updateChildrenViewTree(viewTransactionScope,
+                                   visibleInViewport,
+                                   limitToViewportEnabled,
+                                   viewChanged,
+                                   viewInflationEnabled,
+                                   animator,
+                                   viewCreationBudget,
+                                   updateResult);
+        }
+    }
+}
 
-            if (hasChildWithZIndex()) {
-                auto children = sortChildrenByZIndex();
-                for (ViewNode* childViewNode : *children) {
-                    childViewNode->doUpdateViewTree(viewTransactionScope,
-                                                    _view,
-                                                    visibleInViewport,
-                                                    limitToViewportEnabled,
-                                                    viewChanged,
-                                                    viewInflationEnabled,
-                                                    animator,
-                                                    updateResult,
-                                                    &viewIndex,
-                                                    &viewsCount);
-                }
-            } else {
-                for (ViewNode* childViewNode : *this) {
-                    childViewNode->doUpdateViewTree(viewTransactionScope,
-                                                    _view,
-                                                    visibleInViewport,
-                                                    limitToViewportEnabled,
-                                                    viewChanged,
-                                                    viewInflationEnabled,
-                                                    animator,
-                                                    updateResult,
-                                                    &viewIndex,
-                                                    &viewsCount);
-                }
-            }
-            _numberOfViewChildrenInsertedInTree = viewIndex;
-            _numberOfViewChildren = viewsCount;
+void ViewNode::updateChildrenViewTree(ViewTransactionScope& viewTransactionScope,
+                                      bool visibleInViewport,
+                                      bool limitToViewportEnabled,
+                                      bool viewChanged,
+                                      bool viewInflationEnabled,
+                                      const SharedAnimator& animator,
+                                      ViewCreationBudget* viewCreationBudget,
+                                      ViewNodeUpdateViewTreeResult& updateResult) {
+    int viewIndex = 0;
+    int viewsCount = 0;
+
+    PendingViewParent* previousViewParent = nullptr;
+    PendingViewParent viewParent;
+    if (viewCreationBudget != nullptr) {
+        previousViewParent = viewCreationBudget->currentViewParent;
+        viewParent.visibleInViewport = visibleInViewport;
+        viewParent.limitToViewportEnabled = limitToViewportEnabled;
+        viewParent.animator = animator;
+        viewCreationBudget->currentViewParent = &viewParent;
+    }
+
+    if (hasChildWithZIndex()) {
+        auto children = sortChildrenByZIndex();
+        for (ViewNode* childViewNode : *children) {
+            childViewNode->doUpdateViewTree(viewTransactionScope,
+                                            _view,
+                                            visibleInViewport,
+                                            limitToViewportEnabled,
+                                            viewChanged,
+                                            viewInflationEnabled,
+                                            animator,
+                                            viewCreationBudget,
+                                            updateResult,
+                                            &viewIndex,
+                                            &viewsCount);
+        }
+    } else {
+        for (ViewNode* childViewNode : *this) {
+            childViewNode->doUpdateViewTree(viewTransactionScope,
+                                            _view,
+                                            visibleInViewport,
+                                            limitToViewportEnabled,
+                                            viewChanged,
+                                            viewInflationEnabled,
+                                            animator,
+                                            viewCreationBudget,
+                                            updateResult,
+                                            &viewIndex,
+                                            &viewsCount);
+        }
+    }
+    _numberOfViewChildrenInsertedInTree = viewIndex;
+    _numberOfViewChildren = viewsCount;
+
+    if (viewCreationBudget != nullptr) {
+        viewCreationBudget->currentViewParent = previousViewParent;
+        if (viewParent.hasDeferredChildren) {
+            viewParent.viewNode = strongSmallRef(this);
+            viewCreationBudget->pendingViewParents.emplace_back(std::move(viewParent));
         }
     }
 }
@@ -587,6 +733,15 @@ ViewNodeUpdateViewTreeResult ViewNode::updateViewTree(ViewTransactionScope& view
 
     auto viewInflationEnabled = _viewNodeTree == nullptr || _viewNodeTree->isViewInflationEnabled();
 
+    std::unique_ptr<ViewCreationBudget> viewCreationBudget;
+    if (_viewNodeTree != nullptr && _viewNodeTree->getViewCreationBudgetUs() > 0) {
+        viewCreationBudget = std::make_unique<ViewCreationBudget>();
+        viewCreationBudget->stopWatch.start();
+        viewCreationBudget->budgetUs = _viewNodeTree->getViewCreationBudgetUs();
+        viewCreationBudget->viewport = _viewNodeTree->getViewport().value_or(
+            Frame(0, 0, getCalculatedFrame().width, getCalculatedFrame().height));
+    }
+
     doUpdateViewTree(viewTransactionScope,
                      nullptr,
                      /* parentVisibleInViewport */ true,
@@ -594,20 +749,50 @@ ViewNodeUpdateViewTreeResult ViewNode::updateViewTree(ViewTransactionScope& view
                      false,
                      viewInflationEnabled,
                      nullptr,
+                     viewCreationBudget.get(),
                      updateResult,
                      &viewIndex,
                      &viewsCount);
 
+    while (viewCreationBudget != nullptr && !viewCreationBudget->deferredDistances.empty() &&
+           !viewCreationBudget->isExhausted()) {
+        // Allow the next batch of nearest views to be created
+        auto& deferredDistances = viewCreationBudget->deferredDistances;
+        auto batchEnd = deferredDistances.begin() +
+                        static_cast<std::ptrdiff_t>(std::min(kViewCreationBatchSize, deferredDistances.size()) - 1);
+        std::nth_element(deferredDistances.begin(), batchEnd, deferredDistances.end());
+        viewCreationBudget->maxDistance = *batchEnd;
+        deferredDistances.clear();
+        updateResult.deferredViews = 0;
+
+        // Only the children of the views which deferred some of their children are visited again.
+        // Their ancestors keep their view tree dirty flag until the next update.
+        auto pendingViewParents = std::move(viewCreationBudget->pendingViewParents);
+        viewCreationBudget->pendingViewParents.clear();
+        for (auto& pendingViewParent : pendingViewParents) {
+            pendingViewParent.viewNode->_flags[kViewTreeNeedsUpdateFlag] = false;
+            pendingViewParent.viewNode->updateChildrenViewTree(viewTransactionScope,
+                                                               pendingViewParent.visibleInViewport,
+                                                               pendingViewParent.limitToViewportEnabled,
+                                                               /* viewChanged */ false,
+                                                               viewInflationEnabled,
+                                                               pendingViewParent.animator,
+                                                               viewCreationBudget.get(),
+                                                               updateResult);
+        }
+    }
+
     if (updateResult.visitedNodes > 0 && Valdi::traceRenderingPerformance) {
         VALDI_INFO(getLogger(),
                    "Update view tree: visited {} nodes in {}, total {} nodes, created {} views, destroyed {} views, "
-                   "reinserted {} views",
+                   "reinserted {} views, deferred {} views",
                    updateResult.visitedNodes,
                    sw.elapsed(),
                    getRecursiveChildCount(),
                    updateResult.createdViews,
                    updateResult.destroyedViews,
-                   updateResult.reinsertedViews);
+                   updateResult.reinsertedViews,
+                   updateResult.deferredViews);
     }
 
     return updateResult;
@@ -636,6 +821,10 @@ void ViewNode::updateVisibilityAndPerformUpdates(ViewTransactionScope& viewTrans
 
     auto visibilityChanged = false;
 
+    if (_viewNodeTree != nullptr) {
+        _viewNodeTree->beginLazyLayoutPrefetchPass();
+    }
+
     while (true) {
         VALDI_TRACE("Valdi.updateVisibility");
         int visitedNodes = 0;
@@ -655,6 +844,10 @@ void ViewNode::updateVisibilityAndPerformUpdates(ViewTransactionScope& viewTrans
         }
     }
 
+    if (_viewNodeTree != nullptr) {
+        _viewNodeTree->endLazyLayoutPrefetchPass();
+    }
+
     updateViewTree(viewTransactionScope);
 
     if (visibilityChanged) {
@@ -751,6 +944,10 @@ bool ViewNode::doUpdateVisibility(const Valdi::Frame& viewport,
                     getCalculatedViewport(), viewportChanged, isVisible, visitedNodes);
             };
         }
+
+        if (isVisible && _scrollState != nullptr && _scrollState->isPrefetchEnabled()) {
+            prefetchChildrenInScrollDirection();
+        }
     }
 
     _flags[kCalculatedViewportNeedsUpdateFlag] = false;
@@ -892,6 +1089,10 @@ std::optional<Point> ViewNode::onScroll(const Point& directionDependentContentOf
     auto backendString = getBackendString(getBackend(_viewNodeTree));
     auto metrics = Metrics::scopedOnScrollLatency(getMetrics(), getModuleName(), backendString);
 
+    if (_viewNodeTree != nullptr) {
+        _viewNodeTree->notifyUserInteraction();
+    }
+
     auto& scrollState = getOrCreateScrollState();
 
     if (!scrollState.updateDirectionDependentContentOffset(directionDependentContentOffset,
@@ -899,6 +1100,10 @@ std::optional<Point> ViewNode::onScroll(const Point& directionDependentContentOf
         return std::nullopt;
     }
 
+    // The velocity reported by the platform is only available while the user is dragging,
+    // the content offsets are used instead so that flings are accounted for.
+    scrollState.updateVelocity(scrollState.getDirectionAgnosticContentOffset(), std::chrono::steady_clock::now());
+
     auto directionAgnosticVelocity =
         directionAgnosticVelocityFromDirectionDependentVelocity(directionDependentVelocity);
     handleOnScroll(
@@ -944,6 +1149,10 @@ void ViewNode::onDragStart(const Point& directionDependentContentOffset,
         return;
     }
 
+    if (_viewNodeTree != nullptr) {
+        _viewNodeTree->notifyUserInteraction();
+    }
+
     auto& scrollState = getOrCreateScrollState();
 
     auto directionAgnosticVelocity =
@@ -1074,6 +1283,10 @@ bool ViewNode::setVisibleInViewport(bool visibleInViewport) {
         if (visibleInViewport && _flags[kIsLazyLayoutFlag]) {
             scheduleLazyLayout();
         }
+        if (visibleInViewport) {
+            // The view will be created for real, further prefetches can request it again
+            _flags[kViewsPrefetchedFlag] = false;
+        }
 
         setViewTreeNeedsUpdate();
 
@@ -1353,7 +1566,9 @@ void ViewNode::insertChildAt(ViewTransactionScope& viewTransactionScope, const R
     child->getCSSAttributesManager().setParent(&getCSSAttributesManager());
 
     if (child->getCSSAttributesManager().needUpdateCSS()) {
-        child->setCSSNeedsUpdate();
+        // The ancestors of the child might have changed, which can impact
+        // the ancestor rules of its whole subtree.
+        child->invalidateCSS(CSSInvalidationSelf | CSSInvalidationDescendants);
     }
     if (child->cssNeedsUpdate()) {
         setCSSHasChildNeedsUpdate();
@@ -1440,7 +1655,7 @@ Ref<ViewNode> ViewNode::makePlaceholderViewNode(ViewTransactionScope& viewTransa
     viewNode->setViewNodeTree(_viewNodeTree);
     viewNode->setViewFactory(viewTransactionScope, _viewFactory);
     viewNode->_emittingViewNode = strongSmallRef(this);
-    viewNode->_cssAttributesManager.copyCSSDocument(_cssAttributesManager);
+    viewNode->handleCSSChange(viewNode->_cssAttributesManager.copyCSSDocument(_cssAttributesManager));
     placeholderView->setCanBeReused(false);
 
     _attributesApplier.copyViewLayoutAttributes(viewNode->_attributesApplier);
@@ -2231,6 +2446,93 @@ bool ViewNode::updateCalculatedFrame(float viewOffsetX,
     return true;
 }
 
+bool ViewNode::updatePrefetchedLazyLayout() {
+    if (_viewNodeTree == nullptr) {
+        _flags[kPrefetchLazyLayoutFlag] = false;
+        return updateLazyLayout();
+    }
+
+    if (!_viewNodeTree->canPrefetchLazyLayout()) {
+        // Out of budget for this pass, the flag is kept so that the prefetch resumes on the next one
+        _viewNodeTree->deferLazyLayoutPrefetch(*this);
+        return false;
+    }
+
+    _flags[kPrefetchLazyLayoutFlag] = false;
+
+    _viewNodeTree->beginLazyLayoutPrefetch();
+    auto updated = updateLazyLayout();
+    _viewNodeTree->endLazyLayoutPrefetch();
+
+    return updated;
+}
+
+bool ViewNode::lazyLayoutNeedsCalculation() const {
+    return _lazyLayoutData != nullptr && _lazyLayoutData->yogaNode != nullptr &&
+           (_lazyLayoutData->yogaNode->isDirty() || _lazyLayoutData->availableWidth != _calculatedFrame.width ||
+            _lazyLayoutData->availableHeight != _calculatedFrame.height);
+}
+
+void ViewNode::prefetchChildrenInScrollDirection() {
+    const auto& viewport = getCalculatedViewport();
+    auto prefetchViewport = _scrollState->resolvePrefetchViewport(viewport);
+    if (prefetchViewport == viewport) {
+        return;
+    }
+
+    auto prefetchViews = _scrollState->prefetchesViews();
+
+    if (_childrenIndexer != nullptr) {
+        // Only the children next to the visible ones in the scroll direction are considered
+        auto children = _childrenIndexer->findChildrenAroundVisibleBounds(prefetchViewport);
+        for (auto* childViewNode : *children) {
+            if (!childViewNode->isVisibleInViewport() &&
+                childViewNode->calculateSelfViewport().intersects(prefetchViewport)) {
+                childViewNode->prefetchLazyLayout(prefetchViews);
+            }
+        }
+    } else {
+        // Without childrenIndexer, there are few enough children to go over all of them
+        for (ViewNode* childViewNode : *this) {
+            if (!childViewNode->isVisibleInViewport() &&
+                childViewNode->calculateSelfViewport().intersects(prefetchViewport)) {
+                childViewNode->prefetchLazyLayout(prefetchViews);
+            }
+        }
+    }
+}
+
+void ViewNode::prefetchLazyLayout(bool prefetchViews) {
+    if (isVisibleInViewport()) {
+        return;
+    }
+
+    if (_flags[kIsLazyLayoutFlag] && lazyLayoutNeedsCalculation()) {
+        // The children only have a frame once the lazy layout was calculated,
+        // they will be prefetched on a subsequent scroll event.
+        if (!_flags[kPrefetchLazyLayoutFlag]) {
+            _flags[kPrefetchLazyLayoutFlag] = true;
+            scheduleLazyLayout();
+        }
+        return;
+    }
+
+    if (prefetchViews && !_flags[kViewsPrefetchedFlag] && !isLayout() && _viewNodeTree != nullptr) {
+        _flags[kViewsPrefetchedFlag] = true;
+        _viewNodeTree->prefetchView(getViewClassName());
+    }
+
+    for (ViewNode* childViewNode : *this) {
+        childViewNode->prefetchLazyLayout(prefetchViews);
+    }
+}
+
+void ViewNode::resumeLazyLayoutPrefetch() {
+    if (_flags[kPrefetchLazyLayoutFlag] && !isVisibleInViewport()) {
+        scheduleLazyLayout();
+    }
+}
+
 bool ViewNode::updateLazyLayout() {
     // Using lazy-layout creates a new "detached" yoga subtree, so the device-level RTL/LTR style that
     // we set on the root node doesn't propagate to that detached subtree.
@@ -2367,10 +2669,20 @@ void ViewNode::layoutFinished(ViewTransactionScope& viewTransactionScope,
         shouldVisitChildren = true;
     }
 
-    // Step 3: If we are a lazyLayout, we compute the nested layout if we are visible
+    // Step 3: If we are a lazyLayout, we compute the nested layout if we are visible,
+    // or if we are about to become visible from a scroll
+
+    if (_flags[kIsLazyLayoutFlag] && getLazyLayoutYogaNode() != nullptr &&
+        (_flags[kVisibleInViewportFlag] || _flags[kPrefetchLazyLayoutFlag])) {
+        auto updated = false;
+        if (_flags[kVisibleInViewportFlag]) {
+            _flags[kPrefetchLazyLayoutFlag] = false;
+            updated = updateLazyLayout();
+        } else {
+            updated = updatePrefetchedLazyLayout();
+        }
 
-    if (_flags[kIsLazyLayoutFlag] && getLazyLayoutYogaNode() != nullptr && _flags[kVisibleInViewportFlag]) {
-        if (updateLazyLayout()) {
+        if (updated) {
             didPerformLayoutForChildren = true;
             shouldVisitChildren = true;
         } else {
@@ -2518,7 +2830,7 @@ void ViewNode::applyFrame(ViewTransactionScope& viewTransactionScope,
 
 bool ViewNode::handleCSSChange(bool cssChanged) {
     if (cssChanged) {
-        setCSSNeedsUpdate();
+        invalidateCSS(_cssAttributesManager.consumeInvalidation());
     }
     return cssChanged;
 }
@@ -2560,11 +2872,20 @@ bool ViewNode::setAttribute(ViewTransactionScope& viewTransactionScope,
         setPrefersLazyLayout(viewTransactionScope, attributeValue.toBool());
         return true;
     } else {
+        if (!_cssAttributesManager.isMonitoredAttribute(attributeId)) {
+            return getAttributesApplier().setAttribute(
+                viewTransactionScope, attributeId, attributeOwner, attributeValue, animator);
+        }
+
+        // The attribute is used by attribute selectors, we need to know whether
+        // the resolved value moved in or out of a selector's value.
+        auto previousValue = getAttributesApplier().getResolvedAttributeValue(attributeId);
         auto changed = getAttributesApplier().setAttribute(
             viewTransactionScope, attributeId, attributeOwner, attributeValue, animator);
 
         if (changed) {
-            handleCSSChange(_cssAttributesManager.attributeChanged(attributeId));
+            handleCSSChange(_cssAttributesManager.attributeChanged(
+                attributeId, previousValue, getAttributesApplier().getResolvedAttributeValue(attributeId)));
         }
 
         return changed;
@@ -2861,6 +3182,20 @@ void ViewNode::setCSSNeedsUpdate() {
     }
 }
 
+void ViewNode::invalidateCSS(CSSInvalidation invalidation) {
+    if ((invalidation & CSSInvalidationSelf) != 0) {
+        setCSSNeedsUpdate();
+    }
+    if ((invalidation & CSSInvalidationChildren) != 0 && !_flags[kCSSChildrenNeedUpdate]) {
+        _flags[kCSSChildrenNeedUpdate] = true;
+        setCSSHasChildNeedsUpdate();
+    }
+    if ((invalidation & CSSInvalidationDescendants) != 0 && !_flags[kCSSDescendantsNeedUpdate]) {
+        _flags[kCSSDescendantsNeedUpdate] = true;
+        setCSSHasChildNeedsUpdate();
+    }
+}
+
 void ViewNode::setCSSHasChildNeedsUpdate() {
     if (!_flags[kCSSHasChildNeedsUpdate]) {
         _flags[kCSSHasChildNeedsUpdate] = true;
@@ -2873,7 +3208,8 @@ void ViewNode::setCSSHasChildNeedsUpdate() {
 
 void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope,
                          const Ref<Animator>& animator,
-                         bool force,
+                         CSSInvalidation forcedInvalidation,
+                         const CSSAttributesManager* invalidatingCSSParent,
                          int siblingsCount,
                          int indexAmongSiblings,
                          CSSUpdateResult& updateResult) {
@@ -2881,8 +3217,34 @@ void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope,
 
     handleCSSChange(getCSSAttributesManager().setSiblingsIndexes(siblingsCount, indexAmongSiblings));
 
-    auto needUpdateSelf = force || _flags[kCSSNeedsUpdate];
-    auto needUpdateChildren = needUpdateSelf || _flags[kCSSHasChildNeedsUpdate];
+    auto needUpdateSelf = (forcedInvalidation & CSSInvalidationSelf) != 0 || _flags[kCSSNeedsUpdate];
+
+    // Resolve which of the children need to be matched again, either because
+    // our parent asked for our whole subtree, or because one of our inputs
+    // is used by a parent or ancestor selector.
+    auto childrenInvalidation = CSSInvalidationNone;
+    const CSSAttributesManager* childrenInvalidatingCSSParent = nullptr;
+    if ((forcedInvalidation & CSSInvalidationDescendants) != 0 || _flags[kCSSDescendantsNeedUpdate]) {
+        childrenInvalidation = CSSInvalidationSelf | CSSInvalidationDescendants;
+    } else if (_flags[kCSSChildrenNeedUpdate]) {
+        childrenInvalidation = CSSInvalidationSelf;
+        childrenInvalidatingCSSParent = &getCSSAttributesManager();
+    }
+    if ((forcedInvalidation & CSSInvalidationSelf) != 0 && invalidatingCSSParent != nullptr &&
+        !getCSSAttributesManager().hasCSSDocumentsOf(*invalidatingCSSParent)) {
+        // Our children can resolve their CSS parent past us when we don't share its document,
+        // so an invalidation coming from that parent has to reach them as well.
+        if (childrenInvalidation == CSSInvalidationNone) {
+            childrenInvalidation = CSSInvalidationSelf;
+            childrenInvalidatingCSSParent = invalidatingCSSParent;
+        } else if ((childrenInvalidation & CSSInvalidationDescendants) == 0) {
+            // Both us and a CSS parent past us invalidated our children, match the whole subtree again.
+            childrenInvalidation |= CSSInvalidationDescendants;
+            childrenInvalidatingCSSParent = nullptr;
+        }
+    }
+
+    auto needUpdateChildren = childrenInvalidation != CSSInvalidationNone || _flags[kCSSHasChildNeedsUpdate];
 
     if (needUpdateSelf) {
         updateResult.updatedNodes++;
@@ -2895,15 +3257,32 @@ void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope,
         auto childCount = static_cast<int>(getChildCount());
         int index = 0;
         for (auto* childViewNode : *this) {
-            childViewNode->updateCSS(viewTransactionScope, animator, needUpdateSelf, childCount, index, updateResult);
+            childViewNode->updateCSS(viewTransactionScope,
+                                     animator,
+                                     childrenInvalidation,
+                                     childrenInvalidatingCSSParent,
+                                     childCount,
+                                     index,
+                                     updateResult);
             index++;
         }
     }
 
     _flags[kCSSNeedsUpdate] = false;
+    _flags[kCSSChildrenNeedUpdate] = false;
+    _flags[kCSSDescendantsNeedUpdate] = false;
     _flags[kCSSHasChildNeedsUpdate] = false;
 }
 
+void ViewNode::resetCssSubtree() {
+    _cssAttributesManager.resetResolvedStyles();
+    setCSSNeedsUpdate();
+
+    for (auto* childViewNode : *this) {
+        childViewNode->resetCssSubtree();
+    }
+}
+
 void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope, const Ref<Animator>& animator) {
     snap::utils::time::StopWatch sw;
     sw.start();
@@ -2913,7 +3292,7 @@ void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope, const Ref<A
     CSSUpdateResult updateResult;
     std::memset(&updateResult, 0, sizeof(updateResult));
 
-    getRoot()->updateCSS(viewTransactionScope, animator, false, 0, 0, updateResult);
+    getRoot()->updateCSS(viewTransactionScope, animator, CSSInvalidationNone, nullptr, 0, 0, updateResult);
 
     if (updateResult.updatedNodes > 0 && Valdi::traceRenderingPerformance) {
         VALDI_INFO(getLogger(),
@@ -2992,6 +3371,14 @@ void ViewNode::setViewportExtensionRight(float viewportExtensionRight) {
     updateViewportExtension([&](auto& scrollState) { scrollState.setViewportExtensionRight(viewportExtensionRight); });
 }
 
+void ViewNode::setScrollPrefetchLookahead(float prefetchLookahead) {
+    updateViewportExtension([&](auto& scrollState) { scrollState.setPrefetchLookahead(prefetchLookahead); });
+}
+
+void ViewNode::setScrollPrefetchViews(bool prefetchViews) {
+    updateViewportExtension([&](auto& scrollState) { scrollState.setPrefetchViews(prefetchViews); });
+}
+
 ViewNodeAccessibilityState& ViewNode::getOrCreateAccessibilityState() {
     if (_accessibilityState == nullptr) {
         _accessibilityState = std::make_unique<ViewNodeAccessibilityState>(_attributesApplier);
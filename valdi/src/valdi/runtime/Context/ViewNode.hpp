@@ -35,6 +35,7 @@ class ViewNode;
 class ViewNodeChildrenIndexer;
 class ViewFactory;
 class View;
+class PendingView;
 class IViewNodeAssetHandler;
 
 using SharedViewNode = Ref<ViewNode>;
@@ -92,6 +93,8 @@ struct ViewNodeUpdateViewTreeResult {
     int reinsertedViews = 0;
     int destroyedViews = 0;
     int createdViews = 0;
+    // Views left to be created by a later update, when a view creation budget is set
+    int deferredViews = 0;
 
     ViewNodeUpdateViewTreeResult() = default;
     constexpr ViewNodeUpdateViewTreeResult(int visitedNodes, int reinsertedViews, int destroyedViews, int createdViews)
@@ -108,6 +111,7 @@ struct CSSUpdateResult {
 
 class ViewNodeScrollState;
 class ViewNodeAccessibilityState;
+struct ViewCreationBudget;
 
 class ViewNodeViewStats;
 
@@ -273,6 +277,12 @@ public:
     void setView(ViewTransactionScope& viewTransactionScope, const Ref<View>& view, const Ref<Animator>& animator);
     bool removeView(ViewTransactionScope& viewTransactionScope);
 
+    /**
+     * Swaps the given PendingView for the view that the main thread commit created from it,
+     * if the ViewNode still uses it.
+     */
+    void replacePendingView(ViewTransactionScope& viewTransactionScope, PendingView& pendingView);
+
     const StringBox& getViewClassName() const;
 
     void setViewClassNameForPlatform(ViewTransactionScope& viewTransactionScope,
@@ -455,6 +465,12 @@ public:
      */
     void updateCSS(ViewTransactionScope& viewTransactionScope, const Ref<Animator>& animator);
 
+    /**
+     Discard the resolved CSS styles of this node and its children, and mark them
+     as needing a CSS update.
+     */
+    void resetCssSubtree();
+
     void setHorizontalScroll(bool horizontalScroll);
 
     void setScrollStaticContentWidth(float staticContentWidth);
@@ -467,6 +483,21 @@ public:
     void setViewportExtensionLeft(float viewportExtensionLeft);
     void setViewportExtensionRight(float viewportExtensionRight);
 
+    void setScrollPrefetchLookahead(float prefetchLookahead);
+    void setScrollPrefetchViews(bool prefetchViews);
+
+    /**
+     Calculates ahead of time the lazy layouts in this subtree, and optionally requests
+     the views to be pre-created, as the node is about to enter the viewport of a scroll.
+     */
+    void prefetchLazyLayout(bool prefetchViews);
+
+    /**
+     Schedules again a lazy layout prefetch which was deferred because the prefetch
+     budget of the previous update pass was exhausted.
+     */
+    void resumeLazyLayoutPrefetch();
+
     /**
      * Accessibility attributes (checkout NativeTemplateElement.ts for more info)
      */
@@ -621,7 +652,7 @@ private:
     int _lastChildrenIndexerId = 0;
     RawViewNodeId _rawId = 0;
 
-    std::bitset<30> _flags;
+    std::bitset<34> _flags;
 
     ViewNodeTree* _viewNodeTree = nullptr;
 
@@ -652,6 +683,9 @@ private:
     void setViewFrameNeedsUpdate();
 
     bool updateLazyLayout();
+    bool updatePrefetchedLazyLayout();
+    bool lazyLayoutNeedsCalculation() const;
+    void prefetchChildrenInScrollDirection();
     void doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
                           const Ref<View>& currentParentView,
                           bool parentVisibleInViewport,
@@ -659,9 +693,18 @@ private:
                           bool parentViewChanged,
                           bool viewInflationEnabled,
                           const Ref<Animator>& parentAnimator,
+                          ViewCreationBudget* viewCreationBudget,
                           ViewNodeUpdateViewTreeResult& updateResult,
                           int* currentViewIndex,
                           int* viewsCount);
+    void updateChildrenViewTree(ViewTransactionScope& viewTransactionScope,
+                                bool visibleInViewport,
+                                bool limitToViewportEnabled,
+                                bool viewChanged,
+                                bool viewInflationEnabled,
+                                const Ref<Animator>& animator,
+                                ViewCreationBudget* viewCreationBudget,
+                                ViewNodeUpdateViewTreeResult& updateResult);
 
     bool updateCalculatedFrame(float viewOffsetX,
                                float viewOffsetY,
@@ -679,6 +722,7 @@ private:
                                        bool isFromLazyLayout) const;
 
     bool createView(ViewTransactionScope& viewTransactionScope, const Ref<Animator>& animator);
+    bool shouldDeferViewCreation(ViewCreationBudget& viewCreationBudget) const;
     bool removeView(ViewTransactionScope& viewTransactionScope, bool safeRemove);
 
     void callViewChangedIfNeeded();
@@ -737,12 +781,14 @@ private:
     void setHasParent(bool hasParent);
 
     void setCSSNeedsUpdate();
+    void invalidateCSS(CSSInvalidation invalidation);
 
     void setCSSHasChildNeedsUpdate();
 
     void updateCSS(ViewTransactionScope& viewTransactionScope,
                    const Ref<Animator>& animator,
-                   bool force,
+                   CSSInvalidation forcedInvalidation,
+                   const CSSAttributesManager* invalidatingCSSParent,
                    int siblingsCount,
                    int indexAmongSiblings,
                    CSSUpdateResult& updateResult);
@@ -33,10 +33,14 @@ void ViewNodeChildrenIndexer::setHorizontal(bool horizontal) {
 }
 
 void ViewNodeChildrenIndexer::updateVisibleBounds(const Frame& viewport) {
+    auto bounds = resolveBounds(viewport);
+    _visibleLowerBound = bounds.first;
+    _visibleUpperBound = bounds.second;
+}
+
+std::pair<size_t, size_t> ViewNodeChildrenIndexer::resolveBounds(const Frame& viewport) const {
     if (_cellSize == 0.0f) {
-        _visibleLowerBound = 0;
-        _visibleUpperBound = 0;
-        return;
+        return {0, 0};
     }
 
     float start;
@@ -49,8 +53,9 @@ void ViewNodeChildrenIndexer::updateVisibleBounds(const Frame& viewport) {
         end = viewport.getBottom();
     }
 
-    _visibleUpperBound = std::min(static_cast<size_t>(std::ceil(end / _cellSize)), _cells.size());
-    _visibleLowerBound = std::min(static_cast<size_t>(std::max(start / _cellSize, 0.0f)), _visibleUpperBound);
+    auto upperBound = std::min(static_cast<size_t>(std::ceil(end / _cellSize)), _cells.size());
+    auto lowerBound = std::min(static_cast<size_t>(std::max(start / _cellSize, 0.0f)), upperBound);
+    return {lowerBound, upperBound};
 }
 
 void appendNodeIfNeeded(std::vector<ViewNode*>& output, ViewNode* viewNode, int updateId) {
@@ -115,6 +120,26 @@ ChildrenVisibilityResult ViewNodeChildrenIndexer::findChildrenVisibility(const F
     return result;
 }
 
+ReusableArray<ViewNode*> ViewNodeChildrenIndexer::findChildrenAroundVisibleBounds(const Frame& extendedViewport) {
+    auto output = makeReusableArray<ViewNode*>();
+    if (_needUpdate) {
+        // The cells are only rebuilt by findChildrenVisibility()
+        return output;
+    }
+
+    auto updateId = ++_updateId;
+    auto bounds = resolveBounds(extendedViewport);
+
+    if (bounds.first < _visibleLowerBound) {
+        appendNodesIfNeeded(*output, bounds.first, _visibleLowerBound, updateId);
+    }
+    if (bounds.second > _visibleUpperBound) {
+        appendNodesIfNeeded(*output, _visibleUpperBound, bounds.second, updateId);
+    }
+
+    return output;
+}
+
 void ViewNodeChildrenIndexer::insertNodeInCells(ViewNode* viewNode, float start, float end) {
     auto cellStart = static_cast<size_t>(start / _cellSize);
     auto cellEnd = static_cast<size_t>(std::ceil(end / _cellSize));
@@ -14,6 +14,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace Valdi {
@@ -42,6 +43,12 @@ public:
 
     ChildrenVisibilityResult findChildrenVisibility(const Frame& viewport);
 
+    /**
+     Returns the children within the given extended viewport which are outside of the visible
+     bounds resolved by the last findChildrenVisibility() call, without changing those bounds.
+     */
+    ReusableArray<ViewNode*> findChildrenAroundVisibleBounds(const Frame& extendedViewport);
+
 private:
     ViewNode* _viewNode;
     std::vector<SmallVector<ViewNode*, 2>> _cells;
@@ -55,6 +62,7 @@ private:
     void rebuild();
 
     void updateVisibleBounds(const Frame& viewport);
+    std::pair<size_t, size_t> resolveBounds(const Frame& viewport) const;
 
     void insertNodeInCells(ViewNode* viewNode, float start, float end);
 
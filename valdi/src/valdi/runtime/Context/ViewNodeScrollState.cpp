@@ -13,8 +13,28 @@
 #include "valdi_core/cpp/Utils/Marshaller.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Valdi {
 
+// Samples further apart than this are considered to belong to different gestures
+constexpr float kMaxVelocitySampleInterval = 0.1f;
+// Weight of the newest sample in the smoothed velocity
+constexpr float kVelocitySmoothingFactor = 0.5f;
+// Exponential decay of the velocity per second once the finger is lifted, which is close to
+// the default deceleration of UIScrollView (0.998 per ms) and of the Android OverScroller.
+constexpr float kPrefetchDecelerationRate = 2.0f;
+// The prefetch viewport never grows by more than this ratio of the viewport in the scroll direction
+constexpr float kMaxPrefetchViewportRatio = 3.0f;
+
+static float resolvePrefetchDistance(float velocity, float lookahead, float viewportLength) {
+    // Distance travelled within the lookahead when the velocity decays exponentially
+    auto distance = velocity / kPrefetchDecelerationRate * (1.0f - std::exp(-kPrefetchDecelerationRate * lookahead));
+    auto maxDistance = viewportLength * kMaxPrefetchViewportRatio;
+    return std::clamp(distance, -maxDistance, maxDistance);
+}
+
 ViewNodeScrollState::ViewNodeScrollState() = default;
 
 ViewNodeScrollState::~ViewNodeScrollState() = default;
@@ -336,6 +356,7 @@ void ViewNodeScrollState::notifyOnDragStart(const Point& directionAgnosticConten
 void ViewNodeScrollState::notifyOnScrollEnd(const Point& directionAgnosticContentOffset,
                                             const Point& directionAgnosticUnclampedContentOffset) {
     _scrolling = false;
+    resetVelocity();
     if (_onScrollEndCallback != nullptr) {
         VALDI_TRACE("Valdi.notifyOnScrollEnd")
         static Point velocity = Point(0, 0);
@@ -452,6 +473,78 @@ void ViewNodeScrollState::setViewportExtensionRight(float viewportExtensionRight
     _viewportExtensionRight = viewportExtensionRight;
 }
 
+void ViewNodeScrollState::updateVelocity(const Point& directionAgnosticContentOffset,
+                                         std::chrono::steady_clock::time_point time) {
+    if (_lastVelocitySampleTime) {
+        auto elapsed = std::chrono::duration<float>(time - _lastVelocitySampleTime.value()).count();
+        if (elapsed <= 0.0f) {
+            return;
+        }
+
+        if (elapsed > kMaxVelocitySampleInterval) {
+            _directionAgnosticVelocity = Point();
+        } else {
+            auto sampleVelocityX = (directionAgnosticContentOffset.x - _lastVelocitySampleContentOffset.x) / elapsed;
+            auto sampleVelocityY = (directionAgnosticContentOffset.y - _lastVelocitySampleContentOffset.y) / elapsed;
+
+            _directionAgnosticVelocity.x = sampleVelocityX * kVelocitySmoothingFactor +
+                                            _directionAgnosticVelocity.x * (1.0f - kVelocitySmoothingFactor);
+            _directionAgnosticVelocity.y = sampleVelocityY * kVelocitySmoothingFactor +
+                                            _directionAgnosticVelocity.y * (1.0f - kVelocitySmoothingFactor);
+        }
+    }
+
+    _lastVelocitySampleContentOffset = directionAgnosticContentOffset;
+    _lastVelocitySampleTime = {time};
+}
+
+const Point& ViewNodeScrollState::getDirectionAgnosticVelocity() const {
+    return _directionAgnosticVelocity;
+}
+
+void ViewNodeScrollState::resetVelocity() {
+    _directionAgnosticVelocity = Point();
+    _lastVelocitySampleTime = std::nullopt;
+}
+
+void ViewNodeScrollState::setPrefetchLookahead(float prefetchLookahead) {
+    _prefetchLookahead = std::max(prefetchLookahead, 0.0f);
+}
+
+bool ViewNodeScrollState::isPrefetchEnabled() const {
+    return _prefetchLookahead > 0.0f;
+}
+
+void ViewNodeScrollState::setPrefetchViews(bool prefetchViews) {
+    _prefetchViews = prefetchViews;
+}
+
+bool ViewNodeScrollState::prefetchesViews() const {
+    return _prefetchViews;
+}
+
+Frame ViewNodeScrollState::resolvePrefetchViewport(const Frame& viewport) const {
+    if (!isPrefetchEnabled()) {
+        return viewport;
+    }
+
+    auto distanceX = resolvePrefetchDistance(_directionAgnosticVelocity.x, _prefetchLookahead, viewport.width);
+    auto distanceY = resolvePrefetchDistance(_directionAgnosticVelocity.y, _prefetchLookahead, viewport.height);
+
+    auto prefetchViewport = viewport;
+    if (distanceX < 0) {
+        prefetchViewport.x += distanceX;
+    }
+    prefetchViewport.width += std::abs(distanceX);
+
+    if (distanceY < 0) {
+        prefetchViewport.y += distanceY;
+    }
+    prefetchViewport.height += std::abs(distanceY);
+
+    return prefetchViewport;
+}
+
 bool ViewNodeScrollState::onScrollCallbackPrefersSyncCalls() const {
     return false;
 }
@@ -10,6 +10,7 @@
 #include "valdi/runtime/Views/Frame.hpp"
 #include "valdi_core/cpp/Utils/ValueFunction.hpp"
 
+#include <chrono>
 #include <optional>
 
 namespace Valdi {
@@ -101,6 +102,34 @@ public:
 
     bool onScrollCallbackPrefersSyncCalls() const;
 
+    /**
+     Feeds the content offset after a scroll event, from which the scroll
+     velocity used by the prefetch viewport is estimated.
+     */
+    void updateVelocity(const Point& directionAgnosticContentOffset, std::chrono::steady_clock::time_point time);
+    const Point& getDirectionAgnosticVelocity() const;
+
+    /**
+     How far ahead in time, in seconds, the content that will enter the viewport should be
+     prefetched while scrolling. 0 disables prefetching.
+     */
+    void setPrefetchLookahead(float prefetchLookahead);
+    bool isPrefetchEnabled() const;
+
+    /**
+     Whether the views of the prefetched children should be pre-created in the view pools,
+     on top of having their lazy layout calculated.
+     */
+    void setPrefetchViews(bool prefetchViews);
+    bool prefetchesViews() const;
+
+    /**
+     Returns the viewport extended in the scroll direction by the distance the content is predicted
+     to travel within the prefetch lookahead, given the current velocity and the deceleration of
+     the scroll view. Returns the viewport unchanged when not scrolling or when prefetch is disabled.
+     */
+    Frame resolvePrefetchViewport(const Frame& viewport) const;
+
 private:
     Point _directionAgnosticContentOffset;
     Point _directionAgnosticUnclampedContentOffset;
@@ -115,12 +144,17 @@ private:
     float _viewportExtensionBottom = 0.0f;
     float _staticContentWidth = 0.0f;
     float _staticContentHeight = 0.0f;
+    float _prefetchLookahead = 0.0f;
+    Point _directionAgnosticVelocity;
+    Point _lastVelocitySampleContentOffset;
+    std::optional<std::chrono::steady_clock::time_point> _lastVelocitySampleTime;
     int _circularRatio = 0;
     bool _scrolling = false;
     bool _needsSyncWithView = true;
     bool _currentlyAnimating = false;
     bool _inScrollMode = false;
     bool _isHorizontal = false;
+    bool _prefetchViews = false;
 
     Ref<ValueFunction> _onScrollCallback;
     Ref<ValueFunction> _onScrollEndCallback;
@@ -142,6 +176,8 @@ private:
     Point resolveContentOffset(const Point& convertedContentOffset, bool directionAgnostic) const;
 
     void notifyContentSizeChanged() const;
+
+    void resetVelocity();
 };
 
 } // namespace Valdi
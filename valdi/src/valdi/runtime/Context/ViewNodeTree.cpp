@@ -23,7 +23,9 @@
 #include "valdi/runtime/Runtime.hpp"
 #include "valdi/runtime/Views/GlobalViewFactories.hpp"
 #include "valdi/runtime/Views/MeasureDelegate.hpp"
+#include "valdi/runtime/Views/PendingView.hpp"
 #include "valdi/runtime/Views/ViewTransactionScope.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
@@ -391,6 +393,12 @@ Ref<Metrics> ViewNodeTree::getMetrics() const {
     return _runtime->getMetrics();
 }
 
+void ViewNodeTree::notifyUserInteraction() const {
+    if (_runtime != nullptr) {
+        _runtime->notifyUserInteraction();
+    }
+}
+
 void ViewNodeTree::attachAnimator(SharedAnimator animator, AnimationCancelToken token) {
     flushAnimator();
     _animator = std::move(animator);
@@ -427,6 +435,14 @@ void ViewNodeTree::performUpdatesAndFlushAnimatorIfNeeded() {
 
 void ViewNodeTree::flushAnimator() {
     if (_animator != nullptr) {
+        if (_runtime != nullptr) {
+            // Let the runtime know that an animation is running until its completion is called
+            _runtime->beginAnimation();
+            _animator->appendCompletion([runtime = _runtime](const auto& /*callContext*/) {
+                runtime->endAnimation();
+                return Value::undefined();
+            });
+        }
         getCurrentViewTransactionScope().transaction().flushAnimator(_animator, _animator->makeCompletionFunction());
         _animator = nullptr;
     }
@@ -724,6 +740,63 @@ const Ref<ViewManagerContext>& ViewNodeTree::getViewManagerContext() const {
     return _viewManagerContext;
 }
 
+void ViewNodeTree::setViewCreationBudgetUs(int64_t viewCreationBudgetUs) {
+    _viewCreationBudgetUs = viewCreationBudgetUs;
+}
+
+int64_t ViewNodeTree::getViewCreationBudgetUs() const {
+    return _viewCreationBudgetUs;
+}
+
+void ViewNodeTree::setLazyLayoutPrefetchBudgetUs(int64_t lazyLayoutPrefetchBudgetUs) {
+    _lazyLayoutPrefetchBudgetUs = lazyLayoutPrefetchBudgetUs;
+}
+
+void ViewNodeTree::beginLazyLayoutPrefetchPass() {
+    _lazyLayoutPrefetchStopWatch.reset();
+}
+
+bool ViewNodeTree::canPrefetchLazyLayout() const {
+    return _lazyLayoutPrefetchStopWatch.elapsedUs() < _lazyLayoutPrefetchBudgetUs;
+}
+
+void ViewNodeTree::beginLazyLayoutPrefetch() {
+    _lazyLayoutPrefetchStopWatch.start();
+}
+
+void ViewNodeTree::endLazyLayoutPrefetch() {
+    _lazyLayoutPrefetchStopWatch.stop();
+}
+
+void ViewNodeTree::deferLazyLayoutPrefetch(ViewNode& viewNode) {
+    _deferredLazyLayoutPrefetches.emplace_back(strongRef(&viewNode));
+}
+
+void ViewNodeTree::prefetchView(const StringBox& viewClassName) {
+    _prefetchedViewsCountByClassName[viewClassName]++;
+}
+
+void ViewNodeTree::endLazyLayoutPrefetchPass() {
+    if (!_deferredLazyLayoutPrefetches.empty()) {
+        auto deferredLazyLayoutPrefetches = std::move(_deferredLazyLayoutPrefetches);
+        _deferredLazyLayoutPrefetches = std::vector<Ref<ViewNode>>();
+
+        // Scheduling them again triggers a new update pass
+        for (const auto& viewNode : deferredLazyLayoutPrefetches) {
+            viewNode->resumeLazyLayoutPrefetch();
+        }
+    }
+
+    if (!_prefetchedViewsCountByClassName.empty()) {
+        if (_viewManagerContext != nullptr) {
+            for (const auto& it : _prefetchedViewsCountByClassName) {
+                _viewManagerContext->preloadViews(it.first, it.second);
+            }
+        }
+        _prefetchedViewsCountByClassName.clear();
+    }
+}
+
 IViewManager* ViewNodeTree::getViewManager() const {
     return _viewManager;
 }
@@ -799,6 +872,13 @@ Ref<ViewTransactionScope> ViewNodeTree::beginViewTransaction() {
 
     if (_beginViewTransactionCounter == 1) {
         viewTransactionScope->setRootView(getRootView());
+
+        if (!_pendingViews.empty() && _mainThreadManager != nullptr && _mainThreadManager->currentThreadIsMainThread()) {
+            // The operations of this transaction are applied directly, they cannot reference
+            // PendingViews. Their views are created now, the commits which were dispatched
+            // for them will find them already created.
+            replaceCreatedPendingViews(true);
+        }
     }
 
     return viewTransactionScope;
@@ -813,6 +893,19 @@ void ViewNodeTree::endViewTransaction(const Ref<ViewTransactionScope>& viewTrans
     }
 
     if (_beginViewTransactionCounter == 1) {
+        if (_hasNewPendingViews) {
+            _hasNewPendingViews = false;
+            // Runs in the main thread at the end of the commit, once the operations of this
+            // pass have created the pending views
+            viewTransactionScope->transaction().executeInTransactionThread(
+                [viewNodeTree = strongSmallRef(this)]() {
+                    viewNodeTree->_viewTreeUpdateQueue->async([viewNodeTree]() {
+                        viewNodeTree->scheduleExclusiveUpdate(
+                            [viewNodeTree]() { viewNodeTree->replaceCreatedPendingViews(false); });
+                    });
+                });
+        }
+
         viewTransactionScope->submit();
     }
 
@@ -823,6 +916,48 @@ bool ViewNodeTree::shouldRenderInMainThread() const {
     return _shouldRenderInMainThread;
 }
 
+void ViewNodeTree::setViewTreeUpdateQueue(const Ref<DispatchQueue>& viewTreeUpdateQueue) {
+    _viewTreeUpdateQueue = viewTreeUpdateQueue;
+}
+
+const Ref<DispatchQueue>& ViewNodeTree::getViewTreeUpdateQueue() const {
+    return _viewTreeUpdateQueue;
+}
+
+bool ViewNodeTree::defersViewCreationToMainThread() const {
+    return _viewTreeUpdateQueue != nullptr && _mainThreadManager != nullptr &&
+           !_mainThreadManager->currentThreadIsMainThread();
+}
+
+Ref<View> ViewNodeTree::makePendingView(const Ref<ViewFactory>& viewFactory, ViewNode& viewNode) {
+    _mutex.assertIsLocked();
+    auto pendingView = makeShared<PendingView>(viewFactory, weakRef(this), weakRef(&viewNode));
+    _pendingViews.emplace_back(pendingView, strongSmallRef(&viewNode));
+    _hasNewPendingViews = true;
+    return pendingView;
+}
+
+void ViewNodeTree::replaceCreatedPendingViews(bool createMissingViews) {
+    if (_pendingViews.empty()) {
+        return;
+    }
+
+    auto& viewTransactionScope = getCurrentViewTransactionScope();
+    auto it = _pendingViews.begin();
+    while (it != _pendingViews.end()) {
+        if (createMissingViews) {
+            it->first->getOrCreateView();
+        } else if (!it->first->isCreated()) {
+            // Created by a commit which has not been applied yet
+            it++;
+            continue;
+        }
+
+        it->second->replacePendingView(viewTransactionScope, *it->first);
+        it = _pendingViews.erase(it);
+    }
+}
+
 const Ref<IViewNodesAssetTracker>& ViewNodeTree::getAssetTracker() const {
     return _assetTracker;
 }
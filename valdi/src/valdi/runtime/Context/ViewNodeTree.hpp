@@ -17,6 +17,7 @@
 #include "valdi/runtime/Views/View.hpp"
 #include "valdi/runtime/Views/ViewFactory.hpp"
 #include "valdi/runtime/Views/ViewTransactionScope.hpp"
+#include "utils/time/StopWatch.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/TrackedLock.hpp"
@@ -36,6 +37,8 @@ class ViewNodesVisibilityObserver;
 class ViewNodesFrameObserver;
 class IViewNodesAssetTracker;
 class MainThreadManager;
+class DispatchQueue;
+class PendingView;
 class AttributesManager;
 class Metrics;
 
@@ -133,6 +136,11 @@ public:
     const Ref<Runtime>& getRuntime() const;
     Ref<Metrics> getMetrics() const;
 
+    /**
+     Notify the runtime that the user is interacting with this tree, for example scrolling.
+     */
+    void notifyUserInteraction() const;
+
     void attachAnimator(SharedAnimator animator, AnimationCancelToken token);
     void cancelAnimation(AnimationCancelToken token);
     void removePendingAnimation(AnimationCancelToken token);
@@ -232,6 +240,52 @@ public:
 
     bool shouldRenderInMainThread() const;
 
+    /**
+     Sets the queue on which the updates of the ViewNodeTree are processed. When set, the
+     updates resolve attributes, CSS, layout and the view tree outside of the main thread,
+     and the resulting view operations, including the creation of the views missing from
+     the pools, are applied in the main thread as a single commit.
+     Must be set before the ViewNodeTree starts receiving updates.
+     */
+    void setViewTreeUpdateQueue(const Ref<DispatchQueue>& viewTreeUpdateQueue);
+    const Ref<DispatchQueue>& getViewTreeUpdateQueue() const;
+
+    /**
+     Returns whether views which are not in the pools should be created by the main thread
+     commit instead of the current thread.
+     */
+    bool defersViewCreationToMainThread() const;
+
+    /**
+     Returns a PendingView for the given ViewNode, whose view will be created from the given
+     factory by the main thread commit of the current view transaction. The ViewNode gets
+     the created view once the commit has been applied.
+     */
+    Ref<View> makePendingView(const Ref<ViewFactory>& viewFactory, ViewNode& viewNode);
+
+    /**
+     Sets a time budget for creating the views in a view tree update. When set, the views are
+     created in order of distance to the viewport, starting with the visible ones, and the views
+     which do not fit in the budget are created in the next updates. Their space stays empty until then.
+     0 disables the budget, which is the default. Set from the VALDI_VIEW_CREATION_BUDGET_US
+     runtime tweak when the ViewNodeTree is created.
+     */
+    void setViewCreationBudgetUs(int64_t viewCreationBudgetUs);
+    int64_t getViewCreationBudgetUs() const;
+
+    /**
+     Lazy layouts of the children prefetched ahead of a scroll are calculated within a time budget
+     per update pass. The prefetches which do not fit in the budget are deferred to the next pass.
+     */
+    void setLazyLayoutPrefetchBudgetUs(int64_t lazyLayoutPrefetchBudgetUs);
+    void beginLazyLayoutPrefetchPass();
+    bool canPrefetchLazyLayout() const;
+    void beginLazyLayoutPrefetch();
+    void endLazyLayoutPrefetch();
+    void deferLazyLayoutPrefetch(ViewNode& viewNode);
+    void prefetchView(const StringBox& viewClassName);
+    void endLazyLayoutPrefetchPass();
+
     TrackedLock lock() const;
 
 private:
@@ -256,6 +310,13 @@ private:
 
     FlatMap<AnimationCancelToken, SharedAnimator> _pendingCancellableAnimations;
 
+    int64_t _viewCreationBudgetUs = 0;
+    snap::utils::time::StopWatch _lazyLayoutPrefetchStopWatch;
+    // About a quarter of a frame at 60fps
+    int64_t _lazyLayoutPrefetchBudgetUs = 4000;
+    std::vector<Ref<ViewNode>> _deferredLazyLayoutPrefetches;
+    FlatMap<StringBox, size_t> _prefetchedViewsCountByClassName;
+
     Size _layoutSize;
     LayoutDirection _layoutDirection = LayoutDirectionLTR;
     std::optional<Frame> _viewport;
@@ -285,6 +346,10 @@ private:
     int _disableUpdatesCounter = 0;
     int _beginViewTransactionCounter = 0;
     size_t _layoutDirtyCounter = 0;
+    Ref<DispatchQueue> _viewTreeUpdateQueue;
+    // PendingViews which have not been swapped for their created view yet
+    std::vector<std::pair<Ref<PendingView>, Ref<ViewNode>>> _pendingViews;
+    bool _hasNewPendingViews = false;
 
     std::unique_ptr<AttributeOwner> _parentAttributeOwner;
 
@@ -297,6 +362,8 @@ private:
     void schedulePerformUpdates();
     void performUpdatesIfLayoutSpecsUpToDate();
 
+    void replaceCreatedPendingViews(bool createMissingViews);
+
     Ref<ViewFactory> createDeferredViewFactory();
     void setViewToRootViewNode(const Ref<ViewNode>& rootViewNode, const Ref<View>& view);
 
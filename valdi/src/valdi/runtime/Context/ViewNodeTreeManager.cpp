@@ -7,6 +7,9 @@
 
 #include "valdi/runtime/Context/ViewNodeTreeManager.hpp"
 #include "valdi/runtime/Context/ViewManagerContext.hpp"
+#include "valdi/runtime/Runtime.hpp"
+#include "valdi/runtime/ValdiRuntimeTweaks.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 
 namespace Valdi {
 
@@ -37,12 +40,25 @@ SharedViewNodeTree ViewNodeTreeManager::lockFreeCreateViewNodeTreeForContext(
     if (viewManagerContext != nullptr) {
         viewManager = &viewManagerContext->getViewManager();
     }
+    auto runtimeTweaks = runtime->getRuntimeTweaks();
+    if (threadAffinity == ViewNodeTreeThreadAffinity::MAIN_THREAD && runtimeTweaks != nullptr &&
+        runtimeTweaks->enableMainThreadCommit()) {
+        threadAffinity = ViewNodeTreeThreadAffinity::MAIN_THREAD_COMMIT;
+    }
+    Ref<DispatchQueue> viewNodeTreeUpdateQueue;
+    if (threadAffinity == ViewNodeTreeThreadAffinity::MAIN_THREAD_COMMIT) {
+        viewNodeTreeUpdateQueue = runtime->getViewNodeTreeUpdateQueue();
+    }
     auto viewNodeTree = Valdi::makeShared<ViewNodeTree>(context,
                                                         viewManagerContext,
                                                         viewManager,
                                                         std::move(runtime),
                                                         &_mainThreadManager,
-                                                        threadAffinity == ViewNodeTreeThreadAffinity::MAIN_THREAD);
+                                                        threadAffinity != ViewNodeTreeThreadAffinity::ANY);
+    viewNodeTree->setViewTreeUpdateQueue(viewNodeTreeUpdateQueue);
+    if (runtimeTweaks != nullptr) {
+        viewNodeTree->setViewCreationBudgetUs(runtimeTweaks->viewCreationBudgetUs());
+    }
 
     auto emplaced = _trees.try_emplace(context->getContextId(), viewNodeTree).second;
     SC_ASSERT(emplaced, "ViewNodeTree was already registered");
@@ -29,6 +29,15 @@ enum class ViewNodeTreeThreadAffinity {
      * thread immediately.
      */
     ANY = 2,
+
+    /**
+     * The ViewNodeTree is updated in a background thread: attributes, CSS, layout and the
+     * view tree are resolved there, and only the resulting view operations are applied in
+     * the Main Thread as a single commit, which also creates the views missing from the pools.
+     * MAIN_THREAD trees use this mode when the VALDI_ENABLE_MAIN_THREAD_COMMIT tweak is set.
+     * The ViewNodeTree must be created before its Context submits its first render request.
+     */
+    MAIN_THREAD_COMMIT = 3,
 };
 
 class ViewNodeTreeManager {
@@ -8,10 +8,12 @@
 #pragma once
 
 #include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/PathUtils.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
+#include <vector>
 
 namespace Valdi {
 
@@ -28,6 +30,22 @@ public:
      */
     [[nodiscard]] virtual Result<BytesView> load(const Path& path) = 0;
 
+    /**
+     Load the content of the items at the given paths and call the completion
+     with the results, in the same order as the given paths. The completion
+     might be called from any thread. The default implementation loads the
+     items one by one from the calling thread.
+     */
+    virtual void loadMany(const std::vector<Path>& paths,
+                          const Function<void(std::vector<Result<BytesView>>)>& completion) {
+        std::vector<Result<BytesView>> results;
+        results.reserve(paths.size());
+        for (const auto& path : paths) {
+            results.emplace_back(load(path));
+        }
+        completion(std::move(results));
+    }
+
     /**
      Load the content of the item at the given absolute URL and return the result
      as bytes.
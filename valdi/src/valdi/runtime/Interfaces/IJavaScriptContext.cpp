@@ -114,6 +114,25 @@ JSValueRef IJavaScriptContext::newArrayWithValues(const JSValue* values,
         size, exceptionTracker, [&](size_t i) -> JSValueRef { return JSValueRef::makeUnretained(*this, values[i]); });
 }
 
+JSValueRef IJavaScriptContext::newObjectWithProperties(const JSPropertyName* propertyNames,
+                                                       const JSValue* propertyValues,
+                                                       size_t size,
+                                                       JSExceptionTracker& exceptionTracker) {
+    auto object = newObject(exceptionTracker);
+    if (!exceptionTracker) {
+        return newUndefined();
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        setObjectProperty(object.get(), propertyNames[i], propertyValues[i], exceptionTracker);
+        if (!exceptionTracker) {
+            return newUndefined();
+        }
+    }
+
+    return object;
+}
+
 JSValueRef IJavaScriptContext::callObjectProperty(const JSValue& object,
                                                   const JSPropertyName& propertyName,
                                                   JSFunctionCallContext& callContext) {
@@ -142,6 +142,17 @@ public:
 
     virtual JSValueRef newObject(JSExceptionTracker& exceptionTracker) = 0;
 
+    /**
+     Create a plain object initialized with the given enumerable properties.
+     Callers creating many objects with the same property names, like the
+     typed object marshaller, should pass the property names in a consistent
+     order so that engines can share the object shapes between them.
+     */
+    virtual JSValueRef newObjectWithProperties(const JSPropertyName* propertyNames,
+                                               const JSValue* propertyValues,
+                                               size_t size,
+                                               JSExceptionTracker& exceptionTracker);
+
     virtual JSValueRef newFunction(const Ref<JSFunction>& callable, JSExceptionTracker& exceptionTracker) = 0;
 
     JSValueRef newBool(bool boolean);
@@ -277,6 +288,14 @@ public:
 
     virtual JavaScriptContextMemoryStatistics dumpMemoryStatistics() = 0;
 
+    /**
+     Returns the current size of the JS heap, or 0 if the engine cannot report it cheaply.
+     It is queried on every idle GC check, which is turned off for engines returning 0.
+     */
+    virtual size_t getHeapSizeBytes() {
+        return 0;
+    }
+
     virtual void startDebugger(bool isWorker) {}
 
     virtual std::optional<IJavaScriptContextDebuggerInfo> getDebuggerInfo() const {
@@ -0,0 +1,105 @@
+//
+//  JavaScriptGcScheduler.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/JavaScript/JavaScriptGcScheduler.hpp"
+
+#include <limits>
+
+namespace Valdi {
+
+static int64_t toNanoseconds(JavaScriptGcScheduler::TimePoint timePoint) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+}
+
+static JavaScriptGcScheduler::TimePoint fromNanoseconds(int64_t nanoseconds) {
+    return JavaScriptGcScheduler::TimePoint(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+}
+
+JavaScriptGcScheduler::JavaScriptGcScheduler(const JavaScriptGcSchedulerConfig& config)
+    : _config(config),
+      _lastInteractionNs(std::numeric_limits<int64_t>::min()),
+      _lastAnimationBeganNs(std::numeric_limits<int64_t>::min()),
+      _runningAnimationsCount(0) {}
+
+const JavaScriptGcSchedulerConfig& JavaScriptGcScheduler::getConfig() const {
+    return _config;
+}
+
+void JavaScriptGcScheduler::onJsActivity(TimePoint now) {
+    _lastJsActivity = now;
+    _hasActivitySinceLastCollection = true;
+}
+
+bool JavaScriptGcScheduler::hasActivitySinceLastCollection() const {
+    return _hasActivitySinceLastCollection;
+}
+
+JavaScriptGcScheduler::Decision JavaScriptGcScheduler::evaluate(TimePoint now, size_t heapSizeBytes) const {
+    if (heapSizeBytes != 0) {
+        auto heapGrowth =
+            heapSizeBytes > _heapSizeAfterLastCollection ? heapSizeBytes - _heapSizeAfterLastCollection : 0;
+        if (heapGrowth >= _config.maxHeapGrowthBytes) {
+            return Decision{Action::CollectOverHeadroom};
+        }
+        if (heapGrowth < _config.minHeapGrowthBytes) {
+            // Not worth collecting, the next JS activity will trigger a new evaluation
+            return Decision{Action::None};
+        }
+    } else if (!_hasActivitySinceLastCollection) {
+        return Decision{Action::None};
+    }
+
+    if (isInteracting(now)) {
+        return Decision{Action::Defer, _config.interactionQuietPeriod};
+    }
+
+    auto idleDuration = now - _lastJsActivity;
+    if (idleDuration < _config.idleDelay) {
+        return Decision{Action::Defer, _config.idleDelay - idleDuration};
+    }
+
+    auto durationSinceLastCollection = now - _lastCollection;
+    if (_lastCollection != TimePoint() && durationSinceLastCollection < _config.minCollectionInterval) {
+        return Decision{Action::Defer, _config.minCollectionInterval - durationSinceLastCollection};
+    }
+
+    return Decision{Action::CollectWhenIdle};
+}
+
+void JavaScriptGcScheduler::onCollected(TimePoint now, size_t heapSizeBytes) {
+    _lastCollection = now;
+    _heapSizeAfterLastCollection = heapSizeBytes;
+    _hasActivitySinceLastCollection = false;
+}
+
+void JavaScriptGcScheduler::onInteraction(TimePoint now) {
+    _lastInteractionNs = toNanoseconds(now);
+}
+
+void JavaScriptGcScheduler::onAnimationBegan(TimePoint now) {
+    _lastAnimationBeganNs = toNanoseconds(now);
+    _runningAnimationsCount++;
+}
+
+void JavaScriptGcScheduler::onAnimationEnded() {
+    _runningAnimationsCount--;
+}
+
+bool JavaScriptGcScheduler::isInteracting(TimePoint now) const {
+    auto lastInteractionNs = _lastInteractionNs.load();
+    if (lastInteractionNs != std::numeric_limits<int64_t>::min() &&
+        now - fromNanoseconds(lastInteractionNs) < _config.interactionQuietPeriod) {
+        return true;
+    }
+
+    auto lastAnimationBeganNs = _lastAnimationBeganNs.load();
+    return _runningAnimationsCount.load() > 0 && lastAnimationBeganNs != std::numeric_limits<int64_t>::min() &&
+           now - fromNanoseconds(lastAnimationBeganNs) < _config.maxAnimationDuration;
+}
+
+} // namespace Valdi
@@ -0,0 +1,91 @@
+//
+//  JavaScriptGcScheduler.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Valdi {
+
+struct JavaScriptGcSchedulerConfig {
+    // How long the JS thread needs to stay idle before a collection runs
+    std::chrono::steady_clock::duration idleDelay = std::chrono::seconds(1);
+    // How long after the last scroll event the UI is still considered to be interacting
+    std::chrono::steady_clock::duration interactionQuietPeriod = std::chrono::milliseconds(500);
+    // Animations which did not report their end after this duration are ignored
+    std::chrono::steady_clock::duration maxAnimationDuration = std::chrono::seconds(5);
+    // Minimum time between two collections triggered while idle
+    std::chrono::steady_clock::duration minCollectionInterval = std::chrono::seconds(10);
+    // Heap growth since the last collection below which no collection is triggered
+    size_t minHeapGrowthBytes = 4 * 1024 * 1024;
+    // Heap growth since the last collection above which a collection is triggered
+    // right away, even during an interaction
+    size_t maxHeapGrowthBytes = 64 * 1024 * 1024;
+};
+
+/**
+ The JavaScriptGcScheduler decides when a JS runtime should garbage collect, so that
+ collections happen while the JS thread is idle instead of when the engine heuristics
+ fire in the middle of a render or a scroll. Collections are deferred while the user is
+ scrolling or while animations are running, unless the heap grew beyond the configured
+ headroom since the last collection.
+ The JS activity and collection methods must be called from the JS thread, the interaction
+ methods can be called from any thread.
+ */
+class JavaScriptGcScheduler {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    enum class Action {
+        None,
+        Defer,
+        CollectWhenIdle,
+        CollectOverHeadroom,
+    };
+
+    struct Decision {
+        Action action = Action::None;
+        // When the decision should be re-evaluated, if it was deferred
+        std::chrono::steady_clock::duration checkDelay = std::chrono::steady_clock::duration::zero();
+    };
+
+    explicit JavaScriptGcScheduler(const JavaScriptGcSchedulerConfig& config = JavaScriptGcSchedulerConfig());
+
+    const JavaScriptGcSchedulerConfig& getConfig() const;
+
+    void onJsActivity(TimePoint now);
+    bool hasActivitySinceLastCollection() const;
+
+    /**
+     Decide what to do given the current heap size. A heap size of 0 means that the engine
+     does not report it, in which case the collections only depend on the JS thread activity.
+     */
+    Decision evaluate(TimePoint now, size_t heapSizeBytes) const;
+
+    void onCollected(TimePoint now, size_t heapSizeBytes);
+
+    void onInteraction(TimePoint now);
+    void onAnimationBegan(TimePoint now);
+    void onAnimationEnded();
+    bool isInteracting(TimePoint now) const;
+
+private:
+    JavaScriptGcSchedulerConfig _config;
+    TimePoint _lastJsActivity;
+    TimePoint _lastCollection;
+    size_t _heapSizeAfterLastCollection = 0;
+    bool _hasActivitySinceLastCollection = false;
+
+    std::atomic<int64_t> _lastInteractionNs;
+    std::atomic<int64_t> _lastAnimationBeganNs;
+    std::atomic<int> _runningAnimationsCount;
+};
+
+} // namespace Valdi
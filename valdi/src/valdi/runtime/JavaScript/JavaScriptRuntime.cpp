@@ -264,6 +264,7 @@ JavaScriptRuntime::JavaScriptRuntime(IJavaScriptBridge& jsBridge,
       _listener(nullptr),
       _anrDetector(anrDetector),
       _isDisposed(false),
+      _idleGcEnabled(false),
       _enableDebugger(enableDebugger),
       _enableStackTraceCapture(enableDebugger),
       _platformType(platformType),
@@ -360,6 +361,11 @@ void JavaScriptRuntime::teardown(bool destroyContext) {
     // Just in case postInit() was never called
     _initLock.leaveIfNotCompleted();
 
+    auto workerPool = getWorkerPool();
+    if (workerPool != nullptr) {
+        workerPool->teardown();
+    }
+
     if (destroyContext) {
         _dispatchQueue->sync([&]() {
             if (_anrDetector != nullptr) {
@@ -1240,8 +1246,11 @@ JSValueRef JavaScriptRuntime::runtimeLoadModule(JSFunctionNativeCallContext& cal
             callContext.getExceptionTracker());
     }
 
+    // Preloads can wait behind the downloads that the UI is blocked on
+    auto priority = callback == nullptr ? RemoteDownloaderPriorityBackground : RemoteDownloaderPriorityUrgent;
+
     _resourceManager.loadModuleAsync(
-        moduleName, ResourceManagerLoadModuleType::Sources, [this, callback](const Result<Void>& result) {
+        moduleName, ResourceManagerLoadModuleType::Sources, priority, [this, callback](const Result<Void>& result) {
             if (callback == nullptr) {
                 return;
             }
@@ -2014,24 +2023,7 @@ JSValueRef JavaScriptRuntime::runtimeSetUnhandledRejectionHandler(JSFunctionNati
 }
 
 JSValueRef JavaScriptRuntime::runtimeCreateWorker(JSFunctionNativeCallContext& callContext) {
-    auto workerRuntime = makeShared<JavaScriptRuntime>(_javaScriptBridge,
-                                                       _resourceManager,
-                                                       _contextManager,
-                                                       _mainThreadManager,
-                                                       _attributeIds,
-                                                       _platformType,
-                                                       _enableDebugger,
-                                                       ThreadQoSClassHigh,
-                                                       _anrDetector,
-                                                       _logger,
-                                                       true);
-    workerRuntime->postInit();
-    for (const auto& moduleFactory : _moduleFactories) {
-        workerRuntime->registerJavaScriptModuleFactory(moduleFactory);
-    }
-    for (const auto& typeConverter : _typeConverters) {
-        workerRuntime->registerTypeConverter(typeConverter.typeName, typeConverter.functionPath);
-    }
+    auto workerRuntime = createWorkerRuntime();
     auto worker = makeShared<JavaScriptWorker>(workerRuntime, callContext.getParameterAsString(0));
     worker->postInit();
     CHECK_CALL_CONTEXT(callContext);
@@ -3003,9 +2995,106 @@ Ref<JSStackTraceProvider> JavaScriptRuntime::doCaptureCurrentStackTrace(IJavaScr
 }
 
 void JavaScriptRuntime::performGcNow(IJavaScriptContext& jsContext) {
+    static auto kReason = STRING_LITERAL("explicit");
+    performGcNow(jsContext, kReason, 0);
+}
+
+void JavaScriptRuntime::performGcNow(IJavaScriptContext& jsContext,
+                                     const StringBox& reason,
+                                     size_t heapSizeBeforeBytes) {
     _hasGcScheduled = false;
+    MetricsStopWatch stopWatch;
     jsContext.garbageCollect();
-    VALDI_DEBUG(*_logger, "Performed JS GC");
+    auto pauseDuration = stopWatch.elapsed();
+
+    size_t heapSizeAfterBytes = 0;
+    if (_idleGcEnabled) {
+        heapSizeAfterBytes = jsContext.getHeapSizeBytes();
+        _gcScheduler.onCollected(std::chrono::steady_clock::now(), heapSizeAfterBytes);
+    }
+
+    const auto& metrics = getMetrics();
+    if (metrics != nullptr) {
+        metrics->emitJsGarbageCollection(reason, pauseDuration, heapSizeBeforeBytes, heapSizeAfterBytes);
+    }
+
+    VALDI_DEBUG(*_logger, "Performed JS GC ({}) in {}", reason, pauseDuration);
+}
+
+void JavaScriptRuntime::setIdleGcEnabled(bool idleGcEnabled) {
+    _idleGcEnabled = idleGcEnabled;
+}
+
+void JavaScriptRuntime::notifyUserInteraction() {
+    _gcScheduler.onInteraction(std::chrono::steady_clock::now());
+}
+
+void JavaScriptRuntime::beginAnimation() {
+    _gcScheduler.onAnimationBegan(std::chrono::steady_clock::now());
+}
+
+void JavaScriptRuntime::endAnimation() {
+    _gcScheduler.onAnimationEnded();
+}
+
+void JavaScriptRuntime::onJsTaskCompleted() {
+    if (!_idleGcEnabled) {
+        return;
+    }
+
+    _gcScheduler.onJsActivity(std::chrono::steady_clock::now());
+    if (!_hasIdleGcCheckScheduled) {
+        scheduleIdleGcCheck(_gcScheduler.getConfig().idleDelay);
+    }
+}
+
+void JavaScriptRuntime::scheduleIdleGcCheck(std::chrono::steady_clock::duration delay) {
+    _hasIdleGcCheckScheduled = true;
+    // The check is dispatched as a raw task, so that it does not count as JS activity itself
+    _dispatchQueue->asyncAfter(
+        [weakSelf = weakRef(this)]() {
+            auto self = weakSelf.lock();
+            if (self != nullptr) {
+                self->performIdleGcCheck();
+            }
+        },
+        delay);
+}
+
+void JavaScriptRuntime::performIdleGcCheck() {
+    _hasIdleGcCheckScheduled = false;
+    if (_javaScriptContext == nullptr || !_running || !_idleGcEnabled) {
+        return;
+    }
+
+    auto& jsContext = *_javaScriptContext;
+    auto now = std::chrono::steady_clock::now();
+    auto heapSizeBytes = jsContext.getHeapSizeBytes();
+    if (heapSizeBytes == 0) {
+        VALDI_INFO(*_logger, "Disabling idle JS GC as the JS engine does not report its heap size");
+        _idleGcEnabled = false;
+        return;
+    }
+
+    auto decision = _gcScheduler.evaluate(now, heapSizeBytes);
+
+    switch (decision.action) {
+        case JavaScriptGcScheduler::Action::None:
+            break;
+        case JavaScriptGcScheduler::Action::Defer:
+            scheduleIdleGcCheck(decision.checkDelay);
+            break;
+        case JavaScriptGcScheduler::Action::CollectWhenIdle: {
+            static auto kReason = STRING_LITERAL("idle");
+            JavaScriptContextEntry entry(_globalContext);
+            performGcNow(jsContext, kReason, heapSizeBytes);
+        } break;
+        case JavaScriptGcScheduler::Action::CollectOverHeadroom: {
+            static auto kReason = STRING_LITERAL("headroom");
+            JavaScriptContextEntry entry(_globalContext);
+            performGcNow(jsContext, kReason, heapSizeBytes);
+        } break;
+    }
 }
 
 JavaScriptContextMemoryStatistics JavaScriptRuntime::dumpMemoryStatistics(IJavaScriptContext& jsContext) {
@@ -3153,7 +3242,7 @@ void JavaScriptRuntime::destroyNativeObjectsManager(
         });
 }
 
-std::shared_ptr<snap::valdi_core::JSRuntime> JavaScriptRuntime::createWorker() {
+Ref<JavaScriptRuntime> JavaScriptRuntime::makeWorkerRuntime() {
     auto workerRuntime = makeShared<JavaScriptRuntime>(_javaScriptBridge,
                                                        _resourceManager,
                                                        _contextManager,
@@ -3166,12 +3255,86 @@ std::shared_ptr<snap::valdi_core::JSRuntime> JavaScriptRuntime::createWorker() {
                                                        _logger,
                                                        true);
     workerRuntime->postInit();
+    return workerRuntime;
+}
+
+Ref<JavaScriptRuntime> JavaScriptRuntime::createWorkerRuntime() {
+    Ref<JavaScriptRuntime> workerRuntime;
+    auto workerPool = getWorkerPool();
+    if (workerPool != nullptr) {
+        auto pooledRuntime = workerPool->take();
+        if (pooledRuntime && pooledRuntime.value() != nullptr) {
+            workerRuntime = std::move(pooledRuntime.value());
+        }
+    }
+
+    if (workerRuntime == nullptr) {
+        workerRuntime = makeWorkerRuntime();
+    }
+
+    // Registered after taking the runtime from the pool, as the factories might have changed since it was created
     for (const auto& moduleFactory : _moduleFactories) {
         workerRuntime->registerJavaScriptModuleFactory(moduleFactory);
     }
     for (const auto& typeConverter : _typeConverters) {
         workerRuntime->registerTypeConverter(typeConverter.typeName, typeConverter.functionPath);
     }
+
+    return workerRuntime;
+}
+
+Ref<PrewarmedPool<Ref<JavaScriptRuntime>>> JavaScriptRuntime::getWorkerPool() {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _workerPool;
+}
+
+void JavaScriptRuntime::setWorkerPoolCapacity(size_t capacity) {
+    if (_isWorker) {
+        return;
+    }
+
+    Ref<PrewarmedPool<Ref<JavaScriptRuntime>>> workerPool;
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        // Checked under the lock so that teardown() always sees the pool created here
+        if (_isDisposed) {
+            return;
+        }
+
+        if (_workerPool == nullptr) {
+            if (capacity == 0) {
+                return;
+            }
+
+            auto queue = DispatchQueue::create(STRING_LITERAL("Valdi JS Worker Pool"), ThreadQoSClassLow);
+            _workerPool = makeShared<PrewarmedPool<Ref<JavaScriptRuntime>>>(
+                queue, [weakSelf = weakRef(this)]() -> Ref<JavaScriptRuntime> {
+                    auto self = weakSelf.lock();
+                    if (self == nullptr || self->isDisposed()) {
+                        return nullptr;
+                    }
+
+                    auto workerRuntime = self->makeWorkerRuntime();
+                    // Wait until the worker has initialized its JS context and loaded the core modules
+                    workerRuntime->dispatchSynchronouslyOnJsThread([](JavaScriptEntryParameters& /*jsEntry*/) {});
+                    return workerRuntime;
+                });
+        }
+        workerPool = _workerPool;
+    }
+
+    workerPool->setCapacity(capacity);
+}
+
+void JavaScriptRuntime::trimWorkerPool() {
+    auto workerPool = getWorkerPool();
+    if (workerPool != nullptr) {
+        workerPool->trim();
+    }
+}
+
+std::shared_ptr<snap::valdi_core::JSRuntime> JavaScriptRuntime::createWorker() {
+    auto workerRuntime = createWorkerRuntime();
     _jsWorkers.emplace_back(weakRef(workerRuntime.get()));
     return std::dynamic_pointer_cast<snap::valdi_core::JSRuntime>(*workerRuntime->getInnerSharedPtr());
 }
@@ -3573,6 +3736,8 @@ DispatchFunction JavaScriptRuntime::makeJsThreadDispatchFunction(Ref<Context>&&
                 handleUncaughtJsError(jsContext, ownerContext, exceptionTracker);
             }
         });
+
+        onJsTaskCompleted();
     };
 }
 
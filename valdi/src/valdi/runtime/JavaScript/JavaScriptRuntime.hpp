@@ -20,6 +20,7 @@
 
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
 #include "valdi/runtime/Utils/DumpedLogs.hpp"
+#include "valdi/runtime/Utils/PrewarmedPool.hpp"
 
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
@@ -35,6 +36,7 @@
 
 #include "valdi/runtime/JavaScript/JSPropertyNameIndex.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptComponentContextHandler.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptGcScheduler.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptStringCache.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptTaskScheduler.hpp"
 #include "valdi_core/cpp/JavaScript/JavaScriptPathResolver.hpp"
@@ -233,6 +235,43 @@ public:
     void performGc();
     JavaScriptContextMemoryStatistics dumpMemoryStatistics();
 
+    /**
+     Enable garbage collections scheduled by the runtime when the JS thread becomes idle.
+     Collections are deferred while the user interacts with the UI, unless the heap grows
+     past the headroom of the GC scheduler. Disabled by default, driven by the
+     VALDI_ENABLE_IDLE_GC runtime tweak. Can be called from any thread. Turns itself off
+     on JS engines which do not report their heap size, like JavaScriptCore.
+     */
+    void setIdleGcEnabled(bool idleGcEnabled);
+
+    /**
+     Notify that the user is interacting with the UI, for example scrolling.
+     Can be called from any thread.
+     */
+    void notifyUserInteraction();
+
+    /**
+     Notify that an animation started or completed. Every beginAnimation() call must
+     be balanced by an endAnimation() call. Can be called from any thread.
+     */
+    void beginAnimation();
+    void endAnimation();
+
+    /**
+     Set how many worker runtimes should be kept initialized ahead of time, so that
+     creating a worker does not need to wait for its JS context to be initialized.
+     The pool is refilled from a background thread. Disabled by default.
+     */
+    void setWorkerPoolCapacity(size_t capacity);
+
+    /**
+     Destroy the worker runtimes kept in the pool, typically on memory pressure.
+     */
+    void trimWorkerPool();
+
+    // For Testing Only
+    Ref<PrewarmedPool<Ref<JavaScriptRuntime>>> getWorkerPool();
+
     Result<Value> evaluateScript(const BytesView& script, const StringBox& sourceFilename);
 
     bool isJsModuleLoaded(const ResourceId& resourceId);
@@ -352,6 +391,9 @@ private:
     // A lock that will block the JS thread until postInit() is called and the initialization has completed
     AsyncGroup _initLock;
     bool _hasGcScheduled = false;
+    bool _hasIdleGcCheckScheduled = false;
+    std::atomic<bool> _idleGcEnabled;
+    JavaScriptGcScheduler _gcScheduler;
     bool _symbolicating = false;
     bool _running = false;
     bool _enableDebugger;
@@ -369,6 +411,7 @@ private:
     std::vector<RegisteredTypeConverter> _typeConverters;
     std::vector<Ref<JavaScriptStacktraceCaptureSession>> _stacktraceCaptureSessions;
     std::vector<Weak<JavaScriptRuntime>> _jsWorkers;
+    Ref<PrewarmedPool<Ref<JavaScriptRuntime>>> _workerPool;
 
     Shared<JSValueRefHolder> _uncaughtExceptionHandler;
     Shared<JSValueRefHolder> _unhandledRejectionHandler;
@@ -518,8 +561,14 @@ private:
     void reevalUnloadedModulesIfNeeded();
 
     std::vector<Ref<JavaScriptRuntime>> getAllWorkers();
+    Ref<JavaScriptRuntime> makeWorkerRuntime();
+    Ref<JavaScriptRuntime> createWorkerRuntime();
     void dispatchPerformGcToWorkers();
     void performGcNow(IJavaScriptContext& jsContext);
+    void performGcNow(IJavaScriptContext& jsContext, const StringBox& reason, size_t heapSizeBeforeBytes);
+    void onJsTaskCompleted();
+    void scheduleIdleGcCheck(std::chrono::steady_clock::duration delay);
+    void performIdleGcCheck();
     JavaScriptContextMemoryStatistics dumpMemoryStatistics(IJavaScriptContext& jsContext);
 
     [[nodiscard]] Result<Shared<JavaScriptModuleContainer>> loadModuleContent(
@@ -16,6 +16,7 @@
 
 #include "valdi_core/cpp/Schema/ValueSchema.hpp"
 #include "valdi_core/cpp/Utils/InlineContainerAllocator.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 #include "valdi_core/cpp/Utils/ValueMarshaller.hpp"
@@ -220,19 +221,17 @@ public:
         auto& jsContext = getContext();
         auto& jsExceptionTracker = toJSExceptionTracker(exceptionTracker);
 
-        auto object = jsContext.newObject(jsExceptionTracker);
-        if (!jsExceptionTracker) {
-            return jsContext.newUndefined();
-        }
-
+        SmallVector<JSValue, 16> values;
+        values.reserve(_propertiesSize);
         for (size_t i = 0; i < _propertiesSize; i++) {
-            jsContext.setObjectProperty(object.get(), getPropertyName(i), propertyValues[i].get(), jsExceptionTracker);
-            if (!jsExceptionTracker) {
-                return jsContext.newUndefined();
-            }
+            values.emplace_back(propertyValues[i].get());
         }
 
-        return object;
+        // Property names are resolved once per class and always passed in schema order,
+        // so objects of the same class end up sharing their shape in the engine.
+        InlineContainerAllocator<JavaScriptClassDelegate, JSPropertyName> allocator;
+        return jsContext.newObjectWithProperties(
+            allocator.getContainerStartPtr(this), values.data(), _propertiesSize, jsExceptionTracker);
     }
 
     JSValueRef getProperty(const JSValueRef& object, size_t propertyIndex, ExceptionTracker& exceptionTracker) final {
@@ -1,4 +1,5 @@
 #include "valdi/runtime/JavaScript/Modules/FileSystemFactory.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/DiskUtils.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
@@ -7,7 +8,93 @@
 #include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 
+#include <algorithm>
+#include <array>
+
 namespace Valdi {
+
+static std::optional<size_t> getSizeOption(const Value& options, std::string_view key) {
+    auto value = options.getMapValue(key);
+    if (!value.isNumber()) {
+        return std::nullopt;
+    }
+
+    return static_cast<size_t>(std::max(value.toLong(), static_cast<int64_t>(0)));
+}
+
+static Result<Value> readFile(const StringBox& pathToFile, const Value& options) {
+    Path const path = Path(pathToFile.toStringView());
+
+    auto encoding = options.getMapValue("encoding");
+    auto byteOffset = getSizeOption(options, "offset").value_or(0);
+    auto size = getSizeOption(options, "length");
+    auto isBinary = encoding != Value("utf8") && encoding != Value("utf16");
+    // Mapping is opt-in, as the process crashes when a mapped file is truncated by another writer
+    auto mapped = isBinary && options.getMapValue("mapped").toBool();
+
+    auto result = mapped ? DiskUtils::mapFile(path, byteOffset, size) : DiskUtils::load(path, byteOffset, size);
+    if (!result) {
+        return Error(STRING_FORMAT("Could not read the file at path: '{}'", pathToFile));
+    }
+
+    auto fileContent = result.moveValue();
+
+    if (encoding == Value("utf8")) {
+        return Value(StaticString::makeUTF8(fileContent.asStringView()));
+    } else if (encoding == Value("utf16")) {
+        return Value(StaticString::makeUTF16(reinterpret_cast<const char16_t*>(fileContent.data()),
+                                             fileContent.size() / sizeof(char16_t)));
+    } else {
+        // The ArrayBuffer is backed by the loaded or mapped bytes directly
+        return Value(makeShared<ValueTypedArray>(ArrayBuffer, fileContent));
+    }
+}
+
+static BytesView getFileContentBytes(const Value& fileContent) {
+    if (fileContent.isTypedArray()) {
+        return fileContent.getTypedArray()->getBuffer();
+    } else if (fileContent.isString()) {
+        auto string = fileContent.toStringBox();
+        return BytesView(string.getInternedString(), reinterpret_cast<const Byte*>(string.getCStr()), string.length());
+    }
+
+    return BytesView();
+}
+
+static Result<Void> writeFile(const StringBox& pathToFile, const BytesView& bytes) {
+    Path const path = Path(pathToFile.toStringView());
+
+    if (DiskUtils::isFile(path)) {
+        DiskUtils::remove(path);
+    }
+
+    if (path.getComponents().size() > 1) {
+        auto directory = path.removingLastComponent();
+        if (!DiskUtils::isDirectory(directory)) {
+            DiskUtils::makeDirectory(directory, true);
+        }
+    }
+
+    auto result = DiskUtils::store(path, bytes);
+    if (!result) {
+        return Error(STRING_FORMAT("Could not store the file at path: '{}'", pathToFile));
+    }
+
+    return Void();
+}
+
+// Calls the completion with the value and the error message, from the IO queue
+static void callCompletion(const Ref<ValueFunction>& completion, const Result<Value>& result) {
+    std::array<Value, 2> params;
+    if (result) {
+        params[0] = result.value();
+    } else {
+        params[1] = Value(result.error().toString());
+    }
+
+    (*completion)(params.data(), params.size());
+}
+
 FileSystemFactory::FileSystemFactory() = default;
 FileSystemFactory::~FileSystemFactory() = default;
 
@@ -15,6 +102,15 @@ StringBox FileSystemFactory::getModulePath() {
     return STRING_LITERAL("FileSystem");
 }
 
+Ref<DispatchQueue> FileSystemFactory::getIOQueue() {
+    std::lock_guard<Mutex> lock(_mutex);
+    if (_ioQueue == nullptr) {
+        // Created on first use, so that runtimes which don't use the async functions don't pay for a thread
+        _ioQueue = DispatchQueue::create(STRING_LITERAL("Valdi FileSystem IO"), ThreadQoSClassNormal);
+    }
+    return _ioQueue;
+}
+
 Value FileSystemFactory::loadModule() {
     Value out;
 
@@ -77,29 +173,13 @@ Value FileSystemFactory::loadModule() {
                 return Value::undefined();
             }
 
-            auto options = callContext.getParameter(1);
-
-            Path const path = Path(pathToFile.toStringView());
-
-            auto result = DiskUtils::load(path);
+            auto result = readFile(pathToFile, callContext.getParameter(1));
             if (!result) {
-                callContext.getExceptionTracker().onError(
-                    fmt::format("Could not read the file at path: '{}'", pathToFile));
+                callContext.getExceptionTracker().onError(result.moveError());
                 return Value::undefined();
             }
 
-            auto fileContent = result.moveValue();
-
-            auto encoding = options.getMapValue("encoding");
-
-            if (encoding == Value("utf8")) {
-                return Value(StaticString::makeUTF8(fileContent.asStringView()));
-            } else if (encoding == Value("utf16")) {
-                return Value(StaticString::makeUTF16(reinterpret_cast<const char16_t*>(fileContent.data()),
-                                                     fileContent.size() / sizeof(char16_t)));
-            } else {
-                return Value(makeShared<ValueTypedArray>(ArrayBuffer, fileContent));
-            }
+            return result.moveValue();
         })));
 
     out.setMapValue(
@@ -118,36 +198,93 @@ Value FileSystemFactory::loadModule() {
                 return Value::undefined();
             }
 
-            BytesView bytes;
+            auto result = writeFile(pathToFile, getFileContentBytes(fileContent));
+            if (!result) {
+                callContext.getExceptionTracker().onError(result.moveError());
+                return Value::undefined();
+            }
+
+            return Value::undefined();
+        })));
+
+    out.setMapValue(
+        "readFile",
+        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+            auto pathToFile = callContext.getParameterAsString(0);
+            auto options = callContext.getParameter(1);
+            auto completion = callContext.getParameterAsFunction(2);
+
+            if (!callContext.getExceptionTracker()) {
+                return Value::undefined();
+            }
+
+            strongThis->getIOQueue()->async([pathToFile, options, completion]() {
+                callCompletion(completion, readFile(pathToFile, options));
+            });
 
-            if (fileContent.isTypedArray()) {
-                bytes = fileContent.getTypedArray()->getBuffer();
-            } else if (fileContent.isString()) {
-                auto string = fileContent.toStringBox();
-                bytes = BytesView(
-                    string.getInternedString(), reinterpret_cast<const Byte*>(string.getCStr()), string.length());
+            return Value::undefined();
+        })));
+
+    out.setMapValue(
+        "writeFile",
+        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+            auto pathToFile = callContext.getParameterAsString(0);
+            auto bytes = getFileContentBytes(callContext.getParameter(1));
+            auto completion = callContext.getParameterAsFunction(2);
+
+            if (!callContext.getExceptionTracker()) {
+                return Value::undefined();
             }
 
-            Path const path = Path(pathToFile.toStringView());
+            strongThis->getIOQueue()->async([pathToFile, bytes, completion]() {
+                auto result = writeFile(pathToFile, bytes);
+                callCompletion(completion, result ? Result<Value>(Value::undefined()) : result.moveError());
+            });
+
+            return Value::undefined();
+        })));
+
+    out.setMapValue(
+        "remove",
+        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+            auto pathName = callContext.getParameterAsString(0);
+            auto completion = callContext.getParameterAsFunction(1);
 
-            if (DiskUtils::isFile(path)) {
-                DiskUtils::remove(path);
+            if (!callContext.getExceptionTracker()) {
+                return Value::undefined();
             }
 
-            if (path.getComponents().size() > 1) {
-                auto directory = path.removingLastComponent();
-                if (!DiskUtils::isDirectory(directory)) {
-                    DiskUtils::makeDirectory(directory, true);
+            strongThis->getIOQueue()->async([pathName, completion]() {
+                if (DiskUtils::remove(Path(pathName.toStringView()))) {
+                    callCompletion(completion, Value(true));
+                } else {
+                    callCompletion(completion, Error(STRING_FORMAT("Could not remove path: '{}'", pathName)));
                 }
-            }
+            });
 
-            auto result = DiskUtils::store(path, bytes);
-            if (!result) {
-                callContext.getExceptionTracker().onError(
-                    fmt::format("Could not store the file at path: '{}'", pathToFile));
+            return Value::undefined();
+        })));
+
+    out.setMapValue(
+        "createDirectory",
+        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+            auto pathName = callContext.getParameterAsString(0);
+            auto createIntermediates = callContext.getParameterAsBool(1);
+            auto completion = callContext.getParameterAsFunction(2);
+
+            if (!callContext.getExceptionTracker()) {
                 return Value::undefined();
             }
 
+            strongThis->getIOQueue()->async([pathName, createIntermediates, completion]() {
+                if (DiskUtils::makeDirectory(Path(pathName.toStringView()), createIntermediates)) {
+                    callCompletion(completion, Value(true));
+                } else {
+                    callCompletion(completion,
+                                   Error(STRING_FORMAT("Could not create directory at path: '{}'", pathName)));
+                }
+            });
+
             return Value::undefined();
         })));
 
@@ -1,10 +1,18 @@
 #pragma once
 
 #include "valdi_core/ModuleFactory.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 
 namespace Valdi {
 
+class DispatchQueue;
+
+/**
+ Native module exposing the file system to JS. On top of the sync functions, it
+ provides async variants which perform the disk IO on a dedicated queue and call
+ a completion with the result, so that large files don't block the JS thread.
+ */
 class FileSystemFactory : public Valdi::SharedPtrRefCountable, public snap::valdi_core::ModuleFactory {
 public:
     FileSystemFactory();
@@ -12,6 +20,12 @@ public:
 
     StringBox getModulePath() override;
     Value loadModule() override;
+
+private:
+    Mutex _mutex;
+    Ref<DispatchQueue> _ioQueue;
+
+    Ref<DispatchQueue> getIOQueue();
 };
 
 } // namespace Valdi
@@ -70,6 +70,52 @@ public:
 
     virtual void emitLoadModuleMemory(const StringBox& module, int64_t totalMemory, int64_t ownMemory) {};
 
+    /**
+     Emitted when multiple render requests submitted within the same frame were merged
+     into one. The merge ratio is given by mergedEntriesCount / entriesCount.
+     */
+    virtual void emitRenderRequestsCoalesced(const StringBox& module,
+                                             size_t requestsCount,
+                                             size_t entriesCount,
+                                             size_t mergedEntriesCount) {};
+
+    /**
+     Emitted periodically for every root drawn by the given backend, with the timings of its
+     last frames. Superseded frames were replaced by a newer frame before they could be drawn,
+     dropped frames were not processed because the frame rate of the root was lowered.
+     The composition durations cover all the processed frames, including the superseded ones.
+     */
+    virtual void emitFrameTimings(const StringBox& backend,
+                                  size_t framesCount,
+                                  size_t supersededFramesCount,
+                                  size_t droppedFramesCount,
+                                  size_t missedDeadlinesCount,
+                                  const MetricsDuration& averageProcessDuration,
+                                  const MetricsDuration& averageCompositionDuration,
+                                  const MetricsDuration& maxCompositionDuration,
+                                  const MetricsDuration& averageDrawDuration) {};
+
+    /**
+     Emitted after every garbage collection performed by a JS runtime. The reason is either
+     "idle" or "headroom" when it was triggered by the GC scheduler, or "explicit" otherwise.
+     The heap sizes are 0 when the engine does not report them.
+     */
+    virtual void emitJsGarbageCollection(const StringBox& reason,
+                                         const MetricsDuration& pauseDuration,
+                                         size_t heapSizeBeforeBytes,
+                                         size_t heapSizeAfterBytes) {};
+
+    /**
+     Emitted after every network download made by the RemoteDownloader, with the time the
+     download waited for a free slot and the time its transfer took. The priority is either
+     "urgent", "normal" or "background".
+     */
+    virtual void emitRemoteDownload(const StringBox& item,
+                                    const StringBox& priority,
+                                    const MetricsDuration& queueWaitDuration,
+                                    const MetricsDuration& transferDuration,
+                                    bool success) {};
+
     static ScopedMetrics scopedOnScrollLatency(const Ref<Metrics>& metrics,
                                                const StringBox& module,
                                                const StringBox& backend);
@@ -75,6 +75,16 @@ public:
     RenderRequestEntries::CancelAnimation* appendCancelAnimation();
     RenderRequestEntries::OnLayoutComplete* appendOnLayoutComplete();
 
+    /**
+     Append a copy of an entry taken from another RenderRequest
+     */
+    template<typename T>
+    T* appendEntryCopy(const T& entry) {
+        auto* newEntry = reinterpret_cast<T*>(doAppendEntry(getEntryAllocSize<T>()));
+        new (newEntry) T(entry);
+        return newEntry;
+    }
+
     template<typename Visitor>
     void visitEntries(Visitor& visitor) const {
         const_cast<RenderRequest*>(this)->visitEntries(visitor);
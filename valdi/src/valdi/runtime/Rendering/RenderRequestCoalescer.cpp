@@ -0,0 +1,247 @@
+//
+//  RenderRequestCoalescer.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Rendering/RenderRequestCoalescer.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+
+namespace Valdi {
+
+namespace {
+
+struct CollectEntriesVisitor {
+    std::vector<RenderRequestEntries::EntryBase*>& entries;
+
+    template<typename T>
+    void visit(T& entry) {
+        entries.emplace_back(&entry);
+    }
+};
+
+struct ElementLifetime {
+    size_t createIndex = 0;
+    size_t destroyIndex = 0;
+    bool attached = false;
+};
+
+struct AttributeFoldState {
+    uint32_t segment = 0;
+    uint32_t generation = 0;
+};
+
+bool isAnimationEntry(RenderRequestEntryType type) {
+    return type == RenderRequestEntryType::StartAnimations || type == RenderRequestEntryType::EndAnimations ||
+           type == RenderRequestEntryType::CancelAnimation;
+}
+
+const RenderRequestEntries::ElementEntryBase* asElementEntry(const RenderRequestEntries::EntryBase* entry) {
+    switch (entry->getType()) {
+        case RenderRequestEntryType::CreateElement:
+        case RenderRequestEntryType::DestroyElement:
+        case RenderRequestEntryType::MoveElementToParent:
+        case RenderRequestEntryType::SetRootElement:
+        case RenderRequestEntryType::SetElementAttribute:
+            return static_cast<const RenderRequestEntries::ElementEntryBase*>(entry);
+        default:
+            return nullptr;
+    }
+}
+
+uint64_t makeAttributeKey(const RenderRequestEntries::SetElementAttribute& entry) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(entry.getElementId())) << 32) |
+           (static_cast<uint64_t>(entry.getAttributeId()) << 1) | (entry.isInjectedFromParent() ? 1 : 0);
+}
+
+/**
+ Drops the elements which were created and destroyed within the window. We only do it
+ for elements that never made it into the tree, as removing an attached element would
+ shift the indexes used by the MoveElementToParent entries of its siblings.
+ */
+void dropTransientElements(const std::vector<RenderRequestEntries::EntryBase*>& entries,
+                           std::vector<bool>& keep,
+                           RenderRequestCoalescingStats& stats) {
+    FlatMap<RawViewNodeId, ElementLifetime> createdElements;
+    FlatMap<RawViewNodeId, ElementLifetime> transientElements;
+
+    auto markAttached = [&](RawViewNodeId elementId) {
+        const auto& it = createdElements.find(elementId);
+        if (it != createdElements.end()) {
+            it->second.attached = true;
+        }
+    };
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto* entry = entries[i];
+        switch (entry->getType()) {
+            case RenderRequestEntryType::CreateElement: {
+                auto elementId = static_cast<const RenderRequestEntries::CreateElement*>(entry)->getElementId();
+                auto& lifetime = createdElements[elementId];
+                lifetime = ElementLifetime();
+                lifetime.createIndex = i;
+            } break;
+            case RenderRequestEntryType::MoveElementToParent: {
+                const auto* moveEntry = static_cast<const RenderRequestEntries::MoveElementToParent*>(entry);
+                markAttached(moveEntry->getElementId());
+                markAttached(moveEntry->getParentElementId());
+            } break;
+            case RenderRequestEntryType::SetRootElement:
+                markAttached(static_cast<const RenderRequestEntries::SetRootElement*>(entry)->getElementId());
+                break;
+            case RenderRequestEntryType::DestroyElement: {
+                auto elementId = static_cast<const RenderRequestEntries::DestroyElement*>(entry)->getElementId();
+                const auto& it = createdElements.find(elementId);
+                if (it != createdElements.end()) {
+                    if (!it->second.attached) {
+                        auto lifetime = it->second;
+                        lifetime.destroyIndex = i;
+                        transientElements[elementId] = lifetime;
+                    }
+                    createdElements.erase(it);
+                }
+            } break;
+            default:
+                break;
+        }
+    }
+
+    if (transientElements.empty()) {
+        return;
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto* elementEntry = asElementEntry(entries[i]);
+        if (elementEntry == nullptr) {
+            continue;
+        }
+        const auto& it = transientElements.find(elementEntry->getElementId());
+        if (it != transientElements.end() && i >= it->second.createIndex && i <= it->second.destroyIndex) {
+            keep[i] = false;
+        }
+    }
+
+    stats.droppedElementsCount += transientElements.size();
+}
+
+/**
+ Keeps only the last value of each attribute. We walk the entries backward, such that the
+ first SetElementAttribute we see for an element and attribute is the one that wins. Animation
+ entries start a new segment, attributes are never folded across segments as the animation
+ applies to the values set within its block. Creating or destroying an element starts a new
+ generation for that element, so that a reused element id doesn't get its attributes folded.
+ */
+void foldAttributes(const std::vector<RenderRequestEntries::EntryBase*>& entries,
+                    std::vector<bool>& keep,
+                    RenderRequestCoalescingStats& stats) {
+    FlatMap<uint64_t, AttributeFoldState> lastAttributes;
+    FlatMap<RawViewNodeId, uint32_t> elementGenerations;
+    uint32_t segment = 0;
+
+    auto i = entries.size();
+    while (i > 0) {
+        i--;
+        if (!keep[i]) {
+            continue;
+        }
+
+        const auto* entry = entries[i];
+        auto type = entry->getType();
+        if (isAnimationEntry(type)) {
+            segment++;
+            continue;
+        }
+
+        if (type == RenderRequestEntryType::CreateElement || type == RenderRequestEntryType::DestroyElement) {
+            elementGenerations[static_cast<const RenderRequestEntries::ElementEntryBase*>(entry)->getElementId()]++;
+            continue;
+        }
+
+        if (type != RenderRequestEntryType::SetElementAttribute) {
+            continue;
+        }
+
+        const auto* attributeEntry = static_cast<const RenderRequestEntries::SetElementAttribute*>(entry);
+        AttributeFoldState state;
+        state.segment = segment;
+        const auto& generationIt = elementGenerations.find(attributeEntry->getElementId());
+        if (generationIt != elementGenerations.end()) {
+            state.generation = generationIt->second;
+        }
+
+        auto it = lastAttributes.try_emplace(makeAttributeKey(*attributeEntry), state);
+        if (!it.second) {
+            if (it.first->second.segment == state.segment && it.first->second.generation == state.generation) {
+                // A later entry sets the same attribute
+                keep[i] = false;
+                stats.foldedAttributesCount++;
+            } else {
+                it.first->second = state;
+            }
+        }
+    }
+}
+
+struct CopyEntryVisitor {
+    RenderRequest& output;
+
+    template<typename T>
+    void operator()(T& entry) {
+        output.appendEntryCopy(entry);
+    }
+};
+
+} // namespace
+
+Ref<RenderRequest> RenderRequestCoalescer::coalesce(const std::vector<Ref<RenderRequest>>& renderRequests,
+                                                    RenderRequestCoalescingStats& stats) {
+    stats.requestsCount += renderRequests.size();
+
+    if (renderRequests.size() == 1) {
+        // Nothing to merge, we avoid the copy of the entries
+        const auto& renderRequest = renderRequests[0];
+        stats.entriesCount += renderRequest->getEntriesSize();
+        stats.mergedEntriesCount += renderRequest->getEntriesSize();
+        return renderRequest;
+    }
+
+    std::vector<RenderRequestEntries::EntryBase*> entries;
+    size_t entriesCount = 0;
+    for (const auto& renderRequest : renderRequests) {
+        entriesCount += renderRequest->getEntriesSize();
+    }
+    entries.reserve(entriesCount);
+
+    auto output = makeShared<RenderRequest>();
+    CollectEntriesVisitor collectVisitor{entries};
+    for (const auto& renderRequest : renderRequests) {
+        output->setContextId(renderRequest->getContextId());
+        // Observer callbacks replace each other, only the last one needs to be registered
+        if (!renderRequest->getVisibilityObserverCallback().isNullOrUndefined()) {
+            output->setVisibilityObserverCallback(renderRequest->getVisibilityObserverCallback());
+        }
+        if (!renderRequest->getFrameObserverCallback().isNullOrUndefined()) {
+            output->setFrameObserverCallback(renderRequest->getFrameObserverCallback());
+        }
+
+        renderRequest->visitEntries(collectVisitor);
+    }
+    stats.entriesCount += entries.size();
+
+    std::vector<bool> keep(entries.size(), true);
+    dropTransientElements(entries, keep, stats);
+    foldAttributes(entries, keep, stats);
+
+    CopyEntryVisitor copyVisitor{*output};
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (keep[i]) {
+            RenderRequestEntries::visitEntry(*entries[i], copyVisitor);
+        }
+    }
+    stats.mergedEntriesCount += output->getEntriesSize();
+
+    return output;
+}
+
+} // namespace Valdi
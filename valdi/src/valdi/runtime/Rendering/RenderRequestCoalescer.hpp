@@ -0,0 +1,39 @@
+//
+//  RenderRequestCoalescer.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/Rendering/RenderRequest.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+struct RenderRequestCoalescingStats {
+    size_t requestsCount = 0;
+    size_t entriesCount = 0;
+    size_t mergedEntriesCount = 0;
+    size_t foldedAttributesCount = 0;
+    size_t droppedElementsCount = 0;
+};
+
+/**
+ Merges the render requests submitted for a Context within the same frame window into
+ a single request, so that they are applied, laid out and flushed in one pass. While
+ merging, the coalescer:
+ - Keeps only the last SetElementAttribute of a given element and attribute, as long as no
+   animation entry or lifecycle change of the element happened in between.
+ - Drops the elements that are created and destroyed within the window, when they were
+   never attached to a parent or used as a parent or root, along with their attributes.
+ */
+class RenderRequestCoalescer {
+public:
+    static Ref<RenderRequest> coalesce(const std::vector<Ref<RenderRequest>>& renderRequests,
+                                       RenderRequestCoalescingStats& stats);
+};
+
+} // namespace Valdi
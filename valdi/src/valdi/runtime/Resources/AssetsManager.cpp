@@ -353,8 +353,11 @@ void AssetsManager::resolveAssetLocation(AssetsManagerTransaction& transaction,
     if (bundle != nullptr) {
         if (bundle->hasRemoteAssets()) {
             transaction.releaseLock();
+            // Assets are resolved when a view needs them, they can't wait behind prefetches
             _remoteModuleManager->loadResources(
-                bundle->getName(), [assetKey, weakSelf = weakRef(this), resolveId](auto result) {
+                bundle->getName(),
+                RemoteDownloaderPriorityUrgent,
+                [assetKey, weakSelf = weakRef(this), resolveId](auto result) {
                     auto self = strongRef(weakSelf);
                     if (self == nullptr) {
                         return;
@@ -0,0 +1,78 @@
+//
+//  BatchedDiskCache.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Resources/BatchedDiskCache.hpp"
+
+#include <optional>
+
+namespace Valdi {
+
+BatchedDiskCache::BatchedDiskCache(const StringBox& rootPath)
+    : DiskCacheImpl(rootPath), _batchLoader(makeShared<DiskBatchLoader>()) {}
+
+BatchedDiskCache::BatchedDiskCache(Path rootPath, Path allowedReadPath, Ref<DiskBatchLoader> batchLoader)
+    : DiskCacheImpl(std::move(rootPath), std::move(allowedReadPath)), _batchLoader(std::move(batchLoader)) {}
+
+BatchedDiskCache::~BatchedDiskCache() = default;
+
+void BatchedDiskCache::loadMany(const std::vector<Path>& paths,
+                                const Function<void(std::vector<Result<BytesView>>)>& completion) {
+    std::vector<Path> resolvedPaths;
+    resolvedPaths.reserve(paths.size());
+    std::vector<std::optional<Error>> resolveErrors(paths.size());
+    auto hasResolveErrors = false;
+
+    for (size_t i = 0; i < paths.size(); i++) {
+        auto resolvedPath = resolveAbsolutePath(paths[i], true);
+        if (resolvedPath) {
+            resolvedPaths.emplace_back(resolvedPath.moveValue());
+        } else {
+            resolveErrors[i] = resolvedPath.moveError();
+            hasResolveErrors = true;
+        }
+    }
+
+    if (!hasResolveErrors) {
+        _batchLoader->loadAsync(std::move(resolvedPaths), completion);
+        return;
+    }
+
+    // Paths outside of the cache are not loaded, and their errors are put back at their original index
+    _batchLoader->loadAsync(std::move(resolvedPaths),
+                            [resolveErrors = std::move(resolveErrors),
+                             completion](std::vector<Result<BytesView>> loadResults) {
+                                std::vector<Result<BytesView>> results;
+                                results.reserve(resolveErrors.size());
+                                auto loadResultIt = loadResults.begin();
+                                for (const auto& resolveError : resolveErrors) {
+                                    if (resolveError) {
+                                        results.emplace_back(resolveError.value());
+                                    } else {
+                                        results.emplace_back(std::move(*loadResultIt));
+                                        loadResultIt++;
+                                    }
+                                }
+                                completion(std::move(results));
+                            });
+}
+
+Ref<IDiskCache> BatchedDiskCache::scopedCache(const Path& subfolder, bool allowsReadOutsideOfScope) const {
+    auto result = resolveAbsolutePath(subfolder, false);
+    if (result.failure()) {
+        return nullptr;
+    }
+    auto rootPath = result.value();
+    auto readPath = allowsReadOutsideOfScope ? getAllowedReadPath() : rootPath;
+
+    return makeShared<BatchedDiskCache>(std::move(rootPath), std::move(readPath), _batchLoader);
+}
+
+const Ref<DiskBatchLoader>& BatchedDiskCache::getBatchLoader() const {
+    return _batchLoader;
+}
+
+} // namespace Valdi
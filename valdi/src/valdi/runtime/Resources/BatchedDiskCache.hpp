@@ -0,0 +1,37 @@
+//
+//  BatchedDiskCache.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/Resources/DiskCacheImpl.hpp"
+#include "valdi/runtime/Resources/DiskBatchLoader.hpp"
+
+namespace Valdi {
+
+/**
+ A DiskCacheImpl which loads the items requested through loadMany()
+ as a single batch using a DiskBatchLoader, submitting the reads together
+ through io_uring on Linux. Scoped caches share the same loader.
+ */
+class BatchedDiskCache : public DiskCacheImpl {
+public:
+    explicit BatchedDiskCache(const StringBox& rootPath);
+    BatchedDiskCache(Path rootPath, Path allowedReadPath, Ref<DiskBatchLoader> batchLoader);
+    ~BatchedDiskCache() override;
+
+    void loadMany(const std::vector<Path>& paths,
+                  const Function<void(std::vector<Result<BytesView>>)>& completion) override;
+
+    Ref<IDiskCache> scopedCache(const Path& subfolder, bool allowsReadOutsideOfScope) const override;
+
+    const Ref<DiskBatchLoader>& getBatchLoader() const;
+
+private:
+    Ref<DiskBatchLoader> _batchLoader;
+};
+
+} // namespace Valdi
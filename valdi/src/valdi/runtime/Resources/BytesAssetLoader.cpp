@@ -93,6 +93,7 @@ Shared<snap::valdi_core::Cancelable> BytesAssetLoader::loadAsset(const Value& re
                          url,
                          transformer,
                          BytesView(),
+                         RemoteDownloaderPriorityUrgent,
                          [url, completion, weakThis = Valdi::weakRef(this), cancel](auto result, auto /*loadSource*/) {
                              Result<Ref<LoadedAsset>> retval;
 
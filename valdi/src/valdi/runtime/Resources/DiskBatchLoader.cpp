@@ -0,0 +1,499 @@
+//
+//  DiskBatchLoader.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Resources/DiskBatchLoader.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/DiskUtils.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <string>
+
+// io_uring is not used on Android, where the app seccomp policy can reject its syscalls.
+// The operations used here require the kernel headers from Linux 5.7 or later.
+#if defined(__linux__) && !defined(__ANDROID__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_FEAT_FAST_POLL)
+#define VALDI_HAS_IO_URING 1
+#endif
+#endif
+
+#ifndef VALDI_HAS_IO_URING
+#define VALDI_HAS_IO_URING 0
+#endif
+
+#if VALDI_HAS_IO_URING
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Valdi {
+
+// How many operations can be submitted to the ring at once
+constexpr unsigned kIOUringEntries = 64;
+// How many threads the batch is spread over when io_uring is not available
+constexpr size_t kFallbackThreadsCount = 4;
+
+#if VALDI_HAS_IO_URING
+
+/**
+ A minimal io_uring submission and completion ring, driven directly through
+ the io_uring syscalls. It is not thread safe.
+ */
+class IOUring {
+public:
+    ~IOUring() {
+        if (_sqes != nullptr) {
+            munmap(_sqes, _sqesSize);
+        }
+        if (_cqRing != nullptr && _cqRing != _sqRing) {
+            munmap(_cqRing, _cqRingSize);
+        }
+        if (_sqRing != nullptr) {
+            munmap(_sqRing, _sqRingSize);
+        }
+        close(_fd);
+    }
+
+    unsigned getCapacity() const {
+        return _capacity;
+    }
+
+    void prepareOpen(const char* path, uint64_t userData) {
+        auto* sqe = nextSqe(userData);
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<uint64_t>(path);
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        commitSqe();
+    }
+
+    void prepareRead(int fd, Byte* buffer, uint32_t size, uint64_t userData) {
+        auto* sqe = nextSqe(userData);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(buffer);
+        sqe->len = size;
+        sqe->off = 0;
+        commitSqe();
+    }
+
+    /**
+     Submit the prepared operations and wait until all of them completed,
+     calling onCompletion with the user data and result of each operation.
+     On failure, the operations which were already submitted are waited on
+     before returning false, so that their buffers and file descriptors can
+     be released by the caller.
+     */
+    template<typename F>
+    bool submitAndWait(F&& onCompletion) {
+        auto toSubmit = _prepared;
+        auto remaining = _prepared;
+        _prepared = 0;
+
+        while (remaining > 0) {
+            auto submitted = syscall(__NR_io_uring_enter, _fd, toSubmit, remaining, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted < 0) {
+                if (isTransientError(errno)) {
+                    continue;
+                }
+                drain(remaining - toSubmit, onCompletion);
+                return false;
+            }
+            toSubmit -= static_cast<unsigned>(submitted);
+            remaining -= reapCompletions(onCompletion);
+        }
+
+        return true;
+    }
+
+    /**
+     Returns whether some submitted operations could not be waited on after a failure.
+     The kernel might still access the buffers of those operations.
+     */
+    bool hasAbandonedOperations() const {
+        return _hasAbandonedOperations;
+    }
+
+    static std::unique_ptr<IOUring> create(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        auto fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        std::unique_ptr<IOUring> ioUring(new IOUring(fd));
+        if (!ioUring->map(params) || !ioUring->supportsOperations({IORING_OP_OPENAT, IORING_OP_READ})) {
+            return nullptr;
+        }
+
+        return ioUring;
+    }
+
+private:
+    int _fd;
+    unsigned _capacity = 0;
+    unsigned _prepared = 0;
+    bool _hasAbandonedOperations = false;
+
+    void* _sqRing = nullptr;
+    size_t _sqRingSize = 0;
+    void* _cqRing = nullptr;
+    size_t _cqRingSize = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqesSize = 0;
+
+    uint32_t* _sqTail = nullptr;
+    uint32_t _sqMask = 0;
+    uint32_t* _sqArray = nullptr;
+    uint32_t* _cqHead = nullptr;
+    uint32_t* _cqTail = nullptr;
+    uint32_t _cqMask = 0;
+    io_uring_cqe* _cqes = nullptr;
+
+    explicit IOUring(int fd) : _fd(fd) {}
+
+    bool map(const io_uring_params& params) {
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        auto singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMmap) {
+            _sqRingSize = std::max(_sqRingSize, _cqRingSize);
+            _cqRingSize = _sqRingSize;
+        }
+
+        _sqRing = mapRegion(_sqRingSize, IORING_OFF_SQ_RING);
+        if (_sqRing == nullptr) {
+            return false;
+        }
+
+        _cqRing = singleMmap ? _sqRing : mapRegion(_cqRingSize, IORING_OFF_CQ_RING);
+        if (_cqRing == nullptr) {
+            return false;
+        }
+
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        _sqes = reinterpret_cast<io_uring_sqe*>(mapRegion(_sqesSize, IORING_OFF_SQES));
+        if (_sqes == nullptr) {
+            return false;
+        }
+
+        auto* sq = reinterpret_cast<uint8_t*>(_sqRing);
+        _sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        _sqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+        auto* cq = reinterpret_cast<uint8_t*>(_cqRing);
+        _cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        _cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        _cqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        _capacity = params.sq_entries;
+
+        return true;
+    }
+
+    void* mapRegion(size_t size, off_t offset) const {
+        auto* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, offset);
+        return address == MAP_FAILED ? nullptr : address;
+    }
+
+    bool supportsOperations(std::initializer_list<uint8_t> operations) const {
+        constexpr size_t kMaxOperations = 256;
+        std::vector<uint8_t> storage(sizeof(io_uring_probe) + kMaxOperations * sizeof(io_uring_probe_op), 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+
+        if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PROBE, probe, kMaxOperations) < 0) {
+            return false;
+        }
+
+        return std::all_of(operations.begin(), operations.end(), [&](uint8_t operation) {
+            return operation <= probe->last_op && (probe->ops[operation].flags & IO_URING_OP_SUPPORTED) != 0;
+        });
+    }
+
+    template<typename F>
+    unsigned reapCompletions(F& onCompletion) {
+        unsigned completed = 0;
+        auto head = *_cqHead;
+        auto tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const auto& cqe = _cqes[head & _cqMask];
+            onCompletion(cqe.user_data, cqe.res);
+            head++;
+            completed++;
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+        return completed;
+    }
+
+    template<typename F>
+    void drain(unsigned inFlight, F& onCompletion) {
+        while (inFlight > 0) {
+            auto result = syscall(__NR_io_uring_enter, _fd, 0, inFlight, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (result < 0 && !isTransientError(errno)) {
+                _hasAbandonedOperations = true;
+                return;
+            }
+            inFlight -= reapCompletions(onCompletion);
+        }
+    }
+
+    static bool isTransientError(int error) {
+        return error == EINTR || error == EAGAIN || error == EBUSY;
+    }
+
+    io_uring_sqe* nextSqe(uint64_t userData) {
+        auto index = *_sqTail & _sqMask;
+        auto* sqe = &_sqes[index];
+        std::memset(sqe, 0, sizeof(io_uring_sqe));
+        sqe->user_data = userData;
+        _sqArray[index] = index;
+        return sqe;
+    }
+
+    void commitSqe() {
+        // Publishes the filled entry to the kernel
+        __atomic_store_n(_sqTail, *_sqTail + 1, __ATOMIC_RELEASE);
+        _prepared++;
+    }
+};
+
+#else
+
+class IOUring {
+public:
+    static std::unique_ptr<IOUring> create(unsigned /*entries*/) {
+        return nullptr;
+    }
+};
+
+#endif
+
+static std::vector<Result<BytesView>> loadSequentially(const Path* begin, const Path* end) {
+    std::vector<Result<BytesView>> results;
+    results.reserve(end - begin);
+    for (const auto* it = begin; it != end; it++) {
+        results.emplace_back(DiskUtils::load(*it));
+    }
+    return results;
+}
+
+DiskBatchLoader::DiskBatchLoader() = default;
+DiskBatchLoader::~DiskBatchLoader() = default;
+
+std::vector<Result<BytesView>> DiskBatchLoader::load(const std::vector<Path>& paths) {
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        auto* ioUring = getIOUring();
+        if (ioUring != nullptr) {
+            // The ring is not thread safe, concurrent batches are submitted one after the other
+            return loadWithIOUring(*ioUring, paths);
+        }
+    }
+
+    return loadSequentially(paths.data(), paths.data() + paths.size());
+}
+
+void DiskBatchLoader::loadAsync(std::vector<Path> paths, DiskBatchLoaderCompletion completion) {
+    if (!isUsingIOUring()) {
+        loadWithThreadPool(std::move(paths), std::move(completion));
+        return;
+    }
+
+    std::lock_guard<Mutex> lock(_mutex);
+    getSubmissionQueue()->async(
+        [self = strongSmallRef(this), paths = std::move(paths), completion = std::move(completion)]() {
+            completion(self->load(paths));
+        });
+}
+
+bool DiskBatchLoader::isUsingIOUring() {
+    std::lock_guard<Mutex> lock(_mutex);
+    return getIOUring() != nullptr;
+}
+
+IOUring* DiskBatchLoader::getIOUring() {
+    if (!_ioUringResolved) {
+        _ioUringResolved = true;
+        _ioUring = IOUring::create(kIOUringEntries);
+    }
+
+    return _ioUring.get();
+}
+
+std::vector<Result<BytesView>> DiskBatchLoader::loadWithIOUring(IOUring& ioUring, const std::vector<Path>& paths) {
+#if VALDI_HAS_IO_URING
+    std::vector<Result<BytesView>> results;
+    results.reserve(paths.size());
+
+    for (size_t start = 0; start < paths.size(); start += ioUring.getCapacity()) {
+        auto count = std::min(paths.size() - start, static_cast<size_t>(ioUring.getCapacity()));
+
+        std::vector<std::string> pathStrings;
+        pathStrings.reserve(count);
+        std::vector<int> fds(count, -1);
+        std::vector<int> readResults(count, -1);
+        std::vector<Ref<ByteBuffer>> buffers(count);
+
+        // Open all the files of the batch in one submission
+        for (size_t i = 0; i < count; i++) {
+            pathStrings.emplace_back(paths[start + i].toString());
+            ioUring.prepareOpen(pathStrings.back().c_str(), i);
+        }
+
+        auto submitted =
+            ioUring.submitAndWait([&](uint64_t index, int32_t result) { fds[index] = static_cast<int>(result); });
+
+        // Then read all the opened files in a second one
+        if (submitted) {
+            for (size_t i = 0; i < count; i++) {
+                struct stat st;
+                if (fds[i] < 0 || fstat(fds[i], &st) != 0 || !S_ISREG(st.st_mode) ||
+                    st.st_size > std::numeric_limits<int32_t>::max()) {
+                    continue;
+                }
+
+                buffers[i] = makeShared<ByteBuffer>();
+                buffers[i]->resize(static_cast<size_t>(st.st_size));
+                if (st.st_size == 0) {
+                    readResults[i] = 0;
+                } else {
+                    ioUring.prepareRead(fds[i], buffers[i]->data(), static_cast<uint32_t>(st.st_size), i);
+                }
+            }
+
+            submitted = ioUring.submitAndWait(
+                [&](uint64_t index, int32_t result) { readResults[index] = static_cast<int>(result); });
+        }
+
+        for (auto fd : fds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        if (!submitted) {
+            if (ioUring.hasAbandonedOperations()) {
+                // The kernel might still write into those, they are intentionally never released
+                new std::vector<std::string>(std::move(pathStrings));
+                new std::vector<Ref<ByteBuffer>>(std::move(buffers));
+            }
+
+            // The ring is in an unknown state, the next batches go through the thread pool
+            _ioUring.reset();
+
+            auto fallbackResults = loadSequentially(paths.data() + start, paths.data() + paths.size());
+            for (auto& result : fallbackResults) {
+                results.emplace_back(std::move(result));
+            }
+            break;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            if (buffers[i] != nullptr && readResults[i] == static_cast<int>(buffers[i]->size())) {
+                results.emplace_back(buffers[i]->toBytesView());
+            } else {
+                // Failed and short reads go through the blocking path, which also provides the error
+                results.emplace_back(DiskUtils::load(paths[start + i]));
+            }
+        }
+    }
+
+    return results;
+#else
+    return loadSequentially(paths.data(), paths.data() + paths.size());
+#endif
+}
+
+void DiskBatchLoader::loadWithThreadPool(std::vector<Path> paths, DiskBatchLoaderCompletion completion) {
+    struct PendingBatch : public SimpleRefCountable {
+        Mutex mutex;
+        std::vector<Path> paths;
+        std::vector<std::vector<Result<BytesView>>> chunkResults;
+        size_t remainingChunks = 0;
+        DiskBatchLoaderCompletion completion;
+    };
+
+    if (paths.empty()) {
+        completion(std::vector<Result<BytesView>>());
+        return;
+    }
+
+    std::vector<Ref<DispatchQueue>> queues;
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        queues = getFallbackQueues();
+    }
+
+    auto chunksCount = std::min(paths.size(), queues.size());
+    auto chunkSize = (paths.size() + chunksCount - 1) / chunksCount;
+    chunksCount = (paths.size() + chunkSize - 1) / chunkSize;
+
+    auto pendingBatch = makeShared<PendingBatch>();
+    pendingBatch->paths = std::move(paths);
+    pendingBatch->chunkResults.resize(chunksCount);
+    pendingBatch->remainingChunks = chunksCount;
+    pendingBatch->completion = std::move(completion);
+
+    for (size_t chunkIndex = 0; chunkIndex < chunksCount; chunkIndex++) {
+        queues[chunkIndex]->async([pendingBatch, chunkIndex, chunkSize]() {
+            const auto* begin = pendingBatch->paths.data() + chunkIndex * chunkSize;
+            const auto* end = std::min(begin + chunkSize, pendingBatch->paths.data() + pendingBatch->paths.size());
+            auto chunkResults = loadSequentially(begin, end);
+
+            std::unique_lock<Mutex> lock(pendingBatch->mutex);
+            pendingBatch->chunkResults[chunkIndex] = std::move(chunkResults);
+            if (--pendingBatch->remainingChunks != 0) {
+                return;
+            }
+            lock.unlock();
+
+            // Last chunk to complete, all the other chunks are done and won't touch the batch anymore
+            std::vector<Result<BytesView>> results;
+            results.reserve(pendingBatch->paths.size());
+            for (auto& chunk : pendingBatch->chunkResults) {
+                for (auto& result : chunk) {
+                    results.emplace_back(std::move(result));
+                }
+            }
+            pendingBatch->completion(std::move(results));
+        });
+    }
+}
+
+const Ref<DispatchQueue>& DiskBatchLoader::getSubmissionQueue() {
+    if (_submissionQueue == nullptr) {
+        _submissionQueue = DispatchQueue::create(STRING_LITERAL("Valdi Disk IO"), ThreadQoSClassHigh);
+    }
+    return _submissionQueue;
+}
+
+const std::vector<Ref<DispatchQueue>>& DiskBatchLoader::getFallbackQueues() {
+    if (_fallbackQueues.empty()) {
+        for (size_t i = 0; i < kFallbackThreadsCount; i++) {
+            _fallbackQueues.emplace_back(
+                DispatchQueue::create(STRING_FORMAT("Valdi Disk IO {}", i + 1), ThreadQoSClassHigh));
+        }
+    }
+    return _fallbackQueues;
+}
+
+} // namespace Valdi
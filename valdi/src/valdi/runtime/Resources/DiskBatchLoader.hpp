@@ -0,0 +1,69 @@
+//
+//  DiskBatchLoader.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/PathUtils.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include <memory>
+#include <vector>
+
+namespace Valdi {
+
+class DispatchQueue;
+class IOUring;
+
+using DiskBatchLoaderCompletion = Function<void(std::vector<Result<BytesView>>)>;
+
+/**
+ Loads batches of files from the disk. On Linux, the reads of a batch are
+ submitted together through io_uring, which replaces the open/stat/read/close
+ syscalls per file by a few submissions for the whole batch. When io_uring is
+ not available, or after the ring failed once, the batch is spread over
+ a small pool of threads doing blocking reads.
+ */
+class DiskBatchLoader : public SimpleRefCountable {
+public:
+    DiskBatchLoader();
+    ~DiskBatchLoader() override;
+
+    /**
+     Load the files at the given absolute paths from the calling thread.
+     The results are in the same order as the paths.
+     */
+    std::vector<Result<BytesView>> load(const std::vector<Path>& paths);
+
+    /**
+     Load the files at the given absolute paths and call the completion
+     with the results from an IO thread.
+     */
+    void loadAsync(std::vector<Path> paths, DiskBatchLoaderCompletion completion);
+
+    /**
+     Returns whether the batches are submitted through io_uring.
+     */
+    bool isUsingIOUring();
+
+private:
+    Mutex _mutex;
+    std::unique_ptr<IOUring> _ioUring;
+    bool _ioUringResolved = false;
+    Ref<DispatchQueue> _submissionQueue;
+    std::vector<Ref<DispatchQueue>> _fallbackQueues;
+
+    IOUring* getIOUring();
+    std::vector<Result<BytesView>> loadWithIOUring(IOUring& ioUring, const std::vector<Path>& paths);
+    void loadWithThreadPool(std::vector<Path> paths, DiskBatchLoaderCompletion completion);
+    const Ref<DispatchQueue>& getSubmissionQueue();
+    const std::vector<Ref<DispatchQueue>>& getFallbackQueues();
+};
+
+} // namespace Valdi
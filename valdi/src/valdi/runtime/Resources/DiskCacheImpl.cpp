@@ -126,6 +126,10 @@ Path DiskCacheImpl::getRootPath() const {
     return _rootPath;
 }
 
+const Path& DiskCacheImpl::getAllowedReadPath() const {
+    return _allowedReadPath;
+}
+
 void DiskCacheImpl::setRootPath(const StringBox& rootPath) {
     _rootPath = Path(rootPath.toStringView());
     _rootPath.normalize();
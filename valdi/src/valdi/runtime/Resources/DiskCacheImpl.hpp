@@ -44,11 +44,13 @@ public:
     void setRootPath(const StringBox& rootPath);
     void setAllowedReadPath(const StringBox& allowedReadPath);
 
+protected:
+    Result<Path> resolveAbsolutePath(const Path& path, bool isRead) const;
+    const Path& getAllowedReadPath() const;
+
 private:
     Path _rootPath;
     Path _allowedReadPath;
-
-    Result<Path> resolveAbsolutePath(const Path& path, bool isRead) const;
 };
 
 } // namespace Valdi
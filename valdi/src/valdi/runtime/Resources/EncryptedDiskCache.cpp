@@ -38,6 +38,19 @@ Result<BytesView> EncryptedDiskCache::load(const Path& path) {
     return decrypt(data.value());
 }
 
+void EncryptedDiskCache::loadMany(const std::vector<Path>& paths,
+                                  const Function<void(std::vector<Result<BytesView>>)>& completion) {
+    // Loads through the inner cache, which might batch the reads, and decrypts from its completion
+    _diskCache->loadMany(paths, [self = strongSmallRef(this), completion](std::vector<Result<BytesView>> results) {
+        for (auto& result : results) {
+            if (result) {
+                result = self->decrypt(result.value());
+            }
+        }
+        completion(std::move(results));
+    });
+}
+
 Result<BytesView> EncryptedDiskCache::loadForAbsoluteURL(const StringBox& url) {
     auto data = _diskCache->loadForAbsoluteURL(url);
     if (!data) {
@@ -79,7 +92,7 @@ std::vector<Path> EncryptedDiskCache::list(const Path& path) const {
 Result<BytesView> EncryptedDiskCache::encrypt(const BytesView& input) {
     auto out = makeShared<ByteBuffer>();
 
-    if (!getDataEncryptor().encrypt(input.data(), input.size(), *out)) {
+    if (!getSegmentedDataEncryptor().encrypt(input.data(), input.size(), *out)) {
         return Error("Failed to encrypt data");
     }
 
@@ -88,8 +101,16 @@ Result<BytesView> EncryptedDiskCache::encrypt(const BytesView& input) {
 
 Result<BytesView> EncryptedDiskCache::decrypt(const BytesView& input) {
     auto out = makeShared<ByteBuffer>();
+    if (SegmentedDataEncryptor::parseHeader(input.data(), input.size())) {
+        if (getSegmentedDataEncryptor().decrypt(input.data(), input.size(), *out)) {
+            return out->toBytesView();
+        }
+        // The data can also be in the previous format and start with the magic by chance
+        out->clear();
+    }
+
     if (!getDataEncryptor().decrypt(input.data(), input.size(), *out)) {
-        return Error("Failed to derypt data");
+        return Error("Failed to decrypt data");
     }
 
     return out->toBytesView();
@@ -104,6 +125,14 @@ void EncryptedDiskCache::generateOrRestoreCryptoKey() {
 }
 
 DataEncryptor EncryptedDiskCache::getDataEncryptor() {
+    return DataEncryptor(getCryptoKey());
+}
+
+SegmentedDataEncryptor EncryptedDiskCache::getSegmentedDataEncryptor() {
+    return SegmentedDataEncryptor(getCryptoKey());
+}
+
+snap::utils::crypto::AesEncryptor::Key EncryptedDiskCache::getCryptoKey() {
     std::lock_guard<Mutex> guard(_mutex);
     if (!_cryptoKey) {
         auto key = EncryptedDiskCache::getKeychainKey();
@@ -112,7 +141,7 @@ DataEncryptor EncryptedDiskCache::getDataEncryptor() {
         }
     }
 
-    return DataEncryptor(_cryptoKey.value());
+    return _cryptoKey.value();
 }
 
 bool EncryptedDiskCache::restoreCryptoKey(const StringBox& path) {
@@ -9,6 +9,7 @@
 
 #include "valdi/runtime/Interfaces/IDiskCache.hpp"
 #include "valdi/runtime/Utils/DataEncryptor.hpp"
+#include "valdi/runtime/Utils/SegmentedDataEncryptor.hpp"
 
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 
@@ -24,6 +25,8 @@ namespace Valdi {
  EncryptedDiskCache is an implementation of DiskCache which takes another DiskCache instance to perform
  the actual load, but will encrypt data before writing into the disk cache and decrypt when returning data from
  the disk cache. It will generate and store a private key into the given keychain.
+ Data is stored in the chunked format of SegmentedDataEncryptor. Data stored in the
+ previous single pass format is still readable.
  */
 class EncryptedDiskCache : public IDiskCache {
 public:
@@ -34,6 +37,9 @@ public:
 
     Result<BytesView> load(const Path& path) final;
 
+    void loadMany(const std::vector<Path>& paths,
+                  const Function<void(std::vector<Result<BytesView>>)>& completion) final;
+
     Result<BytesView> loadForAbsoluteURL(const StringBox& url) final;
 
     Result<Void> store(const Path& path, const BytesView& bytes) final;
@@ -66,6 +72,8 @@ private:
     Result<BytesView> encrypt(const BytesView& input);
 
     DataEncryptor getDataEncryptor();
+    SegmentedDataEncryptor getSegmentedDataEncryptor();
+    snap::utils::crypto::AesEncryptor::Key getCryptoKey();
     bool restoreCryptoKey(const StringBox& path);
     void generateCryptoKey(const StringBox& path);
 };
@@ -0,0 +1,118 @@
+//
+//  ModuleArchiveCache.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Resources/ModuleArchiveCache.hpp"
+#include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
+#include "valdi/runtime/Resources/ZStdUtils.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <mutex>
+
+namespace Valdi {
+
+ModuleArchiveCacheKey::ModuleArchiveCacheKey(const StringBox& moduleName, const BytesView& content)
+    : moduleName(moduleName), contentSize(content.size()), contentHash(content.hash()) {}
+
+bool ModuleArchiveCacheKey::operator==(const ModuleArchiveCacheKey& other) const {
+    return contentSize == other.contentSize && contentHash == other.contentHash && moduleName == other.moduleName;
+}
+
+ModuleArchiveCache::ModuleArchiveCache() = default;
+ModuleArchiveCache::~ModuleArchiveCache() = default;
+
+Result<Ref<ValdiModuleArchive>> ModuleArchiveCache::getOrDecompress(const StringBox& moduleName,
+                                                                    const BytesView& data) {
+    if (!ZStdUtils::isZstdFile(data.data(), data.size())) {
+        // Uncompressed archives reference the data directly, there is nothing to share
+        auto result = ValdiModuleArchive::decompress(data.data(), data.size());
+        if (!result) {
+            return result.moveError();
+        }
+        return Valdi::makeShared<ValdiModuleArchive>(result.moveValue());
+    }
+
+    ModuleArchiveCacheKey key(moduleName, data);
+    auto existingArchive = find(key);
+    if (existingArchive != nullptr) {
+        return existingArchive;
+    }
+
+    // Decompress outside of the lock so that loads of other modules are not blocked
+    auto result = ValdiModuleArchive::decompress(data.data(), data.size());
+    if (!result) {
+        return result.moveError();
+    }
+
+    return insert(key, Valdi::makeShared<ValdiModuleArchive>(result.moveValue()));
+}
+
+Ref<ValdiModuleArchive> ModuleArchiveCache::find(const ModuleArchiveCacheKey& key) const {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& it = _archiveByKey.find(key);
+    if (it == _archiveByKey.end()) {
+        return nullptr;
+    }
+    return strongRef(it->second);
+}
+
+Ref<ValdiModuleArchive> ModuleArchiveCache::insert(const ModuleArchiveCacheKey& key,
+                                                   const Ref<ValdiModuleArchive>& archive) {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& it = _archiveByKey.find(key);
+    if (it != _archiveByKey.end()) {
+        auto existingArchive = strongRef(it->second);
+        if (existingArchive != nullptr) {
+            // Another runtime decompressed the same archive concurrently, keep a single copy
+            return existingArchive;
+        }
+    }
+
+    lockFreeRemoveExpiredArchives();
+    _archiveByKey[key] = archive;
+
+    return archive;
+}
+
+size_t ModuleArchiveCache::size() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    size_t count = 0;
+    for (const auto& it : _archiveByKey) {
+        if (!it.second.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void ModuleArchiveCache::lockFreeRemoveExpiredArchives() {
+    auto it = _archiveByKey.begin();
+    while (it != _archiveByKey.end()) {
+        if (it->second.expired()) {
+            _archiveByKey.erase(it++);
+        } else {
+            it++;
+        }
+    }
+}
+
+ModuleArchiveCache& ModuleArchiveCache::getGlobal() {
+    static auto* kCache = new ModuleArchiveCache();
+    return *kCache;
+}
+
+} // namespace Valdi
+
+namespace std {
+
+std::size_t hash<Valdi::ModuleArchiveCacheKey>::operator()(const Valdi::ModuleArchiveCacheKey& k) const {
+    size_t hash = k.moduleName.hash();
+    boost::hash_combine(hash, k.contentSize);
+    boost::hash_combine(hash, k.contentHash);
+    return hash;
+}
+
+} // namespace std
@@ -0,0 +1,80 @@
+//
+//  ModuleArchiveCache.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+namespace Valdi {
+
+class ValdiModuleArchive;
+
+/**
+ Identifies the compressed content of a module. The content is identified by its size
+ and a non cryptographic hash, which is cheap enough to be computed on every load.
+ */
+struct ModuleArchiveCacheKey {
+    StringBox moduleName;
+    size_t contentSize = 0;
+    size_t contentHash = 0;
+
+    ModuleArchiveCacheKey(const StringBox& moduleName, const BytesView& content);
+
+    bool operator==(const ModuleArchiveCacheKey& other) const;
+};
+
+/**
+ Process-wide cache of decompressed module archives keyed by the name and compressed
+ content of their module, so that runtimes loading the same module share a single
+ decompressed copy along with the precompiled JS it contains.
+ The cache only holds weak references: an archive is released as soon as the
+ last bundle using it goes away.
+ */
+class ModuleArchiveCache {
+public:
+    ModuleArchiveCache();
+    ~ModuleArchiveCache();
+
+    /**
+     Returns the decompressed archive for the given module data, reusing the archive
+     decompressed from an identical content if one is still alive.
+     */
+    [[nodiscard]] Result<Ref<ValdiModuleArchive>> getOrDecompress(const StringBox& moduleName,
+                                                                  const BytesView& data);
+
+    /**
+     Returns how many archives are currently shared through the cache.
+     */
+    size_t size() const;
+
+    static ModuleArchiveCache& getGlobal();
+
+private:
+    mutable Mutex _mutex;
+    FlatMap<ModuleArchiveCacheKey, Weak<ValdiModuleArchive>> _archiveByKey;
+
+    Ref<ValdiModuleArchive> find(const ModuleArchiveCacheKey& key) const;
+    Ref<ValdiModuleArchive> insert(const ModuleArchiveCacheKey& key, const Ref<ValdiModuleArchive>& archive);
+
+    void lockFreeRemoveExpiredArchives();
+};
+
+} // namespace Valdi
+
+namespace std {
+
+template<>
+struct hash<Valdi::ModuleArchiveCacheKey> {
+    std::size_t operator()(const Valdi::ModuleArchiveCacheKey& k) const;
+};
+
+} // namespace std
@@ -0,0 +1,95 @@
+//
+//  ModulePrefetcher.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Resources/ModulePrefetcher.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+
+namespace Valdi {
+
+struct PendingPrefetch : public SimpleRefCountable {
+    Mutex mutex;
+    std::vector<StringBox> moduleNames;
+    ModulePrefetcherLoadFunction loadFunction;
+    DispatchFunction completion;
+    size_t nextIndex = 0;
+    size_t remainingWorkers = 0;
+
+    bool next(StringBox& moduleName) {
+        std::lock_guard<Mutex> lock(mutex);
+        if (nextIndex == moduleNames.size()) {
+            return false;
+        }
+        moduleName = moduleNames[nextIndex++];
+        return true;
+    }
+
+    bool onWorkerDone() {
+        std::lock_guard<Mutex> lock(mutex);
+        return --remainingWorkers == 0;
+    }
+};
+
+ModulePrefetcher::ModulePrefetcher(size_t threadsCount, ThreadQoSClass qosClass)
+    : _threadsCount(std::max(threadsCount, static_cast<size_t>(1))), _qosClass(qosClass) {}
+
+ModulePrefetcher::~ModulePrefetcher() = default;
+
+void ModulePrefetcher::prefetch(std::vector<StringBox> moduleNames,
+                                ModulePrefetcherLoadFunction loadFunction,
+                                DispatchFunction completion) {
+    if (moduleNames.empty()) {
+        if (completion) {
+            completion();
+        }
+        return;
+    }
+
+    std::vector<Ref<DispatchQueue>> queues;
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        queues = getQueues();
+    }
+
+    auto workersCount = std::min(moduleNames.size(), queues.size());
+
+    auto pendingPrefetch = makeShared<PendingPrefetch>();
+    pendingPrefetch->moduleNames = std::move(moduleNames);
+    pendingPrefetch->loadFunction = std::move(loadFunction);
+    pendingPrefetch->completion = std::move(completion);
+    pendingPrefetch->remainingWorkers = workersCount;
+
+    for (size_t i = 0; i < workersCount; i++) {
+        queues[i]->async([pendingPrefetch]() {
+            StringBox moduleName;
+            while (pendingPrefetch->next(moduleName)) {
+                pendingPrefetch->loadFunction(moduleName);
+            }
+
+            if (pendingPrefetch->onWorkerDone() && pendingPrefetch->completion) {
+                pendingPrefetch->completion();
+            }
+        });
+    }
+}
+
+size_t ModulePrefetcher::getThreadsCount() const {
+    return _threadsCount;
+}
+
+const std::vector<Ref<DispatchQueue>>& ModulePrefetcher::getQueues() {
+    if (_queues.empty()) {
+        for (size_t i = 0; i < _threadsCount; i++) {
+            _queues.emplace_back(DispatchQueue::create(STRING_FORMAT("Valdi Module Prefetch {}", i + 1), _qosClass));
+        }
+    }
+    return _queues;
+}
+
+} // namespace Valdi
@@ -0,0 +1,54 @@
+//
+//  ModulePrefetcher.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/ThreadQoSClass.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+#include <vector>
+
+namespace Valdi {
+
+class DispatchQueue;
+
+using ModulePrefetcherLoadFunction = Function<void(const StringBox&)>;
+
+/**
+ Loads a list of modules ahead of time on a small pool of threads, so that the
+ archives needed by a component are read and decompressed in parallel instead of
+ one after the other when the JS thread first requires them.
+ Each thread picks the next module of the list once it is done with the previous
+ one, so that a large module does not hold back the ones queued after it.
+ */
+class ModulePrefetcher : public SimpleRefCountable {
+public:
+    ModulePrefetcher(size_t threadsCount, ThreadQoSClass qosClass);
+    ~ModulePrefetcher() override;
+
+    /**
+     Call the load function for every module from the prefetch threads, then call
+     the completion once all of them were loaded.
+     */
+    void prefetch(std::vector<StringBox> moduleNames,
+                  ModulePrefetcherLoadFunction loadFunction,
+                  DispatchFunction completion);
+
+    size_t getThreadsCount() const;
+
+private:
+    Mutex _mutex;
+    size_t _threadsCount;
+    ThreadQoSClass _qosClass;
+    std::vector<Ref<DispatchQueue>> _queues;
+
+    const std::vector<Ref<DispatchQueue>>& getQueues();
+};
+
+} // namespace Valdi
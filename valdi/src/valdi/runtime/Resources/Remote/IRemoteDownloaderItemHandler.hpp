@@ -36,6 +36,15 @@ public:
      Returns a string describing the type of items that the transformer handles
      */
     virtual std::string_view getItemTypeDescription() const = 0;
+
+    /**
+     Whether an update of the item can be downloaded as a zstd patch computed against
+     the previously cached version. This requires preprocess() to store the remote data
+     unchanged, since the cached data is used as the patch base.
+     */
+    virtual bool supportsPatches() const {
+        return false;
+    }
 };
 
 } // namespace Valdi
@@ -0,0 +1,146 @@
+//
+//  RemoteDownloadScheduler.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Resources/Remote/RemoteDownloadScheduler.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+
+namespace Valdi {
+
+RemoteDownloadScheduler::RemoteDownloadScheduler(size_t maxInFlight, size_t maxInFlightPerHost)
+    : _maxInFlight(std::max(maxInFlight, static_cast<size_t>(1))),
+      _maxInFlightPerHost(std::max(maxInFlightPerHost, static_cast<size_t>(1))) {}
+
+RemoteDownloadScheduler::~RemoteDownloadScheduler() = default;
+
+void RemoteDownloadScheduler::schedule(const StringBox& url,
+                                       RemoteDownloaderPriority priority,
+                                       DispatchFunction start) {
+    std::vector<DispatchFunction> starts;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        _pending.emplace_back(PendingDownload{url, getHost(url), priority, _sequence++, std::move(start)});
+        lockFreeCollectStartable(starts);
+    }
+
+    for (const auto& start : starts) {
+        start();
+    }
+}
+
+bool RemoteDownloadScheduler::raisePriority(const StringBox& url, RemoteDownloaderPriority priority) {
+    std::vector<DispatchFunction> starts;
+    auto found = false;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        for (auto& download : _pending) {
+            if (download.url == url) {
+                download.priority = std::max(download.priority, priority);
+                found = true;
+            }
+        }
+
+        // A background download waiting for the reserved slot might be able to start now
+        if (found) {
+            lockFreeCollectStartable(starts);
+        }
+    }
+
+    for (const auto& start : starts) {
+        start();
+    }
+
+    return found;
+}
+
+void RemoteDownloadScheduler::onCompleted(const StringBox& url) {
+    std::vector<DispatchFunction> starts;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        const auto& it = _inFlightByHost.find(getHost(url));
+        if (it == _inFlightByHost.end() || _inFlightCount == 0) {
+            return;
+        }
+
+        _inFlightCount--;
+        if (--it->second == 0) {
+            _inFlightByHost.erase(it);
+        }
+
+        lockFreeCollectStartable(starts);
+    }
+
+    for (const auto& start : starts) {
+        start();
+    }
+}
+
+size_t RemoteDownloadScheduler::getPendingCount() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _pending.size();
+}
+
+size_t RemoteDownloadScheduler::getInFlightCount() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _inFlightCount;
+}
+
+bool RemoteDownloadScheduler::lockFreeCanStart(const PendingDownload& download) const {
+    auto maxInFlight = _maxInFlight;
+    if (download.priority == RemoteDownloaderPriorityBackground && maxInFlight > 1) {
+        maxInFlight--;
+    }
+    if (_inFlightCount >= maxInFlight) {
+        return false;
+    }
+
+    const auto& it = _inFlightByHost.find(download.host);
+    return it == _inFlightByHost.end() || it->second < _maxInFlightPerHost;
+}
+
+void RemoteDownloadScheduler::lockFreeCollectStartable(std::vector<DispatchFunction>& starts) {
+    for (;;) {
+        auto best = _pending.end();
+        for (auto it = _pending.begin(); it != _pending.end(); ++it) {
+            if (!lockFreeCanStart(*it)) {
+                continue;
+            }
+            if (best == _pending.end() || it->priority > best->priority ||
+                (it->priority == best->priority && it->sequence < best->sequence)) {
+                best = it;
+            }
+        }
+
+        if (best == _pending.end()) {
+            return;
+        }
+
+        _inFlightCount++;
+        _inFlightByHost[best->host]++;
+        starts.emplace_back(std::move(best->start));
+        _pending.erase(best);
+    }
+}
+
+StringBox RemoteDownloadScheduler::getHost(const StringBox& url) {
+    auto view = url.toStringView();
+
+    auto schemeEnd = view.find("://");
+    if (schemeEnd != std::string_view::npos) {
+        view = view.substr(schemeEnd + 3);
+    }
+
+    auto hostEnd = view.find_first_of("/?#");
+    if (hostEnd != std::string_view::npos) {
+        view = view.substr(0, hostEnd);
+    }
+
+    return StringCache::getGlobal().makeString(view);
+}
+
+} // namespace Valdi
@@ -0,0 +1,76 @@
+//
+//  RemoteDownloadScheduler.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/Resources/Remote/RemoteDownloaderRequest.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+/**
+ Decides when remote downloads can start. Downloads are started in priority order,
+ then in the order they were scheduled, while keeping the number of downloads in
+ flight under a global and a per host limit. Background downloads always leave one
+ slot free, so that an urgent download never waits behind prefetches.
+ The start functions are called outside of the scheduler lock.
+ */
+class RemoteDownloadScheduler {
+public:
+    RemoteDownloadScheduler(size_t maxInFlight, size_t maxInFlightPerHost);
+    ~RemoteDownloadScheduler();
+
+    /**
+     Queue a download for the given url. The start function is called once the
+     download can start, which might be synchronously from this call.
+     onCompleted() must be called once the download has finished.
+     */
+    void schedule(const StringBox& url, RemoteDownloaderPriority priority, DispatchFunction start);
+
+    /**
+     Raise the priority of a download which has not started yet.
+     Returns whether a pending download was found for the url.
+     */
+    bool raisePriority(const StringBox& url, RemoteDownloaderPriority priority);
+
+    /**
+     Release the slot used by a started download and start the next ones.
+     */
+    void onCompleted(const StringBox& url);
+
+    size_t getPendingCount() const;
+    size_t getInFlightCount() const;
+
+    static StringBox getHost(const StringBox& url);
+
+private:
+    struct PendingDownload {
+        StringBox url;
+        StringBox host;
+        RemoteDownloaderPriority priority;
+        uint64_t sequence;
+        DispatchFunction start;
+    };
+
+    mutable Mutex _mutex;
+    size_t _maxInFlight;
+    size_t _maxInFlightPerHost;
+    std::vector<PendingDownload> _pending;
+    FlatMap<StringBox, size_t> _inFlightByHost;
+    size_t _inFlightCount = 0;
+    uint64_t _sequence = 0;
+
+    bool lockFreeCanStart(const PendingDownload& download) const;
+    void lockFreeCollectStartable(std::vector<DispatchFunction>& starts);
+};
+
+} // namespace Valdi
@@ -10,6 +10,8 @@
 #include "valdi/runtime/Resources/Remote/RemoteDownloaderTask.hpp"
 
 #include "valdi/runtime/Interfaces/IDiskCache.hpp"
+#include "valdi/runtime/Metrics/Metrics.hpp"
+#include "valdi/runtime/Resources/ZStdUtils.hpp"
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
@@ -36,6 +38,61 @@ namespace Valdi {
 STRING_CONST(urlFilePath, "url")
 STRING_CONST(dataFilePath, "data")
 
+// Patches are negotiated through RFC 3229 delta encoding: the request advertises the
+// supported instance manipulation along with the hash of the cached item, and the
+// server can answer with a 226 IM Used response holding a patch against it.
+STRING_CONST(acceptInstanceManipulationHeader, "A-IM")
+STRING_CONST(ifNoneMatchHeader, "If-None-Match")
+STRING_CONST(zstdPatchManipulation, "zstd-patch-from")
+constexpr std::string_view kInstanceManipulationHeader = "im";
+constexpr int32_t kIMUsedStatusCode = 226;
+
+constexpr size_t kMaxConcurrentDownloads = 6;
+constexpr size_t kMaxConcurrentDownloadsPerHost = 4;
+
+static int32_t toHTTPRequestPriority(RemoteDownloaderPriority priority) {
+    switch (priority) {
+        case RemoteDownloaderPriorityBackground:
+            return 1;
+        case RemoteDownloaderPriorityUrgent:
+            return 8;
+        case RemoteDownloaderPriorityNormal:
+            break;
+    }
+    return 4;
+}
+
+static bool isSuccessStatusCode(int32_t statusCode) {
+    return statusCode >= 200 && statusCode < 300;
+}
+
+static StringBox priorityToString(RemoteDownloaderPriority priority) {
+    switch (priority) {
+        case RemoteDownloaderPriorityBackground:
+            return STRING_LITERAL("background");
+        case RemoteDownloaderPriorityUrgent:
+            return STRING_LITERAL("urgent");
+        case RemoteDownloaderPriorityNormal:
+            break;
+    }
+    return STRING_LITERAL("normal");
+}
+
+static StringBox getResponseHeader(const Value& headers, std::string_view lowercasedName) {
+    const auto* map = headers.getMap();
+    if (map == nullptr) {
+        return StringBox();
+    }
+
+    for (const auto& it : *map) {
+        if (it.first.lowercased() == lowercasedName) {
+            return it.second.toStringBox();
+        }
+    }
+
+    return StringBox();
+}
+
 class CachedBundleItem {
 public:
     CachedBundleItem(StringBox url, BytesView data) : _url(std::move(url)), _data(std::move(data)) {}
@@ -124,7 +181,11 @@ RemoteDownloader::RemoteDownloader(const Ref<IDiskCache>& diskCache,
                                    const Holder<Shared<snap::valdi_core::HTTPRequestManager>>& requestManager,
                                    const Ref<DispatchQueue>& workerQueue,
                                    ILogger& logger)
-    : _diskCache(diskCache), _requestManager(requestManager), _workQueue(workerQueue), _logger(logger) {}
+    : _diskCache(diskCache),
+      _requestManager(requestManager),
+      _workQueue(workerQueue),
+      _logger(logger),
+      _scheduler(kMaxConcurrentDownloads, kMaxConcurrentDownloadsPerHost) {}
 
 RemoteDownloader::~RemoteDownloader() = default;
 
@@ -154,6 +215,11 @@ bool RemoteDownloader::loadFromDiskCache(const Shared<RemoteDownloaderTask>& tas
     if (cachedBundleItem.getUrl() != task->getUrl()) {
         // The url changed we need to re-download the module
         VALDI_INFO(_logger, "Module from disk cache at {} is out of date, need re-download", task->getLocalFilename());
+        // The outdated item can still be used as the base of a patch. Patched items are only
+        // accepted when their hash can be verified.
+        if (task->getItemHandler().supportsPatches() && !task->getExpectedHash().empty()) {
+            task->setPatchBase(cachedBundleItem.getData());
+        }
         return false;
     }
 
@@ -242,8 +308,47 @@ void RemoteDownloader::storeDownloadedItemInDiskCache(const Shared<RemoteDownloa
     }
 }
 
+Result<Void> RemoteDownloader::verifyDownloadedPayload(const Shared<RemoteDownloaderTask>& task,
+                                                      const BytesView& downloadedPayload) {
+    const auto& expectedHash = task->getExpectedHash();
+    if (expectedHash.empty()) {
+        return Void();
+    }
+
+    // The payload is verified as downloaded, before anything decompresses or parses it
+    auto calculatedHash = BytesUtils::sha256(downloadedPayload)->toBytesView();
+    if (expectedHash != calculatedHash) {
+        return Error(STRING_FORMAT("SHA256 integrity check failed. Expected '{}', got '{}'",
+                                   expectedHash.asStringView(),
+                                   calculatedHash.asStringView()));
+    }
+
+    return Void();
+}
+
 void RemoteDownloader::handleSuccessRemoteDownload(const Shared<RemoteDownloaderTask>& task,
-                                                   const BytesView& downloadedPayload) {
+                                                   const Value& responseHeaders,
+                                                   BytesView downloadedPayload,
+                                                   bool isPatch) {
+    if (isPatch) {
+        auto patchedResult = applyPatch(task, responseHeaders, downloadedPayload);
+        if (!patchedResult) {
+            retryWithoutPatch(task, patchedResult.error());
+            return;
+        }
+        downloadedPayload = patchedResult.moveValue();
+    }
+
+    auto verifyResult = verifyDownloadedPayload(task, downloadedPayload);
+    if (!verifyResult) {
+        if (isPatch) {
+            retryWithoutPatch(task, verifyResult.error().rethrow("Patched item is invalid"));
+        } else {
+            loadCompleted(task, verifyResult.error().rethrow("Remote load failed"), false);
+        }
+        return;
+    }
+
     auto preprocessedPayload = task->getItemHandler().preprocess(task->getLocalFilename(), downloadedPayload);
     if (!preprocessedPayload) {
         loadCompleted(task, preprocessedPayload.error().rethrow("Failed to preprocess downloaded item"), false);
@@ -270,7 +375,7 @@ void RemoteDownloader::remoteResponseReceived(const Shared<RemoteDownloaderTask>
 
     auto response = responseResult.moveValue();
 
-    if (response.statusCode < 200 || response.statusCode >= 300) {
+    if (!isSuccessStatusCode(response.statusCode)) {
         loadCompleted(
             task, Error(STRING_FORMAT("Remote load failed: Got HTTP status code {}", response.statusCode)), false);
         return;
@@ -288,45 +393,124 @@ void RemoteDownloader::remoteResponseReceived(const Shared<RemoteDownloaderTask>
         return;
     }
 
-    auto expectedHash = task->getExpectedHash();
-    if (!expectedHash.empty()) {
-        auto calculatedHash = BytesUtils::sha256(bodyBytes)->toBytesView();
-        bool hashMatches = expectedHash == calculatedHash;
-        if (!hashMatches) {
-            loadCompleted(
-                task,
-                Error(STRING_FORMAT("Remote load failed: SHA256 integrity check failed. Expected '{}', got '{}'",
-                                    expectedHash.asStringView(),
-                                    calculatedHash.asStringView())),
-                false);
-            return;
-        }
-    }
-
+    // Patching and verification happen on the work queue, which keeps the completion thread
+    // of the request manager free for other transfers.
+    auto isPatch = response.statusCode == kIMUsedStatusCode;
     auto weakThis = weak_from_this();
-    _workQueue->async([=]() {
+    _workQueue->async([=, headers = std::move(response.headers)]() {
         auto strongThis = weakThis.lock();
         if (strongThis == nullptr) {
             return;
         }
 
-        strongThis->handleSuccessRemoteDownload(task, bodyBytes);
+        strongThis->handleSuccessRemoteDownload(task, headers, bodyBytes, isPatch);
     });
 }
 
+Result<BytesView> RemoteDownloader::applyPatch(const Shared<RemoteDownloaderTask>& task,
+                                               const Value& responseHeaders,
+                                               const BytesView& patch) {
+    const auto& patchBase = task->getPatchBase();
+    if (patchBase.empty()) {
+        return Error("Got a patch without having requested one");
+    }
+
+    auto instanceManipulation = getResponseHeader(responseHeaders, kInstanceManipulationHeader);
+    if (instanceManipulation != zstdPatchManipulation()) {
+        return Error(STRING_FORMAT("Unsupported instance manipulation '{}'", instanceManipulation));
+    }
+
+    auto patchedResult = ZStdUtils::applyPatch(patchBase.data(), patchBase.size(), patch.data(), patch.size());
+    if (!patchedResult) {
+        return patchedResult.moveError();
+    }
+
+    VALDI_INFO(_logger,
+               "Applied {} bytes patch on {}, saved {} bytes of download",
+               patch.size(),
+               task->getItemDescription(),
+               static_cast<int64_t>(patchedResult.value()->size()) - static_cast<int64_t>(patch.size()));
+
+    return patchedResult.value()->toBytesView();
+}
+
+void RemoteDownloader::retryWithoutPatch(const Shared<RemoteDownloaderTask>& task, const Error& error) {
+    if (task->getPatchBase().empty()) {
+        // We were not expecting a patch, retrying would get us the same response
+        loadCompleted(task, error.rethrow("Remote load failed"), false);
+        return;
+    }
+
+    VALDI_WARN(_logger,
+               "Failed to apply patch on {}, falling back to a full download: {}",
+               task->getItemDescription(),
+               error);
+
+    task->setPatchBase(BytesView());
+    scheduleRemoteLoad(task);
+}
+
+void RemoteDownloader::scheduleRemoteLoad(const Shared<RemoteDownloaderTask>& task) {
+    // The priority of the task can be raised from enqueue() under the same lock, holding it
+    // here guarantees that the raise is either seen here or applied to the scheduled load.
+    std::lock_guard<Mutex> guard(_mutex);
+
+    task->onQueued();
+
+    // The load can be started from any thread that completes a transfer, hop back to the work queue
+    auto weakThis = weak_from_this();
+    _scheduler.schedule(task->getUrl(), task->getPriority(), [weakThis, task, workQueue = _workQueue]() {
+        workQueue->async([weakThis, task]() {
+            auto strongThis = weakThis.lock();
+            if (strongThis != nullptr) {
+                strongThis->loadRemote(task);
+            }
+        });
+    });
+}
+
+RemoteDownloaderPriority RemoteDownloader::getTaskPriority(const Shared<RemoteDownloaderTask>& task) const {
+    // The priority can be raised from enqueue() at any time
+    std::lock_guard<Mutex> guard(_mutex);
+    return task->getPriority();
+}
+
+void RemoteDownloader::onTransferCompleted(const Shared<RemoteDownloaderTask>& task, bool success) {
+    _scheduler.onCompleted(task->getUrl());
+
+    if (_metrics != nullptr) {
+        _metrics->emitRemoteDownload(task->getLocalFilename(),
+                                     priorityToString(getTaskPriority(task)),
+                                     task->getQueueWaitTime(),
+                                     task->getTransferTime(),
+                                     success);
+    }
+}
+
 void RemoteDownloader::loadRemote(const Shared<RemoteDownloaderTask>& task) {
+    task->onTransferStarted();
+
     auto requestManager = getRequestManager();
 
     if (requestManager == nullptr) {
+        onTransferCompleted(task, false);
         loadCompleted(task, Error(STRING_LITERAL("No RequestManager set in the RemoteDownloader")), false);
         return;
     }
 
-    int32_t priority = 4;
+    auto priority = toHTTPRequestPriority(getTaskPriority(task));
 
     static auto kGetMethod = STRING_LITERAL("GET");
 
-    snap::valdi_core::HTTPRequest request(task->getUrl(), kGetMethod, Value(), {}, priority);
+    Value headers;
+    const auto& patchBase = task->getPatchBase();
+    if (!patchBase.empty()) {
+        headers.setMapValue(acceptInstanceManipulationHeader(), Value(zstdPatchManipulation()));
+        headers.setMapValue(ifNoneMatchHeader(),
+                            Value(STRING_FORMAT("\"{}\"", BytesUtils::sha256String(patchBase))));
+    }
+
+    snap::valdi_core::HTTPRequest request(task->getUrl(), kGetMethod, headers, {}, priority);
 
     VALDI_INFO(_logger, "Starting load of {} at {}", task->getItemDescription(), task->getUrl());
 
@@ -338,6 +522,8 @@ void RemoteDownloader::loadRemote(const Shared<RemoteDownloaderTask>& task) {
                 return;
             }
 
+            strongThis->onTransferCompleted(task,
+                                            response.success() && isSuccessStatusCode(response.value().statusCode));
             strongThis->remoteResponseReceived(task, std::move(response));
         }));
 }
@@ -348,7 +534,7 @@ void RemoteDownloader::doLoad(const Shared<RemoteDownloaderTask>& task) {
     } else if (task->getUrl().hasPrefix("data:image/")) {
         loadBase64Data(task);
     } else if (!loadFromDiskCache(task)) {
-        loadRemote(task);
+        scheduleRemoteLoad(task);
     }
 }
 
@@ -365,6 +551,7 @@ void RemoteDownloader::enqueue(const StringBox& localFilename,
                                const StringBox& url,
                                const IRemoteDownloaderItemHandler& itemHandler,
                                const BytesView& expectedHash,
+                               RemoteDownloaderPriority priority,
                                RemoteDownloaderLoadCompletion completion) {
     std::unique_lock<Mutex> guard(_mutex);
 
@@ -385,12 +572,18 @@ void RemoteDownloader::enqueue(const StringBox& localFilename,
 
     const auto& it = _taskByUrl.find(url);
     if (it == _taskByUrl.end()) {
-        task = Valdi::makeShared<RemoteDownloaderTask>(localFilename, url, expectedHash, itemHandler);
+        task = Valdi::makeShared<RemoteDownloaderTask>(localFilename, url, expectedHash, itemHandler, priority);
         _taskByUrl[url] = task;
 
         shouldStartRequest = true;
     } else {
         task = it->second;
+
+        // A prefetched item became more urgent, move its load ahead if it has not started yet
+        if (priority > task->getPriority()) {
+            task->setPriority(priority);
+            _scheduler.raisePriority(url, priority);
+        }
     }
 
     task->appendRequest(RemoteDownloaderRequest(std::move(completion)));
@@ -463,4 +656,8 @@ std::shared_ptr<snap::valdi_core::HTTPRequestManager> RemoteDownloader::getReque
     return _requestManager.get();
 }
 
+void RemoteDownloader::setMetrics(const Ref<Metrics>& metrics) {
+    _metrics = metrics;
+}
+
 } // namespace Valdi
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "valdi/runtime/Resources/Remote/IRemoteDownloaderItemHandler.hpp"
+#include "valdi/runtime/Resources/Remote/RemoteDownloadScheduler.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteDownloaderRequest.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
@@ -34,6 +35,7 @@ class ValdiModuleArchive;
 class DispatchQueue;
 class RemoteDownloaderTask;
 class IDiskCache;
+class Metrics;
 
 class CachedLoadedItem {
 public:
@@ -61,6 +63,9 @@ private:
  a limited set of unique file ids which can change over time, as opposed to
  manage an unbounded amount of temporary files identified by their urls. The disk
  cache thus only grows when new modules are added in the app.
+ Network loads go through a RemoteDownloadScheduler, which starts them by priority
+ while limiting how many are in flight. Enqueuing an item which is already being
+ loaded raises the priority of the pending load if needed.
  */
 class RemoteDownloader : public std::enable_shared_from_this<RemoteDownloader> {
 public:
@@ -74,10 +79,13 @@ public:
                  const StringBox& url,
                  const IRemoteDownloaderItemHandler& itemHandler,
                  const BytesView& expectedHash,
+                 RemoteDownloaderPriority priority,
                  RemoteDownloaderLoadCompletion completion);
 
     std::shared_ptr<snap::valdi_core::HTTPRequestManager> getRequestManager() const;
 
+    void setMetrics(const Ref<Metrics>& metrics);
+
     void removeItem(const StringBox& url);
 
 private:
@@ -86,6 +94,8 @@ private:
     const Holder<Shared<snap::valdi_core::HTTPRequestManager>> _requestManager;
     Ref<DispatchQueue> _workQueue;
     [[maybe_unused]] ILogger& _logger;
+    RemoteDownloadScheduler _scheduler;
+    Ref<Metrics> _metrics;
 
     FlatMap<StringBox, Shared<RemoteDownloaderTask>> _taskByUrl;
     FlatMap<StringBox, CachedLoadedItem> _downloadedItemByUrl;
@@ -93,7 +103,10 @@ private:
     void doLoad(const Shared<RemoteDownloaderTask>& task);
 
     bool loadFromDiskCache(const Shared<RemoteDownloaderTask>& task);
+    void scheduleRemoteLoad(const Shared<RemoteDownloaderTask>& task);
     void loadRemote(const Shared<RemoteDownloaderTask>& task);
+    void onTransferCompleted(const Shared<RemoteDownloaderTask>& task, bool success);
+    RemoteDownloaderPriority getTaskPriority(const Shared<RemoteDownloaderTask>& task) const;
     void loadFileUrl(const Shared<RemoteDownloaderTask>& task);
     void loadBase64Data(const Shared<RemoteDownloaderTask>& task);
 
@@ -103,7 +116,16 @@ private:
 
     void remoteResponseReceived(const Shared<RemoteDownloaderTask>& task,
                                 Result<snap::valdi_core::HTTPResponse> responseResult);
-    void handleSuccessRemoteDownload(const Shared<RemoteDownloaderTask>& task, const BytesView& downloadedPayload);
+    Result<BytesView> applyPatch(const Shared<RemoteDownloaderTask>& task,
+                                 const Value& responseHeaders,
+                                 const BytesView& patch);
+    void retryWithoutPatch(const Shared<RemoteDownloaderTask>& task, const Error& error);
+    void handleSuccessRemoteDownload(const Shared<RemoteDownloaderTask>& task,
+                                     const Value& responseHeaders,
+                                     BytesView downloadedPayload,
+                                     bool isPatch);
+    static Result<Void> verifyDownloadedPayload(const Shared<RemoteDownloaderTask>& task,
+                                                const BytesView& downloadedPayload);
     void storeDownloadedItemInDiskCache(const Shared<RemoteDownloaderTask>& task, const BytesView& data);
     BytesView loadDownloadedItemFromDiskCache(const Shared<RemoteDownloaderTask>& task);
 
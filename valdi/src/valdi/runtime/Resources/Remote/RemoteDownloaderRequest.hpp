@@ -20,6 +20,16 @@ enum RemoteDownloaderLoadSource {
     RemoteDownloaderLoadSourceNetwork
 };
 
+/**
+ Priority class of a remote download. Urgent downloads are needed to display what
+ the user is looking at, background downloads are prefetches that nobody waits on yet.
+ */
+enum RemoteDownloaderPriority {
+    RemoteDownloaderPriorityBackground,
+    RemoteDownloaderPriorityNormal,
+    RemoteDownloaderPriorityUrgent,
+};
+
 using RemoteDownloaderLoadCompletion = Function<void(Result<Value>, RemoteDownloaderLoadSource)>;
 
 class RemoteDownloaderRequest {
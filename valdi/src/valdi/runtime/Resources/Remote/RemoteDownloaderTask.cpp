@@ -13,11 +13,13 @@ namespace Valdi {
 RemoteDownloaderTask::RemoteDownloaderTask(StringBox localFilename,
                                            StringBox url,
                                            BytesView expectedHash,
-                                           const IRemoteDownloaderItemHandler& itemHandler)
+                                           const IRemoteDownloaderItemHandler& itemHandler,
+                                           RemoteDownloaderPriority priority)
     : _localFilename(std::move(localFilename)),
       _url(std::move(url)),
       _expectedHash(std::move(expectedHash)),
-      _itemHandler(itemHandler) {
+      _itemHandler(itemHandler),
+      _priority(priority) {
     _sw.start();
 }
 
@@ -49,10 +51,42 @@ const BytesView& RemoteDownloaderTask::getExpectedHash() const {
     return _expectedHash;
 }
 
+void RemoteDownloaderTask::setPatchBase(BytesView patchBase) {
+    _patchBase = std::move(patchBase);
+}
+
+const BytesView& RemoteDownloaderTask::getPatchBase() const {
+    return _patchBase;
+}
+
 std::string RemoteDownloaderTask::getItemDescription() const {
     return fmt::format("{} '{}'", _itemHandler.getItemTypeDescription(), _localFilename.toStringView());
 }
 
+RemoteDownloaderPriority RemoteDownloaderTask::getPriority() const {
+    return _priority;
+}
+
+void RemoteDownloaderTask::setPriority(RemoteDownloaderPriority priority) {
+    _priority = priority;
+}
+
+void RemoteDownloaderTask::onQueued() {
+    _queuedTime = _sw.elapsed();
+}
+
+void RemoteDownloaderTask::onTransferStarted() {
+    _transferStartTime = _sw.elapsed();
+}
+
+snap::utils::time::Duration<std::chrono::steady_clock> RemoteDownloaderTask::getQueueWaitTime() const {
+    return _transferStartTime - _queuedTime;
+}
+
+snap::utils::time::Duration<std::chrono::steady_clock> RemoteDownloaderTask::getTransferTime() const {
+    return _sw.elapsed() - _transferStartTime;
+}
+
 snap::utils::time::Duration<std::chrono::steady_clock> RemoteDownloaderTask::getElapsedTime() const {
     return _sw.elapsed();
 }
@@ -24,7 +24,8 @@ public:
     RemoteDownloaderTask(StringBox localFilename,
                          StringBox url,
                          BytesView expectedHash,
-                         const IRemoteDownloaderItemHandler& itemHandler);
+                         const IRemoteDownloaderItemHandler& itemHandler,
+                         RemoteDownloaderPriority priority);
 
     // NOTE: All non const methods are NOT thread safe
     void appendRequest(RemoteDownloaderRequest request);
@@ -37,8 +38,27 @@ public:
     const StringBox& getUrl() const;
     const BytesView& getExpectedHash() const;
 
+    /**
+     The previously downloaded version of the item, against which the remote
+     can send a patch instead of the full item. Empty if a full download is needed.
+     */
+    void setPatchBase(BytesView patchBase);
+    const BytesView& getPatchBase() const;
+
     std::string getItemDescription() const;
 
+    RemoteDownloaderPriority getPriority() const;
+    void setPriority(RemoteDownloaderPriority priority);
+
+    /**
+     Record when the task was queued for a network load and when its transfer started,
+     from which the queue wait and transfer times are computed.
+     */
+    void onQueued();
+    void onTransferStarted();
+    snap::utils::time::Duration<std::chrono::steady_clock> getQueueWaitTime() const;
+    snap::utils::time::Duration<std::chrono::steady_clock> getTransferTime() const;
+
     snap::utils::time::Duration<std::chrono::steady_clock> getElapsedTime() const;
     const IRemoteDownloaderItemHandler& getItemHandler() const;
 
@@ -46,9 +66,13 @@ private:
     StringBox _localFilename;
     StringBox _url;
     BytesView _expectedHash;
+    BytesView _patchBase;
     const IRemoteDownloaderItemHandler& _itemHandler;
     std::vector<RemoteDownloaderRequest> _requests;
+    RemoteDownloaderPriority _priority;
     snap::utils::time::StopWatch _sw;
+    snap::utils::time::Duration<std::chrono::steady_clock> _queuedTime;
+    snap::utils::time::Duration<std::chrono::steady_clock> _transferStartTime;
 };
 
 } // namespace Valdi
@@ -10,6 +10,7 @@
 #include "valdi/runtime/Interfaces/IDiskCache.hpp"
 #include "valdi/runtime/Metrics/Metrics.hpp"
 #include "valdi/runtime/Resources/AssetDensityResolver.hpp"
+#include "valdi/runtime/Resources/ModuleArchiveCache.hpp"
 #include "valdi/runtime/Resources/Remote/DownloadableModuleManifestWrapper.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModuleResources.hpp"
 #include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
@@ -44,15 +45,7 @@ private:
 
 // For modules, we keep them compressed on disk, we decompress them when we want to read them.
 
-Result<Value> ModuleBundleResultTransformer::transform(const StringBox& /*localFilename*/,
-                                                       const BytesView& data) const {
-    Result<ValdiModuleArchive> decompressedBundleResult;
-    if (_decompressionDisabled) {
-        decompressedBundleResult = ValdiModuleArchive::deserialize(data);
-    } else {
-        decompressedBundleResult = ValdiModuleArchive::decompress(data.data(), data.size());
-    }
-
+static Result<Value> toModuleArchiveValue(Result<ValdiModuleArchive> decompressedBundleResult) {
     if (!decompressedBundleResult) {
         return decompressedBundleResult.moveError();
     }
@@ -61,10 +54,31 @@ Result<Value> ModuleBundleResultTransformer::transform(const StringBox& /*localF
         Valdi::makeShared<ValdiModuleArchive>(decompressedBundleResult.moveValue())));
 }
 
+static Result<Value> toModuleArchiveValue(Result<Ref<ValdiModuleArchive>> archiveResult) {
+    if (!archiveResult) {
+        return archiveResult.moveError();
+    }
+
+    return Value(Valdi::makeShared<ValdiModuleArchiveWrapper>(archiveResult.moveValue()));
+}
+
+Result<Value> ModuleBundleResultTransformer::transform(const StringBox& localFilename, const BytesView& data) const {
+    if (_decompressionDisabled) {
+        return toModuleArchiveValue(ValdiModuleArchive::deserialize(data));
+    }
+
+    return toModuleArchiveValue(ModuleArchiveCache::getGlobal().getOrDecompress(localFilename, data));
+}
+
 std::string_view ModuleBundleResultTransformer::getItemTypeDescription() const {
     return "module";
 }
 
+bool ModuleBundleResultTransformer::supportsPatches() const {
+    // Modules are stored in the disk cache as downloaded
+    return true;
+}
+
 void ModuleBundleResultTransformer::setDecompressionDisabled(bool decompressionDisabled) {
     _decompressionDisabled = decompressionDisabled;
 }
@@ -313,6 +327,12 @@ void RemoteModuleManager::handleResourcesLoadCompleted(
 
 void RemoteModuleManager::loadResources(const StringBox& moduleName,
                                         Function<void(Result<Ref<RemoteModuleResources>>)> completion) {
+    loadResources(moduleName, RemoteDownloaderPriorityNormal, std::move(completion));
+}
+
+void RemoteModuleManager::loadResources(const StringBox& moduleName,
+                                        RemoteDownloaderPriority priority,
+                                        Function<void(Result<Ref<RemoteModuleResources>>)> completion) {
     auto manifest = getRegisteredManifest(moduleName);
     if (manifest == nullptr) {
         completion(Error(STRING_FORMAT("Module '{}' doesnt have a downloadable manifest registered", moduleName)));
@@ -340,6 +360,7 @@ void RemoteModuleManager::loadResources(const StringBox& moduleName,
         assetUrl,
         _resourcesTransformer,
         sha256DigestBytesView,
+        priority,
         [weakThis, completion = std::move(completion), manifest, artifact, moduleName](auto result, auto loadSource) {
             auto strongThis = weakThis.lock();
             if (strongThis != nullptr) {
@@ -362,6 +383,12 @@ void RemoteModuleManager::handleModuleLoadCompleted(const Result<Value>& result,
 
 void RemoteModuleManager::loadModule(const StringBox& moduleName,
                                      Function<void(Result<Ref<ValdiModuleArchive>>)> completion) {
+    loadModule(moduleName, RemoteDownloaderPriorityNormal, std::move(completion));
+}
+
+void RemoteModuleManager::loadModule(const StringBox& moduleName,
+                                     RemoteDownloaderPriority priority,
+                                     Function<void(Result<Ref<ValdiModuleArchive>>)> completion) {
     auto manifest = getRegisteredManifest(moduleName);
     if (manifest == nullptr) {
         completion(Error(STRING_FORMAT("Module '{}' doesnt have a downloadable manifest registered", moduleName)));
@@ -378,6 +405,7 @@ void RemoteModuleManager::loadModule(const StringBox& moduleName,
                          url,
                          _moduleTransformer,
                          sha256DigestBytesView,
+                         priority,
                          [weakThis, completion = std::move(completion)](auto result, auto /*loadSource*/) {
                              auto strongThis = weakThis.lock();
                              if (strongThis != nullptr) {
@@ -386,6 +414,11 @@ void RemoteModuleManager::loadModule(const StringBox& moduleName,
                          });
 }
 
+void RemoteModuleManager::setMetrics(const Ref<Metrics>& metrics) {
+    _metrics = metrics;
+    _downloader->setMetrics(metrics);
+}
+
 void RemoteModuleManager::setDecompressionDisabled(bool decompressionDisabled) {
     _moduleTransformer.setDecompressionDisabled(decompressionDisabled);
     _resourcesTransformer.setDecompressionDisabled(decompressionDisabled);
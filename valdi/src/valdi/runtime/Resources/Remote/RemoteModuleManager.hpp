@@ -42,6 +42,8 @@ public:
 
     std::string_view getItemTypeDescription() const override;
 
+    bool supportsPatches() const override;
+
     void setDecompressionDisabled(bool decompressionDisabled);
 
 private:
@@ -89,7 +91,13 @@ public:
     Ref<DownloadableModuleManifestWrapper> getRegisteredManifest(const StringBox& moduleName) const;
 
     void loadModule(const StringBox& moduleName, Function<void(Result<Ref<ValdiModuleArchive>>)> completion);
+    void loadModule(const StringBox& moduleName,
+                    RemoteDownloaderPriority priority,
+                    Function<void(Result<Ref<ValdiModuleArchive>>)> completion);
     void loadResources(const StringBox& moduleName, Function<void(Result<Ref<RemoteModuleResources>>)> completion);
+    void loadResources(const StringBox& moduleName,
+                       RemoteDownloaderPriority priority,
+                       Function<void(Result<Ref<RemoteModuleResources>>)> completion);
 
     void setMetrics(const Ref<Metrics>& metrics);
 
@@ -10,6 +10,8 @@
 #include "valdi/runtime/Metrics/Metrics.hpp"
 #include "valdi/runtime/Resources/AssetDensityResolver.hpp"
 #include "valdi/runtime/Resources/AssetsManager.hpp"
+#include "valdi/runtime/Resources/ModuleArchiveCache.hpp"
+#include "valdi/runtime/Resources/ModulePrefetcher.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModuleManager.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModulePrefetchTask.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModuleResources.hpp"
@@ -40,12 +42,20 @@
 #include "valdi_core/cpp/Utils/ValueMap.hpp"
 #include "valdi_core/cpp/Utils/ValueUtils.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <thread>
 
 namespace Valdi {
 
+static size_t resolveModulePrefetchThreadsCount() {
+    return std::clamp(static_cast<size_t>(std::thread::hardware_concurrency() / 2),
+                      static_cast<size_t>(1),
+                      static_cast<size_t>(4));
+}
+
 ResourceManager::ResourceManager(const Shared<IResourceLoader>& resourceLoader,
                                  const Ref<IDiskCache>& diskCache,
                                  const Ref<AssetLoaderManager>& assetLoaderManager,
@@ -65,6 +75,7 @@ ResourceManager::ResourceManager(const Shared<IResourceLoader>& resourceLoader,
         makeShared<RemoteModuleManager>(diskCache, requestManager, _workerQueue, _logger, _deviceDensity);
     _assetsManager = makeShared<AssetsManager>(
         resourceLoader, _remoteModuleManager, assetLoaderManager, workerQueue, mainThreadManager, logger);
+    _modulePrefetcher = makeShared<ModulePrefetcher>(resolveModulePrefetchThreadsCount(), ThreadQoSClassHigh);
 }
 
 ResourceManager::~ResourceManager() = default;
@@ -91,13 +102,8 @@ Result<Ref<ValdiModuleArchive>> ResourceManager::getArchiveForModule(const Strin
         }
     }
 
-    const auto& data = bundleContent.value();
-
-    auto result = ValdiModuleArchive::decompress(data.data(), data.size());
-    if (!result) {
-        return result.moveError();
-    }
-    return Valdi::makeShared<ValdiModuleArchive>(result.moveValue());
+    // Other runtimes of the process typically load the same modules, share their decompressed archives
+    return ModuleArchiveCache::getGlobal().getOrDecompress(modulePath, bundleContent.value());
 }
 
 BundleInitializer ResourceManager::registerBundle(const StringBox& bundleName) {
@@ -388,32 +394,65 @@ void ResourceManager::preloadForComponentPath(const ComponentPath& componentPath
             return;
         }
 
-        // Load each modules
-        for (const auto& moduleName : strategy->valdiModules) {
-            self->getBundle(moduleName);
-        }
+        // Load the modules in parallel, the JS thread will wait on the bundles which are still
+        // being loaded when requiring them instead of loading them again
+        snap::utils::time::StopWatch sw;
+        sw.start();
+        self->_modulePrefetcher->prefetch(
+            strategy->valdiModules,
+            [self](const StringBox& moduleName) { self->prefetchBundle(moduleName); },
+            [self, componentPathString, sw, modulesCount = strategy->valdiModules.size()]() {
+                if (Valdi::traceLoadModules) {
+                    VALDI_INFO(self->_logger,
+                               "Prefetched {} modules for '{}' in {}",
+                               modulesCount,
+                               componentPathString,
+                               sw.elapsed());
+                }
+            });
     });
 }
 
+void ResourceManager::prefetchBundle(const StringBox& bundleName) {
+    VALDI_TRACE_META("Valdi.prefetchBundle", bundleName);
+    auto bundle = getBundle(bundleName);
+    if (bundle->hasRemoteArchiveNeedingLoad()) {
+        return;
+    }
+
+    // Index the entries of the archive, so that the first require only needs a lookup
+    bundle->getAllEntryPaths();
+}
+
 void ResourceManager::loadModuleAsync(const StringBox& bundleName,
                                       ResourceManagerLoadModuleType loadType,
                                       Function<void(Result<Void>)> onComplete) {
-    loadModuleAsync(_workerQueue, bundleName, loadType, std::move(onComplete));
+    loadModuleAsync(_workerQueue, bundleName, loadType, RemoteDownloaderPriorityNormal, std::move(onComplete));
+}
+
+void ResourceManager::loadModuleAsync(const StringBox& bundleName,
+                                      ResourceManagerLoadModuleType loadType,
+                                      RemoteDownloaderPriority priority,
+                                      Function<void(Result<Void>)> onComplete) {
+    loadModuleAsync(_workerQueue, bundleName, loadType, priority, std::move(onComplete));
 }
 
 void ResourceManager::loadModuleAsync(const Ref<DispatchQueue>& dispatchQueue,
                                       const StringBox& bundleName,
                                       ResourceManagerLoadModuleType loadType,
+                                      RemoteDownloaderPriority priority,
                                       Function<void(Result<Void>)> onComplete) {
-    dispatchQueue->async([self = strongSmallRef(this), bundleName, loadType, completion = std::move(onComplete)]() {
-        FlatSet<StringBox> processedModules;
-        self->loadModuleAsyncInner(bundleName, processedModules, loadType, completion);
-    });
+    dispatchQueue->async(
+        [self = strongSmallRef(this), bundleName, loadType, priority, completion = std::move(onComplete)]() {
+            FlatSet<StringBox> processedModules;
+            self->loadModuleAsyncInner(bundleName, processedModules, loadType, priority, completion);
+        });
 }
 
 void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
                                            FlatSet<StringBox>& processedModules,
                                            ResourceManagerLoadModuleType loadType,
+                                           RemoteDownloaderPriority priority,
                                            Function<void(Result<Void>)> onComplete) {
     if (processedModules.find(bundleName) != processedModules.end()) {
         onComplete(Void());
@@ -440,6 +479,7 @@ void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
         loadModuleAsyncInner(StringCache::getGlobal().makeString(dependency),
                              processedModules,
                              loadType,
+                             priority,
                              [=](auto result) { task->leave(result); });
     }
 
@@ -450,7 +490,7 @@ void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
 
     if (includeSources) {
         task->enter();
-        _remoteModuleManager->loadModule(bundleName, [=](auto result) {
+        _remoteModuleManager->loadModule(bundleName, priority, [=](auto result) {
             if (result) {
                 bundle->setLoadedArchiveIfNeeded(result.value());
             }
@@ -460,7 +500,7 @@ void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
 
     if (includeAssets) {
         task->enter();
-        _remoteModuleManager->loadResources(bundleName, [=](auto result) { task->leave(result); });
+        _remoteModuleManager->loadResources(bundleName, priority, [=](auto result) { task->leave(result); });
     }
 
     task->notify(std::move(onComplete));
@@ -511,6 +551,7 @@ Ref<ValdiRuntimeTweaks> ResourceManager::getRuntimeTweaks() const {
 
 void ResourceManager::setMetrics(const Ref<Metrics>& metrics) {
     _metrics = metrics;
+    _remoteModuleManager->setMetrics(metrics);
 }
 
 const Ref<Metrics>& ResourceManager::getMetrics() const {
@@ -12,6 +12,7 @@
 #include <string>
 
 #include "valdi/runtime/Resources/Bundle.hpp"
+#include "valdi/runtime/Resources/Remote/RemoteDownloaderRequest.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
@@ -43,6 +44,7 @@ class AssetLoaderManager;
 class ValdiRuntimeTweaks;
 class ComponentPath;
 class Metrics;
+class ModulePrefetcher;
 
 enum class ResourceManagerLoadModuleType {
     Sources,
@@ -88,9 +90,18 @@ public:
     void loadModuleAsync(const StringBox& bundleName,
                          ResourceManagerLoadModuleType loadType,
                          Function<void(Result<Void>)> onComplete);
+    /**
+     Load a module and its dependencies, downloading them with the given priority
+     if they are remote.
+     */
+    void loadModuleAsync(const StringBox& bundleName,
+                         ResourceManagerLoadModuleType loadType,
+                         RemoteDownloaderPriority priority,
+                         Function<void(Result<Void>)> onComplete);
     void loadModuleAsync(const Ref<DispatchQueue>& dispatchQueue,
                          const StringBox& bundleName,
                          ResourceManagerLoadModuleType loadType,
+                         RemoteDownloaderPriority priority,
                          Function<void(Result<Void>)> onComplete);
 
     const Ref<IDiskCache>& getDiskCache() const;
@@ -121,6 +132,7 @@ private:
     Ref<RemoteModuleManager> _remoteModuleManager;
     Ref<DispatchQueue> _workerQueue;
     Ref<AssetsManager> _assetsManager;
+    Ref<ModulePrefetcher> _modulePrefetcher;
     double _deviceDensity;
     Ref<ValdiRuntimeTweaks> _runtimeTweaks;
     Ref<Metrics> _metrics;
@@ -146,9 +158,12 @@ private:
 
     void populateSourceMap(const StringBox& bundleName, Bundle& bundle);
 
+    void prefetchBundle(const StringBox& bundleName);
+
     void loadModuleAsyncInner(const StringBox& bundleName,
                               FlatSet<StringBox>& processedModules,
                               ResourceManagerLoadModuleType loadType,
+                              RemoteDownloaderPriority priority,
                               Function<void(Result<Void>)> onComplete);
     void doInsertImageAssetInBundle(const Ref<Bundle>& bundle, const StringBox& filePath, const BytesView& imageData);
 
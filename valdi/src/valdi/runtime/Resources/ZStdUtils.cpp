@@ -11,6 +11,8 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
+
 namespace Valdi {
 
 bool ZStdUtils::isZstdFile(const Byte* input, size_t length) {
@@ -22,24 +24,46 @@ bool ZStdUtils::isZstdFile(const Byte* input, size_t length) {
     return output == ZSTD_MAGICNUMBER;
 }
 
-Result<Ref<ByteBuffer>> ZStdUtils::decompress(const Byte* input, size_t len) {
-    auto* dstream = ZSTD_createDStream();
-    if (dstream == nullptr) {
-        return Error("Could not create ZSTD stream");
+// The frame header might not have been verified yet when the stream is decompressed while
+// its hash is being computed, so the decompressed size it declares is only trusted to
+// preallocate the output up to this ratio of the compressed size.
+constexpr size_t kMaxReservedCompressionRatio = 16;
+
+ZStdStreamDecompressor::ZStdStreamDecompressor(size_t compressedSizeHint)
+    : _dctx(ZSTD_createDCtx()), _compressedSizeHint(compressedSizeHint) {
+    if (_dctx == nullptr) {
+        _error = Error("Could not create ZSTD stream");
     }
+}
 
-    auto bufferSize = ZSTD_DStreamOutSize();
+ZStdStreamDecompressor::~ZStdStreamDecompressor() {
+    if (_dctx != nullptr) {
+        ZSTD_freeDCtx(_dctx);
+    }
+}
 
-    ByteBuffer buffer;
-    buffer.resize(bufferSize);
+void ZStdStreamDecompressor::reserveOutput(const Byte* input, size_t len) {
+    _output = makeShared<ByteBuffer>();
+
+    auto compressedSize = std::max(_compressedSizeHint, len);
+    auto contentSize = ZSTD_getFrameContentSize(input, len);
+    if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR) {
+        auto maxReservedSize = static_cast<unsigned long long>(compressedSize) * kMaxReservedCompressionRatio;
+        _output->reserve(static_cast<size_t>(std::min(contentSize, maxReservedSize)));
+    } else {
+        _output->reserve(compressedSize * 4);
+    }
+
+    _buffer.resize(ZSTD_DStreamOutSize());
+}
+
+Result<Void> ZStdStreamDecompressor::append(const Byte* input, size_t len) {
+    if (_error) {
+        return _error.value();
+    }
 
-    /* In more complex scenarios, a file may consist of multiple appended frames (ex : pzstd).
-     *  The following example decompresses only the first frame.
-     *  It is compatible with other provided streaming examples */
-    auto initResult = ZSTD_initDStream(dstream);
-    if (ZSTD_isError(initResult) != 0) {
-        ZSTD_freeDStream(dstream);
-        return Error(STRING_FORMAT("Could not initialize stream: {}", ZSTD_getErrorName(initResult)));
+    if (_output == nullptr) {
+        reserveOutput(input, len);
     }
 
     ZSTD_inBuffer inBuffer;
@@ -47,30 +71,132 @@ Result<Ref<ByteBuffer>> ZStdUtils::decompress(const Byte* input, size_t len) {
     inBuffer.size = len;
     inBuffer.pos = 0;
 
+    ZSTD_outBuffer outBuffer;
+    outBuffer.dst = _buffer.data();
+    outBuffer.pos = 0;
+    outBuffer.size = _buffer.size();
+
+    // Keep going while the output is full, as the context might still hold decompressed data
+    // unless the frame was entirely flushed
+    while (inBuffer.pos < len || (outBuffer.pos == outBuffer.size && _lastResult != 0)) {
+        outBuffer.pos = 0;
+        _lastResult = ZSTD_decompressStream(_dctx, &outBuffer, &inBuffer);
+        if (ZSTD_isError(_lastResult) != 0) {
+            _error = Error(STRING_FORMAT("Could not decompress stream: {}", ZSTD_getErrorName(_lastResult)));
+            return _error.value();
+        }
+
+        _output->append(_buffer.begin(), _buffer.begin() + outBuffer.pos);
+    }
+
+    return Void();
+}
+
+Result<Ref<ByteBuffer>> ZStdStreamDecompressor::finish() {
+    if (_error) {
+        return _error.value();
+    }
+    if (_output == nullptr || _lastResult != 0) {
+        return Error("Could not decompress stream: truncated input");
+    }
+
+    auto output = std::move(_output);
+    output->shrinkToFit();
+
+    return output;
+}
+
+Result<Ref<ByteBuffer>> ZStdUtils::decompress(const Byte* input, size_t len) {
+    ZStdStreamDecompressor decompressor(len);
+    auto result = decompressor.append(input, len);
+    if (!result) {
+        return result.error();
+    }
+
+    return decompressor.finish();
+}
+
+/**
+ Returns the largest window log a patch needs to reference both its base and its output,
+ so that a patch declaring a larger window is rejected instead of allocating it.
+ */
+static int getPatchWindowLogMax(size_t baseLen, const Byte* patch, size_t patchLen) {
+    unsigned long long windowSize = baseLen;
+    auto contentSize = ZSTD_getFrameContentSize(patch, patchLen);
+    if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR) {
+        windowSize = std::max(windowSize, contentSize);
+    }
+
+    int windowLog = 0;
+    while (windowLog < 63 && (1ULL << windowLog) < windowSize) {
+        windowLog++;
+    }
+
+    auto bounds = ZSTD_dParam_getBounds(ZSTD_d_windowLogMax);
+    return std::clamp(windowLog + 1, bounds.lowerBound, bounds.upperBound);
+}
+
+Result<Ref<ByteBuffer>> ZStdUtils::applyPatch(const Byte* base,
+                                              size_t baseLen,
+                                              const Byte* patch,
+                                              size_t patchLen) {
+    auto* dctx = ZSTD_createDCtx();
+    if (dctx == nullptr) {
+        return Error("Could not create ZSTD context");
+    }
+
+    // Patches reference the whole base as a prefix, which can exceed the default window size
+    auto paramResult =
+        ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, getPatchWindowLogMax(baseLen, patch, patchLen));
+    if (ZSTD_isError(paramResult) == 0) {
+        paramResult = ZSTD_DCtx_refPrefix(dctx, base, baseLen);
+    }
+    if (ZSTD_isError(paramResult) != 0) {
+        ZSTD_freeDCtx(dctx);
+        return Error(STRING_FORMAT("Could not initialize patch context: {}", ZSTD_getErrorName(paramResult)));
+    }
+
+    auto bufferSize = ZSTD_DStreamOutSize();
+
+    ByteBuffer buffer;
+    buffer.resize(bufferSize);
+
+    ZSTD_inBuffer inBuffer;
+    inBuffer.src = patch;
+    inBuffer.size = patchLen;
+    inBuffer.pos = 0;
+
     ZSTD_outBuffer outBuffer;
     outBuffer.dst = buffer.data();
     outBuffer.pos = 0;
     outBuffer.size = bufferSize;
 
     auto output = makeShared<ByteBuffer>();
-    output->reserve(len * 4);
+    output->reserve(baseLen);
 
-    while (inBuffer.pos < len) {
-        auto result = ZSTD_decompressStream(dstream, &outBuffer, &inBuffer);
+    // A full output buffer means the context might still hold data to flush, unless the frame
+    // just ended on it, in which case decompressing again would start reading a new frame
+    size_t result = 1;
+    while (inBuffer.pos < patchLen || (outBuffer.pos == outBuffer.size && result != 0)) {
+        outBuffer.pos = 0;
+        result = ZSTD_decompressStream(dctx, &outBuffer, &inBuffer);
         if (ZSTD_isError(result) != 0) {
-            ZSTD_freeDStream(dstream);
-            return Error(STRING_FORMAT("Could not decompress stream: {}", ZSTD_getErrorName(result)));
+            ZSTD_freeDCtx(dctx);
+            return Error(STRING_FORMAT("Could not apply patch: {}", ZSTD_getErrorName(result)));
         }
 
-        auto written = outBuffer.pos;
+        output->append(buffer.begin(), buffer.begin() + outBuffer.pos);
+    }
 
-        output->append(buffer.begin(), buffer.begin() + written);
-        outBuffer.pos = 0;
+    ZSTD_freeDCtx(dctx);
+
+    if (result != 0) {
+        return Error("Could not apply patch: truncated input");
     }
 
-    ZSTD_freeDStream(dstream);
     output->shrinkToFit();
 
     return output;
 }
+
 } // namespace Valdi
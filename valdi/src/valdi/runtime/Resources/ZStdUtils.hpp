@@ -10,13 +10,59 @@
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
+#include "utils/base/NonCopyable.hpp"
+#include <optional>
 #include <vector>
 
+struct ZSTD_DCtx_s;
+
 namespace Valdi {
 
+/**
+ Decompresses a zstd stream provided in multiple chunks, reporting an incomplete
+ stream as an error.
+ */
+class ZStdStreamDecompressor : public snap::NonCopyable {
+public:
+    /**
+     The compressed size hint is used to size the output buffer when the frame
+     header does not specify the decompressed size, and to bound how much of the
+     declared decompressed size is preallocated.
+     */
+    explicit ZStdStreamDecompressor(size_t compressedSizeHint = 0);
+    ~ZStdStreamDecompressor();
+
+    [[nodiscard]] Result<Void> append(const Byte* input, size_t len);
+
+    /**
+     Returns the decompressed data, or an error if the stream was incomplete
+     or if a previous append() failed.
+     */
+    [[nodiscard]] Result<Ref<ByteBuffer>> finish();
+
+private:
+    ZSTD_DCtx_s* _dctx;
+    size_t _compressedSizeHint;
+    ByteBuffer _buffer;
+    Ref<ByteBuffer> _output;
+    size_t _lastResult = 1;
+    std::optional<Error> _error;
+
+    void reserveOutput(const Byte* input, size_t len);
+};
+
 class ZStdUtils {
 public:
     [[nodiscard]] static Result<Ref<ByteBuffer>> decompress(const Byte* input, size_t len);
+
+    /**
+     Rebuild a file from a patch produced by `zstd --patch-from=<base>`, where the
+     given base is the previous version of the file the patch was computed against.
+     */
+    [[nodiscard]] static Result<Ref<ByteBuffer>> applyPatch(const Byte* base,
+                                                            size_t baseLen,
+                                                            const Byte* patch,
+                                                            size_t patchLen);
     static bool isZstdFile(const Byte* input, size_t length);
 };
 
@@ -43,6 +43,7 @@
 #include "valdi/runtime/ErrorCodes.hpp"
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
 #include "valdi_core/cpp/Resources/ResourceId.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 #include "valdi_core/cpp/Utils/ValueArrayBuilder.hpp"
@@ -132,6 +133,16 @@ void Runtime::fullTeardown() {
     if (Valdi::traceInitialization) {
         VALDI_INFO(*_logger, "Tearing down Valdi Runtime");
     }
+
+    Ref<DispatchQueue> viewNodeTreeUpdateQueue;
+    {
+        std::lock_guard<Mutex> guard(_viewNodeTreeUpdateQueueMutex);
+        viewNodeTreeUpdateQueue = std::move(_viewNodeTreeUpdateQueue);
+    }
+    if (viewNodeTreeUpdateQueue != nullptr) {
+        viewNodeTreeUpdateQueue->fullTeardown();
+    }
+
     _viewNodeManager.removeAllViewNodeTrees();
     _contextManager.destroyAllContexts();
 
@@ -539,11 +550,30 @@ void Runtime::receivedRenderRequest(const Ref<RenderRequest>& renderRequest) {
     auto taskIdOptional = context->enqueueRenderRequest(renderRequest);
 
     if (taskIdOptional && !_autoRenderDisabled) {
-        getMainThreadManager().dispatch(
-            context, [context, taskId = taskIdOptional.value()]() { context->runRenderRequest(taskId); });
+        DispatchFunction runRenderRequestFn = [context, taskId = taskIdOptional.value()]() {
+            context->runRenderRequest(taskId);
+        };
+
+        auto viewNodeTree = _viewNodeManager.getViewNodeTreeForContextId(context->getContextId());
+        if (viewNodeTree != nullptr && viewNodeTree->getViewTreeUpdateQueue() != nullptr) {
+            // The update pass runs in the background, only its view operations and commit hit the main thread
+            viewNodeTree->getViewTreeUpdateQueue()->async(std::move(runRenderRequestFn));
+        } else {
+            getMainThreadManager().dispatch(context, std::move(runRenderRequestFn));
+        }
     }
 }
 
+Ref<DispatchQueue> Runtime::getViewNodeTreeUpdateQueue() {
+    std::lock_guard<Mutex> guard(_viewNodeTreeUpdateQueueMutex);
+    if (_viewNodeTreeUpdateQueue == nullptr) {
+        // Serial, so that the render requests of a Context are processed in order
+        _viewNodeTreeUpdateQueue =
+            DispatchQueue::create(STRING_LITERAL("Valdi ViewNodeTree Update Thread"), ThreadQoSClassHigh);
+    }
+    return _viewNodeTreeUpdateQueue;
+}
+
 void Runtime::processRenderRequest(const Ref<RenderRequest>& rawRenderRequest) {
     snap::utils::time::StopWatch sw;
     sw.start();
@@ -641,6 +671,10 @@ void Runtime::registerTypeConverter(const StringBox& className, const StringBox&
 
 void Runtime::setRuntimeTweaks(const Ref<ValdiRuntimeTweaks>& runtimeTweaks) {
     _resourceManager->setRuntimeTweaks(runtimeTweaks);
+
+    if (_javaScriptRuntime != nullptr) {
+        _javaScriptRuntime->setIdleGcEnabled(runtimeTweaks != nullptr ? runtimeTweaks->enableIdleGC() : false);
+    }
 }
 
 void Runtime::setMetrics(const Ref<Metrics>& metrics) {
@@ -724,6 +758,24 @@ JavaScriptRuntime* Runtime::getJavaScriptRuntime() {
     return _javaScriptRuntime.get();
 }
 
+void Runtime::notifyUserInteraction() {
+    if (_javaScriptRuntime != nullptr) {
+        _javaScriptRuntime->notifyUserInteraction();
+    }
+}
+
+void Runtime::beginAnimation() {
+    if (_javaScriptRuntime != nullptr) {
+        _javaScriptRuntime->beginAnimation();
+    }
+}
+
+void Runtime::endAnimation() {
+    if (_javaScriptRuntime != nullptr) {
+        _javaScriptRuntime->endAnimation();
+    }
+}
+
 void Runtime::setListener(const std::shared_ptr<IRuntimeListener>& listener) {
     _listener = listener;
 }
@@ -20,6 +20,7 @@
 #include "valdi/runtime/Utils/DumpedLogs.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
 #include "valdi/runtime/Utils/SharedAtomic.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/Value.hpp"
@@ -200,6 +201,15 @@ public:
     ResourceManager& getResourceManager();
 
     JavaScriptRuntime* getJavaScriptRuntime();
+
+    /**
+     Forward user interactions and running animations to the JS runtime,
+     so that its idle garbage collections are deferred until the UI settles.
+     Can be called from any thread.
+     */
+    void notifyUserInteraction();
+    void beginAnimation();
+    void endAnimation();
     const ContextManager& getContextManager() const;
     ContextManager& getContextManager();
     const ViewNodeTreeManager& getViewNodeTreeManager() const;
@@ -229,6 +239,12 @@ public:
 
     const Ref<DispatchQueue>& getWorkerQueue() const;
 
+    /**
+     Returns the serial queue processing the updates of the ViewNodeTrees
+     which commit their view tree in the main thread.
+     */
+    Ref<DispatchQueue> getViewNodeTreeUpdateQueue();
+
     ILogger& getLogger() const;
 
     // Made public just for tests
@@ -316,6 +332,8 @@ private:
 
     Shared<YGConfig> _yogaConfig;
     Ref<DispatchQueue> _workerQueue;
+    Ref<DispatchQueue> _viewNodeTreeUpdateQueue;
+    Mutex _viewNodeTreeUpdateQueueMutex;
     Shared<snap::valdi::RuntimeMessageHandler> _runtimeMessageHandler;
 
     Ref<ILogger> _logger;
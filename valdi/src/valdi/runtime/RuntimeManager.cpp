@@ -193,6 +193,7 @@ SharedRuntime RuntimeManager::createRuntime(const Shared<IResourceLoader>& resou
     Ref<ValdiRuntimeTweaks> runtimeTweaks;
     Ref<AttributionResolver> attributionResolver;
     Ref<Metrics> metrics;
+    size_t jsWorkerPoolCapacity;
 
     bool shouldInit = true;
     bool autoRenderDisabled;
@@ -208,6 +209,7 @@ SharedRuntime RuntimeManager::createRuntime(const Shared<IResourceLoader>& resou
         attributionResolver = _attributionResolver;
         metrics = _metrics;
         autoRenderDisabled = _loadOperationsCount > 0;
+        jsWorkerPoolCapacity = _jsWorkerPoolCapacity;
     }
 
     runtime->setRuntimeTweaks(runtimeTweaks);
@@ -219,6 +221,10 @@ SharedRuntime RuntimeManager::createRuntime(const Shared<IResourceLoader>& resou
         runtime->postInit();
     }
 
+    if (jsWorkerPoolCapacity > 0) {
+        runtime->getJavaScriptRuntime()->setWorkerPoolCapacity(jsWorkerPoolCapacity);
+    }
+
     for (const auto& moduleFactory : moduleFactories) {
         runtime->registerNativeModuleFactory(moduleFactory);
     }
@@ -332,6 +338,7 @@ void RuntimeManager::applicationIsLowInMemory() {
     VALDI_INFO(*_logger, "Application is low in memory");
     clearViewPools();
     for (const auto& runtime : getAllRuntimes()) {
+        runtime->getJavaScriptRuntime()->trimWorkerPool();
         runtime->removeUnusedResources();
     }
 }
@@ -531,6 +538,8 @@ void RuntimeManager::setTweakValueProvider(const Shared<ITweakValueProvider>& tw
     for (const auto& runtime : runtimes) {
         runtime->setRuntimeTweaks(runtimeTweaks);
     }
+
+    setJsWorkerPoolCapacity(runtimeTweaks != nullptr ? runtimeTweaks->jsWorkerPoolCapacity() : 0);
 }
 
 void RuntimeManager::cancelDeferredGCTask() {
@@ -585,6 +594,17 @@ void RuntimeManager::setJsThreadQoS(ThreadQoSClass jsThreadQoS) {
     }
 }
 
+void RuntimeManager::setJsWorkerPoolCapacity(size_t jsWorkerPoolCapacity) {
+    std::lock_guard<Mutex> guard(_mutex);
+    if (jsWorkerPoolCapacity != _jsWorkerPoolCapacity) {
+        _jsWorkerPoolCapacity = jsWorkerPoolCapacity;
+        auto runtimes = getAllRuntimes(guard);
+        for (const auto& runtime : runtimes) {
+            runtime->getJavaScriptRuntime()->setWorkerPoolCapacity(jsWorkerPoolCapacity);
+        }
+    }
+}
+
 void RuntimeManager::setAttributionResolver(const Ref<AttributionResolver>& attributionResolver) {
     std::lock_guard<Mutex> guard(_mutex);
     _attributionResolver = attributionResolver;
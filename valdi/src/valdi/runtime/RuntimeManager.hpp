@@ -137,6 +137,13 @@ public:
 
     void setJsThreadQoS(ThreadQoSClass jsThreadQoS);
 
+    /**
+     Set how many JS worker runtimes each runtime keeps initialized ahead of time.
+     The pools are trimmed when the application is low in memory. Disabled by default,
+     set from the VALDI_JS_WORKER_POOL_CAPACITY runtime tweak.
+     */
+    void setJsWorkerPoolCapacity(size_t jsWorkerPoolCapacity);
+
     void setAttributionResolver(const Ref<AttributionResolver>& attributionResolver);
 
     void setKeepDebuggerServiceOnPause(bool keepDebuggerServiceOnPause);
@@ -198,6 +205,7 @@ private:
     Ref<JavaScriptANRDetector> _anrDetector;
     PlatformType _platformType;
     ThreadQoSClass _jsThreadQoS;
+    size_t _jsWorkerPoolCapacity = 0;
     bool _disableRuntimeAutoInit = false;
     bool _keepDebuggerServiceOnPause = false;
     bool _debuggerServiceEnabled = false;
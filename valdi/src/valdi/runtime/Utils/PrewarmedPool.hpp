@@ -0,0 +1,175 @@
+//
+//  PrewarmedPool.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ A PrewarmedPool keeps up to capacity instances created ahead of time from a
+ background queue, so that expensive objects can be handed out without paying
+ their initialization. Every take() schedules a refill of the pool.
+ Instances are destroyed outside of the pool lock.
+ */
+template<typename T>
+class PrewarmedPool : public SharedPtrRefCountable {
+public:
+    using Factory = Function<T()>;
+
+    PrewarmedPool(const Ref<DispatchQueue>& queue, Factory factory)
+        : _queue(queue), _factory(std::move(factory)) {}
+
+    ~PrewarmedPool() override = default;
+
+    /**
+     Set how many instances the pool should keep. Instances above the capacity
+     are destroyed, missing instances are created asynchronously.
+     */
+    void setCapacity(size_t capacity) {
+        std::vector<T> removedItems;
+        {
+            std::lock_guard<Mutex> lock(_mutex);
+            _capacity = capacity;
+            while (_items.size() > _capacity) {
+                removedItems.emplace_back(std::move(_items.back()));
+                _items.pop_back();
+            }
+            lockFreeScheduleRefill();
+        }
+    }
+
+    size_t getCapacity() const {
+        std::lock_guard<Mutex> lock(_mutex);
+        return _capacity;
+    }
+
+    /**
+     Returns a prewarmed instance if one is available, and schedule the creation
+     of its replacement.
+     */
+    std::optional<T> take() {
+        std::lock_guard<Mutex> lock(_mutex);
+        std::optional<T> item;
+        if (!_items.empty()) {
+            item = std::move(_items.front());
+            _items.pop_front();
+        }
+        lockFreeScheduleRefill();
+        return item;
+    }
+
+    /**
+     Destroy all the prewarmed instances, typically when the application is low in memory.
+     The pool is refilled on the next take() or setCapacity() call.
+     */
+    void trim() {
+        std::deque<T> removedItems;
+        {
+            std::lock_guard<Mutex> lock(_mutex);
+            removedItems = std::move(_items);
+            _items.clear();
+            _trimmed = true;
+        }
+    }
+
+    /**
+     Destroy all the prewarmed instances and tear down the queue. Waits for a refill
+     in progress, whose instance is destroyed instead of being added to the pool.
+     The pool cannot be refilled afterwards.
+     */
+    void teardown() {
+        std::deque<T> removedItems;
+        {
+            std::lock_guard<Mutex> lock(_mutex);
+            _disposed = true;
+            _capacity = 0;
+            removedItems = std::move(_items);
+            _items.clear();
+        }
+
+        _queue->flushAndTeardown();
+    }
+
+    size_t size() const {
+        std::lock_guard<Mutex> lock(_mutex);
+        return _items.size();
+    }
+
+    /**
+     Wait until the refill in progress, if any, has completed.
+     */
+    void flush() {
+        _queue->sync([]() {});
+    }
+
+    // For Testing Only
+    std::vector<T> getItems() const {
+        std::lock_guard<Mutex> lock(_mutex);
+        return std::vector<T>(_items.begin(), _items.end());
+    }
+
+private:
+    mutable Mutex _mutex;
+    Ref<DispatchQueue> _queue;
+    Factory _factory;
+    std::deque<T> _items;
+    size_t _capacity = 0;
+    bool _refillScheduled = false;
+    bool _trimmed = false;
+    bool _disposed = false;
+
+    void lockFreeScheduleRefill() {
+        _trimmed = false;
+        if (_disposed || _refillScheduled || _items.size() >= _capacity) {
+            return;
+        }
+
+        _refillScheduled = true;
+        _queue->async([weakSelf = weakRef(this)]() {
+            auto self = weakSelf.lock();
+            if (self != nullptr) {
+                self->refill();
+            }
+        });
+    }
+
+    void refill() {
+        for (;;) {
+            {
+                std::lock_guard<Mutex> lock(_mutex);
+                if (_disposed || _trimmed || _items.size() >= _capacity) {
+                    _refillScheduled = false;
+                    return;
+                }
+            }
+
+            // The instance is created outside of the lock so that take() never waits on the factory
+            auto item = _factory();
+
+            std::unique_lock<Mutex> lock(_mutex);
+            if (_disposed || _trimmed || _items.size() >= _capacity) {
+                _refillScheduled = false;
+                // Destroy the instance outside of the lock
+                lock.unlock();
+                return;
+            }
+            _items.emplace_back(std::move(item));
+        }
+    }
+};
+
+} // namespace Valdi
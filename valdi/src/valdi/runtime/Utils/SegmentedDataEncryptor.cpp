@@ -0,0 +1,260 @@
+//
+//  SegmentedDataEncryptor.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Utils/SegmentedDataEncryptor.hpp"
+
+#include <openssl/aead.h>
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace Valdi {
+
+static constexpr std::array<Byte, 4> kMagic = {'V', 'S', 'E', '1'};
+
+using HeaderBytes = std::array<Byte, SegmentedDataEncryptor::kHeaderSize>;
+// Serialized header followed by the chunk index
+using AdditionalData = std::array<Byte, SegmentedDataEncryptor::kHeaderSize + sizeof(uint64_t)>;
+
+static void writeLE(Byte* out, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        out[i] = static_cast<Byte>(value >> (8 * i));
+    }
+}
+
+static uint64_t readLE(const Byte* data, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+static HeaderBytes serializeHeader(const SegmentedDataEncryptor::Header& header) {
+    HeaderBytes bytes;
+    std::memcpy(bytes.data(), kMagic.data(), kMagic.size());
+    writeLE(bytes.data() + 4, header.chunkSize, 4);
+    writeLE(bytes.data() + 8, header.plainSize, 8);
+    std::memcpy(bytes.data() + 16, header.nonce.data(), header.nonce.size());
+    return bytes;
+}
+
+static snap::utils::crypto::AesEncryptor::Iv makeChunkNonce(const SegmentedDataEncryptor::Header& header,
+                                                            size_t chunkIndex) {
+    auto nonce = header.nonce;
+    // XOR the index into the last 8 bytes of the nonce, big endian
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+        nonce[nonce.size() - 1 - i] ^= static_cast<uint8_t>(static_cast<uint64_t>(chunkIndex) >> (8 * i));
+    }
+    return nonce;
+}
+
+static AdditionalData makeAdditionalData(const HeaderBytes& headerBytes, size_t chunkIndex) {
+    AdditionalData additionalData;
+    std::memcpy(additionalData.data(), headerBytes.data(), headerBytes.size());
+    writeLE(additionalData.data() + headerBytes.size(), chunkIndex, sizeof(uint64_t));
+    return additionalData;
+}
+
+/**
+ Keeps an initialized AEAD context for the duration of an encryption or decryption,
+ so that the key schedule is computed once for all the chunks.
+ */
+class AeadContext {
+public:
+    explicit AeadContext(const snap::utils::crypto::AesEncryptor::Key& key) {
+        _initialized = EVP_AEAD_CTX_init(&_ctx,
+                                         EVP_aead_aes_128_gcm(),
+                                         key.data(),
+                                         key.size(),
+                                         SegmentedDataEncryptor::kTagSize,
+                                         nullptr) != 0;
+    }
+
+    ~AeadContext() {
+        if (_initialized) {
+            EVP_AEAD_CTX_cleanup(&_ctx);
+        }
+    }
+
+    AeadContext(const AeadContext&) = delete;
+    AeadContext& operator=(const AeadContext&) = delete;
+
+    bool isInitialized() const {
+        return _initialized;
+    }
+
+    EVP_AEAD_CTX* get() {
+        return &_ctx;
+    }
+
+private:
+    EVP_AEAD_CTX _ctx;
+    bool _initialized = false;
+};
+
+size_t SegmentedDataEncryptor::Header::getChunksCount() const {
+    if (plainSize == 0) {
+        return 1;
+    }
+    return (plainSize + chunkSize - 1) / chunkSize;
+}
+
+size_t SegmentedDataEncryptor::Header::getEncryptedSize() const {
+    return kHeaderSize + plainSize + getChunksCount() * kTagSize;
+}
+
+size_t SegmentedDataEncryptor::Header::getChunkOffset(size_t chunkIndex) const {
+    return kHeaderSize + chunkIndex * (chunkSize + kTagSize);
+}
+
+size_t SegmentedDataEncryptor::Header::getChunkPlainSize(size_t chunkIndex) const {
+    auto chunkStart = chunkIndex * chunkSize;
+    return std::min(chunkSize, plainSize - std::min(chunkStart, plainSize));
+}
+
+SegmentedDataEncryptor::SegmentedDataEncryptor(const snap::utils::crypto::AesEncryptor::Key& key) : _key(key) {}
+
+bool SegmentedDataEncryptor::encrypt(const Byte* data, size_t length, ByteBuffer& out, size_t chunkSize) const {
+    if (chunkSize == 0 || chunkSize > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    AeadContext ctx(_key);
+    if (!ctx.isInitialized()) {
+        return false;
+    }
+
+    Header header;
+    header.chunkSize = chunkSize;
+    header.plainSize = length;
+    RAND_bytes(header.nonce.data(), header.nonce.size());
+
+    auto headerBytes = serializeHeader(header);
+
+    // The output is sized once and the chunks are sealed in place, so that the
+    // only allocation is the output buffer itself.
+    auto outOffset = out.size();
+    out.resize(outOffset + header.getEncryptedSize());
+    auto* output = out.data() + outOffset;
+
+    std::memcpy(output, headerBytes.data(), headerBytes.size());
+
+    auto chunksCount = header.getChunksCount();
+    for (size_t chunkIndex = 0; chunkIndex < chunksCount; chunkIndex++) {
+        auto nonce = makeChunkNonce(header, chunkIndex);
+        auto additionalData = makeAdditionalData(headerBytes, chunkIndex);
+        auto chunkPlainSize = header.getChunkPlainSize(chunkIndex);
+        auto* chunkOutput = output + header.getChunkOffset(chunkIndex);
+
+        size_t sealedSize = 0;
+        if (EVP_AEAD_CTX_seal(ctx.get(),
+                              chunkOutput,
+                              &sealedSize,
+                              chunkPlainSize + kTagSize,
+                              nonce.data(),
+                              nonce.size(),
+                              data + chunkIndex * chunkSize,
+                              chunkPlainSize,
+                              additionalData.data(),
+                              additionalData.size()) == 0 ||
+            sealedSize != chunkPlainSize + kTagSize) {
+            out.resize(outOffset);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SegmentedDataEncryptor::decrypt(const Byte* data, size_t length, ByteBuffer& out) const {
+    auto header = parseHeader(data, length);
+    if (!header || header->getEncryptedSize() != length) {
+        return false;
+    }
+
+    return decryptChunks(header.value(),
+                         0,
+                         header->getChunksCount(),
+                         data + kHeaderSize,
+                         length - kHeaderSize,
+                         out);
+}
+
+bool SegmentedDataEncryptor::decryptChunks(const Header& header,
+                                           size_t firstChunkIndex,
+                                           size_t chunksCount,
+                                           const Byte* chunks,
+                                           size_t chunksLength,
+                                           ByteBuffer& out) const {
+    if (chunksCount == 0 || firstChunkIndex + chunksCount > header.getChunksCount() ||
+        header.getChunkOffset(firstChunkIndex) + chunksLength !=
+            std::min(header.getChunkOffset(firstChunkIndex + chunksCount), header.getEncryptedSize())) {
+        return false;
+    }
+
+    AeadContext ctx(_key);
+    if (!ctx.isInitialized()) {
+        return false;
+    }
+
+    auto headerBytes = serializeHeader(header);
+    auto outOffset = out.size();
+    out.resize(outOffset + chunksLength - chunksCount * kTagSize);
+
+    auto* output = out.data() + outOffset;
+    const auto* input = chunks;
+
+    for (size_t chunkIndex = firstChunkIndex; chunkIndex < firstChunkIndex + chunksCount; chunkIndex++) {
+        auto nonce = makeChunkNonce(header, chunkIndex);
+        auto additionalData = makeAdditionalData(headerBytes, chunkIndex);
+        auto chunkPlainSize = header.getChunkPlainSize(chunkIndex);
+
+        size_t openedSize = 0;
+        if (EVP_AEAD_CTX_open(ctx.get(),
+                              output,
+                              &openedSize,
+                              chunkPlainSize,
+                              nonce.data(),
+                              nonce.size(),
+                              input,
+                              chunkPlainSize + kTagSize,
+                              additionalData.data(),
+                              additionalData.size()) == 0 ||
+            openedSize != chunkPlainSize) {
+            out.resize(outOffset);
+            return false;
+        }
+
+        output += chunkPlainSize;
+        input += chunkPlainSize + kTagSize;
+    }
+
+    return true;
+}
+
+std::optional<SegmentedDataEncryptor::Header> SegmentedDataEncryptor::parseHeader(const Byte* data, size_t length) {
+    if (length < kHeaderSize || std::memcmp(data, kMagic.data(), kMagic.size()) != 0) {
+        return std::nullopt;
+    }
+
+    Header header;
+    header.chunkSize = static_cast<size_t>(readLE(data + 4, 4));
+    auto plainSize = readLE(data + 8, 8);
+    if (header.chunkSize == 0 || plainSize > std::numeric_limits<size_t>::max() / 2) {
+        return std::nullopt;
+    }
+    header.plainSize = static_cast<size_t>(plainSize);
+    std::memcpy(header.nonce.data(), data + 16, header.nonce.size());
+
+    return header;
+}
+
+} // namespace Valdi
@@ -0,0 +1,77 @@
+//
+//  SegmentedDataEncryptor.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "utils/crypto/AesEncryptor.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+
+#include <optional>
+
+namespace Valdi {
+
+/**
+ * The SegmentedDataEncryptor encrypts data with AES-128-GCM into a sequence of
+ * independently authenticated chunks. Chunks are encrypted one after the other
+ * directly into the output buffer, and any range of the data can be decrypted
+ * by decrypting only the chunks that cover it.
+ *
+ * Layout: [header][chunk 0]...[chunk N - 1]
+ * - header: magic (4 bytes), chunk size (u32 LE), plain size (u64 LE), nonce (12 bytes)
+ * - chunk: ciphertext of up to chunk size bytes, followed by the 16 bytes tag
+ *
+ * Each chunk uses the header nonce with its index XORed in, and authenticates
+ * the header and its index as additional data, so that chunks cannot be
+ * reordered, truncated or moved between files. There is always at least one
+ * chunk, so that the header of an empty input is authenticated as well.
+ */
+class SegmentedDataEncryptor {
+public:
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+    static constexpr size_t kHeaderSize = 28;
+    static constexpr size_t kTagSize = 16;
+
+    struct Header {
+        size_t chunkSize = 0;
+        size_t plainSize = 0;
+        snap::utils::crypto::AesEncryptor::Iv nonce;
+
+        size_t getChunksCount() const;
+        size_t getEncryptedSize() const;
+        // Offset of the given chunk within the encrypted data, header included
+        size_t getChunkOffset(size_t chunkIndex) const;
+        size_t getChunkPlainSize(size_t chunkIndex) const;
+    };
+
+    explicit SegmentedDataEncryptor(const snap::utils::crypto::AesEncryptor::Key& key);
+
+    bool encrypt(const Byte* data, size_t length, ByteBuffer& out, size_t chunkSize = kDefaultChunkSize) const;
+    bool decrypt(const Byte* data, size_t length, ByteBuffer& out) const;
+
+    /**
+     * Decrypt chunksCount chunks starting at firstChunkIndex, given their encrypted bytes,
+     * and append the plain data to the output buffer.
+     */
+    bool decryptChunks(const Header& header,
+                       size_t firstChunkIndex,
+                       size_t chunksCount,
+                       const Byte* chunks,
+                       size_t chunksLength,
+                       ByteBuffer& out) const;
+
+    /**
+     * Parse the header at the beginning of the given data. Returns an empty optional
+     * if the data is not in the segmented format.
+     */
+    static std::optional<Header> parseHeader(const Byte* data, size_t length);
+
+private:
+    snap::utils::crypto::AesEncryptor::Key _key;
+};
+
+} // namespace Valdi
@@ -35,6 +35,14 @@ bool ValdiRuntimeTweaks::enableDeferredGC() const {
     return getConfigKey("VALDI_ENABLE_DEFERRED_GC");
 }
 
+bool ValdiRuntimeTweaks::enableIdleGC() const {
+    return getConfigKey("VALDI_ENABLE_IDLE_GC");
+}
+
+bool ValdiRuntimeTweaks::enableMainThreadCommit() const {
+    return getConfigKey("VALDI_ENABLE_MAIN_THREAD_COMMIT");
+}
+
 bool ValdiRuntimeTweaks::enableCommonJsModuleLoader() const {
     return getConfigKey("VALDI_ENABLE_COMMONJS_MODULE_LOADER");
 }
@@ -104,4 +112,16 @@ bool ValdiRuntimeTweaks::skipProtoIndex() const {
     return getConfigKey("VALDI_PROTO_SKIP_INDEX");
 }
 
+size_t ValdiRuntimeTweaks::jsWorkerPoolCapacity() const {
+    auto configKey = StringCache::getGlobal().makeStringFromLiteral("VALDI_JS_WORKER_POOL_CAPACITY");
+    auto capacity = _tweakValueProvider->getFloat(configKey, 0.0f);
+    return capacity > 0.0f ? static_cast<size_t>(capacity) : 0;
+}
+
+int64_t ValdiRuntimeTweaks::viewCreationBudgetUs() const {
+    auto configKey = StringCache::getGlobal().makeStringFromLiteral("VALDI_VIEW_CREATION_BUDGET_US");
+    auto budgetUs = _tweakValueProvider->getFloat(configKey, 0.0f);
+    return budgetUs > 0.0f ? static_cast<int64_t>(budgetUs) : 0;
+}
+
 } // namespace Valdi
@@ -21,6 +21,8 @@ public:
 
     bool enableAccessibility() const;
     bool enableDeferredGC() const;
+    bool enableIdleGC() const;
+    bool enableMainThreadCommit() const;
     bool enableCommonJsModuleLoader() const;
     bool disableHotReloaderLazyDenylist() const;
     bool disableSyncCallsInCallingThread() const;
@@ -31,6 +33,8 @@ public:
     bool shouldNudgeJSThread() const;
     bool disablePersistentStoreEncryption() const;
     bool skipProtoIndex() const;
+    size_t jsWorkerPoolCapacity() const;
+    int64_t viewCreationBudgetUs() const;
 
 private:
     Shared<ITweakValueProvider> _tweakValueProvider;
@@ -10,6 +10,7 @@
 #include "valdi/runtime/Context/Context.hpp"
 #include "valdi/runtime/Interfaces/IViewManager.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
+#include "valdi/runtime/Views/PendingView.hpp"
 #include "valdi_core/cpp/Resources/LoadedAsset.hpp"
 #include "valdi_core/cpp/Utils/TrackedLock.hpp"
 
@@ -56,34 +57,58 @@ void DeferredViewTransaction::didUpdateRootView(const Ref<View>& view, bool layo
 }
 
 void DeferredViewTransaction::moveViewToTree(const Ref<View>& view, ViewNodeTree* viewNodeTree, ViewNode* viewNode) {
-    enqueue(
-        [view, viewNodeTree = strongSmallRef(viewNodeTree), viewNode = strongSmallRef(viewNode)](
-            IViewTransaction& transaction) { transaction.moveViewToTree(view, viewNodeTree.get(), viewNode.get()); });
+    enqueue([view, viewNodeTree = strongSmallRef(viewNodeTree), viewNode = strongSmallRef(viewNode)](
+                IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.moveViewToTree(resolvedView, viewNodeTree.get(), viewNode.get());
+        }
+    });
 }
 
 void DeferredViewTransaction::insertChildView(const Ref<View>& view,
                                               const Ref<View>& childView,
                                               int index,
                                               const Ref<Animator>& animator) {
-    enqueue([=](IViewTransaction& transaction) { transaction.insertChildView(view, childView, index, animator); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        auto resolvedChildView = PendingView::resolve(childView);
+        if (resolvedView != nullptr && resolvedChildView != nullptr) {
+            transaction.insertChildView(resolvedView, resolvedChildView, index, animator);
+        }
+    });
 }
 
 void DeferredViewTransaction::removeViewFromParent(const Ref<View>& view,
                                                    const Ref<Animator>& animator,
                                                    bool shouldClearViewNode) {
-    enqueue(
-        [=](IViewTransaction& transaction) { transaction.removeViewFromParent(view, animator, shouldClearViewNode); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.removeViewFromParent(resolvedView, animator, shouldClearViewNode);
+        }
+    });
 }
 
 void DeferredViewTransaction::invalidateViewLayout(const Ref<View>& view) {
-    enqueue([=](IViewTransaction& transaction) { transaction.invalidateViewLayout(view); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.invalidateViewLayout(resolvedView);
+        }
+    });
 }
 
 void DeferredViewTransaction::setViewFrame(const Ref<View>& view,
                                            const Frame& newFrame,
                                            bool isRightToLeft,
                                            const Ref<Animator>& animator) {
-    enqueue([=](IViewTransaction& transaction) { transaction.setViewFrame(view, newFrame, isRightToLeft, animator); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.setViewFrame(resolvedView, newFrame, isRightToLeft, animator);
+        }
+    });
 }
 
 void DeferredViewTransaction::setViewScrollSpecs(const Ref<View>& view,
@@ -91,33 +116,60 @@ void DeferredViewTransaction::setViewScrollSpecs(const Ref<View>& view,
                                                  const Size& contentSize,
                                                  bool animated) {
     enqueue([=](IViewTransaction& transaction) {
-        transaction.setViewScrollSpecs(view, directionDependentContentOffset, contentSize, animated);
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.setViewScrollSpecs(resolvedView, directionDependentContentOffset, contentSize, animated);
+        }
     });
 }
 
 void DeferredViewTransaction::setViewLoadedAsset(const Ref<View>& view,
                                                  const Ref<LoadedAsset>& loadedAsset,
                                                  bool shouldDrawFlipped) {
-    enqueue(
-        [=](IViewTransaction& transaction) { transaction.setViewLoadedAsset(view, loadedAsset, shouldDrawFlipped); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.setViewLoadedAsset(resolvedView, loadedAsset, shouldDrawFlipped);
+        }
+    });
 }
 
 void DeferredViewTransaction::layoutView(const Ref<View>& view) {
-    enqueue([=](IViewTransaction& transaction) { transaction.layoutView(view); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.layoutView(resolvedView);
+        }
+    });
 }
 
 void DeferredViewTransaction::cancelAllViewAnimations(const Ref<View>& view) {
-    enqueue([=](IViewTransaction& transaction) { transaction.cancelAllViewAnimations(view); });
+    enqueue([=](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.cancelAllViewAnimations(resolvedView);
+        }
+    });
 }
 
 void DeferredViewTransaction::willEnqueueViewToPool(const Ref<View>& view, Function<void(View&)> onEnqueue) {
     enqueue([view, onEnqueue = std::move(onEnqueue)](IViewTransaction& transaction) {
-        transaction.willEnqueueViewToPool(view, onEnqueue);
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.willEnqueueViewToPool(resolvedView, onEnqueue);
+        }
     });
 }
 
 void DeferredViewTransaction::snapshotView(const Ref<View>& view, Function<void(Result<BytesView>)> cb) {
-    enqueue([view, cb = std::move(cb)](IViewTransaction& transaction) { transaction.snapshotView(view, cb); });
+    enqueue([view, cb = std::move(cb)](IViewTransaction& transaction) {
+        auto resolvedView = PendingView::resolve(view);
+        if (resolvedView != nullptr) {
+            transaction.snapshotView(resolvedView, cb);
+        } else {
+            cb(Error("Cannot snapshot a view which could not be created"));
+        }
+    });
 }
 
 void DeferredViewTransaction::flushAnimator(const Ref<Animator>& animator, const Value& completionCallback) {
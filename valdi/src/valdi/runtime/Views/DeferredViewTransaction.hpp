@@ -26,6 +26,8 @@ class Context;
 /**
  Implementation of IViewTransaction which will defer all operations into a nested view transaction
  provided by the given IViewManager, and executed in the main thread.
+ PendingView instances referenced by the operations are resolved into their created view
+ when the operations are executed.
  */
 class DeferredViewTransaction : public IViewTransaction {
 public:
@@ -0,0 +1,63 @@
+//
+//  PendingView.cpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/Views/PendingView.hpp"
+#include "valdi/runtime/Context/ViewNode.hpp"
+#include "valdi/runtime/Context/ViewNodeTree.hpp"
+#include "valdi/runtime/Interfaces/IViewManager.hpp"
+#include "valdi/runtime/Views/ViewFactory.hpp"
+
+namespace Valdi {
+
+PendingView::PendingView(Ref<ViewFactory> viewFactory, Weak<ViewNodeTree> viewNodeTree, Weak<ViewNode> viewNode)
+    : _viewFactory(std::move(viewFactory)), _viewNodeTree(std::move(viewNodeTree)), _viewNode(std::move(viewNode)) {}
+
+PendingView::~PendingView() = default;
+
+snap::valdi_core::Platform PendingView::getPlatform() const {
+    if (isCreated() && _view != nullptr) {
+        return _view->getPlatform();
+    }
+
+    return _viewFactory->getViewManager().getPlatformType() == PlatformTypeAndroid ?
+               snap::valdi_core::Platform::Android :
+               snap::valdi_core::Platform::Ios;
+}
+
+const Ref<View>& PendingView::getOrCreateView() {
+    if (!isCreated()) {
+        auto viewNodeTree = strongRef(_viewNodeTree);
+        if (viewNodeTree != nullptr) {
+            auto viewNode = strongRef(_viewNode);
+            _view = _viewFactory->createView(viewNodeTree.get(), viewNode.get(), false);
+        }
+        _created.store(true, std::memory_order_release);
+    }
+
+    return _view;
+}
+
+bool PendingView::isCreated() const {
+    return _created.load(std::memory_order_acquire);
+}
+
+const Ref<View>& PendingView::getView() const {
+    return _view;
+}
+
+Ref<View> PendingView::resolve(const Ref<View>& view) {
+    auto* pendingView = dynamic_cast<PendingView*>(view.get());
+    if (pendingView == nullptr) {
+        return view;
+    }
+
+    return pendingView->getOrCreateView();
+}
+
+VALDI_CLASS_IMPL(PendingView)
+
+} // namespace Valdi
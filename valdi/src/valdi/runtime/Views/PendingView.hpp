@@ -0,0 +1,58 @@
+//
+//  PendingView.hpp
+//  valdi
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi/runtime/Views/View.hpp"
+
+#include <atomic>
+
+namespace Valdi {
+
+class ViewFactory;
+
+/**
+ Stands for a view which could not be taken from the pools during an update pass running
+ outside of the main thread. The view operations of the pass reference the PendingView, and
+ the actual view is created from its ViewFactory by the main thread commit when it applies
+ the first of them. The ViewNode swaps the PendingView for the created view afterwards.
+ */
+class PendingView : public View {
+public:
+    PendingView(Ref<ViewFactory> viewFactory, Weak<ViewNodeTree> viewNodeTree, Weak<ViewNode> viewNode);
+    ~PendingView() override;
+
+    snap::valdi_core::Platform getPlatform() const override;
+
+    /**
+     Returns the created view, creating it if needed. Must be called from the main thread.
+     */
+    const Ref<View>& getOrCreateView();
+
+    /**
+     Returns whether getOrCreateView() was called. The created view can then be read from any thread.
+     */
+    bool isCreated() const;
+    const Ref<View>& getView() const;
+
+    /**
+     Returns the view created for the given view if it is a PendingView, or the view itself otherwise.
+     Must be called from the main thread.
+     */
+    static Ref<View> resolve(const Ref<View>& view);
+
+    VALDI_CLASS_HEADER(PendingView)
+
+private:
+    Ref<ViewFactory> _viewFactory;
+    Weak<ViewNodeTree> _viewNodeTree;
+    Weak<ViewNode> _viewNode;
+    Ref<View> _view;
+    std::atomic_bool _created = false;
+};
+
+} // namespace Valdi
@@ -10,6 +10,7 @@
 #include "valdi/runtime/Context/ViewNodeTree.hpp"
 #include "valdi/runtime/Interfaces/IViewTransaction.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
+#include "valdi/runtime/Views/PendingView.hpp"
 
 namespace Valdi {
 
@@ -32,8 +33,9 @@ Size PlaceholderViewMeasureDelegate::measure(
             viewNodeTree->getViewManager(), currentViewTransactionScope->getMainThreadManager(), false);
         viewNodeTree->unsafeSetCurrentViewTransactionScope(nestedViewTransactionScope);
 
-        if (viewNode.getView() != nullptr) {
-            measuredSize = measureView(viewNode.getView(), width, widthMode, height, heightMode);
+        auto view = PendingView::resolve(viewNode.getView());
+        if (view != nullptr) {
+            measuredSize = measureView(view, width, widthMode, height, heightMode);
         } else {
             std::lock_guard<Mutex> guard(_mutex);
             if (!_didFetchPlaceholderView) {
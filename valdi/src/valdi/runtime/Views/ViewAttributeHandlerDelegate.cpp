@@ -8,6 +8,7 @@
 #include "valdi/runtime/Views/ViewAttributeHandlerDelegate.hpp"
 #include "valdi/runtime/Context/ViewNode.hpp"
 #include "valdi/runtime/Interfaces/IViewTransaction.hpp"
+#include "valdi/runtime/Views/PendingView.hpp"
 #include "valdi/runtime/Views/ViewTransactionScope.hpp"
 
 namespace Valdi {
@@ -20,7 +21,11 @@ Result<Void> ViewAttributeHandlerDelegate::onApply(ViewTransactionScope& viewTra
                                                    const Ref<Animator>& animator) {
     viewTransactionScope.transaction().executeInTransactionThread(
         [view, animator, self = strongSmallRef(this), viewNode = strongSmallRef(&viewNode), value, name]() {
-            auto result = self->onViewApply(view, name, value, animator);
+            auto resolvedView = PendingView::resolve(view);
+            if (resolvedView == nullptr) {
+                return;
+            }
+            auto result = self->onViewApply(resolvedView, name, value, animator);
             if (!result) {
                 viewNode->notifyAttributeFailed(viewNode->getAttributeIds().getIdForName(name), result.error());
             }
@@ -35,7 +40,12 @@ void ViewAttributeHandlerDelegate::onReset(ViewTransactionScope& viewTransaction
                                            const StringBox& name,
                                            const Ref<Animator>& animator) {
     viewTransactionScope.transaction().executeInTransactionThread(
-        [view, animator, self = strongSmallRef(this), name]() { self->onViewReset(view, name, animator); });
+        [view, animator, self = strongSmallRef(this), name]() {
+            auto resolvedView = PendingView::resolve(view);
+            if (resolvedView != nullptr) {
+                self->onViewReset(resolvedView, name, animator);
+            }
+        });
 }
 
 } // namespace Valdi
@@ -26,12 +26,8 @@ void ViewFactory::clearViewPool() {
 
 Ref<View> ViewFactory::createView(ViewNodeTree* viewNodeTree, ViewNode* viewNode, bool allowPool) {
     if (allowPool) {
-        std::lock_guard<Mutex> lock(_mutex);
-
-        if (!_pooledViews.empty()) {
-            auto view = _pooledViews.front();
-            _pooledViews.pop_front();
-
+        auto view = dequeueViewFromPool();
+        if (view != nullptr) {
             return view;
         }
     }
@@ -40,6 +36,19 @@ Ref<View> ViewFactory::createView(ViewNodeTree* viewNodeTree, ViewNode* viewNode
     return doCreateView(viewNodeTree, viewNode);
 }
 
+Ref<View> ViewFactory::dequeueViewFromPool() {
+    std::lock_guard<Mutex> lock(_mutex);
+
+    if (_pooledViews.empty()) {
+        return nullptr;
+    }
+
+    auto view = _pooledViews.front();
+    _pooledViews.pop_front();
+
+    return view;
+}
+
 void ViewFactory::enqueueViewToPool(const Ref<View>& view) {
     std::lock_guard<Mutex> lock(_mutex);
     _pooledViews.emplace_back(view);
@@ -30,6 +30,11 @@ public:
     ~ViewFactory() override;
 
     Ref<View> createView(ViewNodeTree* viewNodeTree, ViewNode* viewNode, bool allowPool);
+    /**
+     Returns a view from the pool, or null if the pool is empty.
+     Unlike createView(), it never creates a new view and can be called from any thread.
+     */
+    Ref<View> dequeueViewFromPool();
     void enqueueViewToPool(const Ref<View>& view);
     void clearViewPool();
 
@@ -21,6 +21,12 @@
 //               currently used as a stand-in until we have a more reliable mechanism.
 static const int kShaderCacheVersion = 1;
 
+// Bounds of the shaders loaded ahead of time, the ones compiled during the first frames are enough
+static constexpr size_t kMaxPrefetchedShadersCount = 64;
+static constexpr size_t kMaxPrefetchedShadersBytes = 2 * 1024 * 1024;
+// Prefetched shaders not loaded by Skia within this delay are released
+static constexpr std::chrono::seconds kPrefetchedShadersExpiration = std::chrono::seconds(10);
+
 using namespace Valdi;
 
 namespace snap::drawing {
@@ -47,7 +53,7 @@ static Result<Valdi::BytesView> skDataToByteView(const SkData& data) {
     return retval->toBytesView();
 }
 
-Result<BytesView> ShaderCache::loadShaderFromDisk(const BytesView& key) const {
+Result<BytesView> ShaderCache::loadShaderFromDisk(const BytesView& key) {
     auto keyFilePathResult = keyToFileName(key);
     if (keyFilePathResult.failure()) {
         VALDI_ERROR(_logger, "Failed to generate file name from key");
@@ -55,6 +61,18 @@ Result<BytesView> ShaderCache::loadShaderFromDisk(const BytesView& key) const {
     }
     auto keyFilePath = keyFilePathResult.moveValue();
 
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        const auto& it = _prefetchedShaders.find(keyFilePath.toStringBox());
+        if (it != _prefetchedShaders.end()) {
+            // Skia keeps the compiled program once loaded, the prefetched data is not needed anymore
+            auto data = it->second;
+            _prefetchedShaders.erase(it);
+            return data;
+        }
+        markShaderServed(keyFilePath.toStringBox());
+    }
+
     if (!_diskCache->exists(keyFilePath)) {
         return Error("Key not in cache");
     }
@@ -68,13 +86,19 @@ Result<BytesView> ShaderCache::loadShaderFromDisk(const BytesView& key) const {
     return loadResult.value();
 }
 
-void ShaderCache::storeShaderToDisk(const BytesView& key, const BytesView& data) const {
+void ShaderCache::storeShaderToDisk(const BytesView& key, const BytesView& data) {
     auto keyFilePathResult = keyToFileName(key);
     if (keyFilePathResult.failure()) {
         VALDI_ERROR(_logger, "Failed to generate file name from key");
         return;
     }
     auto keyFilePath = keyFilePathResult.moveValue();
+
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        _prefetchedShaders.erase(keyFilePath.toStringBox());
+        markShaderServed(keyFilePath.toStringBox());
+    }
     if (_diskCache->exists(keyFilePath)) {
         VALDI_WARN(_logger, "Overwriting shader item for {}", keyFilePath);
     }
@@ -100,6 +124,89 @@ ShaderCache::ShaderCache(const Ref<IDiskCache>& diskCache, const Ref<DispatchQue
     });
 }
 
+void ShaderCache::markShaderServed(const StringBox& fileName) {
+    if (_prefetching) {
+        _servedShaders.insert(fileName);
+    }
+}
+
+void ShaderCache::prefetchShadersFromDisk() {
+    auto paths = _diskCache->list(_diskCache->getRootPath());
+    if (paths.size() > kMaxPrefetchedShadersCount) {
+        paths.resize(kMaxPrefetchedShadersCount);
+    }
+    if (paths.empty()) {
+        std::lock_guard<Mutex> lock(_mutex);
+        _prefetching = false;
+        return;
+    }
+
+    auto weakThis = weakRef(this);
+    _diskCache->loadMany(paths, [weakThis, paths](std::vector<Result<BytesView>> results) {
+        auto strongThis = weakThis.lock();
+        if (strongThis != nullptr) {
+            strongThis->onShadersPrefetched(paths, std::move(results));
+        }
+    });
+}
+
+void ShaderCache::onShadersPrefetched(const std::vector<Path>& paths, std::vector<Result<BytesView>> results) {
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        size_t prefetchedBytes = 0;
+        for (size_t i = 0; i < paths.size(); i++) {
+            if (!results[i]) {
+                continue;
+            }
+            auto fileName = StringCache::getGlobal().makeString(paths[i].getLastComponent());
+            if (_servedShaders.find(fileName) != _servedShaders.end()) {
+                // Already loaded from disk or stored again while the prefetch was in flight
+                continue;
+            }
+            if (prefetchedBytes + results[i].value().size() > kMaxPrefetchedShadersBytes) {
+                continue;
+            }
+
+            prefetchedBytes += results[i].value().size();
+            _prefetchedShaders[fileName] = results[i].moveValue();
+        }
+
+        _servedShaders.clear();
+        _prefetching = false;
+    }
+
+    _queue->asyncAfter(
+        [weakThis = weakRef(this)]() {
+            if (auto strongThis = weakThis.lock()) {
+                strongThis->expirePrefetchedShaders();
+            }
+        },
+        kPrefetchedShadersExpiration);
+}
+
+void ShaderCache::expirePrefetchedShaders() {
+    std::lock_guard<Mutex> lock(_mutex);
+    _prefetchedShaders.clear();
+}
+
+void ShaderCache::prefetch() {
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        if (_prefetching) {
+            return;
+        }
+        _prefetching = true;
+    }
+
+    auto weakThis = weakRef(this);
+    _queue->async([weakThis]() {
+        auto strongThis = weakThis.lock();
+        if (strongThis) {
+            strongThis->prefetchShadersFromDisk();
+        }
+    });
+}
+
 void ShaderCache::store(const SkData& key, const SkData& data) {
     auto dataResult = skDataToByteView(data);
     auto ownedKeyResult = skDataToByteView(key);
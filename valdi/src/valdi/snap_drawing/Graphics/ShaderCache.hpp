@@ -14,6 +14,8 @@
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 #include "valdi_core/cpp/Utils/Void.hpp"
 
@@ -29,13 +31,30 @@ public:
     sk_sp<SkData> load(const SkData& key) override;
     void store(const SkData& key, const SkData& data) override;
 
+    /**
+     Load a bounded number of the shaders stored on disk in one batch from the worker queue,
+     so that the first loads don't have to hit the disk from the render thread. The prefetched
+     shaders which were not loaded by Skia during the first frames are released after a delay.
+     */
+    void prefetch();
+
 private:
-    Valdi::Result<Valdi::BytesView> loadShaderFromDisk(const Valdi::BytesView& keyData) const;
-    void storeShaderToDisk(const Valdi::BytesView& key, const Valdi::BytesView& data) const;
+    Valdi::Result<Valdi::BytesView> loadShaderFromDisk(const Valdi::BytesView& keyData);
+    void storeShaderToDisk(const Valdi::BytesView& key, const Valdi::BytesView& data);
+    void prefetchShadersFromDisk();
+    void onShadersPrefetched(const std::vector<Valdi::Path>& paths,
+                             std::vector<Valdi::Result<Valdi::BytesView>> results);
+    void expirePrefetchedShaders();
+    void markShaderServed(const Valdi::StringBox& fileName);
 
     [[maybe_unused]] Valdi::ILogger& _logger;
     Valdi::Ref<Valdi::DispatchQueue> _queue;
     Valdi::Ref<Valdi::IDiskCache> _diskCache;
+    Valdi::Mutex _mutex;
+    Valdi::FlatMap<Valdi::StringBox, Valdi::BytesView> _prefetchedShaders;
+    // Shaders loaded or stored while the prefetch is in flight, which it should not insert anymore
+    Valdi::FlatSet<Valdi::StringBox> _servedShaders;
+    bool _prefetching = false;
 };
 
 } // namespace snap::drawing
@@ -191,4 +191,9 @@ bool BridgeLayer::hitTest(const Point& point) const {
     }
 }
 
+bool BridgeLayer::isHitTestBoundedToFrame() const {
+    // The native view can decide to be hit outside of its bounds
+    return false;
+}
+
 } // namespace snap::drawing
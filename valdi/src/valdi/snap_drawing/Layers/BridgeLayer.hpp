@@ -42,6 +42,7 @@ public:
     void setAttachedData(const Ref<Valdi::RefCountable>& attachedData) override;
 
     bool hitTest(const Point& point) const override;
+    bool isHitTestBoundedToFrame() const override;
 
 protected:
     void onLayout() override;
@@ -10,11 +10,49 @@
 #include "valdi/snap_drawing/ImageLoading/ImageLoaderFactory.hpp"
 #include "valdi/snap_drawing/SnapDrawingViewManager.hpp"
 
+#include "valdi/runtime/Metrics/Metrics.hpp"
+
 #include "snap_drawing/cpp/Drawing/DrawLooper.hpp"
+#include "snap_drawing/cpp/Drawing/DrawPool.hpp"
 #include "snap_drawing/cpp/Text/FontManager.hpp"
 
 namespace snap::drawing {
 
+static Valdi::MetricsDuration toMetricsDuration(Duration duration) {
+    return Valdi::MetricsDuration(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(duration.seconds())));
+}
+
+class FrameTimingsMetricsReporter : public IFrameTimingsListener {
+public:
+    explicit FrameTimingsMetricsReporter(const Valdi::Ref<Valdi::Metrics>& metrics) : _metrics(metrics) {}
+
+    void onFrameTimingsReport(LayerRoot& /*layerRoot*/, const FrameTimingsReport& report) override {
+        auto averageProcessDuration = report.framesCount > 0 ?
+                                          toMetricsDuration(report.totalProcessDuration) / report.framesCount :
+                                          Valdi::MetricsDuration();
+        auto averageCompositionDuration = report.framesCount > 0 ?
+                                              toMetricsDuration(report.totalCompositionDuration) / report.framesCount :
+                                              Valdi::MetricsDuration();
+        auto averageDrawDuration = report.drawnFramesCount > 0 ?
+                                       toMetricsDuration(report.totalDrawDuration) / report.drawnFramesCount :
+                                       Valdi::MetricsDuration();
+
+        _metrics->emitFrameTimings(STRING_LITERAL("snap_drawing"),
+                                   report.framesCount,
+                                   report.supersededFramesCount,
+                                   report.droppedFramesCount,
+                                   report.missedDeadlinesCount,
+                                   averageProcessDuration,
+                                   averageCompositionDuration,
+                                   toMetricsDuration(report.maxCompositionDuration),
+                                   averageDrawDuration);
+    }
+
+private:
+    Valdi::Ref<Valdi::Metrics> _metrics;
+};
+
 Runtime::Runtime(const Ref<IFrameScheduler>& frameScheduler,
                  const GesturesConfiguration& gesturesConfiguration,
                  const Valdi::Ref<Valdi::IDiskCache>& diskCache,
@@ -32,6 +70,7 @@ Runtime::Runtime(const Ref<IFrameScheduler>& frameScheduler,
         auto shaderPath = Valdi::Path("shaders");
         auto shadersDiskCache = diskCache->scopedCache(shaderPath, false);
         _shaderCache = Valdi::makeShared<snap::drawing::ShaderCache>(shadersDiskCache, workerQueue, logger);
+        _shaderCache->prefetch();
     }
 
     _fontManager = Valdi::makeShared<snap::drawing::FontManager>(logger);
@@ -58,6 +97,14 @@ void Runtime::initializeViewManager(Valdi::PlatformType platformType) {
     }
 }
 
+void Runtime::setDrawThreadsCount(size_t drawThreadsCount) {
+    if (drawThreadsCount == 0) {
+        _drawLooper->setDrawPool(nullptr);
+    } else {
+        _drawLooper->setDrawPool(Valdi::makeShared<snap::drawing::DrawPool>(drawThreadsCount));
+    }
+}
+
 void Runtime::registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager) {
     auto& logger = _resources->getLogger();
     auto queue =
@@ -108,4 +155,12 @@ void Runtime::setGraphicsContext(const Ref<GraphicsContext>& graphicsContext) {
     }
 }
 
+void Runtime::setMetrics(const Valdi::Ref<Valdi::Metrics>& metrics) {
+    if (metrics != nullptr) {
+        _drawLooper->setFrameTimingsListener(Valdi::makeShared<FrameTimingsMetricsReporter>(metrics));
+    } else {
+        _drawLooper->setFrameTimingsListener(nullptr);
+    }
+}
+
 } // namespace snap::drawing
@@ -20,6 +20,7 @@ class IViewManager;
 class ILogger;
 class DispatchQueue;
 class AssetLoaderManager;
+class Metrics;
 } // namespace Valdi
 
 namespace snap::drawing {
@@ -50,6 +51,14 @@ public:
 
     void registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager);
 
+    /**
+     Opt into drawing independent LayerRoots concurrently on the given number of draw threads,
+     instead of drawing all of them on the VSync thread. The GraphicsContexts must not be bound
+     to the VSync thread. Only worth it when several LayerRoots are drawn on every frame.
+     Passing 0 draws everything on the VSync thread again, which is the default.
+     */
+    void setDrawThreadsCount(size_t drawThreadsCount);
+
     const Ref<IFrameScheduler>& getFrameScheduler() const;
 
     const Ref<SnapDrawingViewManager>& getViewManager() const;
@@ -66,6 +75,11 @@ public:
 
     void setGraphicsContext(const Ref<GraphicsContext>& graphicsContext);
 
+    /**
+     Set the Metrics instance to which the frame timings of the DrawLooper are reported.
+     */
+    void setMetrics(const Valdi::Ref<Valdi::Metrics>& metrics);
+
 private:
     Valdi::Ref<snap::drawing::IFrameScheduler> _frameScheduler;
     Valdi::Ref<snap::drawing::SnapDrawingViewManager> _snapDrawingViewManager;
@@ -288,6 +288,34 @@ JSValueRef V8JavaScriptContext::newObject(JSExceptionTracker& exceptionTracker)
     return toRetainedJSValueRef(IndirectV8Persistent::make(_isolate, val));
 }
 
+JSValueRef V8JavaScriptContext::newObjectWithProperties(const JSPropertyName* propertyNames,
+                                                        const JSValue* propertyValues,
+                                                        size_t size,
+                                                        JSExceptionTracker& exceptionTracker) {
+    v8::HandleScope handleScope(_isolate);
+    v8::Local<v8::Context> context = v8::Local<v8::Context>::New(_isolate, _context);
+    auto obj = v8::Object::New(_isolate);
+
+    // Resolve the scope and context once for all properties instead of once per property.
+    // v8::Object::New() with names and values is not used as it creates dictionary mode objects.
+    for (size_t i = 0; i < size; i++) {
+        auto key = fromValdiJSPropertyName(_isolate, propertyNames[i], exceptionTracker);
+        if (!exceptionTracker) {
+            return JSValueRef();
+        }
+        auto val = fromValdiJSValue(_isolate, propertyValues[i], exceptionTracker);
+        if (!exceptionTracker) {
+            return JSValueRef();
+        }
+        if (obj->CreateDataProperty(context, key, val).IsNothing()) {
+            exceptionTracker.onError("Failed to set property for object");
+            return JSValueRef();
+        }
+    }
+
+    return toRetainedJSValueRef(IndirectV8Persistent::make(_isolate, obj));
+}
+
 static void InvokeCallable(const v8::FunctionCallbackInfo<v8::Value>& info) {
     auto isolate = info.GetIsolate();
     v8::HandleScope handleScope(isolate);
@@ -1107,6 +1135,12 @@ JavaScriptContextMemoryStatistics V8JavaScriptContext::dumpMemoryStatistics() {
     return retval;
 }
 
+size_t V8JavaScriptContext::getHeapSizeBytes() {
+    v8::HeapStatistics stats;
+    _isolate->GetHeapStatistics(&stats);
+    return stats.used_heap_size();
+}
+
 JSValueRef V8JavaScriptContext::onNewBool(bool boolean) {
     v8::HandleScope handleScope(_isolate);
     auto result = v8::Boolean::New(_isolate, boolean);
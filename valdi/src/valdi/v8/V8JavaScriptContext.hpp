@@ -44,6 +44,11 @@ public:
 
     JSValueRef newObject(JSExceptionTracker& exceptionTracker) override;
 
+    JSValueRef newObjectWithProperties(const JSPropertyName* propertyNames,
+                                       const JSValue* propertyValues,
+                                       size_t size,
+                                       JSExceptionTracker& exceptionTracker) override;
+
     JSValueRef newFunction(const Ref<JSFunction>& callable, JSExceptionTracker& exceptionTracker) override;
 
     JSValueRef newStringUTF8(const std::string_view& str, JSExceptionTracker& exceptionTracker) override;
@@ -138,6 +143,7 @@ public:
     void garbageCollect() override;
 
     JavaScriptContextMemoryStatistics dumpMemoryStatistics() override;
+    size_t getHeapSizeBytes() override;
     void enqueueMicrotask(const JSValue& value, JSExceptionTracker& exceptionTracker) override;
 
     void willEnterVM() override;
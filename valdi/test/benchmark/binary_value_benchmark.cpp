@@ -0,0 +1,106 @@
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Utils/BinaryValueReader.hpp"
+#include "valdi_core/cpp/Utils/BinaryValueWriter.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedObject.hpp"
+#include "valdi_core/cpp/Utils/ValueUtils.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace Valdi;
+
+// Builds a feed-like view model: a list of cards with repeated keys and enum-like strings
+static Value makeViewModel(size_t cardsCount, bool typed) {
+    auto classSchema = ValueSchema::cls(STRING_LITERAL("FeedCard"),
+                                        false,
+                                        {
+                                            ClassPropertySchema(STRING_LITERAL("identifier"), ValueSchema::string()),
+                                            ClassPropertySchema(STRING_LITERAL("title"), ValueSchema::string()),
+                                            ClassPropertySchema(STRING_LITERAL("kind"), ValueSchema::string()),
+                                            ClassPropertySchema(STRING_LITERAL("score"), ValueSchema::doublePrecision()),
+                                            ClassPropertySchema(STRING_LITERAL("viewCount"), ValueSchema::integer()),
+                                            ClassPropertySchema(STRING_LITERAL("unread"), ValueSchema::boolean()),
+                                        })
+                           .getClassRef();
+
+    static const char* kKinds[] = {"story", "spotlight", "discover", "friend"};
+
+    auto cards = ValueArray::make(cardsCount);
+    for (size_t i = 0; i < cardsCount; i++) {
+        auto identifier = Value(STRING_FORMAT("card_{}", i));
+        auto title = Value(STRING_FORMAT("Card title number {}", i % 16));
+        auto kind = Value(kKinds[i % 4]);
+        auto score = Value(static_cast<double>(i) * 0.25);
+        auto viewCount = Value(static_cast<int32_t>(i * 31));
+        auto unread = Value(i % 3 == 0);
+
+        if (typed) {
+            cards->emplace(i,
+                           Value(ValueTypedObject::make(classSchema, {identifier, title, kind, score, viewCount, unread})));
+        } else {
+            cards->emplace(i,
+                           Value()
+                               .setMapValue("identifier", identifier)
+                               .setMapValue("title", title)
+                               .setMapValue("kind", kind)
+                               .setMapValue("score", score)
+                               .setMapValue("viewCount", viewCount)
+                               .setMapValue("unread", unread));
+        }
+    }
+
+    return Value().setMapValue("header", Value("For You")).setMapValue("cards", Value(cards));
+}
+
+static void BinaryValueEncode(benchmark::State& state) {
+    auto viewModel = makeViewModel(static_cast<size_t>(state.range(0)), true);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(valueToBinary(viewModel));
+    }
+
+    state.counters["bytes"] = static_cast<double>(valueToBinary(viewModel).value().size());
+}
+BENCHMARK(BinaryValueEncode)->Range(8, 512);
+
+static void JsonValueEncode(benchmark::State& state) {
+    auto viewModel = makeViewModel(static_cast<size_t>(state.range(0)), false);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(valueToJson(viewModel));
+    }
+
+    state.counters["bytes"] = static_cast<double>(valueToJson(viewModel)->size());
+}
+BENCHMARK(JsonValueEncode)->Range(8, 512);
+
+static void BinaryValueDecode(benchmark::State& state) {
+    auto encoded = valueToBinary(makeViewModel(static_cast<size_t>(state.range(0)), true)).value();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(binaryToValue(encoded));
+    }
+}
+BENCHMARK(BinaryValueDecode)->Range(8, 512);
+
+static void JsonValueDecode(benchmark::State& state) {
+    auto encoded = valueToJson(makeViewModel(static_cast<size_t>(state.range(0)), false));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(jsonToValue(encoded->data(), encoded->size()));
+    }
+}
+BENCHMARK(JsonValueDecode)->Range(8, 512);
+
+// How long does it take to read a single field deep into the document
+static void BinaryValueLazyAccess(benchmark::State& state) {
+    auto cardsCount = static_cast<size_t>(state.range(0));
+    auto encoded = valueToBinary(makeViewModel(cardsCount, true)).value();
+
+    for (auto _ : state) {
+        auto document = BinaryValueDocument::parse(encoded, nullptr);
+        auto card = document.value()->getRoot().getMapValue("cards")->getArrayItem(cardsCount - 1);
+        benchmark::DoNotOptimize(card->getProperty("title")->toValue());
+    }
+}
+BENCHMARK(BinaryValueLazyAccess)->Range(8, 512);
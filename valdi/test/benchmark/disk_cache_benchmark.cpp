@@ -0,0 +1,121 @@
+#include "valdi/runtime/Resources/BatchedDiskCache.hpp"
+#include "valdi/runtime/Resources/DiskCacheImpl.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/DiskUtils.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <future>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace Valdi;
+
+// Size of each file, matching a typical small module or asset file loaded at startup
+constexpr size_t kFileSize = 16 * 1024;
+
+struct DiskCacheFixture {
+    Path rootPath;
+    std::vector<Path> paths;
+
+    explicit DiskCacheFixture(size_t filesCount) {
+        char directoryLocation[] = "/tmp/.valdi_benchmark.XXXXXX";
+        if (mkdtemp(directoryLocation) != nullptr) {
+            rootPath = Path(std::string_view(directoryLocation));
+        }
+
+        ByteBuffer content;
+        content.resize(kFileSize);
+        for (size_t i = 0; i < kFileSize; i++) {
+            content.data()[i] = static_cast<Byte>(i);
+        }
+
+        DiskCacheImpl diskCache(StringCache::getGlobal().makeString(rootPath.toString()));
+        for (size_t i = 0; i < filesCount; i++) {
+            auto path = Path(STRING_FORMAT("modules/file{}", i).toStringView());
+            (void)diskCache.store(path, content.toBytesView());
+            paths.emplace_back(rootPath.appending(path));
+        }
+    }
+
+    ~DiskCacheFixture() {
+        DiskUtils::remove(rootPath);
+    }
+
+    // Evicts the files from the page cache, so that the next loads hit the disk
+    void evictFromPageCache() const {
+        for (const auto& path : paths) {
+            auto fd = open(path.toString().c_str(), O_RDONLY);
+            if (fd >= 0) {
+                fdatasync(fd);
+#if defined(POSIX_FADV_DONTNEED)
+                posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+                close(fd);
+            }
+        }
+    }
+};
+
+static void DiskCacheLoadSequentialCold(benchmark::State& state) {
+    DiskCacheFixture fixture(static_cast<size_t>(state.range(0)));
+    DiskCacheImpl diskCache(StringCache::getGlobal().makeString(fixture.rootPath.toString()));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fixture.evictFromPageCache();
+        state.ResumeTiming();
+
+        for (const auto& path : fixture.paths) {
+            benchmark::DoNotOptimize(diskCache.load(path));
+        }
+    }
+}
+BENCHMARK(DiskCacheLoadSequentialCold)->Range(8, 256)->UseRealTime();
+
+static void DiskCacheLoadBatchedCold(benchmark::State& state) {
+    DiskCacheFixture fixture(static_cast<size_t>(state.range(0)));
+    BatchedDiskCache diskCache(StringCache::getGlobal().makeString(fixture.rootPath.toString()));
+
+    state.SetLabel(diskCache.getBatchLoader()->isUsingIOUring() ? "io_uring" : "thread_pool");
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        fixture.evictFromPageCache();
+        state.ResumeTiming();
+
+        std::promise<std::vector<Result<BytesView>>> promise;
+        diskCache.loadMany(fixture.paths,
+                           [&](std::vector<Result<BytesView>> results) { promise.set_value(std::move(results)); });
+        benchmark::DoNotOptimize(promise.get_future().get());
+    }
+}
+BENCHMARK(DiskCacheLoadBatchedCold)->Range(8, 256)->UseRealTime();
+
+static void DiskCacheLoadSequentialWarm(benchmark::State& state) {
+    DiskCacheFixture fixture(static_cast<size_t>(state.range(0)));
+    DiskCacheImpl diskCache(StringCache::getGlobal().makeString(fixture.rootPath.toString()));
+
+    for (auto _ : state) {
+        for (const auto& path : fixture.paths) {
+            benchmark::DoNotOptimize(diskCache.load(path));
+        }
+    }
+}
+BENCHMARK(DiskCacheLoadSequentialWarm)->Range(8, 256)->UseRealTime();
+
+static void DiskCacheLoadBatchedWarm(benchmark::State& state) {
+    DiskCacheFixture fixture(static_cast<size_t>(state.range(0)));
+    BatchedDiskCache diskCache(StringCache::getGlobal().makeString(fixture.rootPath.toString()));
+
+    for (auto _ : state) {
+        std::promise<std::vector<Result<BytesView>>> promise;
+        diskCache.loadMany(fixture.paths,
+                           [&](std::vector<Result<BytesView>> results) { promise.set_value(std::move(results)); });
+        benchmark::DoNotOptimize(promise.get_future().get());
+    }
+}
+BENCHMARK(DiskCacheLoadBatchedWarm)->Range(8, 256)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -362,6 +362,48 @@ TEST_P(JSContextFixture, canCreateObject) {
     ASSERT_EQ(Value(expectedValue), value1);
 }
 
+TEST_P(JSContextFixture, canCreateObjectWithProperties) {
+    MAIN_THREAD_INIT();
+    auto wrapper = createWrapper();
+
+    auto value1 = wrapper.withContextRet([&](auto& context, auto& exceptionTracker) {
+        auto hello = context.newStringUTF8("world", exceptionTracker);
+        if (!exceptionTracker) {
+            return context.newUndefined();
+        }
+
+        auto number = context.newNumber(42.0);
+        auto boolean = context.newBool(true);
+
+        auto helloName = context.newPropertyName("hello");
+        auto niceName = context.newPropertyName("nice");
+        auto coolName = context.newPropertyName("cool");
+
+        Valdi::JSPropertyName propertyNames[] = {
+            helloName.get(),
+            niceName.get(),
+            coolName.get(),
+        };
+
+        Valdi::JSValue propertyValues[] = {
+            hello.get(),
+            number.get(),
+            boolean.get(),
+        };
+
+        return context.newObjectWithProperties(propertyNames, propertyValues, 3, exceptionTracker);
+    });
+
+    ASSERT_EQ(ValueType::Map, value1.getType());
+
+    auto expectedValue = makeShared<ValueMap>();
+    (*expectedValue)[STRING_LITERAL("hello")] = Value(STRING_LITERAL("world"));
+    (*expectedValue)[STRING_LITERAL("nice")] = Value(42.0);
+    (*expectedValue)[STRING_LITERAL("cool")] = Value(true);
+
+    ASSERT_EQ(Value(expectedValue), value1);
+}
+
 TEST_P(JSContextFixture, canCreateArray) {
     MAIN_THREAD_INIT();
     auto wrapper = createWrapper();
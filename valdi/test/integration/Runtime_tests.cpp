@@ -2,6 +2,8 @@
 #include "TestAsyncUtils.hpp"
 #include "valdi/RuntimeMessageHandler.hpp"
 #include "valdi/runtime/Attributes/AttributesApplier.hpp"
+#include "valdi/runtime/CSS/CSSAttributesManager.hpp"
+#include "valdi/runtime/CSS/CSSDocument.hpp"
 #include "valdi/runtime/Context/ContextHandler.hpp"
 #include "valdi/runtime/Context/IViewNodesAssetTracker.hpp"
 #include "valdi/runtime/Context/ViewNodeAssetHandler.hpp"
@@ -17,10 +19,12 @@
 #include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
 #include "valdi/runtime/Runtime.hpp"
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
+#include "valdi/runtime/Views/PendingView.hpp"
 #include "valdi_core/cpp/Attributes/TextAttributeValue.hpp"
 #include "valdi_core/cpp/JavaScript/ModuleFactoryRegistry.hpp"
 #include "valdi_core/cpp/Schema/ValueSchemaRegistry.hpp"
 #include "valdi_core/cpp/Schema/ValueSchemaTypeResolver.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/Exception.hpp"
 #include "valdi_core/cpp/Utils/ValueArrayBuilder.hpp"
 
@@ -478,6 +482,66 @@ TEST_P(RuntimeFixture, doesntReapplyCSSAfterMultipleRender) {
     checkViewHasSingleHistoryPerAttribute(rootView);
 }
 
+TEST_P(RuntimeFixture, reusesResolvedStylesOnCSSUpdate) {
+    auto viewModel = makeShared<ValueMap>();
+    (*viewModel)[STRING_LITERAL("containerColor")] = Value(STRING_LITERAL("black"));
+
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "CSSAttributes", Value(viewModel));
+
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    auto cssDocument = tree->getRootViewNode()->getCSSAttributesManager().getCSSDocument();
+    ASSERT_TRUE(cssDocument != nullptr);
+
+    auto container = getViewNodeForId(tree, "container");
+    ASSERT_TRUE(container != nullptr);
+    ASSERT_EQ(static_cast<size_t>(3), container->getChildCount());
+
+    std::vector<Ref<CSSResolvedStyle>> buttonStyles;
+    for (size_t i = 0; i < container->getChildCount(); i++) {
+        buttonStyles.emplace_back(container->getChildAt(i)->getCSSAttributesManager().getResolvedStyle());
+        ASSERT_TRUE(buttonStyles.back() != nullptr);
+    }
+
+    // Each button matches a different position rule, so none of them can share a style
+    ASSERT_NE(buttonStyles[0], buttonStyles[1]);
+    ASSERT_NE(buttonStyles[1], buttonStyles[2]);
+    ASSERT_NE(buttonStyles[0], buttonStyles[2]);
+
+    auto& styleSharingCache = cssDocument->getStyleSharingCache();
+    auto hitsCount = styleSharingCache.getHitsCount();
+
+    tree->scheduleExclusiveUpdate([&]() {
+        tree->getRootViewNode()->resetCssSubtree();
+        tree->updateCSS(nullptr);
+    });
+
+    // Every node has the same matching inputs as in the first pass,
+    // so all the styles should have been taken from the cache.
+    ASSERT_GT(styleSharingCache.getHitsCount(), hitsCount);
+    for (size_t i = 0; i < container->getChildCount(); i++) {
+        ASSERT_EQ(buttonStyles[i], container->getChildAt(i)->getCSSAttributesManager().getResolvedStyle());
+    }
+
+    // The shared styles should resolve to the same values as a full match
+    ASSERT_EQ(
+        DummyView("SCValdiView")
+            .addAttribute("color", "white")
+            .addAttribute("alignItems", "center")
+            .addChild(DummyView("SCValdiLabel").addAttribute("value", "Title").addAttribute("font", "title"))
+            .addChild(
+                DummyView("SCValdiView")
+                    .addAttribute("color", "black")
+                    .addAttribute("justifyContent", "space-between")
+                    .addAttribute("id", "container")
+                    .addChild(DummyView("UIButton").addAttribute("dummyHeight", 35).addAttribute("value", "Button 1"))
+                    .addChild(DummyView("UIButton").addAttribute("dummyHeight", 40).addAttribute("value", "Button 2"))
+                    .addChild(
+                        DummyView("UIButton").addAttribute("dummyHeight", 45.0).addAttribute("value", "Button 3"))),
+        getRootView(tree));
+    checkViewHasSingleHistoryPerAttribute(getRootView(tree));
+}
+
 TEST_P(RuntimeFixture, canResetCSSValues) {
     auto viewModel = makeShared<ValueMap>();
     (*viewModel)[STRING_LITERAL("containerColor")] = Value(STRING_LITERAL("black"));
@@ -1513,6 +1577,47 @@ TEST_P(RuntimeFixture, canGCSelfReferencingMainThreadCallback) {
     ASSERT_EQ(1, receiver.use_count());
 }
 
+TEST_P(RuntimeFixture, createsWorkersFromPrewarmedPool) {
+    auto jsRuntime = wrapper.runtime->getJavaScriptRuntime();
+    jsRuntime->setWorkerPoolCapacity(1);
+
+    auto workerPool = jsRuntime->getWorkerPool();
+    ASSERT_TRUE(workerPool != nullptr);
+    workerPool->flush();
+
+    auto prewarmedWorkers = workerPool->getItems();
+    ASSERT_EQ(static_cast<size_t>(1), prewarmedWorkers.size());
+
+    auto worker = jsRuntime->createWorker();
+
+    ASSERT_EQ(static_cast<snap::valdi_core::JSRuntime*>(prewarmedWorkers[0].get()), worker.get());
+
+    // The pool is refilled with a new worker
+    workerPool->flush();
+    auto refilledWorkers = workerPool->getItems();
+    ASSERT_EQ(static_cast<size_t>(1), refilledWorkers.size());
+    ASSERT_NE(prewarmedWorkers[0], refilledWorkers[0]);
+}
+
+TEST_P(RuntimeFixture, tearsDownWorkerPoolWithRuntime) {
+    auto jsRuntime = wrapper.runtime->getJavaScriptRuntime();
+    jsRuntime->setWorkerPoolCapacity(1);
+
+    auto workerPool = jsRuntime->getWorkerPool();
+    ASSERT_TRUE(workerPool != nullptr);
+    workerPool->flush();
+    ASSERT_EQ(static_cast<size_t>(1), workerPool->size());
+
+    jsRuntime->fullTeardown();
+
+    ASSERT_EQ(static_cast<size_t>(0), workerPool->size());
+
+    // The pool is not refilled once the runtime is torn down
+    jsRuntime->setWorkerPoolCapacity(2);
+    ASSERT_EQ(static_cast<size_t>(0), workerPool->size());
+    ASSERT_EQ(static_cast<size_t>(0), workerPool->getCapacity());
+}
+
 TEST_P(RuntimeFixture, canHandleDynamicChildDocument) {
     auto viewModel = makeShared<ValueMap>();
     (*viewModel)[STRING_LITERAL("childDocumentName")] = Valdi::Value(std::string("test:src/BasicViewTree.valdi"));
@@ -8548,6 +8653,110 @@ TEST_P(RuntimeFixture, canDeferRenderContextOutsideOfMainThread) {
               getRootView(tree));
 }
 
+static SharedViewNodeTree createMainThreadCommitViewNodeTree(RuntimeWrapper& wrapper) {
+    auto& runtime = *wrapper.runtime;
+
+    auto context = runtime.getContextManager().createContext(
+        runtime.getJavaScriptRuntime()->getContextHandler(),
+        wrapper.standaloneRuntime->getViewManagerContext(),
+        ComponentPath::parse(STRING_LITERAL("ComponentClass@test/src/BasicViewTree.vue.generated")),
+        nullptr,
+        nullptr,
+        true,
+        false);
+
+    auto tree = runtime.createViewNodeTree(context, ViewNodeTreeThreadAffinity::MAIN_THREAD_COMMIT);
+    tree->setRootViewWithDefaultViewClass();
+
+    context->onCreate();
+
+    return tree;
+}
+
+static bool hasPendingViews(ViewNode* viewNode) {
+    if (castOrNull<PendingView>(viewNode->getView()) != nullptr) {
+        return true;
+    }
+    for (auto* childViewNode : *viewNode) {
+        if (hasPendingViews(childViewNode)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_P(RuntimeFixture, mainThreadCommitCreatesViewTreeInSingleCommit) {
+    auto tree = createMainThreadCommitViewNodeTree(wrapper);
+    auto updateQueue = wrapper.runtime->getViewNodeTreeUpdateQueue();
+
+    // Let the background pass run without running the main thread, its commit stays pending
+    wrapper.flushJsQueue();
+    updateQueue->sync([]() {});
+
+    ASSERT_EQ(DummyView("SCValdiView"), getRootView(tree));
+
+    // The commit creates and inserts the views of the whole tree, without going
+    // back to the update queue in between
+    wrapper.mainQueue->flush();
+
+    auto expectedView = DummyView("SCValdiView")
+                            .addChild(DummyView("SCValdiLabel"))
+                            .addChild(DummyView("SCValdiView")
+                                          .addChild(DummyView("UIButton"))
+                                          .addChild(DummyView("UIButton"))
+                                          .addChild(DummyView("UIButton")));
+
+    ASSERT_EQ(expectedView, getRootView(tree));
+
+    // The views are created for their ViewNode, they never go through the pools
+    auto stats = wrapper.standaloneRuntime->getViewManagerContext()->getViewPoolsStats();
+
+    ASSERT_EQ(0, getNumberOfPooledViews(STRING_LITERAL("SCValdiLabel"), stats));
+    ASSERT_EQ(0, getNumberOfPooledViews(STRING_LITERAL("SCValdiView"), stats));
+    ASSERT_EQ(0, getNumberOfPooledViews(STRING_LITERAL("UIButton"), stats));
+
+    // The ViewNodes get the created views from the update queue
+    updateQueue->sync([]() {});
+    ASSERT_FALSE(hasPendingViews(tree->getRootViewNode().get()));
+}
+
+TEST_P(RuntimeFixture, mainThreadCommitAppliesPendingCommitsInOrder) {
+    auto tree = createMainThreadCommitViewNodeTree(wrapper);
+    auto updateQueue = wrapper.runtime->getViewNodeTreeUpdateQueue();
+
+    wrapper.flushJsQueue();
+    updateQueue->sync([]() {});
+
+    // A second pass runs before the first commit was applied, it keeps using the same pending views
+    updateQueue->sync([&]() {
+        tree->scheduleExclusiveUpdate(
+            [&]() { tree->getRootViewNode()->updateViewTree(tree->getCurrentViewTransactionScope()); });
+    });
+
+    ASSERT_EQ(DummyView("SCValdiView"), getRootView(tree));
+    ASSERT_TRUE(hasPendingViews(tree->getRootViewNode().get()));
+
+    wrapper.mainQueue->flush();
+
+    auto expectedView = DummyView("SCValdiView")
+                            .addChild(DummyView("SCValdiLabel"))
+                            .addChild(DummyView("SCValdiView")
+                                          .addChild(DummyView("UIButton"))
+                                          .addChild(DummyView("UIButton"))
+                                          .addChild(DummyView("UIButton")));
+
+    ASSERT_EQ(expectedView, getRootView(tree));
+
+    updateQueue->sync([]() {});
+    ASSERT_FALSE(hasPendingViews(tree->getRootViewNode().get()));
+
+    auto stats = wrapper.standaloneRuntime->getViewManagerContext()->getViewPoolsStats();
+
+    ASSERT_EQ(0, getNumberOfPooledViews(STRING_LITERAL("SCValdiLabel"), stats));
+    ASSERT_EQ(0, getNumberOfPooledViews(STRING_LITERAL("SCValdiView"), stats));
+    ASSERT_EQ(0, getNumberOfPooledViews(STRING_LITERAL("UIButton"), stats));
+}
+
 TEST_P(RuntimeFixture, supportsTSN) {
     if (!isWithTSN()) {
         return;
@@ -0,0 +1,205 @@
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Schema/ValueSchemaRegistry.hpp"
+#include "valdi_core/cpp/Utils/BinaryValueReader.hpp"
+#include "valdi_core/cpp/Utils/BinaryValueWriter.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
+#include "valdi_core/cpp/Utils/ValueMap.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedObject.hpp"
+#include "valdi_core/cpp/Utils/ValueUtils.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static ValueSchema makeCardSchema() {
+    return ValueSchema::cls(STRING_LITERAL("Card"),
+                            false,
+                            {
+                                ClassPropertySchema(STRING_LITERAL("title"), ValueSchema::string()),
+                                ClassPropertySchema(STRING_LITERAL("count"), ValueSchema::integer()),
+                                ClassPropertySchema(STRING_LITERAL("tags"), ValueSchema::untyped()),
+                            });
+}
+
+static Value makeCard(const Ref<ClassSchema>& classSchema, const char* title, int32_t count) {
+    return Value(ValueTypedObject::make(
+        classSchema, {Value(title), Value(count), Value(ValueArray::make({Value("new"), Value("hot")}))}));
+}
+
+TEST(BinaryValue, canEncodeAndDecodePrimitives) {
+    auto map = makeShared<ValueMap>();
+    (*map)[STRING_LITERAL("null")] = Value();
+    (*map)[STRING_LITERAL("undefined")] = Value::undefined();
+    (*map)[STRING_LITERAL("true")] = Value(true);
+    (*map)[STRING_LITERAL("false")] = Value(false);
+    (*map)[STRING_LITERAL("int")] = Value(static_cast<int32_t>(-42));
+    (*map)[STRING_LITERAL("long")] = Value(static_cast<int64_t>(9007199254740993));
+    (*map)[STRING_LITERAL("double")] = Value(3.25);
+    (*map)[STRING_LITERAL("string")] = Value("Hello 🙂");
+    (*map)[STRING_LITERAL("emptyString")] = Value("");
+    (*map)[STRING_LITERAL("error")] = Value(Error("Something failed"));
+    (*map)[STRING_LITERAL("array")] = Value(ValueArray::make({Value(1), Value(2.5), Value(Value::undefined())}));
+
+    auto encoded = valueToBinary(Value(map));
+    ASSERT_TRUE(encoded) << encoded.description();
+
+    auto decoded = binaryToValue(encoded.value());
+    ASSERT_TRUE(decoded) << decoded.description();
+
+    ASSERT_EQ(Value(map), decoded.value());
+    ASSERT_EQ(ValueType::Int, decoded.value().getMapValue("int").getType());
+    ASSERT_EQ(ValueType::Long, decoded.value().getMapValue("long").getType());
+    ASSERT_EQ(STRING_LITERAL("Something failed"), decoded.value().getMapValue("error").getError().getMessage());
+}
+
+TEST(BinaryValue, internsRepeatedStrings) {
+    auto array = ValueArray::make(100);
+    for (size_t i = 0; i < array->size(); i++) {
+        array->emplace(i, Value().setMapValue("identifier", Value("a_pretty_long_repeated_value")));
+    }
+
+    auto encoded = valueToBinary(Value(array));
+    ASSERT_TRUE(encoded) << encoded.description();
+
+    auto json = valueToJson(Value(array));
+
+    // The key and the value are only written once
+    ASSERT_LT(encoded.value().size(), json->size() / 4);
+
+    auto decoded = binaryToValue(encoded.value());
+    ASSERT_TRUE(decoded) << decoded.description();
+    ASSERT_EQ(Value(array), decoded.value());
+}
+
+TEST(BinaryValue, encodesTypedObjectsWithoutPropertyNames) {
+    auto registry = makeShared<ValueSchemaRegistry>();
+    auto cardSchema = makeCardSchema();
+    registry->registerSchema(STRING_LITERAL("Card"), cardSchema);
+    auto classSchema = cardSchema.getClassRef();
+
+    auto cards = ValueArray::make(
+        {makeCard(classSchema, "First", 1), makeCard(classSchema, "Second", 2), makeCard(classSchema, "Third", 3)});
+
+    auto encoded = valueToBinary(Value(cards));
+    ASSERT_TRUE(encoded) << encoded.description();
+
+    // With the registry, the decoded objects share the registered ClassSchema
+    auto decoded = binaryToValue(encoded.value(), registry.get());
+    ASSERT_TRUE(decoded) << decoded.description();
+    ASSERT_EQ(Value(cards), decoded.value());
+    ASSERT_EQ(classSchema, (*decoded.value().getArray())[0].getTypedObject()->getSchema());
+
+    // Without it, a ClassSchema is recreated from the document
+    decoded = binaryToValue(encoded.value());
+    ASSERT_TRUE(decoded) << decoded.description();
+
+    const auto* typedObject = (*decoded.value().getArray())[1].getTypedObject();
+    ASSERT_EQ(STRING_LITERAL("Card"), typedObject->getClassName());
+    ASSERT_EQ(Value("Second"), typedObject->getPropertyForName(STRING_LITERAL("title")));
+    ASSERT_EQ(Value(2), typedObject->getPropertyForName(STRING_LITERAL("count")));
+}
+
+TEST(BinaryValue, decodesTypedArraysWithoutCopy) {
+    std::vector<float> floats = {1.0f, 2.5f, -3.0f};
+    auto bytes = makeShared<ByteBuffer>(reinterpret_cast<const Byte*>(floats.data()),
+                                        reinterpret_cast<const Byte*>(floats.data() + floats.size()));
+    auto typedArray = makeShared<ValueTypedArray>(TypedArrayType::Float32Array, bytes->toBytesView());
+
+    // The odd sized string forces the typed array to be padded
+    auto value = Value(ValueArray::make({Value("odd"), Value(typedArray)}));
+
+    auto encoded = valueToBinary(value);
+    ASSERT_TRUE(encoded) << encoded.description();
+
+    auto decoded = binaryToValue(encoded.value());
+    ASSERT_TRUE(decoded) << decoded.description();
+    ASSERT_EQ(value, decoded.value());
+
+    const auto& decodedBuffer = (*decoded.value().getArray())[1].getTypedArray()->getBuffer();
+    ASSERT_EQ(encoded.value().getSource(), decodedBuffer.getSource());
+    ASSERT_GE(decodedBuffer.data(), encoded.value().data());
+    ASSERT_LT(decodedBuffer.data(), encoded.value().data() + encoded.value().size());
+    ASSERT_EQ(static_cast<size_t>(0), reinterpret_cast<uintptr_t>(decodedBuffer.data()) % alignof(double));
+}
+
+TEST(BinaryValue, canAccessFieldsLazily) {
+    auto cardSchema = makeCardSchema();
+    auto classSchema = cardSchema.getClassRef();
+
+    auto root = Value()
+                    .setMapValue("header", Value("Trending"))
+                    .setMapValue("cards",
+                                 Value(ValueArray::make({makeCard(classSchema, "First", 1),
+                                                         makeCard(classSchema, "Second", 2),
+                                                         makeCard(classSchema, "Third", 3)})));
+
+    auto encoded = valueToBinary(root);
+    ASSERT_TRUE(encoded) << encoded.description();
+
+    auto document = BinaryValueDocument::parse(encoded.value(), nullptr);
+    ASSERT_TRUE(document) << document.description();
+
+    auto view = document.value()->getRoot();
+    ASSERT_EQ(ValueType::Map, view.getType());
+    ASSERT_EQ(static_cast<size_t>(2), view.size());
+    ASSERT_FALSE(view.getMapValue("missing"));
+
+    auto cards = view.getMapValue("cards");
+    ASSERT_TRUE(cards);
+    ASSERT_EQ(ValueType::Array, cards->getType());
+    ASSERT_EQ(static_cast<size_t>(3), cards->size());
+    ASSERT_FALSE(cards->getArrayItem(3));
+
+    auto card = cards->getArrayItem(2);
+    ASSERT_TRUE(card);
+    ASSERT_EQ(ValueType::TypedObject, card->getType());
+
+    auto title = card->getProperty("title");
+    ASSERT_TRUE(title);
+    ASSERT_EQ(Value("Third"), title->toValue().value());
+
+    auto tags = card->getProperty("tags");
+    ASSERT_TRUE(tags);
+    ASSERT_EQ(Value("hot"), tags->getArrayItem(1)->toValue().value());
+
+    ASSERT_FALSE(card->getProperty("missing"));
+    ASSERT_FALSE(card->getArrayItem(0));
+
+    auto header = view.getMapValue("header");
+    ASSERT_TRUE(header);
+    ASSERT_EQ(Value("Trending"), header->toValue().value());
+}
+
+TEST(BinaryValue, failsOnUnsupportedValues) {
+    auto function = makeShared<ValueFunctionWithCallable>(
+        [](const ValueFunctionCallContext& /*callContext*/) -> Value { return Value(); });
+    auto value = Value().setMapValue("callback", Value(function));
+
+    auto encoded = valueToBinary(value);
+    ASSERT_FALSE(encoded);
+}
+
+TEST(BinaryValue, failsOnMalformedDocuments) {
+    auto encoded = valueToBinary(Value(ValueArray::make({Value("hello"), Value(42)})));
+    ASSERT_TRUE(encoded) << encoded.description();
+
+    const auto& data = encoded.value();
+
+    // Every truncation should be rejected
+    for (size_t size = 0; size < data.size(); size++) {
+        auto decoded = binaryToValue(BytesView(data.getSource(), data.data(), size));
+        ASSERT_FALSE(decoded) << "Expected failure for size " << size;
+    }
+
+    // Corrupted tags should be rejected
+    auto corrupted = makeShared<ByteBuffer>(data.begin(), data.end());
+    corrupted->data()[corrupted->size() - 2] = 0xFF;
+    ASSERT_FALSE(binaryToValue(corrupted->toBytesView()));
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,88 @@
+#include "valdi/runtime/CSS/CSSSelectorDependencies.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static FlatSet<StringBox> makeClasses(std::initializer_list<const char*> classNames) {
+    FlatSet<StringBox> classes;
+    for (const auto* className : classNames) {
+        classes.emplace(StringCache::getGlobal().makeString(std::string_view(className)));
+    }
+    return classes;
+}
+
+TEST(CSSSelectorDependencies, ignoresUnusedClasses) {
+    CSSSelectorDependencies dependencies;
+    dependencies.addClassDependency(STRING_LITERAL("title"), 0);
+
+    ASSERT_EQ(CSSInvalidationNone,
+              dependencies.getClassChangeInvalidation(makeClasses({"title"}), makeClasses({"title", "unused"})));
+    ASSERT_EQ(CSSInvalidationSelf,
+              dependencies.getClassChangeInvalidation(makeClasses({"unused"}), makeClasses({"title", "unused"})));
+    ASSERT_EQ(CSSInvalidationSelf, dependencies.getClassChangeInvalidation(makeClasses({"title"}), makeClasses({})));
+}
+
+TEST(CSSSelectorDependencies, resolvesInvalidationFromDepth) {
+    CSSSelectorDependencies dependencies;
+    dependencies.addClassDependency(STRING_LITERAL("self"), 0);
+    dependencies.addClassDependency(STRING_LITERAL("parent"), 1);
+    dependencies.addClassDependency(STRING_LITERAL("grandparent"), 2);
+    dependencies.addClassDependency(STRING_LITERAL("ancestor"),
+                                    CSSSelectorDependencies::kCSSDependencyDepthAncestor);
+
+    ASSERT_EQ(CSSInvalidationSelf, dependencies.getClassChangeInvalidation(makeClasses({}), makeClasses({"self"})));
+    ASSERT_EQ(CSSInvalidationChildren,
+              dependencies.getClassChangeInvalidation(makeClasses({}), makeClasses({"parent"})));
+    ASSERT_EQ(CSSInvalidationDescendants,
+              dependencies.getClassChangeInvalidation(makeClasses({}), makeClasses({"grandparent"})));
+    ASSERT_EQ(CSSInvalidationDescendants,
+              dependencies.getClassChangeInvalidation(makeClasses({"ancestor"}), makeClasses({})));
+    ASSERT_EQ(CSSInvalidationSelf | CSSInvalidationChildren,
+              dependencies.getClassChangeInvalidation(makeClasses({"self"}), makeClasses({"parent"})));
+}
+
+TEST(CSSSelectorDependencies, combinesDepthsOfSameKey) {
+    CSSSelectorDependencies dependencies;
+    dependencies.addTagDependency(STRING_LITERAL("Label"), 0);
+    dependencies.addTagDependency(STRING_LITERAL("Label"), 1);
+    dependencies.addTagDependency(STRING_LITERAL("*"), 0);
+
+    ASSERT_EQ(CSSInvalidationSelf | CSSInvalidationChildren,
+              dependencies.getTagChangeInvalidation(StringBox(), STRING_LITERAL("Label")));
+    ASSERT_EQ(CSSInvalidationNone, dependencies.getTagChangeInvalidation(StringBox(), STRING_LITERAL("View")));
+}
+
+TEST(CSSSelectorDependencies, onlyInvalidatesWhenAttributeValueMovesInOrOutOfSelector) {
+    CSSSelectorDependencies dependencies;
+    AttributeId attributeId = 1;
+    dependencies.addAttributeValueDependency(attributeId, Value(STRING_LITERAL("black")));
+
+    ASSERT_EQ(CSSInvalidationNone,
+              dependencies.getAttributeChangeInvalidation(
+                  attributeId, Value(STRING_LITERAL("red")), Value(STRING_LITERAL("blue"))));
+    ASSERT_EQ(CSSInvalidationSelf,
+              dependencies.getAttributeChangeInvalidation(
+                  attributeId, Value(STRING_LITERAL("red")), Value(STRING_LITERAL("black"))));
+    ASSERT_EQ(CSSInvalidationSelf,
+              dependencies.getAttributeChangeInvalidation(
+                  attributeId, Value(STRING_LITERAL("black")), Value::undefined()));
+    ASSERT_EQ(CSSInvalidationNone,
+              dependencies.getAttributeChangeInvalidation(
+                  attributeId + 1, Value(STRING_LITERAL("red")), Value(STRING_LITERAL("black"))));
+}
+
+TEST(CSSSelectorDependencies, tracksPositionDependencies) {
+    CSSSelectorDependencies dependencies;
+    ASSERT_EQ(CSSInvalidationNone, dependencies.getPositionChangeInvalidation());
+
+    dependencies.addPositionDependency(0);
+    ASSERT_EQ(CSSInvalidationSelf, dependencies.getPositionChangeInvalidation());
+
+    dependencies.addPositionDependency(CSSSelectorDependencies::kCSSDependencyDepthAncestor);
+    ASSERT_EQ(CSSInvalidationSelf | CSSInvalidationDescendants, dependencies.getPositionChangeInvalidation());
+}
+
+} // namespace ValdiTest
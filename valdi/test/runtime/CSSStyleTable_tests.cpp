@@ -0,0 +1,221 @@
+#include "valdi/runtime/Attributes/AttributeIds.hpp"
+#include "valdi/runtime/CSS/CSSDocument.hpp"
+#include "valdi/runtime/CSS/CSSStyleTable.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static void addDeclaration(Valdi::StyleNode& styleNode, const char* name, const char* value, int id) {
+    auto* declaration = styleNode.add_styles();
+    declaration->mutable_attribute()->set_type(Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_STRING);
+    declaration->mutable_attribute()->set_name(name);
+    declaration->mutable_attribute()->set_str_value(value);
+    declaration->set_id(id);
+    declaration->set_priority(id * 10);
+}
+
+static Valdi::StyleNode makeStyleNode() {
+    Valdi::StyleNode root;
+    auto* ruleIndex = root.mutable_ruleindex();
+
+    auto* titleRule = ruleIndex->add_class_rules();
+    titleRule->set_name("title");
+    addDeclaration(*titleRule->mutable_node(), "color", "red", 1);
+    auto* fontDeclaration = titleRule->mutable_node()->add_styles();
+    fontDeclaration->mutable_attribute()->set_type(Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_DOUBLE);
+    fontDeclaration->mutable_attribute()->set_name("opacity");
+    fontDeclaration->mutable_attribute()->set_double_value(0.5);
+    fontDeclaration->set_id(2);
+
+    auto* containerRule = ruleIndex->add_class_rules();
+    containerRule->set_name("container");
+    addDeclaration(*containerRule->mutable_node(), "color", "red", 3);
+    auto* widthDeclaration = containerRule->mutable_node()->add_styles();
+    widthDeclaration->mutable_attribute()->set_type(Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_INT);
+    widthDeclaration->mutable_attribute()->set_name("width");
+    widthDeclaration->mutable_attribute()->set_int_value(-42);
+    widthDeclaration->set_id(7);
+    // Attribute of a type this runtime doesn't know about
+    auto* unknownDeclaration = containerRule->mutable_node()->add_styles();
+    unknownDeclaration->mutable_attribute()->set_type(static_cast<Valdi::NodeAttribute_Type>(42));
+    unknownDeclaration->mutable_attribute()->set_name("height");
+    unknownDeclaration->mutable_attribute()->set_str_value("ignored");
+    unknownDeclaration->set_id(8);
+
+    auto* attributeRule = ruleIndex->add_attribute_rules();
+    attributeRule->set_type(Valdi::CSSRuleIndex_AttributeRule_Type_EQUALS);
+    attributeRule->mutable_attribute()->set_name("accessibilityId");
+    attributeRule->mutable_attribute()->set_str_value("red");
+    addDeclaration(*attributeRule->mutable_node(), "background", "blue", 4);
+
+    auto* nthChildRule = ruleIndex->add_nth_child_rules();
+    nthChildRule->set_n(2);
+    nthChildRule->set_offset(-1);
+    addDeclaration(*nthChildRule->mutable_node(), "background", "green", 5);
+
+    auto* parentRule = ruleIndex->mutable_direct_parent_rules()->add_tag_rules();
+    parentRule->set_name("view");
+    addDeclaration(*parentRule->mutable_node(), "color", "black", 6);
+
+    return root;
+}
+
+TEST(CSSStyleTable, canDetectStyleTable) {
+    auto table = CSSStyleTable::serialize(makeStyleNode());
+    ASSERT_TRUE(CSSStyleTable::isStyleTable(table.data(), table.size()));
+
+    auto protobuf = makeStyleNode().SerializeAsString();
+    ASSERT_FALSE(CSSStyleTable::isStyleTable(reinterpret_cast<const Byte*>(protobuf.data()), protobuf.size()));
+}
+
+TEST(CSSStyleTable, producesSameDocumentAsProtobuf) {
+    AttributeIds attributeIds;
+    auto styleNode = makeStyleNode();
+    auto table = CSSStyleTable::serialize(styleNode);
+
+    auto result = CSSDocument::parse(ResourceId(STRING_LITERAL("test"), STRING_LITERAL("test.valdicss")),
+                                     table.data(),
+                                     table.size(),
+                                     attributeIds);
+    ASSERT_TRUE(result) << result.description();
+    auto document = result.moveValue();
+    auto expected = makeShared<CSSDocument>(
+        ResourceId(STRING_LITERAL("test"), STRING_LITERAL("test.valdicss")), styleNode, attributeIds);
+
+    const auto& ruleIndex = *document->getRootNode().ruleIndex;
+    const auto& expectedRuleIndex = *expected->getRootNode().ruleIndex;
+
+    ASSERT_EQ(expectedRuleIndex.classRules.size(), ruleIndex.classRules.size());
+    for (const auto& it : expectedRuleIndex.classRules) {
+        const auto& classRule = ruleIndex.classRules.find(it.first);
+        ASSERT_TRUE(classRule != ruleIndex.classRules.end());
+        ASSERT_EQ(it.second.styles.size(), classRule->second.styles.size());
+        for (size_t i = 0; i < it.second.styles.size(); i++) {
+            ASSERT_EQ(it.second.styles[i].attribute.id, classRule->second.styles[i].attribute.id);
+            ASSERT_EQ(it.second.styles[i].attribute.value, classRule->second.styles[i].attribute.value);
+            ASSERT_EQ(it.second.styles[i].priority, classRule->second.styles[i].priority);
+            ASSERT_EQ(it.second.styles[i].id, classRule->second.styles[i].id);
+        }
+    }
+
+    ASSERT_EQ(static_cast<size_t>(1), ruleIndex.attributeRules.size());
+    ASSERT_EQ(Valdi::CSSRuleIndex_AttributeRule_Type_EQUALS, ruleIndex.attributeRules[0].type);
+    ASSERT_EQ(Value(STRING_LITERAL("red")), ruleIndex.attributeRules[0].attribute.value);
+
+    ASSERT_EQ(static_cast<size_t>(1), ruleIndex.nthChildRules.size());
+    ASSERT_EQ(2, ruleIndex.nthChildRules[0].n);
+    ASSERT_EQ(-1, ruleIndex.nthChildRules[0].offset);
+
+    ASSERT_TRUE(ruleIndex.directParentRules != nullptr);
+    ASSERT_EQ(static_cast<size_t>(1), ruleIndex.directParentRules->tagRules.size());
+
+    ASSERT_EQ(expected->getSortedMonitoredAttributes(), document->getSortedMonitoredAttributes());
+    ASSERT_EQ(expected->hasParentRules(), document->hasParentRules());
+    ASSERT_EQ(expected->computePositionSignature(2, 4), document->computePositionSignature(2, 4));
+}
+
+static void expectSameRuleIndex(const CSSProcessedRuleIndex* expected, const CSSProcessedRuleIndex* actual);
+
+static void expectSameStyleNode(const CSSStyleNode& expected, const CSSStyleNode& actual) {
+    ASSERT_EQ(expected.styles.size(), actual.styles.size());
+    for (size_t i = 0; i < expected.styles.size(); i++) {
+        ASSERT_EQ(expected.styles[i].attribute.id, actual.styles[i].attribute.id);
+        ASSERT_EQ(expected.styles[i].attribute.value, actual.styles[i].attribute.value);
+        ASSERT_EQ(expected.styles[i].priority, actual.styles[i].priority);
+        ASSERT_EQ(expected.styles[i].id, actual.styles[i].id);
+    }
+    expectSameRuleIndex(expected.ruleIndex.get(), actual.ruleIndex.get());
+}
+
+static void expectSameOptionalStyleNode(const std::unique_ptr<CSSStyleNode>& expected,
+                                        const std::unique_ptr<CSSStyleNode>& actual) {
+    ASSERT_EQ(expected == nullptr, actual == nullptr);
+    if (expected != nullptr) {
+        expectSameStyleNode(*expected, *actual);
+    }
+}
+
+static void expectSameMapRules(const FlatMap<StringBox, CSSStyleNode>& expected,
+                               const FlatMap<StringBox, CSSStyleNode>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (const auto& it : expected) {
+        const auto& actualIt = actual.find(it.first);
+        ASSERT_TRUE(actualIt != actual.end()) << it.first.toStringView();
+        expectSameStyleNode(it.second, actualIt->second);
+    }
+}
+
+static void expectSameRuleIndex(const CSSProcessedRuleIndex* expected, const CSSProcessedRuleIndex* actual) {
+    ASSERT_EQ(expected == nullptr, actual == nullptr);
+    if (expected == nullptr) {
+        return;
+    }
+
+    expectSameMapRules(expected->idRules, actual->idRules);
+    expectSameMapRules(expected->classRules, actual->classRules);
+    expectSameMapRules(expected->tagRules, actual->tagRules);
+
+    ASSERT_EQ(expected->attributeRules.size(), actual->attributeRules.size());
+    for (size_t i = 0; i < expected->attributeRules.size(); i++) {
+        ASSERT_EQ(expected->attributeRules[i].type, actual->attributeRules[i].type);
+        ASSERT_EQ(expected->attributeRules[i].attribute.id, actual->attributeRules[i].attribute.id);
+        ASSERT_EQ(expected->attributeRules[i].attribute.value, actual->attributeRules[i].attribute.value);
+        expectSameStyleNode(expected->attributeRules[i].styleNode, actual->attributeRules[i].styleNode);
+    }
+
+    expectSameOptionalStyleNode(expected->firstChildRule, actual->firstChildRule);
+    expectSameOptionalStyleNode(expected->lastChildRule, actual->lastChildRule);
+
+    ASSERT_EQ(expected->nthChildRules.size(), actual->nthChildRules.size());
+    for (size_t i = 0; i < expected->nthChildRules.size(); i++) {
+        ASSERT_EQ(expected->nthChildRules[i].n, actual->nthChildRules[i].n);
+        ASSERT_EQ(expected->nthChildRules[i].offset, actual->nthChildRules[i].offset);
+        expectSameStyleNode(expected->nthChildRules[i].node, actual->nthChildRules[i].node);
+    }
+
+    expectSameRuleIndex(expected->ancestorRules.get(), actual->ancestorRules.get());
+    expectSameRuleIndex(expected->directParentRules.get(), actual->directParentRules.get());
+}
+
+TEST(CSSStyleTable, roundTripMatchesProtobufPath) {
+    AttributeIds attributeIds;
+    auto styleNode = makeStyleNode();
+    auto table = CSSStyleTable::serialize(styleNode);
+    auto protobuf = styleNode.SerializeAsString();
+
+    auto fromTable = CSSDocument::parse(ResourceId(STRING_LITERAL("test"), STRING_LITERAL("test.valdicss")),
+                                        table.data(),
+                                        table.size(),
+                                        attributeIds);
+    ASSERT_TRUE(fromTable) << fromTable.description();
+    auto fromProtobuf = CSSDocument::parse(ResourceId(STRING_LITERAL("test"), STRING_LITERAL("test.valdicss")),
+                                           reinterpret_cast<const Byte*>(protobuf.data()),
+                                           protobuf.size(),
+                                           attributeIds);
+    ASSERT_TRUE(fromProtobuf) << fromProtobuf.description();
+
+    expectSameStyleNode(fromProtobuf.value()->getRootNode(), fromTable.value()->getRootNode());
+
+    // Attributes of an unknown type are null on both paths
+    const auto& containerStyles =
+        fromTable.value()->getRootNode().ruleIndex->classRules.find(STRING_LITERAL("container"))->second.styles;
+    ASSERT_EQ(static_cast<size_t>(3), containerStyles.size());
+    ASSERT_EQ(Value(-42), containerStyles[1].attribute.value);
+    ASSERT_TRUE(containerStyles[2].attribute.value.isNullOrUndefined());
+}
+
+TEST(CSSStyleTable, rejectsTruncatedTable) {
+    AttributeIds attributeIds;
+    auto table = CSSStyleTable::serialize(makeStyleNode());
+
+    for (size_t length : {static_cast<size_t>(4), table.size() / 2, table.size() - 4}) {
+        CSSStyleNode rootNode;
+        auto result = CSSStyleTable::deserialize(table.data(), length, attributeIds, rootNode);
+        ASSERT_FALSE(result) << "Expected failure with length " << length;
+    }
+}
+
+} // namespace ValdiTest
@@ -5,12 +5,15 @@
 //  Created by Simon Corsin on 10/1/19.
 //
 
+#include "valdi/runtime/Resources/BatchedDiskCache.hpp"
 #include "valdi/runtime/Resources/DiskCacheImpl.hpp"
 #include "valdi_core/cpp/Utils/DiskUtils.hpp"
 #include "valdi_core/cpp/Utils/Exception.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_test_utils.hpp"
 #include "gtest/gtest.h"
+#include <future>
 #include <stdlib.h>
 
 using namespace Valdi;
@@ -204,4 +207,70 @@ TEST(DiskCache, scopedInstanceRespectsIsolation) {
     ASSERT_FALSE(result.success()) << result.description();
 }
 
+static std::vector<Result<BytesView>> loadMany(IDiskCache& diskCache, const std::vector<Path>& paths) {
+    auto promise = std::make_shared<std::promise<std::vector<Result<BytesView>>>>();
+    auto future = promise->get_future();
+
+    diskCache.loadMany(paths,
+                       [promise](std::vector<Result<BytesView>> results) { promise->set_value(std::move(results)); });
+
+    return waitForFuture(future);
+}
+
+TEST(DiskCache, canLoadMany) {
+    TemporaryDirectory directory;
+    BatchedDiskCache diskCache(directory.get());
+
+    std::vector<Path> paths;
+    for (size_t i = 0; i < 100; i++) {
+        auto path = Path(STRING_FORMAT("dir/file{}", i).toStringView());
+        auto result = diskCache.store(path, createContent(STRING_FORMAT("content{}", i).getCStr()));
+        ASSERT_TRUE(result.success()) << result.description();
+        paths.emplace_back(std::move(path));
+    }
+
+    auto results = loadMany(diskCache, paths);
+
+    ASSERT_EQ(paths.size(), results.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        ASSERT_TRUE(results[i].success()) << results[i].description();
+        ASSERT_EQ(createContent(STRING_FORMAT("content{}", i).getCStr()), results[i].value());
+    }
+}
+
+TEST(DiskCache, loadManyReportsErrorsPerItem) {
+    TemporaryDirectory directory;
+    BatchedDiskCache diskCache(directory.get());
+
+    auto result = diskCache.store(Path("hello"), createContent("world"));
+    ASSERT_TRUE(result.success()) << result.description();
+    result = diskCache.store(Path("empty"), BytesView());
+    ASSERT_TRUE(result.success()) << result.description();
+
+    auto results = loadMany(diskCache, {Path("missing"), Path("hello"), Path("../outside"), Path("empty")});
+
+    ASSERT_EQ(static_cast<size_t>(4), results.size());
+    ASSERT_FALSE(results[0].success());
+    ASSERT_TRUE(results[1].success()) << results[1].description();
+    ASSERT_EQ(createContent("world"), results[1].value());
+    ASSERT_FALSE(results[2].success());
+    ASSERT_TRUE(results[3].success()) << results[3].description();
+    ASSERT_EQ(static_cast<size_t>(0), results[3].value().size());
+}
+
+TEST(DiskCache, scopedInstanceCanLoadMany) {
+    TemporaryDirectory directory;
+    BatchedDiskCache parentDiskCache(directory.get());
+
+    auto result = parentDiskCache.store(Path("dir/hello"), createContent("world"));
+    ASSERT_TRUE(result.success()) << result.description();
+
+    auto scoped = parentDiskCache.scopedCache(Path("dir"), false);
+    auto results = loadMany(*scoped, {Path("hello")});
+
+    ASSERT_EQ(static_cast<size_t>(1), results.size());
+    ASSERT_TRUE(results[0].success()) << results[0].description();
+    ASSERT_EQ(createContent("world"), results[0].value());
+}
+
 } // namespace ValdiTest
@@ -6,6 +6,7 @@
 //
 
 #include "valdi/runtime/Resources/EncryptedDiskCache.hpp"
+#include "valdi/runtime/Utils/DataEncryptor.hpp"
 
 #include "valdi/standalone_runtime/InMemoryDiskCache.hpp"
 #include "valdi/standalone_runtime/InMemoryKeychain.hpp"
@@ -88,4 +89,49 @@ TEST(EncryptedDiskCache, decryptsOnLoad) {
     ASSERT_EQ("Hello World", data.value().asStringView());
 }
 
+static BytesView makeLargeData(size_t size) {
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(size);
+    for (size_t i = 0; i < size; i++) {
+        buffer->data()[i] = static_cast<Byte>(i * 31);
+    }
+    return buffer->toBytesView();
+}
+
+TEST(EncryptedDiskCache, canLoadDataAcrossChunks) {
+    auto innerDiskCache = makeShared<InMemoryDiskCache>();
+    auto keychain = makeShared<InMemoryKeychain>();
+    auto diskCache = makeShared<EncryptedDiskCache>(innerDiskCache, keychain);
+
+    auto data = makeLargeData(SegmentedDataEncryptor::kDefaultChunkSize * 3 + 100);
+    auto result = diskCache->store(Path("file.bin"), data);
+    ASSERT_TRUE(result) << result.description();
+
+    auto loaded = diskCache->load(Path("file.bin"));
+    ASSERT_TRUE(loaded) << loaded.description();
+    ASSERT_EQ(data, loaded.value());
+}
+
+TEST(EncryptedDiskCache, canLoadDataInPreviousFormat) {
+    auto innerDiskCache = makeShared<InMemoryDiskCache>();
+    auto keychain = makeShared<InMemoryKeychain>();
+    auto diskCache = makeShared<EncryptedDiskCache>(innerDiskCache, keychain);
+    diskCache->generateOrRestoreCryptoKey();
+
+    auto keyData = keychain->get(EncryptedDiskCache::getKeychainKey());
+    snap::utils::crypto::AesEncryptor::Key key;
+    ASSERT_EQ(key.size(), keyData.size());
+    std::memcpy(key.data(), keyData.data(), key.size());
+
+    auto data = makeData("Hello World");
+    auto encrypted = makeShared<ByteBuffer>();
+    ASSERT_TRUE(DataEncryptor(key).encrypt(data.data(), data.size(), *encrypted));
+    auto result = innerDiskCache->store(Path("file.txt"), encrypted->toBytesView());
+    ASSERT_TRUE(result) << result.description();
+
+    auto loaded = diskCache->load(Path("file.txt"));
+    ASSERT_TRUE(loaded) << loaded.description();
+    ASSERT_EQ("Hello World", loaded.value().asStringView());
+}
+
 } // namespace
@@ -0,0 +1,128 @@
+#include "valdi/runtime/JavaScript/JavaScriptGcScheduler.hpp"
+#include "gtest/gtest.h"
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static constexpr size_t kMB = 1024 * 1024;
+
+static JavaScriptGcSchedulerConfig makeConfig() {
+    JavaScriptGcSchedulerConfig config;
+    config.idleDelay = std::chrono::seconds(1);
+    config.interactionQuietPeriod = std::chrono::milliseconds(500);
+    config.maxAnimationDuration = std::chrono::seconds(5);
+    config.minCollectionInterval = std::chrono::seconds(10);
+    config.minHeapGrowthBytes = 4 * kMB;
+    config.maxHeapGrowthBytes = 64 * kMB;
+    return config;
+}
+
+static JavaScriptGcScheduler::TimePoint makeTime(int64_t ms) {
+    return JavaScriptGcScheduler::TimePoint(std::chrono::seconds(100) + std::chrono::milliseconds(ms));
+}
+
+TEST(JavaScriptGcScheduler, collectsWhenIdle) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onJsActivity(makeTime(0));
+
+    auto decision = scheduler.evaluate(makeTime(400), 10 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::Defer, decision.action);
+    ASSERT_EQ(std::chrono::milliseconds(600), decision.checkDelay);
+
+    decision = scheduler.evaluate(makeTime(1000), 10 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectWhenIdle, decision.action);
+}
+
+TEST(JavaScriptGcScheduler, doesNotCollectWhenHeapDidNotGrow) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onJsActivity(makeTime(0));
+    scheduler.onCollected(makeTime(0), 10 * kMB);
+    scheduler.onJsActivity(makeTime(100));
+
+    auto decision = scheduler.evaluate(makeTime(20000), 12 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::None, decision.action);
+
+    decision = scheduler.evaluate(makeTime(20000), 14 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectWhenIdle, decision.action);
+}
+
+TEST(JavaScriptGcScheduler, defersDuringInteraction) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onJsActivity(makeTime(0));
+    scheduler.onInteraction(makeTime(1800));
+
+    auto decision = scheduler.evaluate(makeTime(2000), 10 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::Defer, decision.action);
+    ASSERT_EQ(std::chrono::milliseconds(500), decision.checkDelay);
+
+    decision = scheduler.evaluate(makeTime(2300), 10 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectWhenIdle, decision.action);
+}
+
+TEST(JavaScriptGcScheduler, defersWhileAnimating) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onJsActivity(makeTime(0));
+    scheduler.onAnimationBegan(makeTime(1000));
+
+    ASSERT_TRUE(scheduler.isInteracting(makeTime(2000)));
+    ASSERT_EQ(JavaScriptGcScheduler::Action::Defer, scheduler.evaluate(makeTime(2000), 10 * kMB).action);
+
+    scheduler.onAnimationEnded();
+
+    ASSERT_FALSE(scheduler.isInteracting(makeTime(2000)));
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectWhenIdle, scheduler.evaluate(makeTime(2000), 10 * kMB).action);
+}
+
+TEST(JavaScriptGcScheduler, ignoresAnimationsThatNeverEnded) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onAnimationBegan(makeTime(0));
+
+    ASSERT_TRUE(scheduler.isInteracting(makeTime(4000)));
+    ASSERT_FALSE(scheduler.isInteracting(makeTime(6000)));
+}
+
+TEST(JavaScriptGcScheduler, collectsOverHeadroomDuringInteraction) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onCollected(makeTime(0), 10 * kMB);
+    scheduler.onJsActivity(makeTime(100));
+    scheduler.onInteraction(makeTime(100));
+
+    auto decision = scheduler.evaluate(makeTime(200), 74 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectOverHeadroom, decision.action);
+}
+
+TEST(JavaScriptGcScheduler, respectsMinCollectionInterval) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    scheduler.onCollected(makeTime(0), 10 * kMB);
+    scheduler.onJsActivity(makeTime(1000));
+
+    auto decision = scheduler.evaluate(makeTime(4000), 20 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::Defer, decision.action);
+    ASSERT_EQ(std::chrono::seconds(6), decision.checkDelay);
+
+    decision = scheduler.evaluate(makeTime(10000), 20 * kMB);
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectWhenIdle, decision.action);
+}
+
+TEST(JavaScriptGcScheduler, collectsOnActivityWhenHeapSizeIsUnknown) {
+    JavaScriptGcScheduler scheduler(makeConfig());
+
+    ASSERT_EQ(JavaScriptGcScheduler::Action::None, scheduler.evaluate(makeTime(0), 0).action);
+
+    scheduler.onJsActivity(makeTime(0));
+    ASSERT_EQ(JavaScriptGcScheduler::Action::CollectWhenIdle, scheduler.evaluate(makeTime(1000), 0).action);
+
+    scheduler.onCollected(makeTime(1000), 0);
+    ASSERT_FALSE(scheduler.hasActivitySinceLastCollection());
+    ASSERT_EQ(JavaScriptGcScheduler::Action::None, scheduler.evaluate(makeTime(20000), 0).action);
+}
+
+} // namespace ValdiTest
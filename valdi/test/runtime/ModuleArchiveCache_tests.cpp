@@ -0,0 +1,100 @@
+#include "valdi/runtime/Resources/ModuleArchiveCache.hpp"
+#include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
+#include "valdi_core/cpp/Resources/ValdiArchive.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "gtest/gtest.h"
+#include "zstd.h"
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static BytesView makeCompressedModule(const char* content) {
+    ValdiArchiveBuilder moduleBuilder;
+    moduleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file1"), StringCache::getGlobal().makeString(content)));
+    auto moduleBytes = moduleBuilder.build();
+
+    auto output = makeShared<ByteBuffer>();
+    output->resize(ZSTD_compressBound(moduleBytes->size()));
+    auto size = ZSTD_compress(output->data(), output->size(), moduleBytes->data(), moduleBytes->size(), 3);
+    if (ZSTD_isError(size) != 0) {
+        return BytesView();
+    }
+    output->resize(size);
+
+    return output->toBytesView();
+}
+
+TEST(ModuleArchiveCache, sharesArchivesWithIdenticalContent) {
+    ModuleArchiveCache cache;
+
+    auto module = makeCompressedModule("content1");
+    // Same content in a separate buffer, as loaded by another runtime
+    auto sameModule = makeCompressedModule("content1");
+    auto otherModule = makeCompressedModule("content2");
+
+    auto archive1 = cache.getOrDecompress(STRING_LITERAL("module"), module);
+    auto archive2 = cache.getOrDecompress(STRING_LITERAL("module"), sameModule);
+    auto archive3 = cache.getOrDecompress(STRING_LITERAL("module"), otherModule);
+
+    ASSERT_TRUE(archive1) << archive1.description();
+    ASSERT_TRUE(archive2) << archive2.description();
+    ASSERT_TRUE(archive3) << archive3.description();
+
+    ASSERT_EQ(archive1.value().get(), archive2.value().get());
+    ASSERT_NE(archive1.value().get(), archive3.value().get());
+    ASSERT_EQ(static_cast<size_t>(2), cache.size());
+
+    auto entry = archive1.value()->getEntry(STRING_LITERAL("file1"));
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ("content1", std::string_view(reinterpret_cast<const char*>(entry->data), entry->size));
+}
+
+TEST(ModuleArchiveCache, releasesArchivesWhenUnused) {
+    ModuleArchiveCache cache;
+
+    auto module = makeCompressedModule("content1");
+
+    {
+        auto archive = cache.getOrDecompress(STRING_LITERAL("module"), module);
+        ASSERT_TRUE(archive) << archive.description();
+        ASSERT_EQ(static_cast<size_t>(1), cache.size());
+    }
+
+    ASSERT_EQ(static_cast<size_t>(0), cache.size());
+
+    auto archive = cache.getOrDecompress(STRING_LITERAL("module"), module);
+    ASSERT_TRUE(archive) << archive.description();
+    ASSERT_EQ(static_cast<size_t>(1), cache.size());
+    ASSERT_TRUE(archive.value()->getEntry(STRING_LITERAL("file1")).has_value());
+}
+
+TEST(ModuleArchiveCache, failsOnInvalidArchive) {
+    ModuleArchiveCache cache;
+
+    auto module = makeCompressedModule("content1");
+    // Keep the zstd header but truncate the frame
+    auto truncatedModule = BytesView(module.getSource(), module.data(), module.size() / 2);
+
+    auto archive = cache.getOrDecompress(STRING_LITERAL("module"), truncatedModule);
+
+    ASSERT_FALSE(archive);
+    ASSERT_EQ(static_cast<size_t>(0), cache.size());
+}
+
+TEST(ModuleArchiveCache, doesntShareArchivesOfDifferentModules) {
+    ModuleArchiveCache cache;
+
+    auto module = makeCompressedModule("content1");
+
+    auto archive1 = cache.getOrDecompress(STRING_LITERAL("module1"), module);
+    auto archive2 = cache.getOrDecompress(STRING_LITERAL("module2"), module);
+
+    ASSERT_TRUE(archive1) << archive1.description();
+    ASSERT_TRUE(archive2) << archive2.description();
+
+    ASSERT_NE(archive1.value().get(), archive2.value().get());
+    ASSERT_EQ(static_cast<size_t>(2), cache.size());
+}
+
+} // namespace ValdiTest
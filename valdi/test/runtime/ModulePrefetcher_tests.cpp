@@ -0,0 +1,84 @@
+#include "valdi/runtime/Resources/ModulePrefetcher.hpp"
+#include "valdi/runtime/Utils/AsyncGroup.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "gtest/gtest.h"
+
+#include <condition_variable>
+#include <set>
+#include <thread>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+TEST(ModulePrefetcher, loadsAllModules) {
+    auto prefetcher = makeShared<ModulePrefetcher>(3, ThreadQoSClassNormal);
+
+    std::vector<StringBox> moduleNames;
+    for (size_t i = 0; i < 10; i++) {
+        moduleNames.emplace_back(STRING_FORMAT("module_{}", i));
+    }
+
+    Mutex mutex;
+    std::set<StringBox> loadedModules;
+    auto group = makeShared<AsyncGroup>();
+    group->enter();
+
+    prefetcher->prefetch(
+        moduleNames,
+        [&](const StringBox& moduleName) {
+            std::lock_guard<Mutex> lock(mutex);
+            loadedModules.insert(moduleName);
+        },
+        [&]() { group->leave(); });
+
+    ASSERT_TRUE(group->blockingWaitWithTimeout(std::chrono::seconds(5)));
+
+    std::lock_guard<Mutex> lock(mutex);
+    ASSERT_EQ(moduleNames.size(), loadedModules.size());
+    for (const auto& moduleName : moduleNames) {
+        ASSERT_TRUE(loadedModules.find(moduleName) != loadedModules.end());
+    }
+}
+
+TEST(ModulePrefetcher, loadsModulesInParallel) {
+    auto prefetcher = makeShared<ModulePrefetcher>(3, ThreadQoSClassNormal);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t startedCount = 0;
+    bool allStarted = false;
+
+    auto group = makeShared<AsyncGroup>();
+    group->enter();
+
+    // Every load waits until all of them started, which only completes if they run concurrently
+    prefetcher->prefetch(
+        {STRING_LITERAL("a"), STRING_LITERAL("b"), STRING_LITERAL("c")},
+        [&](const StringBox& /*moduleName*/) {
+            std::unique_lock<std::mutex> lock(mutex);
+            startedCount++;
+            condition.notify_all();
+            if (condition.wait_for(lock, std::chrono::seconds(5), [&]() { return startedCount == 3; })) {
+                allStarted = true;
+            }
+        },
+        [&]() { group->leave(); });
+
+    ASSERT_TRUE(group->blockingWaitWithTimeout(std::chrono::seconds(10)));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_TRUE(allStarted);
+}
+
+TEST(ModulePrefetcher, completesWithEmptyList) {
+    auto prefetcher = makeShared<ModulePrefetcher>(2, ThreadQoSClassNormal);
+
+    auto called = false;
+    prefetcher->prefetch(
+        {}, [](const StringBox& /*moduleName*/) {}, [&]() { called = true; });
+
+    ASSERT_TRUE(called);
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,97 @@
+#include "valdi/runtime/Utils/PrewarmedPool.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+struct PrewarmedPoolTestContext {
+    Ref<DispatchQueue> queue = DispatchQueue::create(STRING_LITERAL("PrewarmedPool Test"), ThreadQoSClassNormal);
+    std::shared_ptr<std::atomic_int> createdCount = std::make_shared<std::atomic_int>(0);
+    Ref<PrewarmedPool<int>> pool;
+
+    PrewarmedPoolTestContext() {
+        pool = makeShared<PrewarmedPool<int>>(queue, [createdCount = createdCount]() { return ++(*createdCount); });
+    }
+
+    ~PrewarmedPoolTestContext() {
+        queue->fullTeardown();
+    }
+
+    void flush() {
+        // The refill runs as a single task, flushing the queue waits for it to complete
+        queue->sync([]() {});
+    }
+};
+
+TEST(PrewarmedPool, fillsUpToCapacity) {
+    PrewarmedPoolTestContext context;
+
+    ASSERT_EQ(static_cast<size_t>(0), context.pool->size());
+
+    context.pool->setCapacity(3);
+    context.flush();
+
+    ASSERT_EQ(static_cast<size_t>(3), context.pool->size());
+    ASSERT_EQ(3, context.createdCount->load());
+}
+
+TEST(PrewarmedPool, refillsAfterTake) {
+    PrewarmedPoolTestContext context;
+
+    context.pool->setCapacity(2);
+    context.flush();
+
+    auto item = context.pool->take();
+    ASSERT_TRUE(item.has_value());
+    ASSERT_EQ(1, item.value());
+
+    context.flush();
+
+    ASSERT_EQ(static_cast<size_t>(2), context.pool->size());
+    ASSERT_EQ(3, context.createdCount->load());
+}
+
+TEST(PrewarmedPool, returnsNothingWhenEmpty) {
+    PrewarmedPoolTestContext context;
+
+    ASSERT_FALSE(context.pool->take().has_value());
+    context.flush();
+    ASSERT_EQ(0, context.createdCount->load());
+}
+
+TEST(PrewarmedPool, trimDestroysItemsUntilNextTake) {
+    PrewarmedPoolTestContext context;
+
+    context.pool->setCapacity(2);
+    context.flush();
+
+    context.pool->trim();
+    context.flush();
+
+    ASSERT_EQ(static_cast<size_t>(0), context.pool->size());
+    ASSERT_EQ(2, context.createdCount->load());
+
+    ASSERT_FALSE(context.pool->take().has_value());
+    context.flush();
+
+    ASSERT_EQ(static_cast<size_t>(2), context.pool->size());
+}
+
+TEST(PrewarmedPool, lowerCapacityDestroysExtraItems) {
+    PrewarmedPoolTestContext context;
+
+    context.pool->setCapacity(4);
+    context.flush();
+
+    context.pool->setCapacity(1);
+    context.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), context.pool->size());
+    ASSERT_EQ(static_cast<size_t>(1), context.pool->getCapacity());
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,109 @@
+#include "valdi/runtime/Resources/Remote/RemoteDownloadScheduler.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+struct RemoteDownloadSchedulerTestContext {
+    RemoteDownloadScheduler scheduler;
+    std::vector<StringBox> startedUrls;
+
+    RemoteDownloadSchedulerTestContext(size_t maxInFlight, size_t maxInFlightPerHost)
+        : scheduler(maxInFlight, maxInFlightPerHost) {}
+
+    void schedule(const char* url, RemoteDownloaderPriority priority) {
+        auto urlString = StringCache::getGlobal().makeString(url);
+        scheduler.schedule(urlString, priority, [this, urlString]() { startedUrls.emplace_back(urlString); });
+    }
+};
+
+TEST(RemoteDownloadScheduler, startsDownloadsUpToLimit) {
+    RemoteDownloadSchedulerTestContext context(2, 2);
+
+    context.schedule("https://a.com/1", RemoteDownloaderPriorityNormal);
+    context.schedule("https://a.com/2", RemoteDownloaderPriorityNormal);
+    context.schedule("https://b.com/3", RemoteDownloaderPriorityNormal);
+
+    ASSERT_EQ(static_cast<size_t>(2), context.startedUrls.size());
+    ASSERT_EQ(static_cast<size_t>(2), context.scheduler.getInFlightCount());
+    ASSERT_EQ(static_cast<size_t>(1), context.scheduler.getPendingCount());
+
+    context.scheduler.onCompleted(STRING_LITERAL("https://a.com/1"));
+
+    ASSERT_EQ(static_cast<size_t>(3), context.startedUrls.size());
+    ASSERT_EQ(STRING_LITERAL("https://b.com/3"), context.startedUrls[2]);
+    ASSERT_EQ(static_cast<size_t>(0), context.scheduler.getPendingCount());
+}
+
+TEST(RemoteDownloadScheduler, startsHigherPriorityFirst) {
+    RemoteDownloadSchedulerTestContext context(1, 1);
+
+    context.schedule("https://a.com/busy", RemoteDownloaderPriorityUrgent);
+    context.schedule("https://a.com/normal", RemoteDownloaderPriorityNormal);
+    context.schedule("https://a.com/urgent", RemoteDownloaderPriorityUrgent);
+
+    context.scheduler.onCompleted(STRING_LITERAL("https://a.com/busy"));
+    context.scheduler.onCompleted(STRING_LITERAL("https://a.com/urgent"));
+
+    ASSERT_EQ(static_cast<size_t>(3), context.startedUrls.size());
+    ASSERT_EQ(STRING_LITERAL("https://a.com/urgent"), context.startedUrls[1]);
+    ASSERT_EQ(STRING_LITERAL("https://a.com/normal"), context.startedUrls[2]);
+}
+
+TEST(RemoteDownloadScheduler, limitsDownloadsPerHost) {
+    RemoteDownloadSchedulerTestContext context(4, 1);
+
+    context.schedule("https://a.com/1", RemoteDownloaderPriorityNormal);
+    context.schedule("https://a.com/2", RemoteDownloaderPriorityNormal);
+    context.schedule("https://b.com/3", RemoteDownloaderPriorityNormal);
+
+    ASSERT_EQ(static_cast<size_t>(2), context.startedUrls.size());
+    ASSERT_EQ(STRING_LITERAL("https://b.com/3"), context.startedUrls[1]);
+
+    context.scheduler.onCompleted(STRING_LITERAL("https://a.com/1"));
+
+    ASSERT_EQ(static_cast<size_t>(3), context.startedUrls.size());
+    ASSERT_EQ(STRING_LITERAL("https://a.com/2"), context.startedUrls[2]);
+}
+
+TEST(RemoteDownloadScheduler, backgroundDownloadsLeaveASlotFree) {
+    RemoteDownloadSchedulerTestContext context(2, 2);
+
+    context.schedule("https://a.com/1", RemoteDownloaderPriorityBackground);
+    context.schedule("https://a.com/2", RemoteDownloaderPriorityBackground);
+
+    ASSERT_EQ(static_cast<size_t>(1), context.startedUrls.size());
+
+    context.schedule("https://a.com/3", RemoteDownloaderPriorityUrgent);
+
+    ASSERT_EQ(static_cast<size_t>(2), context.startedUrls.size());
+    ASSERT_EQ(STRING_LITERAL("https://a.com/3"), context.startedUrls[1]);
+}
+
+TEST(RemoteDownloadScheduler, canRaisePriorityOfPendingDownload) {
+    RemoteDownloadSchedulerTestContext context(2, 2);
+
+    context.schedule("https://a.com/1", RemoteDownloaderPriorityBackground);
+    context.schedule("https://a.com/2", RemoteDownloaderPriorityBackground);
+
+    ASSERT_EQ(static_cast<size_t>(1), context.startedUrls.size());
+
+    // Once urgent, the prefetch can use the slot reserved to non background downloads
+    ASSERT_TRUE(context.scheduler.raisePriority(STRING_LITERAL("https://a.com/2"), RemoteDownloaderPriorityUrgent));
+    ASSERT_EQ(static_cast<size_t>(2), context.startedUrls.size());
+
+    ASSERT_FALSE(context.scheduler.raisePriority(STRING_LITERAL("https://a.com/1"), RemoteDownloaderPriorityUrgent));
+}
+
+TEST(RemoteDownloadScheduler, resolvesHostFromUrl) {
+    ASSERT_EQ(STRING_LITERAL("snap.com"), RemoteDownloadScheduler::getHost(STRING_LITERAL("https://snap.com/a/b")));
+    ASSERT_EQ(STRING_LITERAL("snap.com:8080"),
+              RemoteDownloadScheduler::getHost(STRING_LITERAL("http://snap.com:8080?query")));
+    ASSERT_EQ(STRING_LITERAL("snap.com"), RemoteDownloadScheduler::getHost(STRING_LITERAL("snap.com")));
+}
+
+} // namespace ValdiTest
@@ -21,6 +21,7 @@
 #include "valdi_core/cpp/Utils/Exception.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "zstd.h"
 #include <gtest/gtest.h>
 
 using namespace Valdi;
@@ -431,6 +432,170 @@ TEST(RemoteModuleManager, reloadModuleOnOutOfDateCache) {
     ASSERT_NE(diskContent.begin()->second, newDiskContent.begin()->second);
 }
 
+BytesView makeZstdPatch(const BytesView& base, const BytesView& target) {
+    auto* cctx = ZSTD_createCCtx();
+    ZSTD_CCtx_refPrefix(cctx, base.data(), base.size());
+
+    auto output = makeShared<ByteBuffer>();
+    output->resize(ZSTD_compressBound(target.size()));
+    auto size = ZSTD_compress2(cctx, output->data(), output->size(), target.data(), target.size());
+    ZSTD_freeCCtx(cctx);
+
+    if (ZSTD_isError(size) != 0) {
+        return BytesView();
+    }
+    output->resize(size);
+    return output->toBytesView();
+}
+
+void addMockedPatchResponse(RequestManagerMock& requestManager,
+                            const StringBox& url,
+                            const BytesView& base,
+                            const BytesView& patch) {
+    Value requestHeaders;
+    requestHeaders.setMapValue("A-IM", Value(STRING_LITERAL("zstd-patch-from")));
+    requestHeaders.setMapValue("If-None-Match",
+                               Value(STRING_FORMAT("\"{}\"", BytesUtils::sha256String(base))));
+
+    Value responseHeaders;
+    responseHeaders.setMapValue("IM", Value(STRING_LITERAL("zstd-patch-from")));
+
+    requestManager.addMockedResponse(
+        snap::valdi_core::HTTPRequest(url, STRING_LITERAL("GET"), requestHeaders, std::nullopt, 0),
+        snap::valdi_core::HTTPResponse(226, responseHeaders, {patch}));
+}
+
+Ref<ValdiModuleArchive> loadModuleInNewWrapper(const Ref<InMemoryDiskCache>& disk,
+                                               const StringBox& module,
+                                               const Ref<DownloadableModuleManifestWrapper>& manifest,
+                                               const BytesView& moduleBytes) {
+    RemoteModuleManagerWrapper wrapper(0, disk);
+
+    auto url = StringCache::getGlobal().makeString(manifest->pb.artifact().url());
+    wrapper.requestManager->addMockedResponse(url, STRING_LITERAL("GET"), moduleBytes);
+    wrapper.remoteBundleManager->registerManifest(module, manifest);
+
+    auto resultHolder = ResultHolder<Ref<ValdiModuleArchive>>::make();
+    wrapper.remoteBundleManager->loadModule(module, resultHolder->makeCompletion());
+    auto result = resultHolder->waitForResult();
+
+    // Flush the work queue so that the remote bundle manager can store the module in the disk cache
+    wrapper.dispatchQueue->sync([]() {});
+
+    return result.success() ? result.value() : nullptr;
+}
+
+TEST(RemoteModuleManager, canUpdateModuleFromPatch) {
+    auto disk = Valdi::makeShared<InMemoryDiskCache>();
+
+    ValdiArchiveBuilder moduleBuilder;
+    moduleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file1"), STRING_LITERAL("content1")));
+    moduleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file2"), STRING_LITERAL("content2")));
+    auto moduleBytes = moduleBuilder.build();
+
+    auto module = STRING_LITERAL("Module1");
+    auto manifest = makeShared<DownloadableModuleManifestWrapper>();
+    manifest->pb.mutable_artifact()->set_url("http://snap.com/valdi/module1");
+    auto sha256Digest = BytesUtils::sha256(moduleBytes->toBytesView());
+    manifest->pb.mutable_artifact()->set_sha256digest(sha256Digest->data(), sha256Digest->size());
+
+    // Populate the disk cache with the first version of the module
+    ASSERT_TRUE(loadModuleInNewWrapper(disk, module, manifest, moduleBytes->toBytesView()) != nullptr);
+
+    RemoteModuleManagerWrapper wrapper(0, disk);
+
+    ValdiArchiveBuilder newModuleBuilder;
+    newModuleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file1"), STRING_LITERAL("content1")));
+    newModuleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file2"), STRING_LITERAL("content2.new")));
+    auto newModuleBytes = newModuleBuilder.build();
+
+    // Only a patch is served for the new url, the load can only succeed by applying it
+    auto newUrl = STRING_LITERAL("http://snap.com/valdi/module1.new");
+    auto patch = makeZstdPatch(moduleBytes->toBytesView(), newModuleBytes->toBytesView());
+    addMockedPatchResponse(*wrapper.requestManager, newUrl, moduleBytes->toBytesView(), patch);
+
+    manifest->pb.mutable_artifact()->set_url(newUrl.slowToString());
+    auto sha256DigestNew = BytesUtils::sha256(newModuleBytes->toBytesView());
+    manifest->pb.mutable_artifact()->set_sha256digest(sha256DigestNew->data(), sha256DigestNew->size());
+    wrapper.remoteBundleManager->registerManifest(module, manifest);
+
+    auto resultHolder = ResultHolder<Ref<ValdiModuleArchive>>::make();
+    wrapper.remoteBundleManager->loadModule(module, resultHolder->makeCompletion());
+
+    auto result = resultHolder->waitForResult();
+    ASSERT_TRUE(result.success());
+
+    ASSERT_EQ(static_cast<size_t>(1), wrapper.requestManager->getAllPerformedTasks().size());
+
+    auto file2 = result.value()->getEntry(STRING_LITERAL("file2"));
+    ASSERT_TRUE(file2.has_value());
+    ASSERT_EQ(STRING_LITERAL("content2.new"), bundleEntryToString(file2.value()));
+
+    // The patched module should have been stored in the disk cache
+    wrapper.dispatchQueue->sync([]() {});
+
+    RemoteModuleManagerWrapper diskWrapper(0, disk);
+    diskWrapper.requestManager->setDisabled(true);
+    diskWrapper.remoteBundleManager->registerManifest(module, manifest);
+    diskWrapper.remoteBundleManager->loadModule(module, resultHolder->makeCompletion());
+
+    auto diskResult = resultHolder->waitForResult();
+    ASSERT_TRUE(diskResult.success());
+    ASSERT_EQ(*result.value(), *diskResult.value());
+}
+
+TEST(RemoteModuleManager, fallsBackToFullDownloadOnInvalidPatch) {
+    auto disk = Valdi::makeShared<InMemoryDiskCache>();
+
+    ValdiArchiveBuilder moduleBuilder;
+    moduleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file1"), STRING_LITERAL("content1")));
+    moduleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file2"), STRING_LITERAL("content2")));
+    auto moduleBytes = moduleBuilder.build();
+
+    auto module = STRING_LITERAL("Module1");
+    auto manifest = makeShared<DownloadableModuleManifestWrapper>();
+    manifest->pb.mutable_artifact()->set_url("http://snap.com/valdi/module1");
+    auto sha256Digest = BytesUtils::sha256(moduleBytes->toBytesView());
+    manifest->pb.mutable_artifact()->set_sha256digest(sha256Digest->data(), sha256Digest->size());
+
+    ASSERT_TRUE(loadModuleInNewWrapper(disk, module, manifest, moduleBytes->toBytesView()) != nullptr);
+
+    RemoteModuleManagerWrapper wrapper(0, disk);
+
+    ValdiArchiveBuilder newModuleBuilder;
+    newModuleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file1"), STRING_LITERAL("content1")));
+    newModuleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file2"), STRING_LITERAL("content2.new")));
+    auto newModuleBytes = newModuleBuilder.build();
+
+    // The patch targets a different module than the one in the manifest, its hash won't match
+    ValdiArchiveBuilder otherModuleBuilder;
+    otherModuleBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file1"), STRING_LITERAL("content1.other")));
+    auto otherModuleBytes = otherModuleBuilder.build();
+
+    auto newUrl = STRING_LITERAL("http://snap.com/valdi/module1.new");
+    auto patch = makeZstdPatch(moduleBytes->toBytesView(), otherModuleBytes->toBytesView());
+    addMockedPatchResponse(*wrapper.requestManager, newUrl, moduleBytes->toBytesView(), patch);
+    wrapper.requestManager->addMockedResponse(newUrl, STRING_LITERAL("GET"), newModuleBytes->toBytesView());
+
+    manifest->pb.mutable_artifact()->set_url(newUrl.slowToString());
+    auto sha256DigestNew = BytesUtils::sha256(newModuleBytes->toBytesView());
+    manifest->pb.mutable_artifact()->set_sha256digest(sha256DigestNew->data(), sha256DigestNew->size());
+    wrapper.remoteBundleManager->registerManifest(module, manifest);
+
+    auto resultHolder = ResultHolder<Ref<ValdiModuleArchive>>::make();
+    wrapper.remoteBundleManager->loadModule(module, resultHolder->makeCompletion());
+
+    auto result = resultHolder->waitForResult();
+    ASSERT_TRUE(result.success());
+
+    // The patch was requested first, then the full module
+    ASSERT_EQ(static_cast<size_t>(2), wrapper.requestManager->getAllPerformedTasks().size());
+
+    auto file2 = result.value()->getEntry(STRING_LITERAL("file2"));
+    ASSERT_TRUE(file2.has_value());
+    ASSERT_EQ(STRING_LITERAL("content2.new"), bundleEntryToString(file2.value()));
+}
+
 TEST(RemoteModuleManager, canLoadResources) {
     RemoteModuleManagerWrapper wrapper;
 
@@ -0,0 +1,138 @@
+#include "valdi/runtime/Rendering/RenderRequestCoalescer.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static void setAttribute(RenderRequest& renderRequest, RawViewNodeId elementId, AttributeId attributeId, int value) {
+    auto* entry = renderRequest.appendSetElementAttribute();
+    entry->setElementId(elementId);
+    entry->setAttributeId(attributeId);
+    entry->setAttributeValue(Value(static_cast<int32_t>(value)));
+}
+
+static void createElement(RenderRequest& renderRequest, RawViewNodeId elementId) {
+    auto* entry = renderRequest.appendCreateElement();
+    entry->setElementId(elementId);
+    entry->setViewClassName(STRING_LITERAL("View"));
+}
+
+static void destroyElement(RenderRequest& renderRequest, RawViewNodeId elementId) {
+    renderRequest.appendDestroyElement()->setElementId(elementId);
+}
+
+struct RecordedEntry {
+    RenderRequestEntryType type;
+    RawViewNodeId elementId;
+    Value value;
+};
+
+struct RecordEntriesVisitor {
+    std::vector<RecordedEntry> entries;
+
+    void visit(RenderRequestEntries::SetElementAttribute& entry) {
+        entries.emplace_back(RecordedEntry{entry.getType(), entry.getElementId(), entry.getAttributeValue()});
+    }
+
+    void visit(RenderRequestEntries::ElementEntryBase& entry) {
+        entries.emplace_back(RecordedEntry{entry.getType(), entry.getElementId(), Value()});
+    }
+
+    void visit(RenderRequestEntries::EntryBase& entry) {
+        entries.emplace_back(RecordedEntry{entry.getType(), 0, Value()});
+    }
+};
+
+static std::vector<RecordedEntry> recordEntries(const Ref<RenderRequest>& renderRequest) {
+    RecordEntriesVisitor visitor;
+    renderRequest->visitEntries(visitor);
+    return std::move(visitor.entries);
+}
+
+TEST(RenderRequestCoalescer, returnsSingleRequestUnchanged) {
+    auto renderRequest = makeShared<RenderRequest>();
+    setAttribute(*renderRequest, 1, 1, 1);
+    setAttribute(*renderRequest, 1, 1, 2);
+
+    RenderRequestCoalescingStats stats;
+    auto result = RenderRequestCoalescer::coalesce({renderRequest}, stats);
+
+    ASSERT_EQ(renderRequest.get(), result.get());
+    ASSERT_EQ(static_cast<size_t>(2), stats.mergedEntriesCount);
+}
+
+TEST(RenderRequestCoalescer, foldsAttributesToLastValue) {
+    auto first = makeShared<RenderRequest>();
+    setAttribute(*first, 1, 1, 1);
+    setAttribute(*first, 1, 2, 10);
+    auto second = makeShared<RenderRequest>();
+    setAttribute(*second, 1, 1, 2);
+    setAttribute(*second, 2, 1, 3);
+
+    RenderRequestCoalescingStats stats;
+    auto result = RenderRequestCoalescer::coalesce({first, second}, stats);
+    auto entries = recordEntries(result);
+
+    ASSERT_EQ(static_cast<size_t>(3), entries.size());
+    ASSERT_EQ(Value(10), entries[0].value);
+    ASSERT_EQ(1, entries[1].elementId);
+    ASSERT_EQ(Value(2), entries[1].value);
+    ASSERT_EQ(2, entries[2].elementId);
+
+    ASSERT_EQ(static_cast<size_t>(2), stats.requestsCount);
+    ASSERT_EQ(static_cast<size_t>(4), stats.entriesCount);
+    ASSERT_EQ(static_cast<size_t>(3), stats.mergedEntriesCount);
+    ASSERT_EQ(static_cast<size_t>(1), stats.foldedAttributesCount);
+}
+
+TEST(RenderRequestCoalescer, doesNotFoldAttributesAcrossAnimations) {
+    auto first = makeShared<RenderRequest>();
+    setAttribute(*first, 1, 1, 1);
+    auto second = makeShared<RenderRequest>();
+    second->appendStartAnimations();
+    setAttribute(*second, 1, 1, 2);
+    second->appendEndAnimations();
+
+    RenderRequestCoalescingStats stats;
+    auto result = RenderRequestCoalescer::coalesce({first, second}, stats);
+
+    ASSERT_EQ(static_cast<size_t>(4), result->getEntriesSize());
+    ASSERT_EQ(static_cast<size_t>(0), stats.foldedAttributesCount);
+}
+
+TEST(RenderRequestCoalescer, dropsElementsCreatedAndDestroyedWithinWindow) {
+    auto first = makeShared<RenderRequest>();
+    createElement(*first, 2);
+    setAttribute(*first, 2, 1, 1);
+    setAttribute(*first, 1, 1, 1);
+    auto second = makeShared<RenderRequest>();
+    destroyElement(*second, 2);
+
+    RenderRequestCoalescingStats stats;
+    auto result = RenderRequestCoalescer::coalesce({first, second}, stats);
+    auto entries = recordEntries(result);
+
+    ASSERT_EQ(static_cast<size_t>(1), entries.size());
+    ASSERT_EQ(1, entries[0].elementId);
+    ASSERT_EQ(static_cast<size_t>(1), stats.droppedElementsCount);
+}
+
+TEST(RenderRequestCoalescer, keepsAttachedElementsCreatedAndDestroyedWithinWindow) {
+    auto first = makeShared<RenderRequest>();
+    createElement(*first, 2);
+    auto* move = first->appendMoveElementToParent();
+    move->setElementId(2);
+    move->setParentElementId(1);
+    auto second = makeShared<RenderRequest>();
+    destroyElement(*second, 2);
+
+    RenderRequestCoalescingStats stats;
+    auto result = RenderRequestCoalescer::coalesce({first, second}, stats);
+
+    ASSERT_EQ(static_cast<size_t>(3), result->getEntriesSize());
+    ASSERT_EQ(static_cast<size_t>(0), stats.droppedElementsCount);
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,96 @@
+#include "valdi/runtime/Utils/DataEncryptor.hpp"
+#include "valdi/runtime/Utils/SegmentedDataEncryptor.hpp"
+#include "gtest/gtest.h"
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static std::vector<Byte> makeData(size_t size) {
+    std::vector<Byte> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<Byte>(i * 7);
+    }
+    return data;
+}
+
+TEST(SegmentedDataEncryptor, canEncryptAndDecrypt) {
+    SegmentedDataEncryptor encryptor(DataEncryptor::generateKey());
+
+    for (size_t size : {0, 1, 15, 16, 17, 64, 100}) {
+        auto data = makeData(size);
+
+        ByteBuffer encrypted;
+        ASSERT_TRUE(encryptor.encrypt(data.data(), data.size(), encrypted, 16));
+
+        auto header = SegmentedDataEncryptor::parseHeader(encrypted.data(), encrypted.size());
+        ASSERT_TRUE(header.has_value());
+        ASSERT_EQ(size, header->plainSize);
+        ASSERT_EQ(encrypted.size(), header->getEncryptedSize());
+
+        ByteBuffer decrypted;
+        ASSERT_TRUE(encryptor.decrypt(encrypted.data(), encrypted.size(), decrypted));
+        ASSERT_EQ(data, std::vector<Byte>(decrypted.begin(), decrypted.end()));
+    }
+}
+
+TEST(SegmentedDataEncryptor, canDecryptChunksIndependently) {
+    SegmentedDataEncryptor encryptor(DataEncryptor::generateKey());
+    auto data = makeData(100);
+
+    ByteBuffer encrypted;
+    ASSERT_TRUE(encryptor.encrypt(data.data(), data.size(), encrypted, 16));
+    auto header = SegmentedDataEncryptor::parseHeader(encrypted.data(), encrypted.size()).value();
+    ASSERT_EQ(static_cast<size_t>(7), header.getChunksCount());
+
+    // Chunks 2 and 3, covering bytes 32 to 64
+    auto start = header.getChunkOffset(2);
+    auto end = header.getChunkOffset(4);
+
+    ByteBuffer decrypted;
+    ASSERT_TRUE(encryptor.decryptChunks(header, 2, 2, encrypted.data() + start, end - start, decrypted));
+    ASSERT_EQ(std::vector<Byte>(data.begin() + 32, data.begin() + 64),
+              std::vector<Byte>(decrypted.begin(), decrypted.end()));
+
+    // The last chunk is partial
+    start = header.getChunkOffset(6);
+    decrypted.clear();
+    ASSERT_TRUE(
+        encryptor.decryptChunks(header, 6, 1, encrypted.data() + start, encrypted.size() - start, decrypted));
+    ASSERT_EQ(std::vector<Byte>(data.begin() + 96, data.end()), std::vector<Byte>(decrypted.begin(), decrypted.end()));
+
+    // Chunks can't be decrypted at a different index
+    start = header.getChunkOffset(1);
+    end = header.getChunkOffset(2);
+    decrypted.clear();
+    ASSERT_FALSE(encryptor.decryptChunks(header, 2, 1, encrypted.data() + start, end - start, decrypted));
+}
+
+TEST(SegmentedDataEncryptor, failsToDecryptTamperedData) {
+    SegmentedDataEncryptor encryptor(DataEncryptor::generateKey());
+    auto data = makeData(100);
+
+    ByteBuffer encrypted;
+    ASSERT_TRUE(encryptor.encrypt(data.data(), data.size(), encrypted, 16));
+
+    ByteBuffer decrypted;
+
+    // Tampered chunk
+    auto tampered = encrypted;
+    (*tampered[SegmentedDataEncryptor::kHeaderSize + 40])++;
+    ASSERT_FALSE(encryptor.decrypt(tampered.data(), tampered.size(), decrypted));
+
+    // Tampered header nonce
+    tampered = encrypted;
+    (*tampered[20])++;
+    ASSERT_FALSE(encryptor.decrypt(tampered.data(), tampered.size(), decrypted));
+
+    // Truncated
+    ASSERT_FALSE(encryptor.decrypt(encrypted.data(), encrypted.size() - 1, decrypted));
+
+    // Wrong key
+    SegmentedDataEncryptor otherEncryptor(DataEncryptor::generateKey());
+    ASSERT_FALSE(otherEncryptor.decrypt(encrypted.data(), encrypted.size(), decrypted));
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,85 @@
+#include "valdi/runtime/Context/ViewNodeScrollState.hpp"
+#include "gtest/gtest.h"
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static std::chrono::steady_clock::time_point timeAtMs(int64_t ms) {
+    return std::chrono::steady_clock::time_point() + std::chrono::milliseconds(ms);
+}
+
+TEST(ViewNodeScrollState, estimatesVelocityFromContentOffsets) {
+    ViewNodeScrollState scrollState;
+
+    scrollState.updateVelocity(Point(0, 0), timeAtMs(1000));
+    ASSERT_EQ(Point(0, 0), scrollState.getDirectionAgnosticVelocity());
+
+    // 10 points in 10ms
+    scrollState.updateVelocity(Point(0, 10), timeAtMs(1010));
+    ASSERT_FLOAT_EQ(0.0f, scrollState.getDirectionAgnosticVelocity().x);
+    ASSERT_FLOAT_EQ(500.0f, scrollState.getDirectionAgnosticVelocity().y);
+
+    scrollState.updateVelocity(Point(0, 20), timeAtMs(1020));
+    ASSERT_FLOAT_EQ(750.0f, scrollState.getDirectionAgnosticVelocity().y);
+
+    // Samples too far apart start a new gesture
+    scrollState.updateVelocity(Point(0, 30), timeAtMs(2000));
+    ASSERT_EQ(Point(0, 0), scrollState.getDirectionAgnosticVelocity());
+}
+
+TEST(ViewNodeScrollState, resetsVelocityOnScrollEnd) {
+    ViewNodeScrollState scrollState;
+
+    scrollState.updateVelocity(Point(0, 0), timeAtMs(1000));
+    scrollState.updateVelocity(Point(0, 10), timeAtMs(1010));
+    ASSERT_NE(Point(0, 0), scrollState.getDirectionAgnosticVelocity());
+
+    scrollState.notifyOnScrollEnd(Point(0, 10), Point(0, 10));
+    ASSERT_EQ(Point(0, 0), scrollState.getDirectionAgnosticVelocity());
+}
+
+TEST(ViewNodeScrollState, extendsPrefetchViewportInScrollDirection) {
+    ViewNodeScrollState scrollState;
+    auto viewport = Frame(0, 100, 100, 200);
+
+    scrollState.updateVelocity(Point(0, 0), timeAtMs(1000));
+    scrollState.updateVelocity(Point(0, 10), timeAtMs(1010));
+
+    // Disabled by default
+    ASSERT_FALSE(scrollState.isPrefetchEnabled());
+    ASSERT_EQ(viewport, scrollState.resolvePrefetchViewport(viewport));
+
+    scrollState.setPrefetchLookahead(0.25f);
+    ASSERT_TRUE(scrollState.isPrefetchEnabled());
+
+    // Scrolling down extends the bottom of the viewport, taking the deceleration into account
+    auto prefetchViewport = scrollState.resolvePrefetchViewport(viewport);
+    ASSERT_EQ(0.0f, prefetchViewport.x);
+    ASSERT_EQ(100.0f, prefetchViewport.y);
+    ASSERT_EQ(100.0f, prefetchViewport.width);
+    ASSERT_GT(prefetchViewport.height, 200.0f);
+    ASSERT_LT(prefetchViewport.height, 200.0f + 500.0f * 0.25f);
+
+    // Scrolling up extends the top of the viewport
+    scrollState.notifyOnScrollEnd(Point(0, 10), Point(0, 10));
+    scrollState.updateVelocity(Point(0, 10), timeAtMs(2000));
+    scrollState.updateVelocity(Point(0, 0), timeAtMs(2010));
+
+    prefetchViewport = scrollState.resolvePrefetchViewport(viewport);
+    ASSERT_LT(prefetchViewport.y, 100.0f);
+    ASSERT_FLOAT_EQ(300.0f, prefetchViewport.y + prefetchViewport.height);
+}
+
+TEST(ViewNodeScrollState, clampsPrefetchViewport) {
+    ViewNodeScrollState scrollState;
+    auto viewport = Frame(0, 0, 100, 100);
+
+    scrollState.setPrefetchLookahead(10.0f);
+    scrollState.updateVelocity(Point(0, 0), timeAtMs(1000));
+    scrollState.updateVelocity(Point(10000, 0), timeAtMs(1001));
+
+    ASSERT_EQ(Frame(0, 0, 400, 100), scrollState.resolvePrefetchViewport(viewport));
+}
+
+} // namespace ValdiTest
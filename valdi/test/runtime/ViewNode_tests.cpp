@@ -1,6 +1,10 @@
 #include "ViewNodeTestsUtils.hpp"
+#include "valdi/runtime/CSS/CSSDocument.hpp"
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <thread>
+
 using namespace Valdi;
 
 namespace ValdiTest {
@@ -1790,6 +1794,110 @@ TEST(ViewNode, canHandleLazyLayout) {
     ASSERT_EQ(Frame(8, 8, 8, 8), child->getCalculatedFrame());
 }
 
+TEST(ViewNode, prefetchesLazyLayoutAheadOfScroll) {
+    ViewNodeTestsDependencies utils;
+
+    auto root = utils.createRootView();
+    auto scrollContainer = utils.createScroll();
+    utils.setViewNodeFrame(scrollContainer, 0, 0, 100, 100);
+    scrollContainer->setScrollPrefetchLookahead(0.5f);
+
+    root->appendChild(utils.getViewTransactionScope(), scrollContainer);
+
+    std::vector<Ref<ViewNode>> lazyChildren;
+
+    for (size_t i = 0; i < 20; i++) {
+        auto lazyContainer = utils.createLayout();
+        lazyContainer->setPrefersLazyLayout(utils.getViewTransactionScope(), true);
+        utils.setViewNodeAttribute(lazyContainer, "width", Value(100.0));
+        utils.setViewNodeAttribute(lazyContainer, "height", Value(50.0));
+
+        auto lazyChild = utils.createView();
+        utils.setViewNodeFrame(lazyChild, 8, 8, 16, 16);
+        lazyContainer->appendChild(utils.getViewTransactionScope(), lazyChild);
+
+        scrollContainer->appendChild(utils.getViewTransactionScope(), lazyContainer);
+        lazyChildren.emplace_back(std::move(lazyChild));
+    }
+
+    root->performLayout(utils.getViewTransactionScope(), Size(100, 100), LayoutDirectionLTR);
+    root->updateVisibilityAndPerformUpdates(utils.getViewTransactionScope());
+
+    ASSERT_EQ(Frame(8, 8, 16, 16), lazyChildren[0]->getCalculatedFrame());
+    ASSERT_EQ(Frame(0, 0, 0, 0), lazyChildren[6]->getCalculatedFrame());
+
+    // Scroll down, the velocity is estimated from the successive content offsets
+    scrollContainer->onScroll(Point(0, 25), Point(0, 25), Point());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    scrollContainer->onScroll(Point(0, 50), Point(0, 50), Point());
+
+    root->updateVisibilityAndPerformUpdates(utils.getViewTransactionScope());
+
+    // The child at 300 is not visible yet but within the prefetch viewport, which is
+    // extended by at most 3 viewports in the scroll direction
+    ASSERT_FALSE(lazyChildren[6]->getParent()->isVisibleInViewport());
+    ASSERT_EQ(Frame(8, 8, 16, 16), lazyChildren[6]->getCalculatedFrame());
+
+    // The child at 600 is beyond the prefetch viewport
+    ASSERT_EQ(Frame(0, 0, 0, 0), lazyChildren[12]->getCalculatedFrame());
+}
+
+TEST(ViewNode, canSpreadViewCreationAcrossUpdates) {
+    ViewNodeTestsDependencies utils;
+    utils.getTree().setViewCreationBudgetUs(1);
+
+    auto root = utils.createRootView();
+    auto scrollContainer = utils.createScroll();
+    utils.setViewNodeFrame(scrollContainer, 0, 0, 100, 100);
+
+    root->appendChild(utils.getViewTransactionScope(), scrollContainer);
+
+    std::vector<Ref<ViewNode>> children;
+
+    for (size_t i = 0; i < 4; i++) {
+        auto newChild = utils.createView();
+
+        utils.setViewNodeAttribute(newChild, "width", Value(100.0));
+        utils.setViewNodeAttribute(newChild, "height", Value(50.0));
+        scrollContainer->appendChild(utils.getViewTransactionScope(), newChild);
+        children.emplace_back(std::move(newChild));
+    }
+
+    scrollContainer->setViewportExtensionBottom(100);
+
+    root->performLayout(utils.getViewTransactionScope(), Size(100, 100), LayoutDirectionLTR);
+    root->updateVisibilityAndPerformUpdates(utils.getViewTransactionScope());
+
+    for (const auto& child : children) {
+        ASSERT_TRUE(child->isVisibleInViewport());
+    }
+
+    // The views intersecting the viewport are created regardless of the budget,
+    // the view outside of it is deferred
+    ASSERT_TRUE(scrollContainer->hasView());
+    ASSERT_TRUE(children[0]->hasView());
+    ASSERT_TRUE(children[1]->hasView());
+    ASSERT_FALSE(children[3]->hasView());
+    ASSERT_TRUE(root->viewTreeNeedsUpdate());
+
+    ViewNodeUpdateViewTreeResult result;
+    int createdViews = 0;
+    for (size_t i = 0; i <= children.size() && root->viewTreeNeedsUpdate(); i++) {
+        result = root->updateViewTree(utils.getViewTransactionScope());
+        createdViews += result.createdViews;
+    }
+
+    ASSERT_FALSE(root->viewTreeNeedsUpdate());
+    ASSERT_EQ(0, result.deferredViews);
+    ASSERT_GT(createdViews, 0);
+
+    auto platformScrollView = StandaloneView::unwrap(scrollContainer->getView());
+    ASSERT_EQ(children.size(), platformScrollView->getChildren().size());
+    for (size_t i = 0; i < children.size(); i++) {
+        ASSERT_EQ(StandaloneView::unwrap(children[i]->getView()), platformScrollView->getChildren()[i].get());
+    }
+}
+
 // TODO(simon): This test fails because we are not currently able to recover from switching
 // from non lazyLayout to lazyLayout after layout attributes have been applied.
 TEST(ViewNode, DISABLED_canToggleLazyLayout) {
@@ -3037,4 +3145,201 @@ TEST(ViewNode, canSetStaticScrollContentSize) {
     ASSERT_EQ(Point(0, 225), scrollContainer->getDirectionAgnosticScrollContentOffset());
 }
 
+static void addWidthDeclaration(Valdi::StyleNode& styleNode, double width, int id) {
+    auto* declaration = styleNode.add_styles();
+    declaration->mutable_attribute()->set_type(Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_DOUBLE);
+    declaration->mutable_attribute()->set_name("width");
+    declaration->mutable_attribute()->set_double_value(width);
+    declaration->set_id(id);
+    declaration->set_priority(id);
+}
+
+static Value makeCSSDocument(ViewNodeTestsDependencies& utils, const Valdi::StyleNode& styleNode) {
+    auto cssDocument = makeShared<CSSDocument>(
+        ResourceId(STRING_LITERAL("test"), STRING_LITERAL("test.valdicss")), styleNode, utils.getAttributeIds());
+    return Value(Ref<ValdiObject>(cssDocument));
+}
+
+static Value getResolvedWidth(ViewNodeTestsDependencies& utils, const Ref<ViewNode>& viewNode) {
+    return viewNode->getAttributesApplier().getResolvedAttributeValue(
+        utils.getAttributeIds().getIdForName(std::string_view("width")));
+}
+
+TEST(ViewNode, sharesResolvedStylesBetweenNodesWithSameCSSInputs) {
+    ViewNodeTestsDependencies utils;
+
+    Valdi::StyleNode styleNode;
+    auto* classRuleA = styleNode.mutable_ruleindex()->add_class_rules();
+    classRuleA->set_name("a");
+    addWidthDeclaration(*classRuleA->mutable_node(), 10, 1);
+    auto* classRuleB = styleNode.mutable_ruleindex()->add_class_rules();
+    classRuleB->set_name("b");
+    addWidthDeclaration(*classRuleB->mutable_node(), 20, 2);
+    auto cssDocument = makeCSSDocument(utils, styleNode);
+
+    auto root = utils.createLayout();
+    auto child1 = utils.createView();
+    auto child2 = utils.createView();
+    auto child3 = utils.createView();
+    root->appendChild(utils.getViewTransactionScope(), child1);
+    root->appendChild(utils.getViewTransactionScope(), child2);
+    root->appendChild(utils.getViewTransactionScope(), child3);
+
+    utils.setViewNodeAttribute(root, "cssDocument", cssDocument);
+    for (const auto& child : {child1, child2, child3}) {
+        utils.setViewNodeAttribute(child, "cssDocument", cssDocument);
+    }
+    utils.setViewNodeAttribute(child1, "class", Value(STRING_LITERAL("a")));
+    utils.setViewNodeAttribute(child2, "class", Value(STRING_LITERAL("a")));
+    utils.setViewNodeAttribute(child3, "class", Value(STRING_LITERAL("b")));
+
+    root->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    auto style1 = child1->getCSSAttributesManager().getResolvedStyle();
+    auto style2 = child2->getCSSAttributesManager().getResolvedStyle();
+    auto style3 = child3->getCSSAttributesManager().getResolvedStyle();
+
+    ASSERT_TRUE(style1 != nullptr);
+    ASSERT_EQ(style1, style2);
+    ASSERT_NE(style1, style3);
+
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child1));
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child2));
+    ASSERT_EQ(Value(20.0), getResolvedWidth(utils, child3));
+}
+
+static Valdi::StyleNode makeChildOfParentStyleNode() {
+    // .child { width: 5 } and .a > .child { width: 10 }
+    Valdi::StyleNode styleNode;
+    auto* childRule = styleNode.mutable_ruleindex()->add_class_rules();
+    childRule->set_name("child");
+    addWidthDeclaration(*childRule->mutable_node(), 5, 1);
+
+    auto* parentRule = childRule->mutable_node()->mutable_ruleindex()->mutable_direct_parent_rules()->add_class_rules();
+    parentRule->set_name("a");
+    addWidthDeclaration(*parentRule->mutable_node(), 10, 2);
+
+    return styleNode;
+}
+
+TEST(ViewNode, updatesChildCSSWhenParentClassChanges) {
+    ViewNodeTestsDependencies utils;
+    auto cssDocument = makeCSSDocument(utils, makeChildOfParentStyleNode());
+
+    auto root = utils.createLayout();
+    auto parent1 = utils.createView();
+    auto parent2 = utils.createView();
+    auto child1 = utils.createView();
+    auto child2 = utils.createView();
+    root->appendChild(utils.getViewTransactionScope(), parent1);
+    root->appendChild(utils.getViewTransactionScope(), parent2);
+    parent1->appendChild(utils.getViewTransactionScope(), child1);
+    parent2->appendChild(utils.getViewTransactionScope(), child2);
+
+    for (const auto& node : {root, parent1, parent2, child1, child2}) {
+        utils.setViewNodeAttribute(node, "cssDocument", cssDocument);
+    }
+    utils.setViewNodeAttribute(parent1, "class", Value(STRING_LITERAL("b")));
+    utils.setViewNodeAttribute(parent2, "class", Value(STRING_LITERAL("b")));
+    utils.setViewNodeAttribute(child1, "class", Value(STRING_LITERAL("child")));
+    utils.setViewNodeAttribute(child2, "class", Value(STRING_LITERAL("child")));
+
+    root->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child1));
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child2));
+
+    utils.setViewNodeAttribute(parent1, "class", Value(STRING_LITERAL("a")));
+    root->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child1));
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child2));
+    ASSERT_NE(child1->getCSSAttributesManager().getResolvedStyle(),
+              child2->getCSSAttributesManager().getResolvedStyle());
+
+    utils.setViewNodeAttribute(parent2, "class", Value(STRING_LITERAL("a")));
+    root->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    // Both children now have the same inputs and share their style
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child2));
+    ASSERT_EQ(child1->getCSSAttributesManager().getResolvedStyle(),
+              child2->getCSSAttributesManager().getResolvedStyle());
+
+    utils.setViewNodeAttribute(parent1, "class", Value(STRING_LITERAL("b")));
+    root->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child1));
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child2));
+}
+
+TEST(ViewNode, updatesChildCSSWhenParentClassChangesThroughNodeWithoutCSS) {
+    ViewNodeTestsDependencies utils;
+    auto cssDocument = makeCSSDocument(utils, makeChildOfParentStyleNode());
+
+    auto parent = utils.createView();
+    // The intermediate node has no CSS document, the CSS parent of the child is the parent node
+    auto intermediate = utils.createLayout();
+    auto child = utils.createView();
+    parent->appendChild(utils.getViewTransactionScope(), intermediate);
+    intermediate->appendChild(utils.getViewTransactionScope(), child);
+
+    utils.setViewNodeAttribute(parent, "cssDocument", cssDocument);
+    utils.setViewNodeAttribute(child, "cssDocument", cssDocument);
+    utils.setViewNodeAttribute(parent, "class", Value(STRING_LITERAL("b")));
+    utils.setViewNodeAttribute(child, "class", Value(STRING_LITERAL("child")));
+
+    parent->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child));
+
+    utils.setViewNodeAttribute(parent, "class", Value(STRING_LITERAL("a")));
+    parent->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child));
+
+    utils.setViewNodeAttribute(parent, "class", Value(STRING_LITERAL("b")));
+    parent->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child));
+}
+
+TEST(ViewNode, updatesChildCSSWhenParentClassChangesThroughNodesOfOtherDocument) {
+    ViewNodeTestsDependencies utils;
+    auto cssDocument = makeCSSDocument(utils, makeChildOfParentStyleNode());
+    auto otherCSSDocument = makeCSSDocument(utils, makeChildOfParentStyleNode());
+
+    auto parent = utils.createView();
+    // The child is given to a slot of a component rendered with another document,
+    // the CSS parent of the child is still the parent node.
+    auto slotHost = utils.createLayout();
+    auto slot = utils.createLayout();
+    auto child = utils.createView();
+    parent->appendChild(utils.getViewTransactionScope(), slotHost);
+    slotHost->appendChild(utils.getViewTransactionScope(), slot);
+    slot->appendChild(utils.getViewTransactionScope(), child);
+
+    utils.setViewNodeAttribute(parent, "cssDocument", cssDocument);
+    utils.setViewNodeAttribute(slotHost, "cssDocument", otherCSSDocument);
+    utils.setViewNodeAttribute(slot, "cssDocument", otherCSSDocument);
+    utils.setViewNodeAttribute(child, "cssDocument", cssDocument);
+    utils.setViewNodeAttribute(parent, "class", Value(STRING_LITERAL("b")));
+    utils.setViewNodeAttribute(slotHost, "class", Value(STRING_LITERAL("a")));
+    utils.setViewNodeAttribute(slot, "class", Value(STRING_LITERAL("a")));
+    utils.setViewNodeAttribute(child, "class", Value(STRING_LITERAL("child")));
+
+    parent->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child));
+
+    utils.setViewNodeAttribute(parent, "class", Value(STRING_LITERAL("a")));
+    parent->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(10.0), getResolvedWidth(utils, child));
+
+    utils.setViewNodeAttribute(parent, "class", Value(STRING_LITERAL("b")));
+    parent->updateCSS(utils.getViewTransactionScope(), nullptr);
+
+    ASSERT_EQ(Value(5.0), getResolvedWidth(utils, child));
+}
+
 } // namespace ValdiTest
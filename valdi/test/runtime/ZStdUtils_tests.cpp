@@ -0,0 +1,192 @@
+#include "valdi/runtime/Resources/ZStdUtils.hpp"
+#include "gtest/gtest.h"
+#include "zstd.h"
+
+#include <algorithm>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static ByteBuffer makeTestData(size_t size) {
+    ByteBuffer data;
+    data.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        data.data()[i] = static_cast<Byte>((i * 7) % 251);
+    }
+    return data;
+}
+
+static ByteBuffer compress(const ByteBuffer& input, bool includeContentSize) {
+    auto* cctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_contentSizeFlag, includeContentSize ? 1 : 0);
+
+    ByteBuffer output;
+    output.resize(ZSTD_compressBound(input.size()));
+    auto size = ZSTD_compress2(cctx, output.data(), output.size(), input.data(), input.size());
+    ZSTD_freeCCtx(cctx);
+
+    if (ZSTD_isError(size) != 0) {
+        return ByteBuffer();
+    }
+    output.resize(size);
+    return output;
+}
+
+static ByteBuffer makePatch(const ByteBuffer& base, const ByteBuffer& target) {
+    auto* cctx = ZSTD_createCCtx();
+    // Like `zstd --patch-from`, use a window covering both the base and the target
+    int windowLog = 10;
+    while ((1ULL << (windowLog - 1)) < std::max(base.size(), target.size())) {
+        windowLog++;
+    }
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, windowLog);
+    ZSTD_CCtx_refPrefix(cctx, base.data(), base.size());
+
+    ByteBuffer output;
+    output.resize(ZSTD_compressBound(target.size()));
+    auto size = ZSTD_compress2(cctx, output.data(), output.size(), target.data(), target.size());
+    ZSTD_freeCCtx(cctx);
+
+    if (ZSTD_isError(size) != 0) {
+        return ByteBuffer();
+    }
+    output.resize(size);
+    return output;
+}
+
+static ByteBuffer makeUpdatedData(const ByteBuffer& base, size_t size) {
+    ByteBuffer data;
+    data.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        data.data()[i] = i < base.size() ? base.data()[i] : static_cast<Byte>(i % 13);
+    }
+    // Change a few bytes across the file
+    for (size_t i = 0; i < size; i += 4096) {
+        data.data()[i] = static_cast<Byte>(data.data()[i] + 1);
+    }
+    return data;
+}
+
+static Result<Ref<ByteBuffer>> decompressInChunks(const ByteBuffer& input, size_t chunkSize) {
+    ZStdStreamDecompressor decompressor(input.size());
+
+    size_t offset = 0;
+    while (offset < input.size()) {
+        auto length = std::min(chunkSize, input.size() - offset);
+        auto result = decompressor.append(input.data() + offset, length);
+        if (!result) {
+            return result.error();
+        }
+        offset += length;
+    }
+
+    return decompressor.finish();
+}
+
+TEST(ZStdUtils, canDecompressInChunks) {
+    auto data = makeTestData(1024 * 1024);
+    auto compressed = compress(data, true);
+    ASSERT_FALSE(compressed.empty());
+
+    auto result = decompressInChunks(compressed, 1000);
+
+    ASSERT_TRUE(result) << result.description();
+    ASSERT_EQ(data, *result.value());
+}
+
+TEST(ZStdUtils, canDecompressInChunksWithoutContentSize) {
+    auto data = makeTestData(1024 * 1024);
+    auto compressed = compress(data, false);
+    ASSERT_FALSE(compressed.empty());
+
+    auto result = decompressInChunks(compressed, 4096);
+
+    ASSERT_TRUE(result) << result.description();
+    ASSERT_EQ(data, *result.value());
+
+    auto oneShotResult = ZStdUtils::decompress(compressed.data(), compressed.size());
+    ASSERT_TRUE(oneShotResult) << oneShotResult.description();
+    ASSERT_EQ(data, *oneShotResult.value());
+}
+
+TEST(ZStdUtils, failsOnTruncatedInput) {
+    auto data = makeTestData(64 * 1024);
+    auto compressed = compress(data, true);
+    ASSERT_FALSE(compressed.empty());
+
+    ZStdStreamDecompressor decompressor;
+    ASSERT_TRUE(decompressor.append(compressed.data(), compressed.size() / 2));
+
+    ASSERT_FALSE(decompressor.finish());
+}
+
+TEST(ZStdUtils, failsOnInvalidInput) {
+    auto data = makeTestData(1024);
+
+    ZStdStreamDecompressor decompressor;
+    ASSERT_FALSE(decompressor.append(data.data(), data.size()));
+    ASSERT_FALSE(decompressor.finish());
+}
+
+TEST(ZStdUtils, canApplyPatch) {
+    auto base = makeTestData(512 * 1024);
+    auto target = makeUpdatedData(base, 600 * 1024 + 17);
+    auto patch = makePatch(base, target);
+    ASSERT_FALSE(patch.empty());
+
+    auto result = ZStdUtils::applyPatch(base.data(), base.size(), patch.data(), patch.size());
+
+    ASSERT_TRUE(result) << result.description();
+    ASSERT_EQ(target, *result.value());
+}
+
+TEST(ZStdUtils, canApplyPatchWithOutputMultipleOfStreamBufferSize) {
+    // The last decompression call fills the output buffer exactly as the frame ends
+    auto base = makeTestData(512 * 1024);
+    auto target = makeUpdatedData(base, ZSTD_DStreamOutSize() * 4);
+    auto patch = makePatch(base, target);
+    ASSERT_FALSE(patch.empty());
+
+    auto result = ZStdUtils::applyPatch(base.data(), base.size(), patch.data(), patch.size());
+
+    ASSERT_TRUE(result) << result.description();
+    ASSERT_EQ(target, *result.value());
+}
+
+TEST(ZStdUtils, failsToApplyPatchWithWindowLargerThanBaseAndOutput) {
+    auto base = makeTestData(64 * 1024);
+    auto target = makeUpdatedData(base, 64 * 1024);
+
+    // Streaming the input leaves the size unknown, so the frame keeps the window it was given
+    auto* cctx = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, 27);
+    ZSTD_CCtx_refPrefix(cctx, base.data(), base.size());
+
+    ByteBuffer patch;
+    patch.resize(ZSTD_compressBound(target.size()));
+    ZSTD_inBuffer inBuffer = {target.data(), target.size(), 0};
+    ZSTD_outBuffer outBuffer = {patch.data(), patch.size(), 0};
+    ZSTD_compressStream2(cctx, &outBuffer, &inBuffer, ZSTD_e_continue);
+    auto remaining = ZSTD_compressStream2(cctx, &outBuffer, &inBuffer, ZSTD_e_end);
+    ZSTD_freeCCtx(cctx);
+    ASSERT_EQ(static_cast<size_t>(0), remaining);
+    patch.resize(outBuffer.pos);
+
+    auto result = ZStdUtils::applyPatch(base.data(), base.size(), patch.data(), patch.size());
+
+    ASSERT_FALSE(result);
+}
+
+TEST(ZStdUtils, failsToApplyTruncatedPatch) {
+    auto base = makeTestData(512 * 1024);
+    auto target = makeUpdatedData(base, 600 * 1024);
+    auto patch = makePatch(base, target);
+    ASSERT_FALSE(patch.empty());
+
+    auto result = ZStdUtils::applyPatch(base.data(), base.size(), patch.data(), patch.size() / 2);
+
+    ASSERT_FALSE(result);
+}
+
+} // namespace ValdiTest
@@ -74,7 +74,11 @@ Result<snap::valdi_core::HTTPResponse> RequestManagerMock::getResponse(const sna
     for (const auto& mockedResponse : _mockedResponses) {
         const auto& expectedRequest = mockedResponse.first;
 
-        if (expectedRequest.url == request.url && expectedRequest.method == request.method) {
+        // Headers are only matched when the mocked request specifies them
+        auto headersMatch =
+            expectedRequest.headers.isNullOrUndefined() || expectedRequest.headers == request.headers;
+
+        if (expectedRequest.url == request.url && expectedRequest.method == request.method && headersMatch) {
             const auto& response = mockedResponse.second;
 
             return response;
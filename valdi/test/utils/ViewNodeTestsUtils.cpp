@@ -87,6 +87,10 @@ StandaloneViewManager& ViewNodeTestsDependencies::getViewManager() {
     return _viewManager;
 }
 
+AttributeIds& ViewNodeTestsDependencies::getAttributeIds() {
+    return _attributesManager.getAttributeIds();
+}
+
 void ViewNodeTestsDependencies::setViewNodeAttribute(const Ref<ViewNode>& viewNode,
                                                      const char* attribute,
                                                      const Value& attributeValue) {
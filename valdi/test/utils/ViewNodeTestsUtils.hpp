@@ -40,6 +40,8 @@ public:
 
     StandaloneViewManager& getViewManager();
 
+    AttributeIds& getAttributeIds();
+
     void setViewNodeAttribute(const Ref<ViewNode>& viewNode, const char* attribute, const Value& attributeValue);
 
     void setViewNodeFrame(const Ref<ViewNode>& viewNode, double x, double y, double width, double height);
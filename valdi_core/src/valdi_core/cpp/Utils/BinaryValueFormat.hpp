@@ -0,0 +1,71 @@
+//
+//  BinaryValueFormat.hpp
+//  valdi_core
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Valdi {
+
+/**
+ Constants shared by BinaryValueWriter and BinaryValueReader.
+
+ A binary value document is laid out as:
+ - A 16 bytes header: magic, version, size of the tables and size of the body, as 32 bits words.
+ - The string table: the count of strings, followed by each string as a length and its UTF-8 bytes.
+   Every string of the document, whether used as a value, a map key or a class property name,
+   is stored once in this table and referenced by index everywhere else.
+ - The class table: the count of classes, followed by each class as the index of its name,
+   its properties count and the index of each property name.
+ - Padding so that the body starts on an 8 bytes boundary.
+ - The body, which holds the encoded root value.
+
+ Counts, lengths and indexes are written as LEB128 varints. Every value starts with a tag byte:
+ - Int and Long values are zigzag encoded varints, Double values are 8 bytes.
+ - String and Error values are followed by the index of their string.
+ - Arrays, Maps and TypedObjects are followed by their items count and by the size in bytes of their
+   items as a 32 bits word, which lets readers skip them without decoding them.
+   Map entries are written as the index of their key followed by their value. TypedObjects
+   are written as the index of their class followed by their property values in schema order.
+ - TypedArrays are followed by their TypedArrayType and their length, and their bytes are
+   stored inline, aligned on an 8 bytes boundary relative to the start of the body, so that
+   readers can expose them without copying.
+ */
+namespace BinaryValueFormat {
+
+constexpr uint32_t kMagic = 0x31564256; // "VBV1"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderSize = 16;
+constexpr size_t kAlignment = 8;
+
+// Same limit as the default recursion limit of the protobuf parser
+constexpr size_t kMaxNestingDepth = 100;
+
+enum class Tag : uint8_t {
+    Null = 0,
+    Undefined = 1,
+    False = 2,
+    True = 3,
+    Int = 4,
+    Long = 5,
+    Double = 6,
+    String = 7,
+    Error = 8,
+    Array = 9,
+    Map = 10,
+    TypedObject = 11,
+    TypedArray = 12,
+};
+
+constexpr size_t alignedSize(size_t size) {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+} // namespace BinaryValueFormat
+
+} // namespace Valdi
@@ -0,0 +1,711 @@
+//
+//  BinaryValueReader.cpp
+//  valdi_core
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi_core/cpp/Utils/BinaryValueReader.hpp"
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Schema/ValueSchemaRegistry.hpp"
+#include "valdi_core/cpp/Utils/BinaryValueFormat.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include "valdi_core/cpp/Utils/ValueMap.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedObject.hpp"
+
+#include <cstring>
+
+namespace Valdi {
+
+using BinaryValueFormat::Tag;
+
+namespace {
+
+/**
+ Bounds checked cursor over the bytes of a binary value document.
+ */
+class BinaryValueCursor {
+public:
+    BinaryValueCursor(const Byte* current, const Byte* end) : _current(current), _end(end) {}
+
+    const Byte* position() const {
+        return _current;
+    }
+
+    size_t remaining() const {
+        return static_cast<size_t>(_end - _current);
+    }
+
+    bool readByte(uint8_t& output) {
+        if (_current >= _end) {
+            return false;
+        }
+        output = *_current;
+        _current++;
+        return true;
+    }
+
+    bool readTag(Tag& output) {
+        uint8_t tag = 0;
+        if (!readByte(tag) || tag > static_cast<uint8_t>(Tag::TypedArray)) {
+            return false;
+        }
+        output = static_cast<Tag>(tag);
+        return true;
+    }
+
+    bool readWord(uint32_t& output) {
+        if (remaining() < sizeof(uint32_t)) {
+            return false;
+        }
+        std::memcpy(&output, _current, sizeof(uint32_t));
+        _current += sizeof(uint32_t);
+        return true;
+    }
+
+    bool readDouble(double& output) {
+        if (remaining() < sizeof(double)) {
+            return false;
+        }
+        std::memcpy(&output, _current, sizeof(double));
+        _current += sizeof(double);
+        return true;
+    }
+
+    bool readVarInt(uint64_t& output) {
+        output = 0;
+        for (size_t shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = 0;
+            if (!readByte(byte)) {
+                return false;
+            }
+            output |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readSignedVarInt(int64_t& output) {
+        uint64_t zigzag = 0;
+        if (!readVarInt(zigzag)) {
+            return false;
+        }
+        output = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        return true;
+    }
+
+    /**
+     Read a count or a length, which cannot exceed the number of remaining bytes.
+     */
+    bool readSize(size_t& output) {
+        uint64_t size = 0;
+        if (!readVarInt(size) || size > remaining()) {
+            return false;
+        }
+        output = static_cast<size_t>(size);
+        return true;
+    }
+
+    bool readIndex(size_t count, size_t& output) {
+        uint64_t index = 0;
+        if (!readVarInt(index) || index >= count) {
+            return false;
+        }
+        output = static_cast<size_t>(index);
+        return true;
+    }
+
+    bool skip(size_t size) {
+        if (remaining() < size) {
+            return false;
+        }
+        _current += size;
+        return true;
+    }
+
+    bool alignFrom(const Byte* origin) {
+        auto offset = static_cast<size_t>(_current - origin);
+        return skip(BinaryValueFormat::alignedSize(offset) - offset);
+    }
+
+    /**
+     Read the items count and items size of an Array, Map or TypedObject, the cursor
+     is left at the start of the items.
+     */
+    bool readContainerHeader(size_t& itemsCount, size_t& itemsSize) {
+        uint32_t size = 0;
+        if (!readSize(itemsCount) || !readWord(size) || size > remaining() || itemsCount > size) {
+            return false;
+        }
+        itemsSize = static_cast<size_t>(size);
+        return true;
+    }
+
+    bool readTypedArrayHeader(const Byte* documentStart, TypedArrayType& type, size_t& length) {
+        uint8_t rawType = 0;
+        if (!readByte(rawType) || rawType > static_cast<uint8_t>(TypedArrayType::ArrayBuffer)) {
+            return false;
+        }
+        type = static_cast<TypedArrayType>(rawType);
+        return readSize(length) && alignFrom(documentStart) && length <= remaining();
+    }
+
+    /**
+     Move the cursor past the value at the current position, without decoding it.
+     */
+    bool skipValue(const Byte* documentStart) {
+        Tag tag;
+        if (!readTag(tag)) {
+            return false;
+        }
+
+        uint64_t unused = 0;
+        size_t itemsCount = 0;
+        size_t itemsSize = 0;
+
+        switch (tag) {
+            case Tag::Null:
+            case Tag::Undefined:
+            case Tag::False:
+            case Tag::True:
+                return true;
+            case Tag::Int:
+            case Tag::Long:
+            case Tag::String:
+            case Tag::Error:
+                return readVarInt(unused);
+            case Tag::Double:
+                return skip(sizeof(double));
+            case Tag::TypedObject:
+                if (!readVarInt(unused)) {
+                    return false;
+                }
+                [[fallthrough]];
+            case Tag::Array:
+            case Tag::Map:
+                return readContainerHeader(itemsCount, itemsSize) && skip(itemsSize);
+            case Tag::TypedArray: {
+                TypedArrayType type;
+                size_t length = 0;
+                return readTypedArrayHeader(documentStart, type, length) && skip(length);
+            }
+        }
+
+        return false;
+    }
+
+private:
+    const Byte* _current;
+    const Byte* _end;
+};
+
+ValueType valueTypeForTag(Tag tag) {
+    switch (tag) {
+        case Tag::Null:
+            return ValueType::Null;
+        case Tag::Undefined:
+            return ValueType::Undefined;
+        case Tag::False:
+        case Tag::True:
+            return ValueType::Bool;
+        case Tag::Int:
+            return ValueType::Int;
+        case Tag::Long:
+            return ValueType::Long;
+        case Tag::Double:
+            return ValueType::Double;
+        case Tag::String:
+            return ValueType::InternedString;
+        case Tag::Error:
+            return ValueType::Error;
+        case Tag::Array:
+            return ValueType::Array;
+        case Tag::Map:
+            return ValueType::Map;
+        case Tag::TypedObject:
+            return ValueType::TypedObject;
+        case Tag::TypedArray:
+            return ValueType::TypedArray;
+    }
+
+    return ValueType::Undefined;
+}
+
+Error malformedDocumentError() {
+    return Error("Malformed binary value document");
+}
+
+Ref<ClassSchema> resolveClassSchema(const StringBox& className,
+                                    const std::vector<ClassPropertySchema>& properties,
+                                    ValueSchemaRegistry* registry) {
+    if (registry != nullptr) {
+        auto schema = registry->getSchemaForTypeName(className);
+        if (schema && schema->isClass()) {
+            auto classSchema = schema->getClassRef();
+            auto matches = classSchema->getPropertiesSize() == properties.size();
+            for (size_t i = 0; matches && i < properties.size(); i++) {
+                matches = classSchema->getProperty(i).name == properties[i].name;
+            }
+
+            if (matches) {
+                return classSchema;
+            }
+        }
+    }
+
+    return ValueSchema::cls(className, false, properties.data(), properties.size()).getClassRef();
+}
+
+} // namespace
+
+BinaryValueDocument::BinaryValueDocument(const BytesView& data,
+                                         std::vector<std::string_view> strings,
+                                         std::vector<Ref<ClassSchema>> classes,
+                                         size_t bodyOffset)
+    : _data(data), _strings(std::move(strings)), _classes(std::move(classes)), _bodyOffset(bodyOffset) {}
+
+BinaryValueDocument::~BinaryValueDocument() = default;
+
+const BytesView& BinaryValueDocument::getData() const {
+    return _data;
+}
+
+size_t BinaryValueDocument::getStringsSize() const {
+    return _strings.size();
+}
+
+std::string_view BinaryValueDocument::getString(size_t index) const {
+    return _strings[index];
+}
+
+size_t BinaryValueDocument::getClassesSize() const {
+    return _classes.size();
+}
+
+const Ref<ClassSchema>& BinaryValueDocument::getClass(size_t index) const {
+    return _classes[index];
+}
+
+BinaryValueView BinaryValueDocument::getRoot() {
+    return BinaryValueView(strongSmallRef(this), _data.data() + _bodyOffset);
+}
+
+Result<Ref<BinaryValueDocument>> BinaryValueDocument::parse(const BytesView& data, ValueSchemaRegistry* registry) {
+    BinaryValueCursor header(data.begin(), data.end());
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t tablesSize = 0;
+    uint32_t bodySize = 0;
+
+    if (!header.readWord(magic) || magic != BinaryValueFormat::kMagic) {
+        return Error("Invalid binary value document magic");
+    }
+    if (!header.readWord(version) || version != BinaryValueFormat::kVersion) {
+        return Error(STRING_FORMAT("Unsupported binary value document version {}", version));
+    }
+    if (!header.readWord(tablesSize) || !header.readWord(bodySize) ||
+        tablesSize % BinaryValueFormat::kAlignment != 0 || bodySize == 0 ||
+        static_cast<size_t>(tablesSize) + static_cast<size_t>(bodySize) != header.remaining()) {
+        return malformedDocumentError();
+    }
+
+    BinaryValueCursor tables(header.position(), header.position() + tablesSize);
+
+    size_t stringsCount = 0;
+    if (!tables.readSize(stringsCount)) {
+        return malformedDocumentError();
+    }
+
+    std::vector<std::string_view> strings;
+    strings.reserve(stringsCount);
+    for (size_t i = 0; i < stringsCount; i++) {
+        size_t length = 0;
+        if (!tables.readSize(length)) {
+            return malformedDocumentError();
+        }
+        strings.emplace_back(reinterpret_cast<const char*>(tables.position()), length);
+        tables.skip(length);
+    }
+
+    size_t classesCount = 0;
+    if (!tables.readSize(classesCount)) {
+        return malformedDocumentError();
+    }
+
+    std::vector<Ref<ClassSchema>> classes;
+    classes.reserve(classesCount);
+    std::vector<ClassPropertySchema> properties;
+    for (size_t i = 0; i < classesCount; i++) {
+        size_t classNameIndex = 0;
+        size_t propertiesCount = 0;
+        if (!tables.readIndex(strings.size(), classNameIndex) || !tables.readSize(propertiesCount)) {
+            return malformedDocumentError();
+        }
+
+        properties.clear();
+        for (size_t j = 0; j < propertiesCount; j++) {
+            size_t propertyNameIndex = 0;
+            if (!tables.readIndex(strings.size(), propertyNameIndex)) {
+                return malformedDocumentError();
+            }
+            properties.emplace_back(StringCache::getGlobal().makeString(strings[propertyNameIndex]),
+                                    ValueSchema::untyped());
+        }
+
+        classes.emplace_back(resolveClassSchema(
+            StringCache::getGlobal().makeString(strings[classNameIndex]), properties, registry));
+    }
+
+    // Only padding is allowed after the tables
+    while (tables.remaining() > 0) {
+        uint8_t padding = 0;
+        if (!tables.readByte(padding) || padding != 0) {
+            return malformedDocumentError();
+        }
+    }
+
+    return makeShared<BinaryValueDocument>(
+        data, std::move(strings), std::move(classes), BinaryValueFormat::kHeaderSize + tablesSize);
+}
+
+BinaryValueView::BinaryValueView() = default;
+
+BinaryValueView::BinaryValueView(Ref<BinaryValueDocument> document, const Byte* data)
+    : _document(std::move(document)), _data(data) {}
+
+BinaryValueView::~BinaryValueView() = default;
+
+ValueType BinaryValueView::getType() const {
+    if (_document == nullptr) {
+        return ValueType::Undefined;
+    }
+
+    BinaryValueCursor cursor(_data, _document->getData().end());
+    Tag tag;
+    if (!cursor.readTag(tag)) {
+        return ValueType::Undefined;
+    }
+
+    return valueTypeForTag(tag);
+}
+
+size_t BinaryValueView::size() const {
+    if (_document == nullptr) {
+        return 0;
+    }
+
+    BinaryValueCursor cursor(_data, _document->getData().end());
+    Tag tag;
+    uint64_t classIndex = 0;
+    size_t itemsCount = 0;
+    size_t itemsSize = 0;
+    if (!cursor.readTag(tag) || (tag != Tag::Array && tag != Tag::Map && tag != Tag::TypedObject) ||
+        (tag == Tag::TypedObject && !cursor.readVarInt(classIndex)) ||
+        !cursor.readContainerHeader(itemsCount, itemsSize)) {
+        return 0;
+    }
+
+    return itemsCount;
+}
+
+std::optional<BinaryValueView> BinaryValueView::getArrayItem(size_t index) const {
+    if (getType() != ValueType::Array) {
+        return std::nullopt;
+    }
+
+    return getContainerItem(index, false);
+}
+
+std::optional<BinaryValueView> BinaryValueView::getMapValue(std::string_view key) const {
+    if (getType() != ValueType::Map) {
+        return std::nullopt;
+    }
+
+    const auto* documentStart = _document->getData().data();
+    BinaryValueCursor cursor(_data + 1, _document->getData().end());
+    size_t itemsCount = 0;
+    size_t itemsSize = 0;
+    if (!cursor.readContainerHeader(itemsCount, itemsSize)) {
+        return std::nullopt;
+    }
+
+    for (size_t i = 0; i < itemsCount; i++) {
+        size_t keyIndex = 0;
+        if (!cursor.readIndex(_document->getStringsSize(), keyIndex)) {
+            return std::nullopt;
+        }
+        if (_document->getString(keyIndex) == key) {
+            return BinaryValueView(_document, cursor.position());
+        }
+        if (!cursor.skipValue(documentStart)) {
+            return std::nullopt;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<BinaryValueView> BinaryValueView::getProperty(std::string_view propertyName) const {
+    if (getType() != ValueType::TypedObject) {
+        return std::nullopt;
+    }
+
+    BinaryValueCursor cursor(_data + 1, _document->getData().end());
+    size_t classIndex = 0;
+    if (!cursor.readIndex(_document->getClassesSize(), classIndex)) {
+        return std::nullopt;
+    }
+
+    const auto& classSchema = _document->getClass(classIndex);
+    for (size_t i = 0; i < classSchema->getPropertiesSize(); i++) {
+        if (classSchema->getProperty(i).name.toStringView() == propertyName) {
+            return getContainerItem(i, false);
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<BinaryValueView> BinaryValueView::getContainerItem(size_t index, bool hasKeys) const {
+    const auto* documentStart = _document->getData().data();
+    BinaryValueCursor cursor(_data, _document->getData().end());
+    Tag tag;
+    uint64_t unused = 0;
+    size_t itemsCount = 0;
+    size_t itemsSize = 0;
+    if (!cursor.readTag(tag) || (tag == Tag::TypedObject && !cursor.readVarInt(unused)) ||
+        !cursor.readContainerHeader(itemsCount, itemsSize) || index >= itemsCount) {
+        return std::nullopt;
+    }
+
+    for (size_t i = 0; i < index; i++) {
+        if ((hasKeys && !cursor.readVarInt(unused)) || !cursor.skipValue(documentStart)) {
+            return std::nullopt;
+        }
+    }
+
+    if (hasKeys && !cursor.readVarInt(unused)) {
+        return std::nullopt;
+    }
+
+    return BinaryValueView(_document, cursor.position());
+}
+
+Result<Value> BinaryValueView::toValue() const {
+    if (_document == nullptr) {
+        return Value::undefined();
+    }
+
+    BinaryValueReader reader(_document);
+    return reader.read(_data);
+}
+
+BinaryValueReader::BinaryValueReader(const Ref<BinaryValueDocument>& document)
+    : _document(document),
+      _strings(document->getStringsSize()),
+      _resolvedStrings(document->getStringsSize(), false),
+      _end(document->getData().end()) {}
+
+BinaryValueReader::~BinaryValueReader() = default;
+
+Result<Value> BinaryValueReader::read(const Byte* data) {
+    _current = data;
+
+    Value output;
+    if (!readValue(output, 0)) {
+        return malformedDocumentError();
+    }
+
+    return output;
+}
+
+bool BinaryValueReader::readValue(Value& output, size_t depth) {
+    if (depth > BinaryValueFormat::kMaxNestingDepth) {
+        return false;
+    }
+
+    BinaryValueCursor cursor(_current, _end);
+    // Keeps _current in sync with the cursor when returning
+    auto readAndAdvance = [&](bool result) {
+        _current = cursor.position();
+        return result;
+    };
+
+    Tag tag;
+    if (!cursor.readTag(tag)) {
+        return false;
+    }
+
+    switch (tag) {
+        case Tag::Null:
+            output = Value();
+            return readAndAdvance(true);
+        case Tag::Undefined:
+            output = Value::undefined();
+            return readAndAdvance(true);
+        case Tag::False:
+        case Tag::True:
+            output = Value(tag == Tag::True);
+            return readAndAdvance(true);
+        case Tag::Int: {
+            int64_t i = 0;
+            if (!cursor.readSignedVarInt(i)) {
+                return false;
+            }
+            output = Value(static_cast<int32_t>(i));
+            return readAndAdvance(true);
+        }
+        case Tag::Long: {
+            int64_t l = 0;
+            if (!cursor.readSignedVarInt(l)) {
+                return false;
+            }
+            output = Value(l);
+            return readAndAdvance(true);
+        }
+        case Tag::Double: {
+            double d = 0;
+            if (!cursor.readDouble(d)) {
+                return false;
+            }
+            output = Value(d);
+            return readAndAdvance(true);
+        }
+        case Tag::String:
+        case Tag::Error: {
+            size_t index = 0;
+            if (!cursor.readIndex(_strings.size(), index)) {
+                return false;
+            }
+            const auto& str = getString(index);
+            output = tag == Tag::String ? Value(str) : Value(Error(str));
+            return readAndAdvance(true);
+        }
+        case Tag::Array: {
+            size_t itemsCount = 0;
+            size_t itemsSize = 0;
+            if (!cursor.readContainerHeader(itemsCount, itemsSize)) {
+                return false;
+            }
+            const auto* itemsEnd = cursor.position() + itemsSize;
+            _current = cursor.position();
+
+            auto array = ValueArray::make(itemsCount);
+            for (size_t i = 0; i < itemsCount; i++) {
+                Value item;
+                if (!readValue(item, depth + 1)) {
+                    return false;
+                }
+                array->emplace(i, std::move(item));
+            }
+
+            output = Value(array);
+            return _current == itemsEnd;
+        }
+        case Tag::Map: {
+            size_t itemsCount = 0;
+            size_t itemsSize = 0;
+            if (!cursor.readContainerHeader(itemsCount, itemsSize)) {
+                return false;
+            }
+            const auto* itemsEnd = cursor.position() + itemsSize;
+            _current = cursor.position();
+
+            auto map = makeShared<ValueMap>();
+            map->reserve(itemsCount);
+            for (size_t i = 0; i < itemsCount; i++) {
+                StringBox key;
+                Value item;
+                if (!readString(key) || !readValue(item, depth + 1)) {
+                    return false;
+                }
+                (*map)[key] = std::move(item);
+            }
+
+            output = Value(map);
+            return _current == itemsEnd;
+        }
+        case Tag::TypedObject: {
+            size_t classIndex = 0;
+            size_t itemsCount = 0;
+            size_t itemsSize = 0;
+            if (!cursor.readIndex(_document->getClassesSize(), classIndex) ||
+                !cursor.readContainerHeader(itemsCount, itemsSize)) {
+                return false;
+            }
+            const auto& classSchema = _document->getClass(classIndex);
+            if (itemsCount != classSchema->getPropertiesSize()) {
+                return false;
+            }
+            const auto* itemsEnd = cursor.position() + itemsSize;
+            _current = cursor.position();
+
+            auto typedObject = ValueTypedObject::make(classSchema);
+            for (size_t i = 0; i < itemsCount; i++) {
+                Value property;
+                if (!readValue(property, depth + 1)) {
+                    return false;
+                }
+                typedObject->setProperty(i, std::move(property));
+            }
+
+            output = Value(typedObject);
+            return _current == itemsEnd;
+        }
+        case Tag::TypedArray: {
+            const auto& data = _document->getData();
+            TypedArrayType type;
+            size_t length = 0;
+            if (!cursor.readTypedArrayHeader(data.data(), type, length)) {
+                return false;
+            }
+
+            if (data.getSource() != nullptr) {
+                output = Value(makeShared<ValueTypedArray>(type, BytesView(data.getSource(), cursor.position(), length)));
+            } else {
+                // The document does not own its bytes, the typed array needs its own copy
+                auto bytes = makeShared<ByteBuffer>(cursor.position(), cursor.position() + length);
+                output = Value(makeShared<ValueTypedArray>(type, bytes->toBytesView()));
+            }
+
+            cursor.skip(length);
+            return readAndAdvance(true);
+        }
+    }
+
+    return false;
+}
+
+bool BinaryValueReader::readString(StringBox& output) {
+    BinaryValueCursor cursor(_current, _end);
+    size_t index = 0;
+    if (!cursor.readIndex(_strings.size(), index)) {
+        return false;
+    }
+    _current = cursor.position();
+    output = getString(index);
+    return true;
+}
+
+const StringBox& BinaryValueReader::getString(size_t index) {
+    if (!_resolvedStrings[index]) {
+        _resolvedStrings[index] = true;
+        _strings[index] = StringCache::getGlobal().makeString(_document->getString(index));
+    }
+    return _strings[index];
+}
+
+Result<Value> binaryToValue(const BytesView& data, ValueSchemaRegistry* registry) {
+    auto document = BinaryValueDocument::parse(data, registry);
+    if (!document) {
+        return document.moveError();
+    }
+
+    return document.value()->getRoot().toValue();
+}
+
+} // namespace Valdi
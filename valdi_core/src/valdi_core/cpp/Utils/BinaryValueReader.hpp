@@ -0,0 +1,130 @@
+//
+//  BinaryValueReader.hpp
+//  valdi_core
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Valdi {
+
+class ClassSchema;
+class ValueSchemaRegistry;
+class BinaryValueView;
+
+/**
+ A binary value document produced by BinaryValueWriter. Parsing a document only
+ reads its string and class tables, values are decoded on demand through BinaryValueView.
+ The document retains the underlying bytes, which are shared with the TypedArrays
+ decoded from it.
+ */
+class BinaryValueDocument : public SimpleRefCountable {
+public:
+    BinaryValueDocument(const BytesView& data,
+                        std::vector<std::string_view> strings,
+                        std::vector<Ref<ClassSchema>> classes,
+                        size_t bodyOffset);
+    ~BinaryValueDocument() override;
+
+    const BytesView& getData() const;
+    size_t getStringsSize() const;
+    std::string_view getString(size_t index) const;
+    size_t getClassesSize() const;
+    const Ref<ClassSchema>& getClass(size_t index) const;
+
+    /**
+     Returns a view on the root value of the document.
+     */
+    BinaryValueView getRoot();
+
+    /**
+     Parse the header and tables of the given binary value document.
+     When a registry is provided, TypedObjects are decoded using the ClassSchema
+     registered for their class name, as long as its properties match the ones
+     the document was written with. Otherwise, a ClassSchema is created from the
+     property names stored in the document.
+     */
+    static Result<Ref<BinaryValueDocument>> parse(const BytesView& data, ValueSchemaRegistry* registry);
+
+private:
+    BytesView _data;
+    std::vector<std::string_view> _strings;
+    std::vector<Ref<ClassSchema>> _classes;
+    size_t _bodyOffset;
+};
+
+/**
+ A view on an encoded value inside a BinaryValueDocument, which gives access to the
+ items of arrays, maps and typed objects without decoding the rest of the document.
+ */
+class BinaryValueView {
+public:
+    BinaryValueView();
+    BinaryValueView(Ref<BinaryValueDocument> document, const Byte* data);
+    ~BinaryValueView();
+
+    /**
+     Returns the type that the value will have once decoded, or Undefined if the view is invalid.
+     */
+    ValueType getType() const;
+
+    /**
+     Returns the number of items of an array, entries of a map or properties of a typed object.
+     */
+    size_t size() const;
+
+    std::optional<BinaryValueView> getArrayItem(size_t index) const;
+    std::optional<BinaryValueView> getMapValue(std::string_view key) const;
+    std::optional<BinaryValueView> getProperty(std::string_view propertyName) const;
+
+    /**
+     Decode the viewed value and all its descendants.
+     */
+    Result<Value> toValue() const;
+
+private:
+    Ref<BinaryValueDocument> _document;
+    const Byte* _data = nullptr;
+
+    std::optional<BinaryValueView> getContainerItem(size_t index, bool hasKeys) const;
+};
+
+/**
+ BinaryValueReader decodes values from a BinaryValueDocument in a single pass over the
+ encoded bytes. Strings are interned once per reader, TypedArrays reference the bytes of
+ the document without copying them.
+ */
+class BinaryValueReader {
+public:
+    explicit BinaryValueReader(const Ref<BinaryValueDocument>& document);
+    ~BinaryValueReader();
+
+    Result<Value> read(const Byte* data);
+
+private:
+    Ref<BinaryValueDocument> _document;
+    std::vector<StringBox> _strings;
+    std::vector<bool> _resolvedStrings;
+    const Byte* _current = nullptr;
+    const Byte* _end = nullptr;
+
+    bool readValue(Value& output, size_t depth);
+    bool readString(StringBox& output);
+    const StringBox& getString(size_t index);
+};
+
+/**
+ Convenience function which decodes a binary value document produced by valueToBinary().
+ */
+Result<Value> binaryToValue(const BytesView& data, ValueSchemaRegistry* registry = nullptr);
+
+} // namespace Valdi
@@ -0,0 +1,261 @@
+//
+//  BinaryValueWriter.cpp
+//  valdi_core
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#include "valdi_core/cpp/Utils/BinaryValueWriter.hpp"
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Utils/BinaryValueFormat.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include "valdi_core/cpp/Utils/ValueMap.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedObject.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedProxyObject.hpp"
+
+#include <cstring>
+
+namespace Valdi {
+
+using BinaryValueFormat::Tag;
+
+static void appendVarInt(ByteBuffer& output, uint64_t value) {
+    while (value >= 0x80) {
+        output.append(static_cast<Byte>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    output.append(static_cast<Byte>(value));
+}
+
+static void appendWord(ByteBuffer& output, uint32_t word) {
+    std::memcpy(output.appendWritable(sizeof(uint32_t)), &word, sizeof(uint32_t));
+}
+
+static void appendPadding(ByteBuffer& output, size_t alignedSize) {
+    while (output.size() < alignedSize) {
+        output.append(static_cast<Byte>(0));
+    }
+}
+
+BinaryValueWriter::BinaryValueWriter() : _body(makeShared<ByteBuffer>()) {}
+
+BinaryValueWriter::~BinaryValueWriter() = default;
+
+Result<BytesView> BinaryValueWriter::write(const Value& value) {
+    _body->clear();
+    _stringIndexes.clear();
+    _strings.clear();
+    _classIndexes.clear();
+    _classes.clear();
+
+    auto result = writeValue(value, 0);
+    if (!result) {
+        return result.moveError();
+    }
+
+    return makeDocument()->toBytesView();
+}
+
+Result<Void> BinaryValueWriter::writeValue(const Value& value, size_t depth) {
+    if (depth > BinaryValueFormat::kMaxNestingDepth) {
+        return Error("Exceeded maximum nesting depth while encoding value");
+    }
+
+    switch (value.getType()) {
+        case ValueType::Null:
+            writeTag(static_cast<uint8_t>(Tag::Null));
+            break;
+        case ValueType::Undefined:
+            writeTag(static_cast<uint8_t>(Tag::Undefined));
+            break;
+        case ValueType::Bool:
+            writeTag(static_cast<uint8_t>(value.toBool() ? Tag::True : Tag::False));
+            break;
+        case ValueType::Int:
+            writeTag(static_cast<uint8_t>(Tag::Int));
+            writeSignedVarInt(value.toInt());
+            break;
+        case ValueType::Long:
+            writeTag(static_cast<uint8_t>(Tag::Long));
+            writeSignedVarInt(value.toLong());
+            break;
+        case ValueType::Double: {
+            writeTag(static_cast<uint8_t>(Tag::Double));
+            auto d = value.toDouble();
+            std::memcpy(_body->appendWritable(sizeof(double)), &d, sizeof(double));
+        } break;
+        case ValueType::InternedString:
+        case ValueType::StaticString:
+            writeTag(static_cast<uint8_t>(Tag::String));
+            writeString(value.toStringBox());
+            break;
+        case ValueType::Error:
+            writeTag(static_cast<uint8_t>(Tag::Error));
+            writeString(value.getError().getMessage());
+            break;
+        case ValueType::Array: {
+            const auto* array = value.getArray();
+            writeTag(static_cast<uint8_t>(Tag::Array));
+            auto sizeOffset = beginContainer(array->size());
+            for (const auto& item : *array) {
+                auto result = writeValue(item, depth + 1);
+                if (!result) {
+                    return result;
+                }
+            }
+            endContainer(sizeOffset);
+        } break;
+        case ValueType::Map: {
+            const auto* map = value.getMap();
+            writeTag(static_cast<uint8_t>(Tag::Map));
+            auto sizeOffset = beginContainer(map->size());
+            for (const auto& it : *map) {
+                writeString(it.first);
+                auto result = writeValue(it.second, depth + 1);
+                if (!result) {
+                    return result;
+                }
+            }
+            endContainer(sizeOffset);
+        } break;
+        case ValueType::TypedArray: {
+            const auto* typedArray = value.getTypedArray();
+            const auto& buffer = typedArray->getBuffer();
+
+            writeTag(static_cast<uint8_t>(Tag::TypedArray));
+            _body->append(static_cast<Byte>(typedArray->getType()));
+            writeVarInt(buffer.size());
+            appendPadding(*_body, BinaryValueFormat::alignedSize(_body->size()));
+            _body->append(buffer.begin(), buffer.end());
+        } break;
+        case ValueType::TypedObject:
+            return writeTypedObject(*value.getTypedObject(), depth);
+        case ValueType::ProxyTypedObject:
+            return writeTypedObject(*value.getProxyObject()->getTypedObject(), depth);
+        case ValueType::Function:
+        case ValueType::ValdiObject:
+            return Error(STRING_FORMAT("Cannot encode value of type {}", valueTypeToString(value.getType())));
+    }
+
+    return Void();
+}
+
+Result<Void> BinaryValueWriter::writeTypedObject(const ValueTypedObject& typedObject, size_t depth) {
+    writeTag(static_cast<uint8_t>(Tag::TypedObject));
+    writeVarInt(getClassIndex(typedObject.getSchema()));
+
+    auto propertiesSize = typedObject.getPropertiesSize();
+    auto sizeOffset = beginContainer(propertiesSize);
+    for (size_t i = 0; i < propertiesSize; i++) {
+        auto result = writeValue(typedObject.getProperty(i), depth + 1);
+        if (!result) {
+            return result;
+        }
+    }
+    endContainer(sizeOffset);
+
+    return Void();
+}
+
+void BinaryValueWriter::writeTag(uint8_t tag) {
+    _body->append(static_cast<Byte>(tag));
+}
+
+void BinaryValueWriter::writeVarInt(uint64_t value) {
+    appendVarInt(*_body, value);
+}
+
+void BinaryValueWriter::writeSignedVarInt(int64_t value) {
+    // Zigzag encoding, so that small negative numbers stay small
+    writeVarInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void BinaryValueWriter::writeString(const StringBox& str) {
+    writeVarInt(getStringIndex(str));
+}
+
+size_t BinaryValueWriter::beginContainer(size_t itemsCount) {
+    writeVarInt(itemsCount);
+    auto sizeOffset = _body->size();
+    appendWord(*_body, 0);
+    return sizeOffset;
+}
+
+void BinaryValueWriter::endContainer(size_t sizeOffset) {
+    auto itemsSize = static_cast<uint32_t>(_body->size() - sizeOffset - sizeof(uint32_t));
+    std::memcpy(_body->data() + sizeOffset, &itemsSize, sizeof(uint32_t));
+}
+
+uint32_t BinaryValueWriter::getStringIndex(const StringBox& str) {
+    const auto& it = _stringIndexes.find(str);
+    if (it != _stringIndexes.end()) {
+        return it->second;
+    }
+
+    auto index = static_cast<uint32_t>(_strings.size());
+    _strings.emplace_back(str);
+    _stringIndexes[str] = index;
+    return index;
+}
+
+uint32_t BinaryValueWriter::getClassIndex(const Ref<ClassSchema>& classSchema) {
+    const auto& it = _classIndexes.find(classSchema.get());
+    if (it != _classIndexes.end()) {
+        return it->second;
+    }
+
+    auto index = static_cast<uint32_t>(_classes.size());
+    _classes.emplace_back(classSchema);
+    _classIndexes[classSchema.get()] = index;
+
+    // Make sure the names are part of the string table
+    getStringIndex(classSchema->getClassName());
+    for (const auto& property : *classSchema) {
+        getStringIndex(property.name);
+    }
+
+    return index;
+}
+
+Ref<ByteBuffer> BinaryValueWriter::makeDocument() {
+    ByteBuffer tables;
+
+    appendVarInt(tables, _strings.size());
+    for (const auto& str : _strings) {
+        auto view = str.toStringView();
+        appendVarInt(tables, view.size());
+        tables.append(view);
+    }
+
+    appendVarInt(tables, _classes.size());
+    for (const auto& classSchema : _classes) {
+        appendVarInt(tables, _stringIndexes[classSchema->getClassName()]);
+        appendVarInt(tables, classSchema->getPropertiesSize());
+        for (const auto& property : *classSchema) {
+            appendVarInt(tables, _stringIndexes[property.name]);
+        }
+    }
+
+    // The header size is a multiple of the alignment, so aligning the tables aligns the body
+    appendPadding(tables, BinaryValueFormat::alignedSize(tables.size()));
+
+    auto output = makeShared<ByteBuffer>();
+    output->reserve(BinaryValueFormat::kHeaderSize + tables.size() + _body->size());
+    appendWord(*output, BinaryValueFormat::kMagic);
+    appendWord(*output, BinaryValueFormat::kVersion);
+    appendWord(*output, static_cast<uint32_t>(tables.size()));
+    appendWord(*output, static_cast<uint32_t>(_body->size()));
+    output->append(tables.begin(), tables.end());
+    output->append(_body->begin(), _body->end());
+
+    return output;
+}
+
+Result<BytesView> valueToBinary(const Value& value) {
+    BinaryValueWriter writer;
+    return writer.write(value);
+}
+
+} // namespace Valdi
@@ -0,0 +1,69 @@
+//
+//  BinaryValueWriter.hpp
+//  valdi_core
+//
+//  Copyright © 2026 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+class ClassSchema;
+
+/**
+ BinaryValueWriter encodes a Value graph into a compact binary document, which can be
+ decoded back with BinaryValueReader. Compared to JSON, strings are interned into a table
+ and written once, TypedObjects are written without their property names by relying on
+ their ClassSchema, and TypedArrays are stored inline so that they can be read back without
+ copying. See BinaryValueFormat.hpp for the layout of the document.
+
+ Functions and ValdiObjects cannot be encoded. Proxy objects are encoded as their
+ underlying TypedObject.
+ */
+class BinaryValueWriter {
+public:
+    BinaryValueWriter();
+    ~BinaryValueWriter();
+
+    /**
+     Encode the given value as the root value of the document and returns the document.
+     */
+    Result<BytesView> write(const Value& value);
+
+private:
+    Ref<ByteBuffer> _body;
+    FlatMap<StringBox, uint32_t> _stringIndexes;
+    std::vector<StringBox> _strings;
+    FlatMap<const ClassSchema*, uint32_t> _classIndexes;
+    std::vector<Ref<ClassSchema>> _classes;
+
+    Result<Void> writeValue(const Value& value, size_t depth);
+    Result<Void> writeTypedObject(const ValueTypedObject& typedObject, size_t depth);
+
+    void writeTag(uint8_t tag);
+    void writeVarInt(uint64_t value);
+    void writeSignedVarInt(int64_t value);
+    void writeString(const StringBox& str);
+    size_t beginContainer(size_t itemsCount);
+    void endContainer(size_t sizeOffset);
+
+    uint32_t getStringIndex(const StringBox& str);
+    uint32_t getClassIndex(const Ref<ClassSchema>& classSchema);
+
+    Ref<ByteBuffer> makeDocument();
+};
+
+/**
+ Convenience function which encodes the given value into a binary value document.
+ */
+Result<BytesView> valueToBinary(const Value& value);
+
+} // namespace Valdi
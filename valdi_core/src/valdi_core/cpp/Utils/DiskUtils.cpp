@@ -12,7 +12,9 @@
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include <cstdio>
 #include <dirent.h>
+#include <fcntl.h>
 #include <fstream>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -168,6 +170,72 @@ Result<BytesView> DiskUtils::loadFromFd(int fd) {
     return bytes->toBytesView();
 }
 
+namespace {
+
+class MappedFile : public SimpleRefCountable {
+public:
+    MappedFile(void* address, size_t length) : _address(address), _length(length) {}
+    ~MappedFile() override {
+        munmap(_address, _length);
+    }
+
+private:
+    void* _address;
+    size_t _length;
+};
+
+} // namespace
+
+Result<BytesView> DiskUtils::mapFile(const Path& path, size_t byteOffset, std::optional<size_t> size) {
+    auto pathStr = path.toString();
+    auto fd = open(pathStr.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Error(STRING_FORMAT("Unable to open file at {}: {}", pathStr, strerror(errno)));
+    }
+
+    auto stat = statFromFd(fd);
+    if (!stat.isFile()) {
+        ::close(fd);
+        return Error(STRING_FORMAT("No file at {}", pathStr));
+    }
+
+    auto fileSize = stat.size();
+    if (byteOffset > fileSize) {
+        ::close(fd);
+        return outOfBOundsLoad(pathStr, byteOffset, size.value_or(0), fileSize);
+    }
+
+    auto toMapSize = size.value_or(fileSize - byteOffset);
+    if (byteOffset + toMapSize > fileSize) {
+        ::close(fd);
+        return outOfBOundsLoad(pathStr, byteOffset, toMapSize, fileSize);
+    }
+
+    if (toMapSize == 0) {
+        ::close(fd);
+        return BytesView();
+    }
+
+    // mmap offsets have to be aligned on the page size
+    auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto alignedOffset = byteOffset - (byteOffset % pageSize);
+    auto alignmentPadding = byteOffset - alignedOffset;
+    auto mappedLength = toMapSize + alignmentPadding;
+
+    // Mapped as private and writable, so that writes made by the consumer of the bytes
+    // are copy on write and never reach the file.
+    auto* address =
+        mmap(nullptr, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+    ::close(fd);
+
+    if (address == MAP_FAILED) {
+        return Error(STRING_FORMAT("Unable to map file at {}: {}", pathStr, strerror(errno)));
+    }
+
+    auto mappedFile = makeShared<MappedFile>(address, mappedLength);
+    return BytesView(mappedFile, reinterpret_cast<const Byte*>(address) + alignmentPadding, toMapSize);
+}
+
 Result<Void> DiskUtils::store(const Path& path, const BytesView& bytes) {
     return store(path, bytes.asStringView());
 }
@@ -78,6 +78,14 @@ public:
 
     static Result<BytesView> loadFromFd(int fd);
 
+    /**
+     Maps the given range of the file into memory instead of reading it. The pages are loaded lazily
+     as the returned bytes are accessed, and are unmapped once the bytes are released.
+     Accessing the bytes crashes with SIGBUS if the file is truncated while mapped, so this
+     should only be used on files which are not modified by other writers.
+     */
+    static Result<BytesView> mapFile(const Path& path, size_t byteOffset, std::optional<size_t> size);
+
     static Result<Void> store(const Path& path, const BytesView& bytes);
 
     static Result<Void> store(const Path& path, std::string_view bytes);